@@ -255,6 +255,30 @@ ErrorOr<size_t> CircularBuffer::copy_from_seekback(size_t distance, size_t lengt
     if (distance > m_seekback_limit)
         return Error::from_string_literal("Tried a seekback copy beyond the seekback limit");
 
+    // Fast path: Neither the source nor the destination wrap around the end of the buffer. Overlapping copies with a
+    // distance of at least a word are done front to back a word at a time, since every word only reads bytes that
+    // have already been written.
+    auto const write_offset = (m_reading_head + m_used_space) % capacity();
+    if (length <= empty_space() && distance <= write_offset && write_offset + length <= capacity()
+        && (distance >= length || distance >= sizeof(u64))) {
+        auto* destination = m_buffer.data() + write_offset;
+        auto const* source = destination - distance;
+
+        if (distance >= length) {
+            memcpy(destination, source, length);
+        } else {
+            size_t offset = 0;
+            for (; offset + sizeof(u64) <= length; offset += sizeof(u64))
+                memcpy(destination + offset, source + offset, sizeof(u64));
+            for (; offset < length; ++offset)
+                destination[offset] = source[offset];
+        }
+
+        m_used_space += length;
+        m_seekback_limit = min(m_seekback_limit + length, capacity());
+        return length;
+    }
+
     auto remaining_length = length;
     while (remaining_length > 0) {
         if (empty_space() == 0)
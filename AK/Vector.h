@@ -118,6 +118,13 @@ public:
 
     bool is_empty() const { return size() == 0; }
     ALWAYS_INLINE size_t size() const { return m_size; }
+
+    // NOTE: This is used by the LibJS JIT to access the elements of a Vector without an inline buffer directly.
+    static constexpr size_t outline_buffer_offset()
+    {
+        static_assert(inline_capacity == 0);
+        return __builtin_offsetof(Vector, m_outline_buffer);
+    }
     size_t capacity() const { return m_capacity; }
 
     ALWAYS_INLINE StorageType* data()
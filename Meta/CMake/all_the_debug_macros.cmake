@@ -92,6 +92,7 @@ set(ISO9660_DEBUG ON)
 set(ISO9660_VERY_DEBUG ON)
 set(ITEM_RECTS_DEBUG ON)
 set(JBIG2_DEBUG ON)
+set(JIT_DEBUG ON)
 set(JOB_DEBUG ON)
 set(JPEG_DEBUG ON)
 set(JPEG2000_DEBUG ON)
@@ -10,6 +10,7 @@
 #include <AK/BitStream.h>
 #include <AK/MemoryStream.h>
 #include <AK/Random.h>
+#include <AK/StringBuilder.h>
 #include <LibCompress/Deflate.h>
 #include <LibCore/File.h>
 #include <cstring>
@@ -62,6 +63,35 @@ TEST_CASE(canonical_code_complex)
         EXPECT_EQ(MUST(huffman.read_symbol(bit_stream)), output[idx]);
 }
 
+TEST_CASE(canonical_code_long_codes)
+{
+    // Symbol n has a code of length n + 1, up to two codes of the maximum length, which do not fit into a single lookup.
+    Array<u8, 16> const code {
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 15
+    };
+    Array<u32, 20> const symbols {
+        15, 0, 9, 14, 3, 10, 11, 1, 12, 13, 8, 2, 4, 5, 6, 7, 15, 14, 9, 0
+    };
+
+    auto const huffman = TRY_OR_FAIL(Compress::CanonicalCode::from_bytes(code));
+
+    AllocatingMemoryStream output_stream;
+    {
+        LittleEndianOutputBitStream output_bit_stream { MaybeOwned<Stream>(output_stream) };
+        for (auto symbol : symbols)
+            TRY_OR_FAIL(huffman.write_symbol(output_bit_stream, symbol));
+        TRY_OR_FAIL(output_bit_stream.align_to_byte_boundary());
+        TRY_OR_FAIL(output_bit_stream.flush_buffer_to_stream());
+    }
+    auto encoded = TRY_OR_FAIL(output_stream.read_until_eof());
+
+    // The last symbols are shorter than the longest code, so decoding them can not look ahead as far as usual.
+    FixedMemoryStream memory_stream { encoded.bytes() };
+    LittleEndianInputBitStream bit_stream { MaybeOwned<Stream>(memory_stream) };
+    for (auto symbol : symbols)
+        EXPECT_EQ(TRY_OR_FAIL(huffman.read_symbol(bit_stream)), symbol);
+}
+
 TEST_CASE(invalid_canonical_code)
 {
     Array<u8, 257> code;
@@ -156,6 +186,24 @@ TEST_CASE(deflate_round_trip_compress_large)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(deflate_round_trip_compress_in_parallel)
+{
+    // Half random, half repeated data, spread over several chunks with a partial chunk at the end.
+    auto size = Compress::DeflateCompressor::parallel_chunk_size * 5 + 1234;
+    auto original = ByteBuffer::create_uninitialized(size).release_value();
+    fill_with_random(original.bytes().trim(size / 2));
+    for (size_t i = size / 2; i < size; ++i)
+        original[i] = original[i % 1024];
+
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all_in_parallel(original, 4, Compress::DeflateCompressor::CompressionLevel::FAST));
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+
+    // Every block is compressed on its own, so splitting the input only adds the markers between the chunks.
+    auto compressed_serially = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, Compress::DeflateCompressor::CompressionLevel::FAST));
+    EXPECT(compressed.size() <= compressed_serially.size() + 5 * 6);
+}
+
 TEST_CASE(deflate_compress_literals)
 {
     // This byte array is known to not produce any back references with our lz77 implementation even at the highest compression settings
@@ -180,3 +228,26 @@ TEST_CASE(ossfuzz_58046)
     auto test_data = TRY_OR_FAIL(test_file->read_until_eof());
     EXPECT(Compress::DeflateDecompressor::decompress_all(test_data).is_error());
 }
+
+BENCHMARK_CASE(deflate_decompress_text_corpus)
+{
+    // A fixed pseudo-random sequence of words, which compresses to the usual mix of literals and back references.
+    static constexpr Array words { "the"sv, "of"sv, "and"sv, "to"sv, "in"sv, "a"sv, "is"sv, "that"sv, "for"sv, "it"sv,
+        "stream"sv, "block"sv, "huffman"sv, "distance"sv, "length"sv, "literal"sv, "symbol"sv, "window"sv, "buffer"sv, "code"sv };
+
+    StringBuilder builder;
+    u32 state = 0x12345678;
+    while (builder.length() < 8 * MiB) {
+        state = state * 1103515245 + 12345;
+        builder.append(words[(state >> 16) % words.size()]);
+        builder.append((state & 0xf) == 0 ? ".\n"sv : " "sv);
+    }
+    auto corpus = builder.string_view().bytes();
+
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(corpus, Compress::DeflateCompressor::CompressionLevel::FAST));
+
+    for (size_t i = 0; i < 10; ++i) {
+        auto decompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+        EXPECT(decompressed.bytes() == corpus);
+    }
+}
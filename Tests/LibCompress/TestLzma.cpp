@@ -95,6 +95,74 @@ TEST_CASE(compress_long_overflow_chain)
     EXPECT_EQ(uncompressed, result.span());
 }
 
+static ByteBuffer generate_compressible_data(size_t size)
+{
+    // Words picked by a simple LCG give a mix of short and long matches at many different distances.
+    constexpr Array words { "lorem"sv, "ipsum"sv, "dolor"sv, "sit"sv, "amet"sv, "consectetur"sv, "adipiscing"sv, "elit"sv, "\n"sv };
+
+    auto data = MUST(ByteBuffer::create_uninitialized(size));
+    u32 state = 12345;
+    size_t offset = 0;
+    while (offset < size) {
+        state = state * 1103515245 + 12345;
+        auto word = words[(state >> 16) % words.size()];
+        auto count = min(word.length() + 1, size - offset);
+        data.overwrite(offset, ByteString::formatted("{} ", word).characters(), count);
+        offset += count;
+    }
+    return data;
+}
+
+static void expect_roundtrip(ReadonlyBytes uncompressed, Compress::LzmaCompressorOptions const& compressor_options)
+{
+    auto stream = MUST(try_make<AllocatingMemoryStream>());
+
+    auto compressor = TRY_OR_FAIL(Compress::LzmaCompressor::create_container(MaybeOwned<Stream> { *stream }, compressor_options));
+    TRY_OR_FAIL(compressor->write_until_depleted(uncompressed));
+    TRY_OR_FAIL(compressor->flush());
+
+    // Anything this repetitive should compress well, regardless of the match finder and parser.
+    EXPECT(stream->used_buffer_size() < uncompressed.size() / 4);
+
+    auto decompressor = TRY_OR_FAIL(Compress::LzmaDecompressor::create_from_container(MaybeOwned<Stream> { *stream }));
+    auto result = TRY_OR_FAIL(decompressor->read_until_eof());
+
+    EXPECT_EQ(uncompressed, result.span());
+}
+
+TEST_CASE(compress_decompress_roundtrip_with_hash_chain_and_lazy_parsing)
+{
+    auto const uncompressed = generate_compressible_data(256 * KiB);
+
+    expect_roundtrip(uncompressed, {
+                                       .dictionary_size = 64 * KiB,
+                                       .match_finder = Compress::LzmaMatchFinderType::HashChain4,
+                                       .parsing_mode = Compress::LzmaParsingMode::Lazy,
+                                       .nice_length = 273,
+                                   });
+}
+
+TEST_CASE(compress_decompress_roundtrip_with_binary_tree_and_optimal_parsing)
+{
+    auto const uncompressed = generate_compressible_data(256 * KiB);
+
+    expect_roundtrip(uncompressed, {
+                                       .dictionary_size = 64 * KiB,
+                                       .match_finder = Compress::LzmaMatchFinderType::BinaryTree4,
+                                       .parsing_mode = Compress::LzmaParsingMode::Optimal,
+                                       .nice_length = 32,
+                                   });
+}
+
+TEST_CASE(compress_decompress_roundtrip_with_presets)
+{
+    // The dictionary of the fastest preset is smaller than the data, so the window has to be compacted along the way.
+    auto const uncompressed = generate_compressible_data(640 * KiB);
+
+    for (u8 level : { 0, 3, 4 })
+        expect_roundtrip(uncompressed, Compress::LzmaCompressorOptions::preset(level));
+}
+
 // The following tests are based on test files from the LZMA specification, which has been placed in the public domain.
 // LZMA Specification Draft (2015): https://www.7-zip.org/a/lzma-specification.7z
 
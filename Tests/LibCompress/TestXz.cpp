@@ -1941,6 +1941,94 @@ TEST_CASE(xz_utils_good_2_lzma2)
     EXPECT_EQ(buffer.span(), xz_utils_hello_world.bytes());
 }
 
+TEST_CASE(xz_utils_good_2_lzma2_in_parallel)
+{
+    Array<u8, 92> const compressed {
+        0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00, 0x00, 0x01, 0x69, 0x22, 0xDE, 0x36, 0x02, 0x00, 0x21, 0x01,
+        0x08, 0x00, 0x00, 0x00, 0xD8, 0x0F, 0x23, 0x13, 0x01, 0x00, 0x05, 0x48, 0x65, 0x6C, 0x6C, 0x6F,
+        0x0A, 0x00, 0x00, 0x00, 0x16, 0x35, 0x96, 0x31, 0x02, 0x00, 0x21, 0x01, 0x08, 0x00, 0x00, 0x00,
+        0xD8, 0x0F, 0x23, 0x13, 0x01, 0x00, 0x06, 0x57, 0x6F, 0x72, 0x6C, 0x64, 0x21, 0x0A, 0x00, 0x00,
+        0xDD, 0xD1, 0xCA, 0x53, 0x00, 0x02, 0x1A, 0x06, 0x1B, 0x07, 0x00, 0x00, 0x06, 0xDC, 0xE7, 0x5D,
+        0x3E, 0x30, 0x0D, 0x8B, 0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0x59, 0x5A
+    };
+
+    auto buffer = TRY_OR_FAIL(Compress::XzDecompressor::decompress_all_in_parallel(compressed, 2));
+    EXPECT_EQ(buffer.span(), xz_utils_hello_world.bytes());
+
+    // The same Stream twice, with Stream Padding in between and at the end.
+    ByteBuffer concatenated;
+    TRY_OR_FAIL(concatenated.try_append(compressed.span()));
+    TRY_OR_FAIL(concatenated.try_resize(concatenated.size() + 4));
+    concatenated.bytes().slice(compressed.size()).fill(0);
+    TRY_OR_FAIL(concatenated.try_append(compressed.span()));
+    TRY_OR_FAIL(concatenated.try_resize(concatenated.size() + 8));
+    concatenated.bytes().slice(concatenated.size() - 8).fill(0);
+
+    buffer = TRY_OR_FAIL(Compress::XzDecompressor::decompress_all_in_parallel(concatenated, 4));
+    EXPECT_EQ(buffer.span().trim(xz_utils_hello_world.length()), xz_utils_hello_world.bytes());
+    EXPECT_EQ(buffer.span().slice(xz_utils_hello_world.length()), xz_utils_hello_world.bytes());
+
+    // The Index is used to find the Blocks, so it has to be intact.
+    auto corrupted = compressed;
+    corrupted[0x47] = 0x07;
+    EXPECT(Compress::XzDecompressor::decompress_all_in_parallel(corrupted, 2).is_error());
+}
+
+static ErrorOr<ByteBuffer> xz_compress(ReadonlyBytes uncompressed, Compress::LzmaCompressorOptions const& options)
+{
+    AllocatingMemoryStream stream;
+    auto compressor = TRY(Compress::XzCompressor::create(MaybeOwned<Stream> { stream }, options));
+    TRY(compressor->write_until_depleted(uncompressed));
+    TRY(compressor->finish());
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(stream.used_buffer_size()));
+    TRY(stream.read_until_filled(buffer));
+    return buffer;
+}
+
+static ErrorOr<ByteBuffer> xz_decompress(ReadonlyBytes compressed)
+{
+    auto stream = TRY(try_make<FixedMemoryStream>(compressed));
+    auto decompressor = TRY(Compress::XzDecompressor::create(move(stream)));
+    return decompressor->read_until_eof();
+}
+
+TEST_CASE(compress_decompress_roundtrip)
+{
+    auto compressed = TRY_OR_FAIL(xz_compress(xz_utils_hello_world.bytes(), {}));
+    EXPECT_EQ(TRY_OR_FAIL(xz_decompress(compressed)).span(), xz_utils_hello_world.bytes());
+}
+
+TEST_CASE(compress_decompress_roundtrip_empty)
+{
+    // An empty Stream doesn't contain any Blocks, so this is just the Stream Header, the Index and the Stream Footer.
+    auto compressed = TRY_OR_FAIL(xz_compress({}, {}));
+    EXPECT_EQ(compressed.size(), 32u);
+    EXPECT(TRY_OR_FAIL(xz_decompress(compressed)).is_empty());
+}
+
+TEST_CASE(compress_decompress_roundtrip_multiple_chunks)
+{
+    // Pseudo-random bytes barely compress, so the LZMA2 data is split into many chunks due to their compressed size limit.
+    auto uncompressed = TRY_OR_FAIL(ByteBuffer::create_uninitialized(256 * KiB));
+    u32 state = 1;
+    for (auto& byte : uncompressed.bytes()) {
+        state = state * 1103515245 + 12345;
+        byte = state >> 24;
+    }
+
+    // Runs of a single byte compress extremely well, so these are split due to the uncompressed size limit instead.
+    auto repeated = TRY_OR_FAIL(ByteBuffer::create_uninitialized(5 * MiB));
+    repeated.bytes().fill('A');
+    TRY_OR_FAIL(uncompressed.try_append(repeated));
+
+    for (u8 level : { 0, 6 }) {
+        auto compressed = TRY_OR_FAIL(xz_compress(uncompressed, Compress::LzmaCompressorOptions::preset(level)));
+        EXPECT_EQ(TRY_OR_FAIL(xz_decompress(compressed)).span(), uncompressed.span());
+        EXPECT_EQ(TRY_OR_FAIL(Compress::XzDecompressor::decompress_all_in_parallel(compressed, 2)).span(), uncompressed.span());
+    }
+}
+
 // The following test files are designated as "unsupported", which usually means that they test indicators
 // for not-yet-specified features or where they test files that are not explicitly wrong but that would fail
 // in the reference implementation due to self-imposed limits (i.e. filter ordering restrictions).
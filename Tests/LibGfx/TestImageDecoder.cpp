@@ -450,6 +450,31 @@ TEST_CASE(test_odd_mcu_restart_interval)
     TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 102, 77 }));
 }
 
+TEST_CASE(test_jpeg_scaled_decoding)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/several_scans.jpg"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+
+    // The image is decoded at 1/8, 1/4, 1/2 or its full size, whichever is the smallest that's at least as big as the ideal size.
+    auto expect_decoded_size = [&](Gfx::IntSize ideal_size, Gfx::IntSize size) {
+        auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, ideal_size));
+        EXPECT_EQ(frame.image->size(), size);
+        EXPECT_EQ(plugin_decoder->size(), Gfx::IntSize(592, 800));
+    };
+    expect_decoded_size({ 1, 1 }, { 74, 100 });
+    expect_decoded_size({ 74, 100 }, { 74, 100 });
+    expect_decoded_size({ 100, 100 }, { 148, 200 });
+    expect_decoded_size({ 296, 400 }, { 296, 400 });
+    expect_decoded_size({ 300, 400 }, { 592, 800 });
+
+    auto other_plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+    auto small_frame = TRY_OR_FAIL(other_plugin_decoder->frame(0, Gfx::IntSize { 74, 100 }));
+    EXPECT_EQ(small_frame.image->size(), Gfx::IntSize(74, 100));
+
+    // Asking for the full image afterwards decodes it again.
+    TRY_OR_FAIL(expect_single_frame_of_size(*other_plugin_decoder, { 592, 800 }));
+}
+
 TEST_CASE(test_jpeg_rgb_components)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/rgb_components.jpg"sv)));
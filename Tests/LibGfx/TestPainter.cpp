@@ -53,3 +53,45 @@ TEST_CASE(draw_rect_rough_bounds)
     painter.draw_rect(Gfx::IntRect(0, 0, 1, 1), Color::Black, true);
     painter.draw_rect(Gfx::IntRect(9, 9, 1, 1), Color::Black, true);
 }
+
+TEST_CASE(blending_matches_color_blend)
+{
+    // The rows are blended several pixels at a time, which must give the same result as blending pixel by pixel.
+    auto make_bitmap = [](Gfx::BitmapFormat format, u32 seed) {
+        auto bitmap = MUST(Gfx::Bitmap::create(format, { 13, 7 }));
+        for (int y = 0; y < bitmap->height(); ++y) {
+            for (int x = 0; x < bitmap->width(); ++x) {
+                seed = seed * 1103515245 + 12345;
+                auto alpha = (x + y) % 3 == 0 ? 255 : (x + y) % 3 == 1 ? 0 : (seed >> 24);
+                bitmap->scanline(y)[x] = (alpha << 24) | (seed & 0xffffff);
+            }
+        }
+        return bitmap;
+    };
+
+    for (auto format : { Gfx::BitmapFormat::BGRx8888, Gfx::BitmapFormat::BGRA8888 }) {
+        auto source = make_bitmap(Gfx::BitmapFormat::BGRA8888, 1);
+        auto bitmap = make_bitmap(format, 2);
+        auto expected = MUST(bitmap->clone());
+
+        Gfx::Painter painter(bitmap);
+        painter.blit(Gfx::IntPoint { 0, 0 }, source, source->rect(), 0.5f);
+        for (int y = 0; y < bitmap->height(); ++y) {
+            for (int x = 0; x < bitmap->width(); ++x) {
+                auto source_color = source->get_pixel(x, y);
+                source_color.set_alpha(255 * (0.5f * static_cast<float>(source_color.alpha() / 255.0)));
+                EXPECT_EQ(bitmap->get_pixel(x, y), expected->get_pixel(x, y).blend(source_color));
+            }
+        }
+
+        bitmap = make_bitmap(format, 3);
+        expected = MUST(bitmap->clone());
+        Gfx::Painter fill_painter(bitmap);
+        auto color = Color(10, 200, 30, 100);
+        fill_painter.fill_rect(bitmap->rect(), color);
+        for (int y = 0; y < bitmap->height(); ++y) {
+            for (int x = 0; x < bitmap->width(); ++x)
+                EXPECT_EQ(bitmap->get_pixel(x, y), expected->get_pixel(x, y).blend(color));
+        }
+    }
+}
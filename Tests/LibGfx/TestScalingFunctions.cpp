@@ -64,3 +64,41 @@ TEST_CASE(test_bitmap_scaling_uses_premultiplied_alpha)
     auto bottom_right_pixel = scaled_bitmap->get_pixel(scaled_bitmap->rect().bottom_right().translated(-1));
     EXPECT_EQ(bottom_right_pixel, Color::Transparent);
 }
+
+TEST_CASE(test_bitmap_resampling_uses_premultiplied_alpha)
+{
+    for (auto filter : { Gfx::ResamplingFilter::Lanczos3, Gfx::ResamplingFilter::Mitchell }) {
+        auto src_bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 2, 2 }));
+        src_bitmap->fill(Color::Transparent);
+        src_bitmap->set_pixel({ 0, 0 }, Color::White);
+
+        auto scaled_bitmap = MUST(src_bitmap->scaled_to_size({ 5, 5 }, filter));
+        EXPECT_EQ(scaled_bitmap->size(), Gfx::IntSize(5, 5));
+
+        auto center_pixel = scaled_bitmap->get_pixel(scaled_bitmap->rect().center());
+        EXPECT(center_pixel.alpha() > 0);
+        EXPECT(center_pixel.alpha() < 255);
+        EXPECT_EQ(center_pixel.with_alpha(0), Color(Color::White).with_alpha(0));
+    }
+}
+
+TEST_CASE(test_bitmap_resampling_keeps_solid_colors)
+{
+    // Big enough to be resampled on several threads.
+    auto src_bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 640, 480 }));
+    auto color = Color(200, 100, 50, 150);
+    src_bitmap->fill(color);
+
+    for (auto filter : { Gfx::ResamplingFilter::Lanczos3, Gfx::ResamplingFilter::Mitchell }) {
+        for (auto size : { Gfx::IntSize(97, 61), Gfx::IntSize(1000, 700) }) {
+            auto scaled_bitmap = MUST(src_bitmap->scaled_to_size(size, filter));
+            EXPECT_EQ(scaled_bitmap->size(), size);
+            size_t changed_pixels = 0;
+            for (auto pixel : *scaled_bitmap) {
+                if (Color::from_argb(pixel) != color)
+                    ++changed_pixels;
+            }
+            EXPECT_EQ(changed_pixels, 0u);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/System.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+#include <stdlib.h>
+
+// Something of everything the cache has to get right: closures, classes, block scopes, generators with finally blocks,
+// regular expressions, and string and BigInt constants.
+static constexpr auto source = R"~~~(
+function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }
+class Point {
+    constructor(x) { this.x = x; }
+    get double() { return this.x * 2; }
+}
+let result = [];
+{
+    let x = 1;
+    function inner() { return x; }
+    result.push(inner());
+}
+function* generator() {
+    try {
+        yield 1;
+        yield 2;
+    } finally {
+        result.push("done");
+    }
+}
+for (let value of generator())
+    result.push(value);
+result.push(fib(10), new Point(21).double, /a(b+)/.exec("xabbb")[1], (2n ** 70n).toString(), "café", [1, 2.5, null]);
+result.join(",");
+)~~~"sv;
+
+static ByteString run_script()
+{
+    auto vm = MUST(JS::VM::create());
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& realm = *root_execution_context->realm;
+
+    auto script = JS::Script::parse(source, realm, "test.js"sv);
+    EXPECT(!script.is_error());
+    auto result = vm->bytecode_interpreter().run(*script.value());
+    EXPECT(!result.is_error());
+    return MUST(result.value().to_byte_string(*vm));
+}
+
+// Cache files are written to a temporary file that is then renamed, so a rewritten file gets a new inode.
+static HashMap<ByteString, ino_t> cache_file_inodes(ByteString const& directory)
+{
+    HashMap<ByteString, ino_t> inodes;
+    Core::DirIterator iterator(directory, Core::DirIterator::SkipDots);
+    while (iterator.has_next()) {
+        auto path = iterator.next_full_path();
+        inodes.set(path, MUST(Core::System::stat(path)).st_ino);
+    }
+    return inodes;
+}
+
+TEST_CASE(cached_bytecode_gives_the_same_result)
+{
+    char pattern[] = "/tmp/libjs-bytecode-cache.XXXXXX";
+    auto directory = MUST(Core::System::mkdtemp(pattern)).to_byte_string();
+    // This has to happen before anything consults the cache, as it only reads the environment once.
+    setenv("LIBJS_BYTECODE_CACHE", directory.characters(), 1);
+
+    auto expected = "1,1,2,done,55,42,bbb,1180591620717411303424,café,1,2.5,"sv;
+
+    EXPECT_EQ(run_script(), expected);
+    auto inodes_after_first_run = cache_file_inodes(directory);
+    EXPECT(!inodes_after_first_run.is_empty());
+
+    // The second run should use what the first one stored, without storing anything again.
+    EXPECT_EQ(run_script(), expected);
+    auto inodes_after_second_run = cache_file_inodes(directory);
+    EXPECT_EQ(inodes_after_second_run.size(), inodes_after_first_run.size());
+    for (auto const& [path, inode] : inodes_after_first_run)
+        EXPECT_EQ(inodes_after_second_run.get(path), inode);
+
+    MUST(FileSystem::remove(directory, FileSystem::RecursionMode::Allowed));
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/ElapsedTimer.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Heap/Heap.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+// A tree of plain objects, where every object stores its children as indexed properties.
+static JS::NonnullGCPtr<JS::Object> create_object_tree(JS::Realm& realm, size_t depth, size_t children_per_object)
+{
+    auto object = JS::Object::create(realm, nullptr);
+    if (depth == 0)
+        return object;
+    for (size_t i = 0; i < children_per_object; ++i)
+        object->define_direct_property(i, create_object_tree(realm, depth - 1, children_per_object), JS::default_attributes);
+    return object;
+}
+
+static size_t count_objects_in_tree(JS::Object& object)
+{
+    size_t count = 1;
+    auto const& indexed_properties = object.indexed_properties();
+    for (size_t i = 0; i < indexed_properties.array_like_size(); ++i)
+        count += count_objects_in_tree(indexed_properties.get(i)->value.as_object());
+    return count;
+}
+
+static ByteString run_script(JS::Realm& realm, StringView source)
+{
+    auto& vm = realm.vm();
+    auto script = JS::Script::parse(source, realm, "test.js"sv);
+    EXPECT(!script.is_error());
+    auto result = vm.bytecode_interpreter().run(*script.value());
+    EXPECT(!result.is_error());
+    return MUST(result.value().to_byte_string(vm));
+}
+
+static ByteString run_script(StringView source)
+{
+    auto vm = MUST(JS::VM::create());
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    return run_script(*root_execution_context->realm, source);
+}
+
+// Closures with environments of their own, and objects with shapes of their own, that are only reachable through the realm.
+static constexpr auto reachable_functions_environments_and_shapes_source = R"~~~(
+const closures = [];
+const dictionaries = [];
+for (let i = 0; i < 1000; ++i) {
+    const captured = { i };
+    closures.push(function () { return captured.i; });
+    const dictionary = {};
+    dictionary["p" + i] = i;
+    dictionaries.push(dictionary);
+}
+"ok";
+)~~~"sv;
+
+static constexpr auto check_functions_environments_and_shapes_source = R"~~~(
+for (let i = 0; i < 1000; ++i) {
+    if (closures[i]() !== i || dictionaries[i]["p" + i] !== i || Object.keys(dictionaries[i]).length !== 1)
+        throw new Error("lost a reachable cell");
+}
+"ok";
+)~~~"sv;
+
+TEST_CASE(full_collection_keeps_reachable_cells_alive)
+{
+    auto vm = MUST(JS::VM::create());
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& realm = *root_execution_context->realm;
+
+    auto tree = JS::make_handle(create_object_tree(realm, 4, 8));
+    auto object_count = count_objects_in_tree(*tree);
+    EXPECT_EQ(run_script(realm, reachable_functions_environments_and_shapes_source), "ok"sv);
+
+    for (size_t i = 0; i < 3; ++i) {
+        vm->heap().collect_garbage();
+
+        // Reuse the cells of anything that was collected, so that a reachable cell collected by mistake gets overwritten.
+        for (size_t j = 0; j < 10'000; ++j)
+            (void)JS::Object::create(realm, nullptr);
+        EXPECT_EQ(count_objects_in_tree(*tree), object_count);
+        EXPECT_EQ(run_script(realm, check_functions_environments_and_shapes_source), "ok"sv);
+    }
+}
+
+BENCHMARK_CASE(full_collection_pause_time)
+{
+    auto vm = MUST(JS::VM::create());
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& realm = *root_execution_context->realm;
+
+    // 8^6 objects, plus the indexed property storage of the inner ones.
+    auto tree = JS::make_handle(create_object_tree(realm, 6, 8));
+    auto object_count = count_objects_in_tree(*tree);
+
+    for (size_t i = 0; i < 5; ++i) {
+        Core::ElapsedTimer timer;
+        timer.start();
+        vm->heap().collect_garbage();
+        outln("Full collection: {} ms", timer.elapsed_milliseconds());
+        EXPECT_EQ(count_objects_in_tree(*tree), object_count);
+    }
+}
+
+// Each phase allocates enough garbage for several young generation collections, so that the functions, environments
+// and shapes created before it are old by the time young cells are stored into them.
+static constexpr auto old_cells_pointing_to_young_cells_source = R"~~~(
+function churn() {
+    let garbage;
+    for (let i = 0; i < 100000; ++i)
+        garbage = { i, array: [i] };
+}
+
+function makeBox() {
+    let value = null;
+    return { set(v) { value = v; }, get() { return value; } };
+}
+
+const boxes = [];
+const uncalled = [];
+const dictionaries = [];
+for (let i = 0; i < 1000; ++i) {
+    const n = i;
+    boxes.push(makeBox());
+    uncalled.push(function (x = { n }) { return x.n; });
+    const dictionary = {};
+    for (let j = 0; j < 100; ++j)
+        dictionary["p" + j] = j;
+    dictionaries.push(dictionary);
+}
+churn();
+
+for (let i = 0; i < 1000; ++i) {
+    boxes[i].set({ i });
+    Object.setPrototypeOf(dictionaries[i], { i });
+    dictionaries[i][Symbol.for("key" + i)] = i;
+    if (uncalled[i]() !== i)
+        throw new Error("wrong default parameter");
+}
+churn();
+
+for (let i = 0; i < 1000; ++i) {
+    if (boxes[i].get().i !== i || Object.getPrototypeOf(dictionaries[i]).i !== i || uncalled[i]() !== i)
+        throw new Error("lost a young cell referenced from an old one");
+}
+"ok";
+)~~~"sv;
+
+TEST_CASE(young_generation_collection_keeps_cells_referenced_from_old_cells_alive)
+{
+    EXPECT_EQ(run_script(old_cells_pointing_to_young_cells_source), "ok"sv);
+}
+
+// Keeps many closures (and the environments they capture) alive while allocating short-lived objects.
+static constexpr auto retained_closures_source = R"~~~(
+const closures = [];
+for (let i = 0; i < 300000; ++i) {
+    const captured = { i };
+    closures.push(() => captured.i);
+}
+
+let garbage;
+for (let i = 0; i < 1000000; ++i)
+    garbage = { i };
+
+let sum = 0;
+for (const closure of closures)
+    sum += closure();
+sum;
+)~~~"sv;
+
+BENCHMARK_CASE(many_retained_closures)
+{
+    Core::ElapsedTimer timer;
+    timer.start();
+    EXPECT_EQ(run_script(retained_closures_source), "44999850000"sv);
+    outln("Retained closures with churn: {} ms", timer.elapsed_milliseconds());
+}
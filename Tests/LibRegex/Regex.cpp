@@ -1037,6 +1037,56 @@ TEST_CASE(optimizer_atomic_groups)
     }
 }
 
+TEST_CASE(optimizer_literals_for_prefiltering)
+{
+    {
+        Regex<ECMA262> re("ERROR.*timeout"sv);
+        auto const& optimization_data = re.parser_result.optimization_data;
+        EXPECT_EQ(optimization_data.literal_prefix, "ERROR"sv);
+        EXPECT_EQ(optimization_data.required_literal, "timeout"sv);
+    }
+    {
+        Regex<ECMA262> re("(?:a|b)+cd(efg)?h"sv);
+        auto const& optimization_data = re.parser_result.optimization_data;
+        EXPECT(!optimization_data.literal_prefix.has_value());
+        // "efg" is longer, but it's optional.
+        EXPECT_EQ(optimization_data.required_literal, "cd"sv);
+        EXPECT_EQ(optimization_data.starting_bytes, (Vector<u8> { 'a', 'b' }));
+    }
+    {
+        // Anything could come first, and nothing is needed.
+        Regex<ECMA262> re("a?|.b|(?=x)"sv);
+        auto const& optimization_data = re.parser_result.optimization_data;
+        EXPECT(!optimization_data.literal_prefix.has_value());
+        EXPECT(!optimization_data.required_literal.has_value());
+        EXPECT(optimization_data.starting_bytes.is_empty());
+    }
+
+    Array tests {
+        // Pattern, Subject, Expected match
+        Tuple { "ERROR.*timeout"sv, "INFO timeout\nWARN ERROR: read timeout"sv, "ERROR: read timeout"sv },
+        Tuple { "aab"sv, "aaaab"sv, "aab"sv },
+        Tuple { "[xy]z+"sv, "x y yzz"sv, "yzz"sv },
+        Tuple { "(?:ab|cd)e"sv, "abcde"sv, "cde"sv },
+        Tuple { "ab|cd"sv, "xxcd"sv, "cd"sv },
+        Tuple { "a[^b]c"sv, "abc adc"sv, "adc"sv },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.get<0>(), ECMAScriptFlags::Global | (ECMAScriptFlags)regex::AllFlags::SingleMatch);
+        auto result = re.match(test.get<1>());
+        EXPECT(result.success);
+        if (result.success)
+            EXPECT_EQ(result.matches.first().view.to_byte_string(), test.get<2>());
+    }
+
+    // The literals are only searched for when they're what's being matched.
+    Regex<ECMA262> re("time+out"sv, ECMAScriptFlags::Global | ECMAScriptFlags::Insensitive);
+    EXPECT(re.match("TIMEOUT"sv).success);
+    Regex<ECMA262> sticky_re("ER+OR"sv, ECMAScriptFlags::Sticky);
+    EXPECT(!sticky_re.match("xERROR"sv).success);
+}
+
 TEST_CASE(optimizer_char_class_lut)
 {
     Regex<ECMA262> re(R"([\f\n\r\t\v\u00a0\u1680\u2000\u2001\u2002\u2003\u2004\u2005\u2006\u2007\u2008\u2009\u200a\u2028\u2029\u202f\u205f\u3000\ufeff]+$)");
@@ -1197,3 +1247,67 @@ TEST_CASE(mismatching_brackets)
         EXPECT_EQ(re.parser_result.error, regex::Error::MismatchingBracket);
     }
 }
+
+TEST_CASE(nested_quantifiers_without_backtracking)
+{
+    // These take exponential time to fail when every way of splitting up the a's is tried in turn.
+    Array patterns {
+        "(a*)*b"sv,
+        "(a|a)*c"sv,
+        "(a|aa)+$x"sv,
+        "^(\\w+\\s?)*$"sv,
+    };
+    auto subject = ByteString::formatted("{}!", ByteString::repeated('a', 10'000));
+    for (auto& pattern : patterns) {
+        Regex<ECMA262> re(pattern);
+        EXPECT_EQ(re.match(subject).success, false);
+    }
+
+    Regex<ECMA262> re("(a|aa)*b"sv, ECMAScriptFlags::Global);
+    auto result = re.match(ByteString::formatted("{}b", ByteString::repeated('a', 10'000)));
+    EXPECT_EQ(result.success, true);
+    EXPECT_EQ(result.matches.size(), 1u);
+    EXPECT_EQ(result.matches.first().view.length(), 10'001u);
+}
+
+TEST_CASE(capture_groups_without_backtracking)
+{
+    struct _test {
+        StringView pattern;
+        StringView subject;
+        Vector<StringView> expected;
+    };
+
+    // The first match found by backtracking is the one that has to be returned, along with what its groups captured.
+    Array tests {
+        _test { "(a+)(a+)"sv, "xaaaa"sv, { "aaaa"sv, "aaa"sv, "a"sv } },
+        _test { "(a+?)(a+)"sv, "xaaaa"sv, { "aaaa"sv, "a"sv, "aaa"sv } },
+        _test { "(a|ab)(c|bcd)(d*)"sv, "abcd"sv, { "abcd"sv, "a"sv, "bcd"sv, ""sv } },
+        _test { "(?:(a)|b)*"sv, "abab"sv, { "abab"sv, ""sv } }, // The group is cleared when the loop goes around again.
+        _test { "(?:(a)|(b))+"sv, "ab"sv, { "ab"sv, ""sv, "b"sv } },
+        _test { "(\\w)\\w{2}\\b"sv, "ab abcd"sv, { "bcd"sv, "b"sv } },
+        _test { "(?<first>x)(y?)z"sv, "..xz"sv, { "xz"sv, "x"sv, ""sv } },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.pattern, ECMAScriptFlags::Global | (ECMAScriptFlags)regex::AllFlags::SingleMatch | (ECMAScriptFlags)regex::AllFlags::SkipTrimEmptyMatches);
+        auto result = re.match(test.subject);
+        EXPECT_EQ(result.success, true);
+        if (!result.success)
+            continue;
+        EXPECT_EQ(result.matches.first().view.to_byte_string(), test.expected.first());
+        for (size_t i = 1; i < test.expected.size(); ++i)
+            EXPECT_EQ(result.capture_group_matches.first()[i].view.to_byte_string(), test.expected[i]);
+    }
+}
+
+TEST_CASE(unicode_flag_on_utf8_string_without_backtracking)
+{
+    // The string isn't decoded, so positions count bytes while each multi-byte code point is skipped over at once.
+    Regex<PosixExtended> re(".*"sv);
+    auto result = re.match("Pröv+2"sv, PosixFlags::Insensitive | PosixFlags::Unicode);
+    EXPECT_EQ(result.success, true);
+
+    Regex<PosixExtended> re2("PRöV.*"sv);
+    EXPECT_EQ(re2.match("Pröv+2"sv, PosixFlags::Insensitive | PosixFlags::Unicode).success, true);
+}
@@ -123,6 +123,7 @@ constexpr static u32 pointers[] = {
 NonnullRefPtr<SQL::BTree> setup_btree(SQL::Serializer&);
 void insert_and_get_to_and_from_btree(int);
 void insert_into_and_scan_btree(int);
+void bulk_load_and_scan_btree(int);
 
 NonnullRefPtr<SQL::BTree> setup_btree(SQL::Serializer& serializer)
 {
@@ -317,3 +318,127 @@ TEST_CASE(btree_scan_50_keys)
 {
     insert_into_and_scan_btree(50);
 }
+
+TEST_CASE(btree_reload_three_levels)
+{
+    // Enough keys for a tree whose root node doesn't point to leaf nodes directly.
+    static constexpr auto num_keys = 10000;
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    {
+        auto heap = MUST(SQL::Heap::create("/tmp/test.db"));
+        TRY_OR_FAIL(heap->open());
+        SQL::Serializer serializer(heap);
+        auto btree = setup_btree(serializer);
+
+        for (auto ix = 0; ix < num_keys; ix++) {
+            SQL::Key k(btree->descriptor());
+            k[0] = ix;
+            k.set_block_index(ix + 1);
+            btree->insert(k);
+        }
+    }
+
+    {
+        auto heap = MUST(SQL::Heap::create("/tmp/test.db"));
+        TRY_OR_FAIL(heap->open());
+        SQL::Serializer serializer(heap);
+        auto btree = setup_btree(serializer);
+
+        for (auto ix = 0; ix < num_keys; ix++) {
+            SQL::Key k(btree->descriptor());
+            k[0] = ix;
+            auto pointer_opt = btree->get(k);
+            VERIFY(pointer_opt.has_value());
+            EXPECT_EQ(pointer_opt.value(), static_cast<u32>(ix + 1));
+        }
+    }
+}
+
+void bulk_load_and_scan_btree(int num_keys)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    {
+        auto heap = MUST(SQL::Heap::create("/tmp/test.db"));
+        TRY_OR_FAIL(heap->open());
+        SQL::Serializer serializer(heap);
+        auto btree = setup_btree(serializer);
+
+        Vector<SQL::Key> sorted_keys;
+        for (auto ix = 0; ix < num_keys; ix++) {
+            SQL::Key k(btree->descriptor());
+            k[0] = ix * 2;
+            k.set_block_index(ix + 1);
+            sorted_keys.append(move(k));
+        }
+
+        EXPECT(btree->bulk_load(sorted_keys));
+        EXPECT(!btree->bulk_load(sorted_keys));
+
+        // The bulk loaded tree must still accept regular inserts.
+        SQL::Key k(btree->descriptor());
+        k[0] = 1;
+        k.set_block_index(num_keys + 1);
+        EXPECT(btree->insert(k));
+
+        MUST(heap->flush());
+    }
+
+    {
+        auto heap = MUST(SQL::Heap::create("/tmp/test.db"));
+        TRY_OR_FAIL(heap->open());
+        SQL::Serializer serializer(heap);
+        auto btree = setup_btree(serializer);
+
+        for (auto ix = 0; ix < num_keys; ix++) {
+            SQL::Key k(btree->descriptor());
+            k[0] = ix * 2;
+            auto pointer_opt = btree->get(k);
+            VERIFY(pointer_opt.has_value());
+            EXPECT_EQ(pointer_opt.value(), static_cast<u32>(ix + 1));
+        }
+
+        int count = 0;
+        SQL::Tuple prev;
+        for (auto iter = btree->begin(); !iter.is_end(); iter++, count++) {
+            auto key = (*iter);
+            if (prev.size())
+                EXPECT(prev < key);
+            prev = key;
+        }
+        EXPECT_EQ(count, num_keys + 1);
+    }
+}
+
+TEST_CASE(btree_bulk_load_one_key)
+{
+    bulk_load_and_scan_btree(1);
+}
+
+TEST_CASE(btree_bulk_load_50_keys)
+{
+    bulk_load_and_scan_btree(50);
+}
+
+TEST_CASE(btree_bulk_load_10000_keys)
+{
+    bulk_load_and_scan_btree(10000);
+}
+
+TEST_CASE(btree_bulk_load_unsorted_keys)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    auto heap = MUST(SQL::Heap::create("/tmp/test.db"));
+    TRY_OR_FAIL(heap->open());
+    SQL::Serializer serializer(heap);
+    auto btree = setup_btree(serializer);
+
+    Vector<SQL::Key> unsorted_keys;
+    for (auto ix = 0; ix < 3; ix++) {
+        SQL::Key k(btree->descriptor());
+        k[0] = keys[ix];
+        unsorted_keys.append(move(k));
+    }
+
+    EXPECT(!btree->bulk_load(unsorted_keys));
+    EXPECT(btree->bulk_load(unsorted_keys.span().slice(0, 2)));
+}
@@ -9,6 +9,7 @@
 
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
+#include <LibCore/EventLoop.h>
 #include <LibCore/System.h>
 #include <LibSQL/BTree.h>
 #include <LibSQL/Database.h>
@@ -235,3 +236,48 @@ TEST_CASE(reuse_row_storage)
     auto size_in_bytes_after_reinsertion = MUST(db->file_size_in_bytes());
     EXPECT(size_in_bytes_after_reinsertion <= original_size_in_bytes);
 }
+
+TEST_CASE(group_commit)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    Core::EventLoop event_loop;
+
+    {
+        auto db = MUST(SQL::Database::create("/tmp/test.db"));
+        MUST(db->open());
+        (void)setup_table(db);
+        commit(db);
+
+        db->enable_group_commit();
+        auto table = MUST(db->get_table("TestSchema", "TestTable"));
+
+        size_t durable_commits = 0;
+        for (auto i = 0; i < 2; ++i) {
+            SQL::Row row(*table);
+            row["TextColumn"] = ByteString::formatted("Test{}", i);
+            row["IntColumn"] = i;
+            TRY_OR_FAIL(db->insert(row));
+            commit(db);
+
+            db->when_durable([&](ErrorOr<void> result) {
+                EXPECT(!result.is_error());
+                ++durable_commits;
+            });
+        }
+
+        // Both commits are visible right away, but only become durable once the event loop runs.
+        verify_table_contents(db, 2);
+        EXPECT_EQ(durable_commits, 0u);
+
+        event_loop.pump(Core::EventLoop::WaitMode::PollForEvents);
+        EXPECT_EQ(durable_commits, 2u);
+
+        // Without pending commits, the callback is invoked immediately.
+        db->when_durable([&](auto) { ++durable_commits; });
+        EXPECT_EQ(durable_commits, 3u);
+    }
+
+    auto db = MUST(SQL::Database::create("/tmp/test.db"));
+    MUST(db->open());
+    verify_table_contents(db, 2);
+}
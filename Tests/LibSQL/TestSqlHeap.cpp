@@ -6,8 +6,10 @@
 
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
+#include <LibCore/File.h>
 #include <LibCore/System.h>
 #include <LibSQL/Heap.h>
+#include <LibSQL/WriteAheadLog.h>
 #include <LibTest/TestCase.h>
 
 static constexpr auto db_path = "/tmp/test.db"sv;
@@ -192,3 +194,181 @@ TEST_CASE(heap_free_storage)
     auto new_heap_size = MUST(heap->file_size_in_bytes());
     EXPECT(new_heap_size <= heap_size);
 }
+
+TEST_CASE(heap_page_sizes)
+{
+    StringBuilder builder;
+    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 20));
+    auto long_string = builder.string_view();
+
+    for (u32 page_size : { 4 * KiB, 16 * KiB, 64 * KiB }) {
+        ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+        SQL::Block::Index storage_block_id = 0;
+
+        {
+            auto heap = MUST(SQL::Heap::create(db_path, page_size));
+            MUST(heap->open());
+            EXPECT_EQ(heap->page_size(), page_size);
+
+            storage_block_id = heap->request_new_block_index();
+            TRY_OR_FAIL(heap->write_storage(storage_block_id, long_string.bytes()));
+            MUST(heap->flush());
+        }
+
+        // The page size only determines how the file is cached, so reopen it with a different one.
+        auto heap = MUST(SQL::Heap::create(db_path, page_size == 4 * KiB ? 64 * KiB : 4 * KiB));
+        MUST(heap->open());
+        auto stored_long_string = TRY_OR_FAIL(heap->read_storage(storage_block_id));
+        EXPECT_EQ(long_string.bytes(), stored_long_string.bytes());
+    }
+}
+
+TEST_CASE(heap_page_cache_hits_and_evictions)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+
+    // A cache holding only two pages of four blocks each, so that a chain of 20 blocks can not fit.
+    auto heap = MUST(SQL::Heap::create(db_path, 4 * KiB, 8 * KiB));
+    MUST(heap->open());
+
+    StringBuilder builder;
+    for (size_t i = 0; i < 20; ++i)
+        MUST(builder.try_append_repeated('a' + i, SQL::Block::DATA_SIZE));
+    auto long_string = builder.string_view();
+
+    auto storage_block_id = heap->request_new_block_index();
+    TRY_OR_FAIL(heap->write_storage(storage_block_id, long_string.bytes()));
+    MUST(heap->flush());
+
+    auto statistics_before_read = heap->page_cache_statistics();
+    EXPECT(statistics_before_read.evictions > 0);
+    EXPECT(statistics_before_read.write_backs > 0);
+
+    auto stored_long_string = TRY_OR_FAIL(heap->read_storage(storage_block_id));
+    EXPECT_EQ(long_string.bytes(), stored_long_string.bytes());
+
+    // Neighbouring blocks of the chain share a page, so most of them are served from the cache.
+    auto statistics = heap->page_cache_statistics();
+    auto hits = statistics.hits - statistics_before_read.hits;
+    auto misses = statistics.misses - statistics_before_read.misses;
+    EXPECT_EQ(hits + misses, 20u);
+    EXPECT(hits > misses);
+}
+
+static void copy_file(StringView source, StringView destination)
+{
+    auto source_file = MUST(Core::File::open(source, Core::File::OpenMode::Read));
+    auto contents = MUST(source_file->read_until_eof());
+    auto destination_file = MUST(Core::File::open(destination, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+    MUST(destination_file->write_until_depleted(contents));
+}
+
+TEST_CASE(heap_recover_from_log)
+{
+    static constexpr auto recovered_db_path = "/tmp/test-recovered.db"sv;
+    ScopeGuard guard([]() {
+        MUST(Core::System::unlink(db_path));
+        MUST(Core::System::unlink(recovered_db_path));
+    });
+
+    StringBuilder builder;
+    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 4));
+    auto long_string = builder.string_view();
+
+    auto heap = create_heap();
+    auto storage_block_id = heap->request_new_block_index();
+    TRY_OR_FAIL(heap->write_storage(storage_block_id, long_string.bytes()));
+    MUST(heap->flush());
+
+    // Simulate a crash by copying the files before the heap gets the chance to checkpoint.
+    copy_file(db_path, recovered_db_path);
+    copy_file(ByteString::formatted("{}.wal", db_path), ByteString::formatted("{}.wal", recovered_db_path));
+
+    // Also pretend that the crash happened while the next transaction was being appended to the log.
+    {
+        auto log = MUST(Core::File::open(ByteString::formatted("{}.wal", recovered_db_path), Core::File::OpenMode::Write | Core::File::OpenMode::Append));
+        u32 magic = SQL::WriteAheadLog::MAGIC;
+        MUST(log->write_until_depleted({ &magic, sizeof(magic) }));
+        MUST(log->write_until_depleted("torn"sv.bytes()));
+    }
+
+    auto recovered_heap = MUST(SQL::Heap::create(recovered_db_path));
+    MUST(recovered_heap->open());
+    auto stored_long_string = TRY_OR_FAIL(recovered_heap->read_storage(storage_block_id));
+    EXPECT_EQ(long_string.bytes(), stored_long_string.bytes());
+}
+
+TEST_CASE(heap_remove_log_when_closed)
+{
+    static constexpr auto other_db_path = "/tmp/test-other.db"sv;
+    ScopeGuard guard([]() {
+        MUST(Core::System::unlink(db_path));
+        MUST(Core::System::unlink(other_db_path));
+    });
+    auto log_path = ByteString::formatted("{}.wal", db_path);
+    {
+        auto heap = create_heap();
+        MUST(heap->flush());
+        EXPECT(!Core::System::access(log_path, F_OK).is_error());
+    }
+    EXPECT(Core::System::access(log_path, F_OK).is_error());
+    MUST(Core::System::unlink(db_path));
+
+    // A log whose Heap file is gone is not replayed into a new Heap file.
+    auto other_heap = MUST(SQL::Heap::create(other_db_path));
+    MUST(other_heap->open());
+    auto storage_block_id = other_heap->request_new_block_index();
+    TRY_OR_FAIL(other_heap->write_storage(storage_block_id, "other"sv.bytes()));
+    other_heap->set_user_value(0, 42);
+    MUST(other_heap->flush());
+    copy_file(ByteString::formatted("{}.wal", other_db_path), log_path);
+
+    auto heap = create_heap();
+    EXPECT_EQ(heap->user_value(0), 0u);
+    EXPECT_EQ(heap->request_new_block_index(), storage_block_id);
+}
+
+TEST_CASE(heap_open_non_heap_file_leaves_it_alone)
+{
+    static constexpr auto other_path = "/tmp/test-not-a-heap.txt"sv;
+    ScopeGuard guard([]() { MUST(Core::System::unlink(other_path)); });
+    StringBuilder builder;
+    MUST(builder.try_append_repeated('x', SQL::Block::SIZE * 2));
+    auto contents = builder.string_view();
+    {
+        auto file = MUST(Core::File::open(other_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        MUST(file->write_until_depleted(contents.bytes()));
+    }
+
+    auto heap = MUST(SQL::Heap::create(other_path));
+    EXPECT(heap->open().is_error());
+    EXPECT(Core::System::access(ByteString::formatted("{}.wal", other_path), F_OK).is_error());
+
+    auto file = MUST(Core::File::open(other_path, Core::File::OpenMode::Read));
+    EXPECT_EQ(MUST(file->read_until_eof()).bytes(), contents.bytes());
+}
+
+TEST_CASE(heap_share_log_sync_between_commits)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+    auto heap = create_heap();
+    MUST(heap->flush());
+    auto sync_count = heap->log_sync_count();
+
+    auto first_block_id = heap->request_new_block_index();
+    TRY_OR_FAIL(heap->write_storage(first_block_id, "first"sv.bytes()));
+    MUST(heap->log_uncommitted_blocks());
+
+    auto second_block_id = heap->request_new_block_index();
+    TRY_OR_FAIL(heap->write_storage(second_block_id, "second"sv.bytes()));
+    MUST(heap->log_uncommitted_blocks());
+
+    // Committed blocks are readable right away, even before they are durable.
+    EXPECT(heap->has_unsynced_blocks());
+    EXPECT_EQ(TRY_OR_FAIL(heap->read_storage(first_block_id)).bytes(), "first"sv.bytes());
+
+    MUST(heap->sync_log());
+    EXPECT(!heap->has_unsynced_blocks());
+    EXPECT_EQ(heap->log_sync_count(), sync_count + 1);
+    EXPECT_EQ(TRY_OR_FAIL(heap->read_storage(second_block_id)).bytes(), "second"sv.bytes());
+}
@@ -9,6 +9,7 @@
 
 #include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
+#include <LibSQL/AST/Operator.h>
 #include <LibSQL/AST/Parser.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Result.h>
@@ -230,6 +231,50 @@ TEST_CASE(insert_with_placeholders)
     }
 }
 
+TEST_CASE(insert_batch_with_placeholders)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_table(database);
+
+    auto parser = SQL::AST::Parser(SQL::AST::Lexer("INSERT INTO TestSchema.TestTable VALUES (?, ?);"sv));
+    auto statement = parser.next_statement();
+    EXPECT(!parser.has_errors());
+    auto const& insert = verify_cast<SQL::AST::Insert>(*statement);
+
+    {
+        Vector<Vector<SQL::Value>> placeholder_value_sets;
+        placeholder_value_sets.append(placeholders("Test_1"sv, 42));
+        placeholder_value_sets.append(placeholders(43, 43));
+
+        // A failing set of values fails the whole batch.
+        auto result = insert.execute_batch(database, placeholder_value_sets);
+        EXPECT(result.is_error());
+        EXPECT_EQ(result.error().error(), SQL::SQLErrorCode::InvalidValueType);
+
+        auto rows = execute(database, "SELECT TextColumn FROM TestSchema.TestTable;");
+        EXPECT(rows.is_empty());
+    }
+    {
+        Vector<Vector<SQL::Value>> placeholder_value_sets;
+        for (auto i = 0; i < 100; ++i)
+            placeholder_value_sets.append(placeholders(ByteString::formatted("Test_{:03}", i), i));
+
+        auto result = insert.execute_batch(database, placeholder_value_sets).release_value();
+        EXPECT_EQ(result.size(), 100u);
+
+        result = execute(database, "SELECT TextColumn, IntColumn FROM TestSchema.TestTable ORDER BY IntColumn;");
+        EXPECT_EQ(result.size(), 100u);
+
+        for (auto i = 0; i < 100; ++i) {
+            EXPECT_EQ(result[i].row[0], ByteString::formatted("Test_{:03}", i));
+            EXPECT_EQ(result[i].row[1], i);
+        }
+    }
+}
+
 TEST_CASE(select_from_empty_table)
 {
     ScopeGuard guard([]() { unlink(db_name); });
@@ -318,6 +363,75 @@ TEST_CASE(select_with_where)
     }
 }
 
+TEST_CASE(select_with_column_predicates)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_table(database);
+    auto result = execute(database,
+        "INSERT INTO TestSchema.TestTable ( TextColumn, IntColumn ) VALUES "
+        "( 'Test_1', 42 ), "
+        "( 'Test_2', 43 ), "
+        "( 'Test_3', 44 ), "
+        "( 'Test_4', 45 ), "
+        "( 'Test_5', 46 );");
+    EXPECT(result.size() == 5);
+
+    result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn = 44;");
+    EXPECT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].row[0].to_byte_string(), "Test_3");
+
+    result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE (44 = IntColumn) AND (TextColumn = 'Test_3');");
+    EXPECT_EQ(result.size(), 1u);
+
+    result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE (IntColumn = 44) AND (TextColumn = 'Test_4');");
+    EXPECT_EQ(result.size(), 0u);
+
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE (IntColumn >= 43) AND (46 > IntColumn) ORDER BY IntColumn;");
+    EXPECT_EQ(result.size(), 3u);
+    EXPECT_EQ(result[0].row[0].to_int<i32>(), 43);
+    EXPECT_EQ(result[2].row[0].to_int<i32>(), 45);
+
+    result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE (IntColumn = ?) OR (IntColumn = 46);", placeholders(42));
+    EXPECT_EQ(result.size(), 2u);
+
+    result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE (IntColumn > ?) AND (IntColumn < 45);", placeholders(42));
+    EXPECT_EQ(result.size(), 2u);
+}
+
+TEST_CASE(select_cross_join_with_column_predicates)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_two_tables(database);
+    auto result = execute(database,
+        "INSERT INTO TestSchema.TestTable1 ( TextColumn1, IntColumn ) VALUES "
+        "( 'Test_1', 42 ), "
+        "( 'Test_2', 43 ), "
+        "( 'Test_3', 44 );");
+    EXPECT(result.size() == 3);
+    result = execute(database,
+        "INSERT INTO TestSchema.TestTable2 ( TextColumn2, IntColumn ) VALUES "
+        "( 'Test_10', 40 ), "
+        "( 'Test_11', 41 ), "
+        "( 'Test_12', 42 );");
+    EXPECT(result.size() == 3);
+
+    result = execute(database,
+        "SELECT TextColumn1, TextColumn2 FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE (TextColumn1 = 'Test_2') AND (TestTable2.IntColumn > 40);");
+    EXPECT_EQ(result.size(), 2u);
+    for (auto& row : result)
+        EXPECT_EQ(row.row[0].to_byte_string(), "Test_2");
+
+    // An unqualified column which exists in both tables is still reported as ambiguous.
+    auto select_result = try_execute(database, "SELECT * FROM TestSchema.TestTable1, TestSchema.TestTable2 WHERE IntColumn = 42;");
+    EXPECT(select_result.is_error());
+    EXPECT(select_result.release_error().error() == SQL::SQLErrorCode::AmbiguousColumnName);
+}
+
 TEST_CASE(select_cross_join)
 {
     ScopeGuard guard([]() { unlink(db_name); });
@@ -384,6 +498,82 @@ TEST_CASE(select_inner_join)
     EXPECT_EQ(result[0].row[2].to_byte_string(), "Test_12");
 }
 
+TEST_CASE(select_inner_join_with_duplicate_keys)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_two_tables(database);
+    auto result = execute(database,
+        "INSERT INTO TestSchema.TestTable1 ( TextColumn1, IntColumn ) VALUES "
+        "( 'Test_1', 42 ), "
+        "( 'Test_2', 43 ), "
+        "( 'Test_3', 42 );");
+    EXPECT(result.size() == 3);
+    result = execute(database, "INSERT INTO TestSchema.TestTable1 ( TextColumn1 ) VALUES ( 'Test_4' );");
+    EXPECT(result.size() == 1);
+    result = execute(database,
+        "INSERT INTO TestSchema.TestTable2 ( TextColumn2, IntColumn ) VALUES "
+        "( 'Test_10', 42 ), "
+        "( 'Test_11', 44 ), "
+        "( 'Test_12', 42 );");
+    EXPECT(result.size() == 3);
+    result = execute(database, "INSERT INTO TestSchema.TestTable2 ( TextColumn2 ) VALUES ( 'Test_13' );");
+    EXPECT(result.size() == 1);
+    result = execute(database,
+        "SELECT TextColumn1, TextColumn2 "
+        "FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE TestTable1.IntColumn = TestTable2.IntColumn "
+        "ORDER BY TextColumn1, TextColumn2;");
+    EXPECT_EQ(result.size(), 4u);
+    EXPECT_EQ(result[0].row[0].to_byte_string(), "Test_1");
+    EXPECT_EQ(result[0].row[1].to_byte_string(), "Test_10");
+    EXPECT_EQ(result[1].row[0].to_byte_string(), "Test_1");
+    EXPECT_EQ(result[1].row[1].to_byte_string(), "Test_12");
+    EXPECT_EQ(result[2].row[0].to_byte_string(), "Test_3");
+    EXPECT_EQ(result[2].row[1].to_byte_string(), "Test_10");
+    EXPECT_EQ(result[3].row[0].to_byte_string(), "Test_3");
+    EXPECT_EQ(result[3].row[1].to_byte_string(), "Test_12");
+}
+
+TEST_CASE(select_inner_join_on_float_columns)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_schema(database);
+    auto result = execute(database, "CREATE TABLE TestSchema.TestTable1 ( TextColumn1 text, FloatColumn float );");
+    result = execute(database, "CREATE TABLE TestSchema.TestTable2 ( TextColumn2 text, FloatColumn float );");
+    result = execute(database,
+        "INSERT INTO TestSchema.TestTable1 ( TextColumn1, FloatColumn ) VALUES "
+        "( 'Test_1', 4.5 ), "
+        "( 'Test_2', 1.5 ), "
+        "( 'Test_3', 2.5 ), "
+        "( 'Test_4', 1.5 );");
+    EXPECT(result.size() == 4);
+    result = execute(database,
+        "INSERT INTO TestSchema.TestTable2 ( TextColumn2, FloatColumn ) VALUES "
+        "( 'Test_10', 2.5 ), "
+        "( 'Test_11', 1.5 ), "
+        "( 'Test_12', 3.5 ), "
+        "( 'Test_13', 4.5 );");
+    EXPECT(result.size() == 4);
+    result = execute(database,
+        "SELECT TextColumn1, TextColumn2 "
+        "FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE TestTable1.FloatColumn = TestTable2.FloatColumn "
+        "ORDER BY TextColumn1;");
+    EXPECT_EQ(result.size(), 4u);
+    EXPECT_EQ(result[0].row[0].to_byte_string(), "Test_1");
+    EXPECT_EQ(result[0].row[1].to_byte_string(), "Test_13");
+    EXPECT_EQ(result[1].row[0].to_byte_string(), "Test_2");
+    EXPECT_EQ(result[1].row[1].to_byte_string(), "Test_11");
+    EXPECT_EQ(result[2].row[0].to_byte_string(), "Test_3");
+    EXPECT_EQ(result[2].row[1].to_byte_string(), "Test_10");
+    EXPECT_EQ(result[3].row[0].to_byte_string(), "Test_4");
+    EXPECT_EQ(result[3].row[1].to_byte_string(), "Test_11");
+}
+
 TEST_CASE(select_with_like)
 {
     ScopeGuard guard([]() { unlink(db_name); });
@@ -664,6 +854,87 @@ TEST_CASE(select_with_offset_out_of_bounds)
     EXPECT_EQ(result.size(), 0u);
 }
 
+TEST_CASE(select_with_cursor)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_table(database);
+    for (auto count = 0; count < 100; count++) {
+        auto result = execute(database,
+            ByteString::formatted("INSERT INTO TestSchema.TestTable ( TextColumn, IntColumn ) VALUES ( 'Test_{}', {} );", count, count));
+        EXPECT(result.size() == 1);
+    }
+
+    auto parser = SQL::AST::Parser(SQL::AST::Lexer("SELECT TextColumn, IntColumn FROM TestSchema.TestTable WHERE IntColumn >= ? LIMIT 5;"sv));
+    auto statement = parser.next_statement();
+    EXPECT(!parser.has_errors());
+    EXPECT(is<SQL::AST::Select>(*statement));
+
+    auto select = static_ptr_cast<SQL::AST::Select const>(statement);
+    auto cursor = MUST(SQL::AST::Cursor::create(database, move(select), placeholders(90)));
+    EXPECT_EQ(cursor->column_names().size(), 2u);
+    EXPECT_EQ(cursor->column_names()[0], "TEXTCOLUMN");
+    EXPECT_EQ(cursor->column_names()[1], "INTCOLUMN");
+
+    Vector<i32> values;
+    for (;;) {
+        auto row = MUST(cursor->next());
+        if (!row.has_value())
+            break;
+        values.append((*row)[1].to_int<i32>().value());
+    }
+
+    quick_sort(values);
+    EXPECT_EQ(values.size(), 5u);
+    for (auto const& value : values)
+        EXPECT(value >= 90);
+
+    // An exhausted cursor keeps reporting that there are no more rows.
+    EXPECT(!MUST(cursor->next()).has_value());
+}
+
+TEST_CASE(cursor_survives_modifications_of_its_table)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_table(database);
+    for (auto count = 0; count < 20; count++) {
+        auto result = execute(database,
+            ByteString::formatted("INSERT INTO TestSchema.TestTable ( TextColumn, IntColumn ) VALUES ( 'Test_{}', {} );", count, count));
+        EXPECT(result.size() == 1);
+    }
+
+    auto parser = SQL::AST::Parser(SQL::AST::Lexer("SELECT IntColumn FROM TestSchema.TestTable;"sv));
+    auto statement = parser.next_statement();
+    EXPECT(!parser.has_errors());
+    auto select = static_ptr_cast<SQL::AST::Select const>(statement);
+    auto cursor = MUST(SQL::AST::Cursor::create(database, move(select), {}));
+
+    Vector<i32> values;
+    for (auto i = 0; i < 5; ++i)
+        values.append((*MUST(cursor->next()))[0].to_int<i32>().value());
+
+    // Deleting rows frees their blocks, and the following insertions reuse them. The cursor must still
+    // produce the rows that were in the table when it got to them, and nothing else.
+    execute(database, "DELETE FROM TestSchema.TestTable WHERE IntColumn < 15;");
+    for (auto count = 100; count < 120; count++)
+        execute(database, ByteString::formatted("INSERT INTO TestSchema.TestTable ( TextColumn, IntColumn ) VALUES ( 'Test_{}', {} );", count, count));
+
+    for (;;) {
+        auto row = MUST(cursor->next());
+        if (!row.has_value())
+            break;
+        values.append((*row)[0].to_int<i32>().value());
+    }
+
+    quick_sort(values);
+    EXPECT_EQ(values.size(), 20u);
+    for (auto i = 0; i < 20; ++i)
+        EXPECT_EQ(values[i], i);
+}
+
 TEST_CASE(describe_table)
 {
     ScopeGuard guard([]() { unlink(db_name); });
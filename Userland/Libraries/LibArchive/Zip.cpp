@@ -122,8 +122,9 @@ ErrorOr<Statistics> Zip::calculate_statistics() const
     return Statistics(file_count, directory_count, uncompressed_bytes);
 }
 
-ZipOutputStream::ZipOutputStream(NonnullOwnPtr<Stream> stream)
+ZipOutputStream::ZipOutputStream(NonnullOwnPtr<Stream> stream, size_t compression_thread_count)
     : m_stream(move(stream))
+    , m_compression_thread_count(compression_thread_count)
 {
 }
 
@@ -170,7 +171,7 @@ ErrorOr<ZipOutputStream::MemberInformation> ZipOutputStream::add_member_from_str
         member.modification_time = to_packed_dos_time(modification_time->hour(), modification_time->minute(), modification_time->second());
     }
 
-    auto deflate_buffer = Compress::DeflateCompressor::compress_all(buffer);
+    auto deflate_buffer = Compress::DeflateCompressor::compress_all_in_parallel(buffer, m_compression_thread_count);
     auto compression_ratio = 1.f;
     auto compressed_size = buffer.size();
 
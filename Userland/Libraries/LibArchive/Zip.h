@@ -279,7 +279,7 @@ public:
         size_t compressed_size;
     };
 
-    ZipOutputStream(NonnullOwnPtr<Stream>);
+    ZipOutputStream(NonnullOwnPtr<Stream>, size_t compression_thread_count = 1);
 
     ErrorOr<void> add_member(ZipMember const&);
     ErrorOr<MemberInformation> add_member_from_stream(StringView, Stream&, Optional<Core::DateTime> const& = {});
@@ -292,6 +292,7 @@ public:
 
 private:
     NonnullOwnPtr<Stream> m_stream;
+    size_t m_compression_thread_count { 1 };
     Vector<ZipMember> m_members;
 
     bool m_finished { false };
@@ -7,13 +7,14 @@
 
 #include <AK/Array.h>
 #include <AK/Assertions.h>
+#include <AK/Atomic.h>
 #include <AK/BinaryHeap.h>
-#include <AK/BinarySearch.h>
 #include <AK/BitStream.h>
 #include <AK/MemoryStream.h>
 #include <string.h>
 
 #include <LibCompress/Deflate.h>
+#include <LibThreading/WorkerThread.h>
 
 namespace Compress {
 
@@ -63,9 +64,10 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
     }
 
     if (non_zero_symbols == 1) { // special case - only 1 symbol
-        code.m_prefix_table[0] = PrefixTableEntry { static_cast<u16>(last_non_zero), 1u };
-        code.m_prefix_table[1] = code.m_prefix_table[0];
-        code.m_max_prefixed_code_length = 1;
+        code.m_primary_table[0] = DecodeTableEntry { static_cast<u16>(last_non_zero), 1, 0 };
+        code.m_primary_table[1] = code.m_primary_table[0];
+        code.m_primary_table_bits = 1;
+        code.m_max_code_length = 1;
 
         if (code.m_bit_codes.size() < static_cast<size_t>(last_non_zero + 1)) {
             TRY(code.m_bit_codes.try_resize(last_non_zero + 1));
@@ -77,13 +79,12 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
         return code;
     }
 
-    struct PrefixCode {
+    struct SymbolCode {
         u16 symbol_code { 0 };
         u16 symbol_value { 0 };
-        u16 code_length { 0 };
+        u8 code_length { 0 };
     };
-    Array<PrefixCode, 1 << CanonicalCode::max_allowed_prefixed_code_length> prefix_codes;
-    size_t number_of_prefix_codes = 0;
+    Vector<SymbolCode, 288> symbol_codes;
 
     auto next_code = 0;
     for (size_t code_length = 1; code_length <= 15; ++code_length) {
@@ -97,20 +98,8 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
             if (next_code > start_bit)
                 return Error::from_string_literal("Failed to decode code lengths");
 
-            if (code_length <= CanonicalCode::max_allowed_prefixed_code_length) {
-                if (number_of_prefix_codes >= prefix_codes.size())
-                    return Error::from_string_literal("Invalid canonical Huffman code");
-
-                auto& prefix_code = prefix_codes[number_of_prefix_codes++];
-                prefix_code.symbol_code = next_code;
-                prefix_code.symbol_value = symbol;
-                prefix_code.code_length = code_length;
-
-                code.m_max_prefixed_code_length = code_length;
-            } else {
-                code.m_symbol_codes.append(start_bit | next_code);
-                code.m_symbol_values.append(symbol);
-            }
+            TRY(symbol_codes.try_append({ static_cast<u16>(next_code), static_cast<u16>(symbol), static_cast<u8>(code_length) }));
+            code.m_max_code_length = code_length;
 
             if (code.m_bit_codes.size() < symbol + 1) {
                 TRY(code.m_bit_codes.try_resize(symbol + 1));
@@ -126,41 +115,79 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
     if (next_code != (1 << 15))
         return Error::from_string_literal("Failed to decode code lengths");
 
-    for (auto [symbol_code, symbol_value, code_length] : prefix_codes) {
-        if (code_length == 0 || code_length > CanonicalCode::max_allowed_prefixed_code_length)
-            break;
+    // Codes are read lsb-first, so the tables are indexed by the reversed codes. Every code fills all the entries
+    // whose index starts with it, which means a lookup needs no knowledge of how many bits the code actually has.
+    code.m_primary_table_bits = min(code.m_max_code_length, primary_table_bits);
+    auto const primary_bits = code.m_primary_table_bits;
+
+    // Codes which are longer than the primary table share a secondary table with all the other codes starting with
+    // the same bits, which is just large enough to hold the longest of them.
+    Array<u8, 1 << primary_table_bits> secondary_table_bits {};
+    for (auto const& symbol_code : symbol_codes) {
+        if (symbol_code.code_length <= primary_bits)
+            continue;
+        auto remaining_length = symbol_code.code_length - primary_bits;
+        auto index = fast_reverse16(symbol_code.symbol_code >> remaining_length, primary_bits);
+        secondary_table_bits[index] = max<u8>(secondary_table_bits[index], remaining_length);
+    }
 
-        auto shift = code.m_max_prefixed_code_length - code_length;
-        symbol_code <<= shift;
+    for (size_t index = 0; index < (1u << primary_bits); ++index) {
+        if (secondary_table_bits[index] == 0)
+            continue;
+        code.m_primary_table[index] = DecodeTableEntry { static_cast<u16>(code.m_secondary_tables.size()), 0, secondary_table_bits[index] };
+        TRY(code.m_secondary_tables.try_resize(code.m_secondary_tables.size() + (1u << secondary_table_bits[index])));
+    }
 
-        for (size_t j = 0; j < (1u << shift); ++j) {
-            auto index = fast_reverse16(symbol_code + j, code.m_max_prefixed_code_length);
-            code.m_prefix_table[index] = PrefixTableEntry { symbol_value, code_length };
+    for (auto const& [symbol_code, symbol_value, code_length] : symbol_codes) {
+        if (code_length <= primary_bits) {
+            auto index = fast_reverse16(symbol_code, code_length);
+            for (size_t j = 0; j < (1u << (primary_bits - code_length)); ++j)
+                code.m_primary_table[index | (j << code_length)] = DecodeTableEntry { symbol_value, code_length, 0 };
+            continue;
         }
+
+        auto remaining_length = code_length - primary_bits;
+        auto const& pointer = code.m_primary_table[fast_reverse16(symbol_code >> remaining_length, primary_bits)];
+        auto index = fast_reverse16(symbol_code, remaining_length);
+        for (size_t j = 0; j < (1u << (pointer.secondary_table_bits - remaining_length)); ++j)
+            code.m_secondary_tables[pointer.symbol_value + (index | (j << remaining_length))] = DecodeTableEntry { symbol_value, code_length, 0 };
     }
 
     return code;
 }
 
-ErrorOr<u32> CanonicalCode::read_symbol(LittleEndianInputBitStream& stream) const
+ALWAYS_INLINE CanonicalCode::DecodeTableEntry CanonicalCode::lookup(size_t bits) const
 {
-    auto prefix = TRY(stream.peek_bits<size_t>(m_max_prefixed_code_length));
+    auto entry = m_primary_table[bits & ((1u << m_primary_table_bits) - 1)];
+    if (entry.secondary_table_bits == 0)
+        return entry;
 
-    if (auto [symbol_value, code_length] = m_prefix_table[prefix]; code_length != 0) {
-        stream.discard_previously_peeked_bits(code_length);
-        return symbol_value;
-    }
+    auto index = (bits >> m_primary_table_bits) & ((1u << entry.secondary_table_bits) - 1);
+    return m_secondary_tables[entry.symbol_value + index];
+}
 
-    auto code_bits = TRY(stream.read_bits<u16>(m_max_prefixed_code_length));
-    code_bits = fast_reverse16(code_bits, m_max_prefixed_code_length);
-    code_bits |= 1 << m_max_prefixed_code_length;
+ErrorOr<u32> CanonicalCode::read_symbol(LittleEndianInputBitStream& stream) const
+{
+    auto bits = stream.peek_bits<size_t>(m_max_code_length);
+    if (bits.is_error()) [[unlikely]]
+        return read_symbol_bit_by_bit(stream);
 
-    for (size_t i = m_max_prefixed_code_length; i < 16; ++i) {
-        size_t index;
-        if (binary_search(m_symbol_codes.span(), code_bits, &index))
-            return m_symbol_values[index];
+    auto entry = lookup(bits.value());
+    stream.discard_previously_peeked_bits(entry.code_length);
+    return entry.symbol_value;
+}
 
-        code_bits = code_bits << 1 | TRY(stream.read_bit());
+ErrorOr<u32> CanonicalCode::read_symbol_bit_by_bit(LittleEndianInputBitStream& stream) const
+{
+    // Close to the end of the stream, there might be fewer bits left than the longest code has. Since the tables are
+    // filled for every possible continuation of a code, looking up the bits read so far finds a code of exactly that
+    // length as soon as all of its bits have been read.
+    size_t bits = 0;
+    for (size_t code_length = 1; code_length <= m_max_code_length; ++code_length) {
+        bits |= TRY(stream.read_bits<size_t>(1)) << (code_length - 1);
+
+        if (auto entry = lookup(bits); entry.code_length == code_length)
+            return entry.symbol_value;
     }
 
     return Error::from_string_literal("Symbol exceeds maximum symbol number");
@@ -186,37 +213,54 @@ ErrorOr<bool> DeflateDecompressor::CompressedBlock::try_read_more()
     if (m_eof == true)
         return false;
 
-    auto const symbol = TRY(m_literal_codes.read_symbol(*m_decompressor.m_input_stream));
+    auto& input_stream = *m_decompressor.m_input_stream;
+    auto& output_buffer = m_decompressor.m_output_buffer;
+
+    // Decode symbols for as long as the output buffer is guaranteed to have enough space for them. Literals are
+    // collected and written in batches instead of one byte at a time.
+    Array<u8, 64> literals;
+    size_t literal_count = 0;
+    auto flush_literals = [&] {
+        auto written_bytes = output_buffer.write(literals.span().trim(literal_count));
+        VERIFY(written_bytes == literal_count);
+        literal_count = 0;
+    };
 
-    if (symbol >= 286)
-        return Error::from_string_literal("Invalid deflate literal/length symbol");
+    while (output_buffer.empty_space() >= literal_count + max_back_reference_length) {
+        auto const symbol = TRY(m_literal_codes.read_symbol(input_stream));
 
-    if (symbol < 256) {
-        u8 byte_symbol = symbol;
-        m_decompressor.m_output_buffer.write({ &byte_symbol, sizeof(byte_symbol) });
-        return true;
-    }
+        if (symbol < 256) {
+            literals[literal_count++] = symbol;
+            if (literal_count == literals.size())
+                flush_literals();
+            continue;
+        }
 
-    if (symbol == 256) {
-        m_eof = true;
-        return false;
-    }
+        flush_literals();
 
-    if (!m_distance_codes.has_value())
-        return Error::from_string_literal("Distance codes have not been initialized");
+        if (symbol == 256) {
+            m_eof = true;
+            return true;
+        }
+
+        if (symbol >= 286)
+            return Error::from_string_literal("Invalid deflate literal/length symbol");
 
-    auto const length = TRY(m_decompressor.decode_length(symbol));
-    auto const distance_symbol = TRY(m_distance_codes.value().read_symbol(*m_decompressor.m_input_stream));
-    if (distance_symbol >= 30)
-        return Error::from_string_literal("Invalid deflate distance symbol");
+        if (!m_distance_codes.has_value())
+            return Error::from_string_literal("Distance codes have not been initialized");
 
-    auto const distance = TRY(m_decompressor.decode_distance(distance_symbol));
+        auto const length = TRY(m_decompressor.decode_length(symbol));
+        auto const distance_symbol = TRY(m_distance_codes.value().read_symbol(input_stream));
+        if (distance_symbol >= 30)
+            return Error::from_string_literal("Invalid deflate distance symbol");
 
-    auto copied_length = TRY(m_decompressor.m_output_buffer.copy_from_seekback(distance, length));
+        auto const distance = TRY(m_decompressor.decode_distance(distance_symbol));
 
-    // TODO: What should we do if the output buffer is full?
-    VERIFY(copied_length == length);
+        auto copied_length = TRY(output_buffer.copy_from_seekback(distance, length));
+        VERIFY(copied_length == length);
+    }
 
+    flush_literals();
     return true;
 }
 
@@ -379,31 +423,22 @@ ErrorOr<ByteBuffer> DeflateDecompressor::decompress_all(ReadonlyBytes bytes)
 
 ErrorOr<u32> DeflateDecompressor::decode_length(u32 symbol)
 {
-    if (symbol <= 264)
-        return symbol - 254;
+    VERIFY(symbol >= 257 && symbol <= 285);
+    auto const& [_, base_length, extra_bits] = packed_length_symbols[symbol - 257];
 
-    if (symbol <= 284) {
-        auto extra_bits = (symbol - 261) / 4;
-        return (((symbol - 265) % 4 + 4) << extra_bits) + 3 + TRY(m_input_stream->read_bits(extra_bits));
-    }
-
-    if (symbol == 285)
-        return DeflateDecompressor::max_back_reference_length;
-
-    VERIFY_NOT_REACHED();
+    if (extra_bits == 0)
+        return base_length;
+    return base_length + TRY(m_input_stream->read_bits(extra_bits));
 }
 
 ErrorOr<u32> DeflateDecompressor::decode_distance(u32 symbol)
 {
-    if (symbol <= 3)
-        return symbol + 1;
+    VERIFY(symbol <= 29);
+    auto const& [_, base_distance, extra_bits] = packed_distances[symbol];
 
-    if (symbol <= 29) {
-        auto extra_bits = (symbol / 2) - 1;
-        return ((symbol % 2 + 2) << extra_bits) + 1 + TRY(m_input_stream->read_bits(extra_bits));
-    }
-
-    VERIFY_NOT_REACHED();
+    if (extra_bits == 0)
+        return base_distance;
+    return base_distance + TRY(m_input_stream->read_bits(extra_bits));
 }
 
 ErrorOr<void> DeflateDecompressor::decode_codes(CanonicalCode& literal_code, Optional<CanonicalCode>& distance_code)
@@ -1041,6 +1076,23 @@ ErrorOr<void> DeflateCompressor::final_flush()
     return {};
 }
 
+ErrorOr<void> DeflateCompressor::sync_flush()
+{
+    VERIFY(!m_finished);
+    if (m_pending_block_size > 0)
+        TRY(flush());
+
+    TRY(m_output_stream->write_bits(0u, 1));     // not the final block
+    TRY(m_output_stream->write_bits(0b00u, 2)); // no compression
+    TRY(m_output_stream->align_to_byte_boundary());
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0));
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0xffff));
+    TRY(m_output_stream->flush_buffer_to_stream());
+
+    m_finished = true;
+    return {};
+}
+
 ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, CompressionLevel compression_level)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
@@ -1055,4 +1107,73 @@ ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, Compres
     return buffer;
 }
 
+ErrorOr<ByteBuffer> DeflateCompressor::compress_all_in_parallel(ReadonlyBytes bytes, size_t thread_count, CompressionLevel compression_level)
+{
+    auto chunk_count = ceil_div(bytes.size(), parallel_chunk_size);
+    thread_count = min(thread_count, chunk_count);
+    if (thread_count <= 1)
+        return compress_all(bytes, compression_level);
+
+    Vector<ByteBuffer> compressed_chunks;
+    TRY(compressed_chunks.try_resize(chunk_count));
+
+    // Chunks are handed out in order, so that the threads finish at roughly the same time.
+    Atomic<size_t> next_chunk_index { 0 };
+
+    auto compress_chunks = [&]() -> ErrorOr<void> {
+        while (true) {
+            auto chunk_index = next_chunk_index.fetch_add(1);
+            if (chunk_index >= chunk_count)
+                return {};
+
+            auto chunk_offset = chunk_index * parallel_chunk_size;
+            auto chunk = bytes.slice(chunk_offset, min(parallel_chunk_size, bytes.size() - chunk_offset));
+
+            auto output_stream = TRY(try_make<AllocatingMemoryStream>());
+            auto deflate_stream = TRY(DeflateCompressor::construct(MaybeOwned<Stream>(*output_stream), compression_level));
+
+            TRY(deflate_stream->write_until_depleted(chunk));
+            if (chunk_index == chunk_count - 1)
+                TRY(deflate_stream->final_flush());
+            else
+                TRY(deflate_stream->sync_flush());
+
+            auto& compressed_chunk = compressed_chunks[chunk_index];
+            compressed_chunk = TRY(ByteBuffer::create_uninitialized(output_stream->used_buffer_size()));
+            TRY(output_stream->read_until_filled(compressed_chunk));
+        }
+    };
+
+    Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>> workers;
+    TRY(workers.try_ensure_capacity(thread_count));
+
+    for (size_t i = 0; i < thread_count; ++i) {
+        auto worker = TRY(Threading::WorkerThread<Error>::create("Deflate Worker"sv));
+        worker->start_task([&] { return compress_chunks(); });
+        workers.unchecked_append(move(worker));
+    }
+
+    Optional<Error> error;
+    for (auto& worker : workers) {
+        auto result = worker->wait_until_task_is_finished();
+        if (result.is_error() && !error.has_value())
+            error = result.release_error();
+    }
+    if (error.has_value())
+        return error.release_value();
+
+    size_t compressed_size = 0;
+    for (auto const& compressed_chunk : compressed_chunks)
+        compressed_size += compressed_chunk.size();
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(compressed_size));
+    size_t offset = 0;
+    for (auto const& compressed_chunk : compressed_chunks) {
+        buffer.overwrite(offset, compressed_chunk.data(), compressed_chunk.size());
+        offset += compressed_chunk.size();
+    }
+
+    return buffer;
+}
+
 }
@@ -30,19 +30,25 @@ public:
     static ErrorOr<CanonicalCode> from_bytes(ReadonlyBytes);
 
 private:
-    static constexpr size_t max_allowed_prefixed_code_length = 8;
+    // Codes of up to this length are decoded with a single lookup into the primary table.
+    static constexpr size_t primary_table_bits = 9;
 
-    struct PrefixTableEntry {
+    // An entry with a non-zero secondary_table_bits does not hold a symbol, but points to the secondary table at
+    // m_secondary_tables[symbol_value], which is indexed by the next secondary_table_bits bits of the stream.
+    struct DecodeTableEntry {
         u16 symbol_value { 0 };
-        u16 code_length { 0 };
+        u8 code_length { 0 };
+        u8 secondary_table_bits { 0 };
     };
 
-    // Decompression - indexed by code
-    Vector<u16, 286> m_symbol_codes;
-    Vector<u16, 286> m_symbol_values;
+    DecodeTableEntry lookup(size_t bits) const;
+    ErrorOr<u32> read_symbol_bit_by_bit(LittleEndianInputBitStream&) const;
 
-    Array<PrefixTableEntry, 1 << max_allowed_prefixed_code_length> m_prefix_table {};
-    size_t m_max_prefixed_code_length { 0 };
+    // Decompression - indexed by the next bits of the stream (which are the code, reversed)
+    Array<DecodeTableEntry, 1 << primary_table_bits> m_primary_table {};
+    Vector<DecodeTableEntry> m_secondary_tables;
+    size_t m_primary_table_bits { 0 };
+    size_t m_max_code_length { 0 };
 
     // Compression - indexed by symbol
     // Deflate uses a maximum of 288 symbols (maximum of 32 for distances),
@@ -131,6 +137,10 @@ public:
     static constexpr size_t max_match_length = 258; // matches longer than these cannot be encoded using huffman codes
     static constexpr u16 empty_slot = UINT16_MAX;
 
+    // The input is split into chunks of this size to be compressed in parallel. Since every block is compressed on its
+    // own, chunks made up of whole blocks compress to exactly the same blocks as they would in a single stream.
+    static constexpr size_t parallel_chunk_size = block_size * 8;
+
     struct CompressionConstants {
         size_t good_match_length;  // Once we find a match of at least this length (a good enough match) we reduce max_chain to lower processing time
         size_t max_lazy_length;    // If the match is at least this long we dont defer matching to the next byte (which takes time) as its good enough
@@ -165,8 +175,15 @@ public:
     virtual void close() override;
     ErrorOr<void> final_flush();
 
+    // Ends the output on a byte boundary with an empty, non-final block, without ending the deflate stream. The output of
+    // another compressor can then be appended to form a single stream. Like final_flush(), this finishes the compressor.
+    ErrorOr<void> sync_flush();
+
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD);
 
+    // Compresses chunks of the input on up to thread_count threads, and concatenates them into a single deflate stream.
+    static ErrorOr<ByteBuffer> compress_all_in_parallel(ReadonlyBytes bytes, size_t thread_count, CompressionLevel = CompressionLevel::GOOD);
+
 private:
     DeflateCompressor(NonnullOwnPtr<LittleEndianOutputBitStream>, CompressionLevel = CompressionLevel::GOOD);
 
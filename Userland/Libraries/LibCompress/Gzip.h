@@ -92,8 +92,9 @@ public:
     virtual bool is_open() const override;
     virtual void close() override;
 
-    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes);
-    static ErrorOr<void> compress_file(StringView input_file, NonnullOwnPtr<Stream> output_stream);
+    // With more than one thread, the data is compressed in chunks in parallel (see DeflateCompressor::compress_all_in_parallel()).
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, size_t thread_count = 1);
+    static ErrorOr<void> compress_file(StringView input_file, NonnullOwnPtr<Stream> output_stream, size_t thread_count = 1);
 
 private:
     MaybeOwned<Stream> m_output_stream;
@@ -116,6 +116,33 @@ ErrorOr<LzmaHeader> LzmaHeader::from_compressor_options(LzmaCompressorOptions co
     };
 }
 
+LzmaCompressorOptions LzmaCompressorOptions::preset(u8 level)
+{
+    VERIFY(level <= 9);
+
+    // These follow lzma_lzma_preset() of the XZ utils. The lower levels use a hash chain match finder and a lazy parser,
+    // the higher levels use a binary tree match finder and the optimal parser.
+    static constexpr Array<u8, 10> dictionary_size_exponents { 18, 20, 21, 22, 22, 23, 23, 24, 25, 26 };
+    static constexpr Array<u32, 4> hash_chain_search_depths { 4, 8, 24, 48 };
+
+    LzmaCompressorOptions options {};
+    options.dictionary_size = 1u << dictionary_size_exponents[level];
+
+    if (level <= 3) {
+        options.match_finder = LzmaMatchFinderType::HashChain4;
+        options.parsing_mode = LzmaParsingMode::Lazy;
+        options.nice_length = level <= 1 ? 128 : 273;
+        options.search_depth = hash_chain_search_depths[level];
+    } else {
+        options.match_finder = LzmaMatchFinderType::BinaryTree4;
+        options.parsing_mode = LzmaParsingMode::Optimal;
+        options.nice_length = level == 4 ? 16 : level == 5 ? 32 : 64;
+        options.search_depth = 0;
+    }
+
+    return options;
+}
+
 void LzmaState::initialize_to_default_probability(Span<Probability> span)
 {
     for (auto& entry : span)
@@ -527,12 +554,9 @@ ErrorOr<void> LzmaCompressor::encode_literal(u8 literal)
 
     TRY(encode_match_type(MatchType::Literal));
 
-    // Note: We have already read the next byte from the input buffer, so it's now in the seekback buffer, shifting all seekback offsets by one.
     u8 previous_byte = 0;
-    if (m_dictionary->seekback_limit() - m_dictionary->used_space() > 1) {
-        auto read_bytes = MUST(m_dictionary->read_with_seekback({ &previous_byte, sizeof(previous_byte) }, 2 + m_dictionary->used_space()));
-        VERIFY(read_bytes.size() == sizeof(previous_byte));
-    }
+    if (m_total_processed_bytes > 0)
+        previous_byte = m_match_finder->byte_at(m_total_processed_bytes - 1);
     u16 const literal_state_bits_from_position = m_total_processed_bytes & ((1 << m_options.literal_position_bits) - 1);
     u16 const literal_state_bits_from_output = previous_byte >> (8 - m_options.literal_context_bits);
     u16 const literal_state = literal_state_bits_from_position << m_options.literal_context_bits | literal_state_bits_from_output;
@@ -543,9 +567,7 @@ ErrorOr<void> LzmaCompressor::encode_literal(u8 literal)
     u16 result = 1;
 
     if (m_state >= 7) {
-        u8 matched_byte = 0;
-        auto read_bytes = TRY(m_dictionary->read_with_seekback({ &matched_byte, sizeof(matched_byte) }, current_repetition_offset() + m_dictionary->used_space() + 1));
-        VERIFY(read_bytes.size() == sizeof(matched_byte));
+        u8 matched_byte = m_match_finder->byte_at(m_total_processed_bytes - current_repetition_offset());
 
         dbgln_if(LZMA_DEBUG, "Encoding literal using match byte {:#x}", matched_byte);
 
@@ -582,6 +604,15 @@ ErrorOr<void> LzmaCompressor::encode_literal(u8 literal)
     return {};
 }
 
+ErrorOr<void> LzmaCompressor::encode_short_rep_match()
+{
+    TRY(encode_match_type(MatchType::ShortRepMatch));
+    update_state_after_short_rep();
+    m_total_processed_bytes += 1;
+
+    return {};
+}
+
 ErrorOr<void> LzmaCompressor::encode_existing_match(size_t real_distance, size_t real_length)
 {
     VERIFY(real_distance >= normalized_to_real_match_distance_offset);
@@ -619,7 +650,6 @@ ErrorOr<void> LzmaCompressor::encode_existing_match(size_t real_distance, size_t
 
     TRY(encode_normalized_match_length(m_rep_length_coder, normalized_length));
     update_state_after_rep();
-    MUST(m_dictionary->discard(real_length));
     m_total_processed_bytes += real_length;
 
     return {};
@@ -635,7 +665,6 @@ ErrorOr<void> LzmaCompressor::encode_new_match(size_t real_distance, size_t real
 
     TRY(encode_normalized_simple_match(normalized_distance, normalized_length));
 
-    MUST(m_dictionary->discard(real_length));
     m_total_processed_bytes += real_length;
 
     return {};
@@ -844,38 +873,48 @@ u32 LzmaState::current_repetition_offset() const
     return m_rep0 + normalized_to_real_match_distance_offset;
 }
 
+u16 LzmaState::state_after_literal(u16 state)
+{
+    if (state < 4)
+        return 0;
+    if (state < 10)
+        return state - 3;
+    return state - 6;
+}
+
+u16 LzmaState::state_after_match(u16 state)
+{
+    return state < 7 ? 7 : 10;
+}
+
+u16 LzmaState::state_after_rep(u16 state)
+{
+    return state < 7 ? 8 : 11;
+}
+
+u16 LzmaState::state_after_short_rep(u16 state)
+{
+    return state < 7 ? 9 : 11;
+}
+
 void LzmaState::update_state_after_literal()
 {
-    if (m_state < 4)
-        m_state = 0;
-    else if (m_state < 10)
-        m_state -= 3;
-    else
-        m_state -= 6;
+    m_state = state_after_literal(m_state);
 }
 
 void LzmaState::update_state_after_match()
 {
-    if (m_state < 7)
-        m_state = 7;
-    else
-        m_state = 10;
+    m_state = state_after_match(m_state);
 }
 
 void LzmaState::update_state_after_rep()
 {
-    if (m_state < 7)
-        m_state = 8;
-    else
-        m_state = 11;
+    m_state = state_after_rep(m_state);
 }
 
 void LzmaState::update_state_after_short_rep()
 {
-    if (m_state < 7)
-        m_state = 9;
-    else
-        m_state = 11;
+    m_state = state_after_short_rep(m_state);
 }
 
 ErrorOr<LzmaDecompressor::MatchType> LzmaDecompressor::decode_match_type()
@@ -989,37 +1028,466 @@ ErrorOr<void> LzmaCompressor::encode_match_type(MatchType match_type)
     return {};
 }
 
-ErrorOr<void> LzmaCompressor::encode_once()
+// Prices are stored in 1/16th of a bit. This table is generated the same way as the one in the LZMA SDK,
+// it contains the cost of a bit that had a probability of ((index * 16) + 8) / 2048.
+static constexpr Array<u32, 128> bit_prices = [] {
+    Array<u32, 128> prices {};
+    for (u32 i = 0; i < prices.size(); i++) {
+        u32 value = (i << 4) + (1 << 3);
+        u32 bit_count = 0;
+        for (size_t j = 0; j < 4; j++) {
+            value *= value;
+            bit_count <<= 1;
+            while (value >= (1u << 16)) {
+                value >>= 1;
+                bit_count++;
+            }
+        }
+        prices[i] = (11 << 4) - 15 - bit_count;
+    }
+    return prices;
+}();
+
+static u32 price_of_bit(u16 probability, u8 bit)
+{
+    return bit_prices[(bit == 0 ? probability : (2048 - probability)) >> 4];
+}
+
+static u32 price_of_bit_tree_symbol(ReadonlySpan<u16> probability_tree, size_t bit_count, u32 value)
+{
+    u32 price = 0;
+    size_t tree_index = 1;
+    for (size_t i = bit_count; i > 0; i--) {
+        u8 const bit = (value >> (i - 1)) & 1;
+        price += price_of_bit(probability_tree[tree_index], bit);
+        tree_index = (tree_index << 1) | bit;
+    }
+    return price;
+}
+
+static u32 price_of_reverse_bit_tree_symbol(ReadonlySpan<u16> probability_tree, size_t bit_count, u32 value)
+{
+    u32 price = 0;
+    size_t tree_index = 1;
+    for (size_t i = 0; i < bit_count; i++) {
+        u8 const bit = value & 1;
+        value >>= 1;
+        price += price_of_bit(probability_tree[tree_index], bit);
+        tree_index = (tree_index << 1) | bit;
+    }
+    return price;
+}
+
+static u32 position_slot_for_distance(u32 normalized_distance)
 {
-    // Check if any of our existing match distances are currently usable.
-    Vector<size_t> const existing_distances {
-        m_rep0 + normalized_to_real_match_distance_offset,
-        m_rep1 + normalized_to_real_match_distance_offset,
-        m_rep2 + normalized_to_real_match_distance_offset,
-        m_rep3 + normalized_to_real_match_distance_offset,
+    if (normalized_distance < 4)
+        return normalized_distance;
+
+    u32 const distance_log2 = AK::log2(normalized_distance);
+    return (distance_log2 << 1) + ((normalized_distance >> (distance_log2 - 1)) & 1);
+}
+
+void LzmaCompressor::update_prices()
+{
+    auto const length_price = [](LzmaLengthCoderState const& coder, size_t position_state, u32 normalized_length) -> u32 {
+        if (normalized_length < 8)
+            return price_of_bit(coder.m_first_choice_probability, 0) + price_of_bit_tree_symbol(coder.m_low_length_probabilities[position_state], 3, normalized_length);
+
+        u32 const price = price_of_bit(coder.m_first_choice_probability, 1);
+        if (normalized_length < 16)
+            return price + price_of_bit(coder.m_second_choice_probability, 0) + price_of_bit_tree_symbol(coder.m_medium_length_probabilities[position_state], 3, normalized_length - 8);
+
+        return price + price_of_bit(coder.m_second_choice_probability, 1) + price_of_bit_tree_symbol(coder.m_high_length_probabilities, 8, normalized_length - 16);
     };
-    auto existing_distance_result = m_dictionary->find_copy_in_seekback(existing_distances, m_dictionary->used_space(), normalized_to_real_match_length_offset);
 
-    if (existing_distance_result.has_value()) {
-        auto selected_match = existing_distance_result.release_value();
-        TRY(encode_existing_match(selected_match.distance, selected_match.length));
+    for (size_t position_state = 0; position_state < (1u << m_options.position_bits); position_state++) {
+        for (u32 normalized_length = 0; normalized_length < m_length_prices[position_state].size(); normalized_length++) {
+            m_length_prices[position_state][normalized_length] = length_price(m_length_coder, position_state, normalized_length);
+            m_rep_length_prices[position_state][normalized_length] = length_price(m_rep_length_coder, position_state, normalized_length);
+        }
+    }
+
+    for (size_t length_state = 0; length_state < number_of_length_to_position_states; length_state++) {
+        for (u32 position_slot = 0; position_slot < m_position_slot_prices[length_state].size(); position_slot++)
+            m_position_slot_prices[length_state][position_slot] = price_of_bit_tree_symbol(m_length_to_position_states[length_state], 6, position_slot);
+
+        // Distances that are small enough to not have any direct bits have their price precalculated as a whole.
+        for (u32 normalized_distance = 0; normalized_distance < number_of_full_distance_prices; normalized_distance++) {
+            u32 const position_slot = position_slot_for_distance(normalized_distance);
+            u32 price = m_position_slot_prices[length_state][position_slot];
+
+            if (position_slot >= first_position_slot_with_binary_tree_bits) {
+                u32 const number_of_footer_bits = (position_slot >> 1) - 1;
+                u32 const base = (2 | (position_slot & 1)) << number_of_footer_bits;
+                price += price_of_reverse_bit_tree_symbol(m_binary_tree_distance_probabilities[position_slot - first_position_slot_with_binary_tree_bits], number_of_footer_bits, normalized_distance - base);
+            }
+
+            m_full_distance_prices[length_state][normalized_distance] = price;
+        }
+    }
+
+    for (u32 alignment_bits = 0; alignment_bits < m_alignment_prices.size(); alignment_bits++)
+        m_alignment_prices[alignment_bits] = price_of_reverse_bit_tree_symbol(m_alignment_bit_probabilities, number_of_alignment_bits, alignment_bits);
+}
+
+u32 LzmaCompressor::literal_price(u64 position, u16 state, u32 rep0, u8 literal) const
+{
+    // This mirrors `encode_literal`, but only sums up the prices of the encoded bits.
+    u8 const previous_byte = position > 0 ? m_match_finder->byte_at(position - 1) : 0;
+    u16 const literal_state_bits_from_position = position & ((1 << m_options.literal_position_bits) - 1);
+    u16 const literal_state_bits_from_output = previous_byte >> (8 - m_options.literal_context_bits);
+    u16 const literal_state = literal_state_bits_from_position << m_options.literal_context_bits | literal_state_bits_from_output;
+
+    auto const probability_table = m_literal_probabilities.span().slice(literal_probability_table_size * literal_state, literal_probability_table_size);
+
+    u32 price = 0;
+    u16 result = 1;
+
+    if (state >= 7) {
+        u8 matched_byte = m_match_finder->byte_at(position - rep0 - normalized_to_real_match_distance_offset);
+
+        do {
+            u8 const match_bit = (matched_byte >> 7) & 1;
+            matched_byte <<= 1;
+
+            u8 const encoded_bit = (literal & 0x80) >> 7;
+            literal <<= 1;
+
+            price += price_of_bit(probability_table[((1 + match_bit) << 8) + result], encoded_bit);
+            result = result << 1 | encoded_bit;
+
+            if (match_bit != encoded_bit)
+                break;
+        } while (result < 0x100);
+    }
+
+    while (result < 0x100) {
+        u8 const encoded_bit = (literal & 0x80) >> 7;
+        literal <<= 1;
+
+        price += price_of_bit(probability_table[result], encoded_bit);
+        result = (result << 1) | encoded_bit;
+    }
+
+    return price;
+}
+
+u32 LzmaCompressor::rep_match_price(u16 state, u16 position_state, size_t rep_index) const
+{
+    // This mirrors the part of `encode_match_type` that follows the "is rep" bit.
+    if (rep_index == 0)
+        return price_of_bit(m_is_rep_g0_probabilities[state], 0) + price_of_bit(m_is_rep0_long_probabilities[(state << maximum_number_of_position_bits) + position_state], 1);
+
+    u32 const price = price_of_bit(m_is_rep_g0_probabilities[state], 1);
+    if (rep_index == 1)
+        return price + price_of_bit(m_is_rep_g1_probabilities[state], 0);
+
+    return price + price_of_bit(m_is_rep_g1_probabilities[state], 1) + price_of_bit(m_is_rep_g2_probabilities[state], rep_index - 2);
+}
+
+u32 LzmaCompressor::distance_price(u32 normalized_distance, u32 real_length) const
+{
+    u32 const length_state = min(real_length - normalized_to_real_match_length_offset, number_of_length_to_position_states - 1);
+
+    if (normalized_distance < number_of_full_distance_prices)
+        return m_full_distance_prices[length_state][normalized_distance];
+
+    // Direct bits have a fixed price of exactly one bit each.
+    u32 const position_slot = position_slot_for_distance(normalized_distance);
+    u32 const number_of_direct_bits = (position_slot >> 1) - 1 - number_of_alignment_bits;
+    return m_position_slot_prices[length_state][position_slot] + (number_of_direct_bits << 4) + m_alignment_prices[normalized_distance & ((1 << number_of_alignment_bits) - 1)];
+}
+
+// Returns whether large_distance is so much larger than small_distance that a match at small_distance that is one byte shorter is preferable.
+static bool is_much_larger_distance(u32 small_distance, u32 large_distance)
+{
+    return (large_distance >> 7) > small_distance;
+}
+
+LzmaCompressor::Symbol LzmaCompressor::find_next_symbol_lazily()
+{
+    // This follows the heuristics of the "fast" mode of the XZ utils (lzma_lzma_optimum_fast).
+    if (!m_matches_are_for_next_position)
+        m_match_finder->find_matches(m_matches);
+    m_matches_are_for_next_position = false;
+
+    // From here on, the match finder is one byte ahead of the current position.
+    u64 const position = m_total_processed_bytes;
+    u32 const available = min(m_match_finder->end_position() - position, static_cast<u64>(largest_real_match_length));
+    if (available < normalized_to_real_match_length_offset)
         return {};
+
+    Array<u32, 4> const reps { m_rep0, m_rep1, m_rep2, m_rep3 };
+
+    u32 rep_length = 0;
+    u32 rep_distance = 0;
+    for (auto rep : reps) {
+        u32 const real_distance = rep + normalized_to_real_match_distance_offset;
+        if (real_distance > position)
+            continue;
+
+        u32 const length = m_match_finder->match_length_at(position, real_distance, available);
+        if (length < normalized_to_real_match_length_offset)
+            continue;
+
+        if (length >= m_options.nice_length) {
+            m_match_finder->skip(length - 1);
+            return { MatchType::RepMatch0, length, real_distance };
+        }
+
+        if (length > rep_length) {
+            rep_length = length;
+            rep_distance = real_distance;
+        }
+    }
+
+    u32 main_length = 0;
+    u32 main_distance = 0;
+    if (!m_matches.is_empty()) {
+        main_length = m_matches.last().length;
+        main_distance = m_matches.last().distance;
     }
 
-    // If we weren't able to find any viable existing offsets, we now have to search the rest of the dictionary for possible new offsets.
-    auto new_distance_result = m_dictionary->find_copy_in_seekback(m_dictionary->used_space(), normalized_to_real_match_length_offset);
+    if (main_length >= m_options.nice_length) {
+        m_match_finder->skip(main_length - 1);
+        return { MatchType::SimpleMatch, main_length, main_distance };
+    }
+
+    // Prefer a match that is only one byte shorter if it is a lot closer, since its distance is much cheaper to encode.
+    while (m_matches.size() > 1 && main_length == m_matches[m_matches.size() - 2].length + 1) {
+        auto const& shorter_match = m_matches[m_matches.size() - 2];
+        if (!is_much_larger_distance(shorter_match.distance - 1, main_distance - 1))
+            break;
+
+        main_length = shorter_match.length;
+        main_distance = shorter_match.distance;
+        m_matches.take_last();
+    }
+
+    // A short match that is far away usually costs more than encoding the bytes as literals.
+    if (main_length == normalized_to_real_match_length_offset && main_distance - 1 >= 0x80)
+        main_length = 0;
+
+    if (rep_length >= normalized_to_real_match_length_offset) {
+        if (rep_length + 1 >= main_length
+            || (rep_length + 2 >= main_length && main_distance - 1 > (1u << 9))
+            || (rep_length + 3 >= main_length && main_distance - 1 > (1u << 15))) {
+            m_match_finder->skip(rep_length - 1);
+            return { MatchType::RepMatch0, rep_length, rep_distance };
+        }
+    }
 
-    if (new_distance_result.has_value()) {
-        auto selected_match = new_distance_result.release_value();
-        TRY(encode_new_match(selected_match.distance, selected_match.length));
+    if (main_length < normalized_to_real_match_length_offset || available <= normalized_to_real_match_length_offset)
         return {};
+
+    // Look at the next position. If there is a better match there, encode the current byte as a literal and use that match instead.
+    m_match_finder->find_matches(m_matches);
+    m_matches_are_for_next_position = true;
+
+    if (!m_matches.is_empty()) {
+        u32 const next_length = m_matches.last().length;
+        u32 const next_distance = m_matches.last().distance - 1;
+        u32 const normalized_main_distance = main_distance - 1;
+
+        if ((next_length >= main_length && next_distance < normalized_main_distance)
+            || (next_length == main_length + 1 && !is_much_larger_distance(normalized_main_distance, next_distance))
+            || next_length > main_length + 1
+            || (next_length + 1 >= main_length && main_length >= 3 && is_much_larger_distance(next_distance, normalized_main_distance)))
+            return {};
     }
 
-    // If we weren't able to find any matches, we don't have any other choice than to encode the next byte as a literal.
-    u8 next_byte { 0 };
-    TRY(m_dictionary->read({ &next_byte, sizeof(next_byte) }));
-    TRY(encode_literal(next_byte));
-    return {};
+    // The same goes for repeated matches at the next position that are almost as long as the current match.
+    u32 const limit = max(static_cast<u32>(normalized_to_real_match_length_offset), main_length - 1);
+    for (auto rep : reps) {
+        u32 const real_distance = rep + normalized_to_real_match_distance_offset;
+        if (real_distance <= position + 1 && m_match_finder->match_length_at(position + 1, real_distance, limit) == limit)
+            return {};
+    }
+
+    m_matches_are_for_next_position = false;
+    m_match_finder->skip(main_length - 2);
+    return { MatchType::SimpleMatch, main_length, main_distance };
+}
+
+LzmaCompressor::Symbol LzmaCompressor::find_next_symbol_optimally()
+{
+    if (m_next_optimal_symbol == m_optimal_symbols.size()) {
+        find_optimal_symbols();
+        m_next_optimal_symbol = 0;
+    }
+
+    return m_optimal_symbols[m_next_optimal_symbol++];
+}
+
+void LzmaCompressor::find_optimal_symbols()
+{
+    // This is a shortest path search over the positions of the next block of data, where the nodes are the positions
+    // and every possible literal or match is an edge weighted by its price. Prices are based on the probabilities at
+    // the start of the block, and each node keeps track of the state and repetition offsets of its cheapest path.
+    VERIFY(m_match_finder->position() == m_total_processed_bytes);
+    update_prices();
+
+    static constexpr Array<MatchType, 4> rep_match_types { MatchType::RepMatch0, MatchType::RepMatch1, MatchType::RepMatch2, MatchType::RepMatch3 };
+
+    u64 const start = m_total_processed_bytes;
+    u16 const position_mask = (1 << m_options.position_bits) - 1;
+    auto& nodes = m_optimal_nodes;
+
+    nodes[0].price = 0;
+    nodes[0].state = m_state;
+    nodes[0].reps = { m_rep0, m_rep1, m_rep2, m_rep3 };
+
+    size_t last_node = 0;
+    auto const reach = [&](size_t node) {
+        while (last_node < node)
+            nodes[++last_node].price = infinite_price;
+    };
+
+    auto const relax = [&](size_t origin_index, u32 price, Symbol symbol, size_t rep_index) {
+        auto& node = nodes[origin_index + symbol.real_length];
+        if (price >= node.price)
+            return;
+
+        auto const& origin = nodes[origin_index];
+        node.price = price;
+        node.previous = origin_index;
+        node.symbol = symbol;
+        node.reps = origin.reps;
+
+        switch (symbol.type) {
+        case MatchType::Literal:
+            node.state = state_after_literal(origin.state);
+            break;
+        case MatchType::ShortRepMatch:
+            node.state = state_after_short_rep(origin.state);
+            break;
+        case MatchType::SimpleMatch:
+            node.state = state_after_match(origin.state);
+            node.reps = { symbol.real_distance - normalized_to_real_match_distance_offset, origin.reps[0], origin.reps[1], origin.reps[2] };
+            break;
+        default:
+            node.state = state_after_rep(origin.state);
+            for (size_t i = rep_index; i > 0; i--)
+                node.reps[i] = origin.reps[i - 1];
+            node.reps[0] = origin.reps[rep_index];
+            break;
+        }
+    };
+
+    size_t end_node = 0;
+    size_t current = 0;
+    do {
+        auto const& node = nodes[current];
+        u64 const position = start + current;
+        u32 const available = min(m_match_finder->end_position() - position, static_cast<u64>(largest_real_match_length));
+        u16 const position_state = position & position_mask;
+        u16 const state = node.state;
+
+        m_match_finder->find_matches(m_matches);
+
+        Array<u32, 4> rep_lengths {};
+        size_t longest_rep_index = 0;
+        for (size_t i = 0; i < rep_lengths.size(); i++) {
+            u32 const real_distance = node.reps[i] + normalized_to_real_match_distance_offset;
+            if (available >= normalized_to_real_match_length_offset && real_distance <= position)
+                rep_lengths[i] = m_match_finder->match_length_at(position, real_distance, available);
+            if (rep_lengths[i] > rep_lengths[longest_rep_index])
+                longest_rep_index = i;
+        }
+
+        // Long matches are taken right away. Nothing that ends inside of them is likely to be much better, and this
+        // keeps very repetitive data from making us search every single position.
+        Optional<Symbol> long_match;
+        if (rep_lengths[longest_rep_index] >= m_options.nice_length)
+            long_match = Symbol { rep_match_types[longest_rep_index], rep_lengths[longest_rep_index], node.reps[longest_rep_index] + normalized_to_real_match_distance_offset };
+        else if (!m_matches.is_empty() && m_matches.last().length >= m_options.nice_length)
+            long_match = Symbol { MatchType::SimpleMatch, m_matches.last().length, m_matches.last().distance };
+
+        if (long_match.has_value()) {
+            end_node = current + long_match->real_length;
+            nodes[end_node].previous = current;
+            nodes[end_node].symbol = *long_match;
+            m_match_finder->skip(long_match->real_length - 1);
+            break;
+        }
+
+        u8 const current_byte = m_match_finder->byte_at(position);
+        auto const is_match_probability = m_is_match_probabilities[(state << maximum_number_of_position_bits) + position_state];
+
+        reach(current + 1);
+        relax(current, node.price + price_of_bit(is_match_probability, 0) + literal_price(position, state, node.reps[0], current_byte), {}, 0);
+
+        u32 const match_price = node.price + price_of_bit(is_match_probability, 1);
+        u32 const any_rep_match_price = match_price + price_of_bit(m_is_rep_probabilities[state], 1);
+
+        u32 const rep0_real_distance = node.reps[0] + normalized_to_real_match_distance_offset;
+        if (rep0_real_distance <= position && m_match_finder->byte_at(position - rep0_real_distance) == current_byte) {
+            u32 const short_rep_price = any_rep_match_price + price_of_bit(m_is_rep_g0_probabilities[state], 0) + price_of_bit(m_is_rep0_long_probabilities[(state << maximum_number_of_position_bits) + position_state], 0);
+            relax(current, short_rep_price, { MatchType::ShortRepMatch, 1, rep0_real_distance }, 0);
+        }
+
+        for (size_t i = 0; i < rep_lengths.size(); i++) {
+            if (rep_lengths[i] < normalized_to_real_match_length_offset)
+                continue;
+
+            reach(current + rep_lengths[i]);
+            u32 const price = any_rep_match_price + rep_match_price(state, position_state, i);
+            u32 const real_distance = node.reps[i] + normalized_to_real_match_distance_offset;
+            for (u32 length = normalized_to_real_match_length_offset; length <= rep_lengths[i]; length++)
+                relax(current, price + m_rep_length_prices[position_state][length - normalized_to_real_match_length_offset], { rep_match_types[i], length, real_distance }, i);
+        }
+
+        if (!m_matches.is_empty()) {
+            reach(current + m_matches.last().length);
+            u32 const price = match_price + price_of_bit(m_is_rep_probabilities[state], 0);
+
+            // Every match also stands for all the shorter lengths that weren't covered by an even shorter match.
+            u32 length = normalized_to_real_match_length_offset;
+            for (auto const& match : m_matches) {
+                for (; length <= match.length; length++) {
+                    u32 const length_price = m_length_prices[position_state][length - normalized_to_real_match_length_offset];
+                    relax(current, price + length_price + distance_price(match.distance - 1, length), { MatchType::SimpleMatch, length, match.distance }, 0);
+                }
+            }
+        }
+
+        current++;
+        end_node = current;
+    } while (current < last_node && current < optimal_parsing_block_size);
+
+    m_optimal_symbols.clear_with_capacity();
+    for (size_t node = end_node; node > 0; node = nodes[node].previous)
+        m_optimal_symbols.append(nodes[node].symbol);
+    m_optimal_symbols.reverse();
+}
+
+ErrorOr<void> LzmaCompressor::encode_symbol(Symbol const& symbol)
+{
+    switch (symbol.type) {
+    case MatchType::Literal:
+        return encode_literal(m_match_finder->byte_at(m_total_processed_bytes));
+    case MatchType::ShortRepMatch:
+        return encode_short_rep_match();
+    case MatchType::SimpleMatch:
+        return encode_new_match(symbol.real_distance, symbol.real_length);
+    default:
+        return encode_existing_match(symbol.real_distance, symbol.real_length);
+    }
+}
+
+size_t LzmaCompressor::required_lookahead() const
+{
+    if (m_options.parsing_mode == LzmaParsingMode::Optimal)
+        return optimal_parsing_block_size + largest_real_match_length;
+
+    // The lazy parser might look one position ahead.
+    return largest_real_match_length + 1;
+}
+
+ErrorOr<void> LzmaCompressor::encode_once()
+{
+    auto const symbol = m_options.parsing_mode == LzmaParsingMode::Optimal ? find_next_symbol_optimally() : find_next_symbol_lazily();
+    return encode_symbol(symbol);
 }
 
 ErrorOr<Bytes> LzmaDecompressor::read_some(Bytes bytes)
@@ -1214,24 +1682,43 @@ void LzmaDecompressor::close()
 
 ErrorOr<NonnullOwnPtr<LzmaCompressor>> LzmaCompressor::create_container(MaybeOwned<Stream> stream, LzmaCompressorOptions const& options)
 {
-    auto dictionary = TRY(try_make<SearchableCircularBuffer>(TRY(SearchableCircularBuffer::create_empty(options.dictionary_size + largest_real_match_length))));
+    auto header = TRY(LzmaHeader::from_compressor_options(options));
+    TRY(stream->write_value(header));
+
+    return create_from_raw_stream(move(stream), options);
+}
+
+ErrorOr<NonnullOwnPtr<LzmaCompressor>> LzmaCompressor::create_from_raw_stream(MaybeOwned<Stream> stream, LzmaCompressorOptions const& options)
+{
+    if (options.dictionary_size < 4 * KiB)
+        return Error::from_string_literal("LZMA dictionary size is smaller than the minimum of 4 KiB");
+
+    if (options.nice_length < 4 || options.nice_length > largest_real_match_length)
+        return Error::from_string_literal("LZMA nice length is outside of the supported range");
+
+    // The search depths match the defaults of the XZ utils.
+    auto search_depth = options.search_depth;
+    if (search_depth == 0)
+        search_depth = options.match_finder == LzmaMatchFinderType::BinaryTree4 ? 16 + options.nice_length / 2 : 4 + options.nice_length / 4;
+
+    auto match_finder = TRY(LzmaMatchFinder::create(options.match_finder, options.dictionary_size, options.nice_length, search_depth));
 
     // "The LZMA Decoder uses (1 << (lc + lp)) tables with CProb values, where each table contains 0x300 CProb values."
     auto literal_probabilities = TRY(FixedArray<Probability>::create(literal_probability_table_size * (1 << (options.literal_context_bits + options.literal_position_bits))));
 
-    auto header = TRY(LzmaHeader::from_compressor_options(options));
-    TRY(stream->write_value(header));
+    auto compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) LzmaCompressor(move(stream), options, move(match_finder), move(literal_probabilities))));
 
-    auto compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) LzmaCompressor(move(stream), options, move(dictionary), move(literal_probabilities))));
+    if (options.parsing_mode == LzmaParsingMode::Optimal)
+        compressor->m_optimal_nodes = TRY(FixedArray<OptimalNode>::create(optimal_parsing_block_size + largest_real_match_length + 1));
 
     return compressor;
 }
 
-LzmaCompressor::LzmaCompressor(MaybeOwned<AK::Stream> stream, Compress::LzmaCompressorOptions options, MaybeOwned<SearchableCircularBuffer> dictionary, FixedArray<Compress::LzmaState::Probability> literal_probabilities)
+LzmaCompressor::LzmaCompressor(MaybeOwned<AK::Stream> stream, Compress::LzmaCompressorOptions options, NonnullOwnPtr<LzmaMatchFinder> match_finder, FixedArray<Compress::LzmaState::Probability> literal_probabilities)
     : LzmaState(move(literal_probabilities))
     , m_stream(move(stream))
     , m_options(move(options))
-    , m_dictionary(move(dictionary))
+    , m_match_finder(move(match_finder))
 {
 }
 
@@ -1242,25 +1729,19 @@ ErrorOr<Bytes> LzmaCompressor::read_some(Bytes)
 
 ErrorOr<size_t> LzmaCompressor::write_some(ReadonlyBytes bytes)
 {
-    // Fill the input buffer until it's full or until we can't read any more data.
-    size_t processed_bytes = min(bytes.size(), largest_real_match_length - m_dictionary->used_space());
-    bytes = bytes.trim(processed_bytes);
-
-    while (bytes.size() > 0) {
-        auto const written_bytes = m_dictionary->write(bytes);
-        bytes = bytes.slice(written_bytes);
-    }
-
-    VERIFY(m_dictionary->used_space() <= largest_real_match_length);
-
-    if (m_options.uncompressed_size.has_value() && m_total_processed_bytes + m_dictionary->used_space() > m_options.uncompressed_size.value())
+    if (m_options.uncompressed_size.has_value() && m_match_finder->end_position() + bytes.size() > m_options.uncompressed_size.value())
         return Error::from_string_literal("Tried to compress more LZMA data than announced");
 
-    TRY(encode_once());
+    // Fill the input buffer until it's full or until we can't read any more data.
+    auto const processed_bytes = m_match_finder->append(bytes);
+
+    // Only encode once we have enough data to not miss out on any matches.
+    while (m_match_finder->available() >= required_lookahead())
+        TRY(encode_once());
 
     // If we read enough data to reach the final uncompressed size, flush automatically.
     // Flushing will handle encoding the remaining data for us and finalize the stream.
-    if (m_options.uncompressed_size.has_value() && m_total_processed_bytes + m_dictionary->used_space() >= m_options.uncompressed_size.value())
+    if (m_options.uncompressed_size.has_value() && m_match_finder->end_position() >= m_options.uncompressed_size.value())
         TRY(flush());
 
     return processed_bytes;
@@ -1271,7 +1752,7 @@ ErrorOr<void> LzmaCompressor::flush()
     if (m_has_flushed_data)
         return Error::from_string_literal("Flushed an LZMA stream twice");
 
-    while (m_dictionary->used_space() > 0)
+    while (has_unencoded_data())
         TRY(encode_once());
 
     if (m_options.uncompressed_size.has_value() && m_total_processed_bytes < m_options.uncompressed_size.value())
@@ -1282,6 +1763,14 @@ ErrorOr<void> LzmaCompressor::flush()
     if (!m_options.uncompressed_size.has_value())
         TRY(encode_normalized_simple_match(end_of_stream_marker, 0));
 
+    TRY(flush_range_encoder());
+
+    m_has_flushed_data = true;
+    return {};
+}
+
+ErrorOr<void> LzmaCompressor::flush_range_encoder()
+{
     // Shifting the range encoder using the normal operation handles any pending overflows.
     TRY(shift_range_encoder());
 
@@ -1295,10 +1784,17 @@ ErrorOr<void> LzmaCompressor::flush()
     TRY(m_stream->write_value<u8>(m_range_encoder_code >> 16));
     TRY(m_stream->write_value<u8>(m_range_encoder_code >> 8));
 
-    m_has_flushed_data = true;
     return {};
 }
 
+void LzmaCompressor::reset_range_encoder()
+{
+    m_range_encoder_range = 0xFFFFFFFF;
+    m_range_encoder_code = 0;
+    m_range_encoder_cached_byte = 0x00;
+    m_range_encoder_ff_chain_length = 0;
+}
+
 bool LzmaCompressor::is_eof() const
 {
     return true;
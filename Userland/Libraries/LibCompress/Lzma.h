@@ -11,6 +11,7 @@
 #include <AK/MaybeOwned.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Stream.h>
+#include <LibCompress/LzmaMatchFinder.h>
 
 namespace Compress {
 
@@ -32,13 +33,30 @@ struct LzmaDecompressorOptions {
     bool reject_end_of_stream_marker { false };
 };
 
+enum class LzmaParsingMode {
+    // Takes the longest match at the current position, unless the next position has a noticeably better one.
+    Lazy,
+    // Estimates the encoded size of every way to encode a block of data using the current probabilities,
+    // and picks the cheapest one.
+    Optimal,
+};
+
 struct LzmaCompressorOptions {
     // Note: The default settings have been chosen based on the default settings of other LZMA compressors.
     u8 literal_context_bits { 3 };
     u8 literal_position_bits { 0 };
     u8 position_bits { 2 };
     u32 dictionary_size { 8 * MiB };
+    LzmaMatchFinderType match_finder { LzmaMatchFinderType::BinaryTree4 };
+    LzmaParsingMode parsing_mode { LzmaParsingMode::Optimal };
+    // Matches of at least this length are taken without searching any further.
+    u32 nice_length { 64 };
+    // The maximum number of candidates the match finder checks per position, zero picks a default based on the nice length.
+    u32 search_depth { 0 };
     Optional<u64> uncompressed_size {};
+
+    // Returns the settings for the given compression level (0-9), which mirror the presets of the XZ utils.
+    static LzmaCompressorOptions preset(u8 level);
 };
 
 // Described in section "lzma file format".
@@ -136,6 +154,11 @@ protected:
     void update_state_after_rep();
     void update_state_after_short_rep();
 
+    static u16 state_after_literal(u16 state);
+    static u16 state_after_match(u16 state);
+    static u16 state_after_rep(u16 state);
+    static u16 state_after_short_rep(u16 state);
+
     static constexpr size_t maximum_number_of_position_bits = 4;
     static constexpr size_t number_of_states = 12;
     Array<Probability, (number_of_states << maximum_number_of_position_bits)> m_is_match_probabilities;
@@ -229,7 +252,11 @@ public:
     virtual ~LzmaCompressor();
 
 private:
-    LzmaCompressor(MaybeOwned<Stream>, LzmaCompressorOptions, MaybeOwned<SearchableCircularBuffer>, FixedArray<Probability> literal_probabilities);
+    friend class Lzma2Compressor;
+
+    static ErrorOr<NonnullOwnPtr<LzmaCompressor>> create_from_raw_stream(MaybeOwned<Stream>, LzmaCompressorOptions const&);
+
+    LzmaCompressor(MaybeOwned<Stream>, LzmaCompressorOptions, NonnullOwnPtr<LzmaMatchFinder>, FixedArray<Probability> literal_probabilities);
 
     ErrorOr<void> shift_range_encoder();
     ErrorOr<void> normalize_range_encoder();
@@ -242,20 +269,78 @@ private:
 
     ErrorOr<void> encode_match_type(MatchType);
     ErrorOr<void> encode_literal(u8 literal);
+    ErrorOr<void> encode_short_rep_match();
     ErrorOr<void> encode_existing_match(size_t real_distance, size_t real_length);
     ErrorOr<void> encode_new_match(size_t real_distance, size_t real_length);
     ErrorOr<void> encode_normalized_simple_match(u32 normalized_distance, u16 normalized_length);
 
+    // A single decision of the parser, which is then passed on to the range encoder.
+    struct Symbol {
+        MatchType type { MatchType::Literal };
+        u32 real_length { 1 };
+        u32 real_distance { 0 };
+    };
+
+    ErrorOr<void> encode_symbol(Symbol const&);
+    Symbol find_next_symbol_lazily();
+    Symbol find_next_symbol_optimally();
+    void find_optimal_symbols();
+
+    // The number of bytes that have to be available past the match finder position before encode_once() is allowed to run.
+    // Less than that is only acceptable if all the remaining data is available, i.e. once we are flushing.
+    size_t required_lookahead() const;
+    bool has_unencoded_data() const { return m_total_processed_bytes < m_match_finder->end_position(); }
     ErrorOr<void> encode_once();
 
+    // Writes out the remaining data of the range coder, but leaves the rest of the state untouched.
+    // This is used by LZMA2 to end a chunk, after which the range coder has to be restarted.
+    ErrorOr<void> flush_range_encoder();
+    void reset_range_encoder();
+
+    // An upper bound for the number of bytes that will be written when flushing the range coder.
+    size_t pending_range_encoder_size() const { return 1 + m_range_encoder_ff_chain_length + 4; }
+
     bool m_has_flushed_data { false };
 
     MaybeOwned<Stream> m_stream;
     LzmaCompressorOptions m_options;
 
-    // This doubles as an input buffer, which is appended at the very front of the buffer.
-    // Therefore, the size of this should at least be the dictionary size + the largest possible repetition length.
-    MaybeOwned<SearchableCircularBuffer> m_dictionary;
+    // The match finder holds the dictionary as well as all the data that has been written but not yet been encoded.
+    NonnullOwnPtr<LzmaMatchFinder> m_match_finder;
+    Vector<LzmaMatchFinder::Match, 16> m_matches;
+
+    // The lazy parser looks up the matches for the next position before deciding on the current one. If it
+    // decides to encode a literal, those matches are kept around for the next call.
+    bool m_matches_are_for_next_position { false };
+
+    // Prices are the estimated encoded size of a decision in 1/16th of a bit, based on the current probabilities.
+    // They are recalculated at the start of each block of the optimal parser.
+    static constexpr u32 infinite_price = NumericLimits<u32>::max() / 2;
+    static constexpr size_t optimal_parsing_block_size = 4096;
+    void update_prices();
+    u32 literal_price(u64 position, u16 state, u32 rep0, u8 literal) const;
+    u32 rep_match_price(u16 state, u16 position_state, size_t rep_index) const;
+    u32 distance_price(u32 normalized_distance, u32 real_length) const;
+
+    Array<Array<u32, largest_real_match_length - normalized_to_real_match_length_offset + 1>, (1 << maximum_number_of_position_bits)> m_length_prices;
+    Array<Array<u32, largest_real_match_length - normalized_to_real_match_length_offset + 1>, (1 << maximum_number_of_position_bits)> m_rep_length_prices;
+    Array<Array<u32, (1 << 6)>, number_of_length_to_position_states> m_position_slot_prices;
+    static constexpr size_t number_of_full_distance_prices = 1 << (first_position_slot_with_direct_encoded_bits / 2);
+    Array<Array<u32, number_of_full_distance_prices>, number_of_length_to_position_states> m_full_distance_prices;
+    Array<u32, (1 << number_of_alignment_bits)> m_alignment_prices;
+
+    struct OptimalNode {
+        u32 price { infinite_price };
+        u32 previous { 0 };
+        Symbol symbol;
+
+        // The state after arriving at this node.
+        u16 state { 0 };
+        Array<u32, 4> reps {};
+    };
+    FixedArray<OptimalNode> m_optimal_nodes;
+    Vector<Symbol> m_optimal_symbols;
+    size_t m_next_optimal_symbol { 0 };
 
     // Range encoder state.
     u32 m_range_encoder_range { 0xFFFFFFFF };
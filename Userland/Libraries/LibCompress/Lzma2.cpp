@@ -186,4 +186,151 @@ void Lzma2Decompressor::close()
 {
 }
 
+ErrorOr<NonnullOwnPtr<Lzma2Compressor>> Lzma2Compressor::create_from_raw_stream(MaybeOwned<Stream> stream, LzmaCompressorOptions const& options)
+{
+    // "lc + lp <= 4" is a restriction that LZMA2 adds on top of LZMA.
+    if (options.literal_context_bits + options.literal_position_bits > 4)
+        return Error::from_string_literal("LZMA2 requires the sum of the literal context bits and literal position bits to be at most 4");
+
+    auto encoded_model_properties = TRY(LzmaHeader::encode_model_properties({
+        .literal_context_bits = options.literal_context_bits,
+        .literal_position_bits = options.literal_position_bits,
+        .position_bits = options.position_bits,
+    }));
+
+    // The size of each chunk is stored in the chunk header, so the LZMA data itself never has an end-of-stream marker.
+    auto lzma_options = options;
+    lzma_options.uncompressed_size.clear();
+
+    auto chunk_data = TRY(try_make<AllocatingMemoryStream>());
+    auto compressor = TRY(LzmaCompressor::create_from_raw_stream(MaybeOwned<Stream> { *chunk_data }, lzma_options));
+
+    return adopt_nonnull_own_or_enomem(new (nothrow) Lzma2Compressor(move(stream), move(chunk_data), move(compressor), encoded_model_properties));
+}
+
+Lzma2Compressor::Lzma2Compressor(MaybeOwned<Stream> stream, NonnullOwnPtr<AllocatingMemoryStream> chunk_data, NonnullOwnPtr<LzmaCompressor> compressor, u8 encoded_model_properties)
+    : m_stream(move(stream))
+    , m_chunk_data(move(chunk_data))
+    , m_compressor(move(compressor))
+    , m_encoded_model_properties(encoded_model_properties)
+{
+}
+
+Lzma2Compressor::~Lzma2Compressor()
+{
+    if (!m_finished) {
+        // Note: We need a better API for specifying things like this.
+        finish().release_value_but_fixme_should_propagate_errors();
+    }
+}
+
+ErrorOr<Bytes> Lzma2Compressor::read_some(Bytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+ErrorOr<size_t> Lzma2Compressor::write_some(ReadonlyBytes bytes)
+{
+    if (m_finished)
+        return Error::from_string_literal("Tried to write to a finished LZMA2 stream");
+
+    auto const processed_bytes = m_compressor->m_match_finder->append(bytes);
+    TRY(encode_available_data(false));
+    return processed_bytes;
+}
+
+ErrorOr<void> Lzma2Compressor::finish()
+{
+    if (m_finished)
+        return Error::from_string_literal("Finished an LZMA2 stream twice");
+
+    TRY(encode_available_data(true));
+    TRY(write_chunk());
+
+    // "0 denotes the end of the file"
+    TRY(m_stream->write_value<u8>(0x00));
+    m_compressed_size++;
+
+    // All of the LZMA data has been written as part of the chunks, so there is nothing left to flush.
+    m_compressor->m_has_flushed_data = true;
+    m_finished = true;
+    return {};
+}
+
+ErrorOr<void> Lzma2Compressor::encode_available_data(bool finishing)
+{
+    auto& compressor = *m_compressor;
+
+    while (finishing ? compressor.has_unencoded_data() : compressor.m_match_finder->available() >= compressor.required_lookahead()) {
+        TRY(compressor.encode_once());
+
+        if (is_chunk_full())
+            TRY(write_chunk());
+    }
+
+    return {};
+}
+
+bool Lzma2Compressor::is_chunk_full() const
+{
+    // Stop early enough that the next symbol is guaranteed to still fit into the chunk.
+    auto const uncompressed_size = m_compressor->m_total_processed_bytes - m_chunk_start_position;
+    if (uncompressed_size + LzmaCompressor::largest_real_match_length > maximum_chunk_uncompressed_size)
+        return true;
+
+    auto const compressed_size = m_chunk_data->used_buffer_size() + m_compressor->pending_range_encoder_size();
+    return compressed_size + maximum_symbol_compressed_size > maximum_chunk_compressed_size;
+}
+
+ErrorOr<void> Lzma2Compressor::write_chunk()
+{
+    auto const uncompressed_size = m_compressor->m_total_processed_bytes - m_chunk_start_position;
+    if (uncompressed_size == 0)
+        return {};
+
+    TRY(m_compressor->flush_range_encoder());
+    m_compressor->reset_range_encoder();
+
+    auto const compressed_data = TRY(m_chunk_data->read_until_eof());
+    VERIFY(uncompressed_size <= maximum_chunk_uncompressed_size);
+    VERIFY(compressed_data.size() <= maximum_chunk_compressed_size);
+
+    // "0x80-0xff denotes an LZMA chunk, where the lowest 5 bits are used as bit 16-20
+    //  of the uncompressed size minus one, and bit 5-6 indicates what should be reset."
+    // The first chunk resets everything and sets the properties, all following chunks continue where the previous one left off.
+    u8 control_byte = 0x80 | ((uncompressed_size - 1) >> 16);
+    if (!m_wrote_first_chunk)
+        control_byte |= 3 << 5;
+
+    TRY(m_stream->write_value<u8>(control_byte));
+    TRY(m_stream->write_value<BigEndian<u16>>((uncompressed_size - 1) & 0xFFFF));
+    TRY(m_stream->write_value<BigEndian<u16>>(compressed_data.size() - 1));
+    if (!m_wrote_first_chunk)
+        TRY(m_stream->write_value<u8>(m_encoded_model_properties));
+    TRY(m_stream->write_until_depleted(compressed_data));
+
+    m_compressed_size += 5 + (m_wrote_first_chunk ? 0 : 1) + compressed_data.size();
+    m_chunk_start_position = m_compressor->m_total_processed_bytes;
+    m_wrote_first_chunk = true;
+    return {};
+}
+
+bool Lzma2Compressor::is_eof() const
+{
+    return true;
+}
+
+bool Lzma2Compressor::is_open() const
+{
+    return !m_finished;
+}
+
+void Lzma2Compressor::close()
+{
+    if (!m_finished) {
+        // Note: We need a better API for specifying things like this.
+        finish().release_value_but_fixme_should_propagate_errors();
+    }
+}
+
 }
@@ -8,6 +8,7 @@
 
 #include <AK/CircularBuffer.h>
 #include <AK/MaybeOwned.h>
+#include <AK/MemoryStream.h>
 #include <AK/Stream.h>
 #include <LibCompress/Lzma.h>
 
@@ -43,4 +44,51 @@ private:
     Optional<LzmaDecompressorOptions> m_last_lzma_options;
 };
 
+class Lzma2Compressor : public Stream {
+public:
+    /// Creates a compressor that does not write the leading byte indicating the dictionary size.
+    static ErrorOr<NonnullOwnPtr<Lzma2Compressor>> create_from_raw_stream(MaybeOwned<Stream>, LzmaCompressorOptions const&);
+
+    /// Encodes all of the remaining data and writes the end of the stream.
+    ErrorOr<void> finish();
+
+    /// The number of bytes that have been written to the underlying stream so far.
+    u64 compressed_size() const { return m_compressed_size; }
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+
+    virtual ~Lzma2Compressor();
+
+private:
+    // The sizes of a chunk are stored minus one in 21 and 16 bits respectively.
+    static constexpr size_t maximum_chunk_uncompressed_size = 2 * MiB;
+    static constexpr size_t maximum_chunk_compressed_size = 64 * KiB;
+
+    // This is larger than what the largest possible LZMA symbol takes up in the compressed data.
+    static constexpr size_t maximum_symbol_compressed_size = 64;
+
+    Lzma2Compressor(MaybeOwned<Stream>, NonnullOwnPtr<AllocatingMemoryStream> chunk_data, NonnullOwnPtr<LzmaCompressor>, u8 encoded_model_properties);
+
+    ErrorOr<void> encode_available_data(bool finishing);
+    bool is_chunk_full() const;
+    ErrorOr<void> write_chunk();
+
+    MaybeOwned<Stream> m_stream;
+
+    // The header of a chunk contains its compressed size, so the LZMA compressor writes into this buffer
+    // until the chunk is complete.
+    NonnullOwnPtr<AllocatingMemoryStream> m_chunk_data;
+    NonnullOwnPtr<LzmaCompressor> m_compressor;
+    u8 m_encoded_model_properties { 0 };
+
+    u64 m_chunk_start_position { 0 };
+    u64 m_compressed_size { 0 };
+    bool m_wrote_first_chunk { false };
+    bool m_finished { false };
+};
+
 }
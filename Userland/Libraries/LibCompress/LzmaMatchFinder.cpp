@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteReader.h>
+#include <AK/NumericLimits.h>
+#include <LibCompress/LzmaMatchFinder.h>
+
+namespace Compress {
+
+ErrorOr<NonnullOwnPtr<LzmaMatchFinder>> LzmaMatchFinder::create(LzmaMatchFinderType type, u32 dictionary_size, u32 nice_length, u32 search_depth)
+{
+    VERIFY(dictionary_size >= 4 * KiB);
+    VERIFY(nice_length >= 4 && nice_length <= maximum_match_length);
+    VERIFY(search_depth > 0);
+
+    // The window has to fit the whole dictionary in front of the current position. Anything on top of that
+    // is room for new data, which saves us from having to move the window contents around too often.
+    auto const reserved_size = max(dictionary_size / 2, 256 * KiB) + 2 * maximum_match_length;
+    auto window = TRY(ByteBuffer::create_uninitialized(static_cast<size_t>(dictionary_size) + reserved_size));
+
+    // This is sized the same way the LZMA SDK does it, the four-byte hash table ends up with about half as
+    // many entries as there are positions in the dictionary.
+    u32 hash4_mask = dictionary_size - 1;
+    hash4_mask |= hash4_mask >> 1;
+    hash4_mask |= hash4_mask >> 2;
+    hash4_mask |= hash4_mask >> 4;
+    hash4_mask |= hash4_mask >> 8;
+    hash4_mask |= hash4_mask >> 16;
+    hash4_mask >>= 1;
+    hash4_mask |= 0xFFFF;
+    if (hash4_mask > (1 << 24))
+        hash4_mask >>= 1;
+
+    auto hash_table = TRY(FixedArray<u32>::create(hash2_size + hash3_size + hash4_mask + 1));
+
+    auto const chain_entries_per_position = type == LzmaMatchFinderType::BinaryTree4 ? 2 : 1;
+    auto chain = TRY(FixedArray<u32>::create(static_cast<size_t>(dictionary_size) * chain_entries_per_position));
+
+    return adopt_nonnull_own_or_enomem(new (nothrow) LzmaMatchFinder(type, dictionary_size, nice_length, search_depth, move(window), move(hash_table), move(chain), hash4_mask));
+}
+
+LzmaMatchFinder::LzmaMatchFinder(LzmaMatchFinderType type, u32 dictionary_size, u32 nice_length, u32 search_depth, ByteBuffer window, FixedArray<u32> hash_table, FixedArray<u32> chain, u32 hash4_mask)
+    : m_type(type)
+    , m_cyclic_size(dictionary_size)
+    , m_nice_length(nice_length)
+    , m_search_depth(search_depth)
+    , m_window(move(window))
+    , m_internal_position(dictionary_size)
+    , m_hash_table(move(hash_table))
+    , m_hash4_mask(hash4_mask)
+    , m_chain(move(chain))
+{
+}
+
+size_t LzmaMatchFinder::append(ReadonlyBytes bytes)
+{
+    if (m_window_size == m_window.size()) {
+        // Keep the dictionary in front of the current position, and one more byte for the literal context of a
+        // compressor that is lagging one position behind us.
+        u64 const keep_size = static_cast<u64>(m_cyclic_size) + 1;
+        u64 const new_window_start = m_position > keep_size ? m_position - keep_size : 0;
+
+        if (new_window_start > m_window_start) {
+            size_t const shift = new_window_start - m_window_start;
+            memmove(m_window.data(), m_window.data() + shift, m_window_size - shift);
+            m_window_start = new_window_start;
+            m_window_size -= shift;
+        }
+    }
+
+    auto const count = min(bytes.size(), m_window.size() - m_window_size);
+    m_window.overwrite(m_window_size, bytes.data(), count);
+    m_window_size += count;
+    return count;
+}
+
+u32 LzmaMatchFinder::match_length_at(u64 position, u32 distance, u32 maximum_length) const
+{
+    VERIFY(position >= m_window_start + distance);
+    VERIFY(position + maximum_length <= end_position());
+
+    u8 const* data = m_window.data() + (position - m_window_start);
+    u8 const* candidate = data - distance;
+
+    u32 length = 0;
+    while (length < maximum_length && candidate[length] == data[length])
+        length++;
+    return length;
+}
+
+LzmaMatchFinder::HashedPosition LzmaMatchFinder::hash_current_position() const
+{
+    u32 const value = ByteReader::load32(current());
+
+    // The two-byte hash is just the two bytes themselves. The three- and four-byte hashes use multiplicative hashing,
+    // which mixes all of the input bits into the upper bits of the product.
+    return {
+        .hash2 = value & 0xFFFF,
+        .hash3 = ((value & 0xFFFFFF) * 2654435761u) >> 16,
+        .hash4 = static_cast<u32>((value * 0x9E3779B97F4A7C15ull) >> 32) & m_hash4_mask,
+    };
+}
+
+void LzmaMatchFinder::find_matches(Vector<Match, 16>& matches)
+{
+    matches.clear_with_capacity();
+
+    auto const position = m_position;
+    auto const available_length = static_cast<u32>(min(available(), static_cast<size_t>(maximum_match_length)));
+
+    insert_current_position(&matches);
+
+    // The search stops once it reaches the nice length, but a longer match may still be useful for the caller.
+    if (!matches.is_empty() && matches.last().length == m_nice_length && available_length > m_nice_length)
+        matches.last().length = match_length_at(position, matches.last().distance, available_length);
+}
+
+void LzmaMatchFinder::skip(size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        insert_current_position(nullptr);
+}
+
+void LzmaMatchFinder::insert_current_position(Vector<Match, 16>* matches)
+{
+    u32 const length_limit = min(available(), static_cast<size_t>(m_nice_length));
+
+    // There is not enough data left to hash, so this position will never be part of a match.
+    if (length_limit < 4) {
+        move_to_next_position();
+        return;
+    }
+
+    auto const hashes = hash_current_position();
+    u8 const* current_data = current();
+
+    u32& hash2_entry = m_hash_table[hashes.hash2];
+    u32& hash3_entry = m_hash_table[hash2_size + hashes.hash3];
+    u32& hash4_entry = m_hash_table[hash2_size + hash3_size + hashes.hash4];
+
+    u32 const hash2_distance = m_internal_position - hash2_entry;
+    u32 const hash3_distance = m_internal_position - hash3_entry;
+    u32 const current_match = hash4_entry;
+
+    hash2_entry = m_internal_position;
+    hash3_entry = m_internal_position;
+    hash4_entry = m_internal_position;
+
+    u32 longest_length = 0;
+    if (matches) {
+        auto const check_short_match = [&](u32 distance, u32 minimum_length) {
+            if (distance >= m_cyclic_size)
+                return;
+
+            u8 const* candidate = current_data - distance;
+            u32 length = 0;
+            while (length < length_limit && candidate[length] == current_data[length])
+                length++;
+
+            if (length >= minimum_length && length > longest_length) {
+                longest_length = length;
+                matches->append({ length, distance });
+            }
+        };
+
+        check_short_match(hash2_distance, 2);
+        if (hash3_distance != hash2_distance)
+            check_short_match(hash3_distance, 3);
+
+        // We already found the longest possible match, so only update the search structures for this position.
+        if (longest_length == length_limit)
+            matches = nullptr;
+    }
+
+    // Anything up to a length of three would have been found through the two- and three-byte hashes already.
+    longest_length = max(longest_length, 3u);
+
+    if (m_type == LzmaMatchFinderType::HashChain4)
+        search_hash_chain(current_match, length_limit, longest_length, matches);
+    else
+        search_binary_tree(current_match, length_limit, longest_length, matches);
+
+    move_to_next_position();
+}
+
+void LzmaMatchFinder::search_hash_chain(u32 current_match, u32 length_limit, u32 longest_length, Vector<Match, 16>* matches)
+{
+    m_chain[m_cyclic_position] = current_match;
+
+    if (!matches)
+        return;
+
+    u8 const* current_data = current();
+
+    for (u32 depth = m_search_depth; depth > 0; depth--) {
+        u32 const distance = m_internal_position - current_match;
+        if (distance >= m_cyclic_size)
+            return;
+
+        u8 const* candidate = current_data - distance;
+
+        // Checking the byte just past the longest match first rejects most candidates without a full comparison.
+        if (candidate[longest_length] == current_data[longest_length] && candidate[0] == current_data[0]) {
+            u32 length = 0;
+            while (length < length_limit && candidate[length] == current_data[length])
+                length++;
+
+            if (length > longest_length) {
+                longest_length = length;
+                matches->append({ length, distance });
+
+                if (length == length_limit)
+                    return;
+            }
+        }
+
+        current_match = m_chain[m_cyclic_position - distance + (distance > m_cyclic_position ? m_cyclic_size : 0)];
+    }
+}
+
+void LzmaMatchFinder::search_binary_tree(u32 current_match, u32 length_limit, u32 longest_length, Vector<Match, 16>* matches)
+{
+    // Every position is the root of a binary tree of older positions, sorted by the data following them. While walking
+    // down the tree of the previous position with the same hash, we split it into the trees of the new position, with
+    // everything that sorts before the new position on the left and everything that sorts after it on the right.
+    // The common prefix length with the closest nodes on each side is a lower bound for the match length of anything
+    // further down the tree, so the comparisons don't have to start from the beginning.
+    u8 const* current_data = current();
+
+    u32* left_child = &m_chain[(m_cyclic_position << 1) + 1];
+    u32* right_child = &m_chain[m_cyclic_position << 1];
+    u32 left_length = 0;
+    u32 right_length = 0;
+
+    for (u32 depth = m_search_depth;; depth--) {
+        u32 const distance = m_internal_position - current_match;
+        if (depth == 0 || distance >= m_cyclic_size) {
+            *left_child = 0;
+            *right_child = 0;
+            return;
+        }
+
+        u32* pair = &m_chain[(m_cyclic_position - distance + (distance > m_cyclic_position ? m_cyclic_size : 0)) << 1];
+        u8 const* candidate = current_data - distance;
+
+        u32 length = min(left_length, right_length);
+        if (candidate[length] == current_data[length]) {
+            while (++length != length_limit && candidate[length] == current_data[length])
+                ;
+
+            if (matches && length > longest_length) {
+                longest_length = length;
+                matches->append({ length, distance });
+            }
+
+            // The candidate is equal to the new position as far as we care, so it replaces it in the tree.
+            if (length == length_limit) {
+                *right_child = pair[0];
+                *left_child = pair[1];
+                return;
+            }
+        }
+
+        if (candidate[length] < current_data[length]) {
+            *right_child = current_match;
+            right_child = pair + 1;
+            current_match = *right_child;
+            right_length = length;
+        } else {
+            *left_child = current_match;
+            left_child = pair;
+            current_match = *left_child;
+            left_length = length;
+        }
+    }
+}
+
+void LzmaMatchFinder::move_to_next_position()
+{
+    m_position++;
+
+    if (++m_cyclic_position == m_cyclic_size)
+        m_cyclic_position = 0;
+
+    if (++m_internal_position == NumericLimits<u32>::max())
+        normalize_positions();
+}
+
+void LzmaMatchFinder::normalize_positions()
+{
+    // Rebase all stored positions so that the current one is back at the cyclic size. Anything that would end up
+    // before that is out of reach of the dictionary anyways, so it is marked as empty.
+    u32 const subtrahend = m_internal_position - m_cyclic_size;
+
+    auto const normalize = [subtrahend](Span<u32> entries) {
+        for (auto& entry : entries)
+            entry = entry <= subtrahend ? 0 : entry - subtrahend;
+    };
+    normalize(m_hash_table.span());
+    normalize(m_chain.span());
+
+    m_internal_position -= subtrahend;
+}
+
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/FixedArray.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
+
+namespace Compress {
+
+// The match finders are modeled after the ones in the LZMA SDK (LzFind.c), which has been placed in the public domain.
+// Both of them hash the next four bytes to find the most recent position with the same prefix, and additionally
+// look up the most recent positions sharing the next two and three bytes to find short, close matches cheaply.
+enum class LzmaMatchFinderType {
+    // Keeps every position in a chain of older positions with the same hash. Fast to update, but every search
+    // has to walk the chain and compare each candidate.
+    HashChain4,
+
+    // Keeps the positions with the same hash in a binary tree sorted by the data following them. Slower to
+    // update, but finds the longest matches after far fewer comparisons, which pays off for longer search depths.
+    BinaryTree4,
+};
+
+class LzmaMatchFinder {
+public:
+    // The longest match that LZMA is able to encode.
+    static constexpr u32 maximum_match_length = 273;
+
+    struct Match {
+        u32 length;
+        // This is the real distance, i.e. 1 refers to the previous byte.
+        u32 distance;
+    };
+
+    static ErrorOr<NonnullOwnPtr<LzmaMatchFinder>> create(LzmaMatchFinderType, u32 dictionary_size, u32 nice_length, u32 search_depth);
+
+    // Appends as much of the given data to the window as currently fits, and returns the number of bytes that were taken.
+    // Data is only ever discarded from the window once it is further back than the dictionary size.
+    size_t append(ReadonlyBytes);
+
+    // The absolute position of the next byte that will be inserted into the search structures.
+    u64 position() const { return m_position; }
+
+    // The absolute position just past the last byte that has been appended.
+    u64 end_position() const { return m_window_start + m_window_size; }
+
+    size_t available() const { return end_position() - m_position; }
+
+    u8 byte_at(u64 position) const
+    {
+        VERIFY(position >= m_window_start && position < end_position());
+        return m_window[position - m_window_start];
+    }
+
+    // Returns the length of the match at the given absolute position, comparing up to maximum_length bytes.
+    u32 match_length_at(u64 position, u32 distance, u32 maximum_length) const;
+
+    // Inserts the current position and returns all matches for it that are longer than any match that has
+    // been found before them, so the longest match is always the last one. Advances to the next position.
+    void find_matches(Vector<Match, 16>& matches);
+
+    // Inserts the next count positions without searching for matches.
+    void skip(size_t count);
+
+private:
+    LzmaMatchFinder(LzmaMatchFinderType, u32 dictionary_size, u32 nice_length, u32 search_depth, ByteBuffer window, FixedArray<u32> hash_table, FixedArray<u32> chain, u32 hash4_mask);
+
+    struct HashedPosition {
+        u32 hash2;
+        u32 hash3;
+        u32 hash4;
+    };
+    HashedPosition hash_current_position() const;
+
+    u8 const* current() const { return m_window.data() + (m_position - m_window_start); }
+
+    void search_hash_chain(u32 current_match, u32 length_limit, u32 longest_length, Vector<Match, 16>* matches);
+    void search_binary_tree(u32 current_match, u32 length_limit, u32 longest_length, Vector<Match, 16>* matches);
+
+    void insert_current_position(Vector<Match, 16>* matches);
+    void move_to_next_position();
+    void normalize_positions();
+
+    LzmaMatchFinderType m_type;
+    u32 m_cyclic_size { 0 };
+    u32 m_nice_length { 0 };
+    u32 m_search_depth { 0 };
+
+    // The window keeps at least the last dictionary size bytes before the current position, as well as all the
+    // appended data after it. It is compacted once it runs full.
+    ByteBuffer m_window;
+    u64 m_window_start { 0 };
+    size_t m_window_size { 0 };
+    u64 m_position { 0 };
+
+    // The hash tables and chains store positions relative to an internal 32-bit counter. As in the LZMA SDK,
+    // the counter starts at the cyclic size, so that an empty entry (zero) is always out of reach.
+    u32 m_internal_position { 0 };
+    u32 m_cyclic_position { 0 };
+
+    static constexpr size_t hash2_size = 1 << 16;
+    static constexpr size_t hash3_size = 1 << 16;
+    FixedArray<u32> m_hash_table;
+    u32 m_hash4_mask { 0 };
+
+    // For the hash chain finder, this contains the previous position with the same hash for every position.
+    // For the binary tree finder, this contains the left and right child for every position.
+    FixedArray<u32> m_chain;
+};
+
+}
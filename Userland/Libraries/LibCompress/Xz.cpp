@@ -4,11 +4,13 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/ByteBuffer.h>
 #include <AK/MemoryStream.h>
 #include <LibCompress/Lzma2.h>
 #include <LibCompress/Xz.h>
 #include <LibCrypto/Checksum/CRC32.h>
+#include <LibThreading/WorkerThread.h>
 
 namespace Compress {
 
@@ -44,6 +46,19 @@ ErrorOr<XzMultibyteInteger> XzMultibyteInteger::read_from_stream(Stream& stream)
     return XzMultibyteInteger { result };
 }
 
+ErrorOr<void> XzMultibyteInteger::write_to_stream(Stream& stream) const
+{
+    u64 value = m_value;
+
+    while (value >= 0x80) {
+        TRY(stream.write_value<u8>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+
+    TRY(stream.write_value<u8>(value));
+    return {};
+}
+
 ErrorOr<void> XzStreamHeader::validate() const
 {
     // 2.1.1.1. Header Magic Bytes:
@@ -161,6 +176,14 @@ u32 XzFilterLzma2Properties::dictionary_size() const
     return dictionary_size;
 }
 
+XzFilterLzma2Properties XzFilterLzma2Properties::for_dictionary_size(u32 dictionary_size)
+{
+    XzFilterLzma2Properties properties { .encoded_dictionary_size = 0, .reserved = 0 };
+    while (properties.dictionary_size() < dictionary_size)
+        properties.encoded_dictionary_size++;
+    return properties;
+}
+
 u32 XzFilterDeltaProperties::distance() const
 {
     // "The Properties byte indicates the delta distance, which can be
@@ -812,4 +835,393 @@ void XzDecompressor::close()
 {
 }
 
+ErrorOr<Vector<XzDecompressor::BlockLocation>> XzDecompressor::locate_blocks(ReadonlyBytes data)
+{
+    // Everything in XZ is a multiple of four bytes in size, so the whole file has to be as well.
+    if (data.size() % 4 != 0)
+        return Error::from_string_literal("XZ data size is not a multiple of four");
+
+    auto read_u32_at = [&](size_t offset) {
+        u32 value;
+        memcpy(&value, data.offset_pointer(offset), sizeof(value));
+        return value;
+    };
+
+    Vector<BlockLocation> blocks;
+    bool found_stream = false;
+
+    // Only the Stream Footer tells us where the Index, and thereby the Blocks of a Stream are, so we have to
+    // locate the Streams from back to front.
+    u64 stream_end = data.size();
+    while (true) {
+        // 2.2. Stream Padding:
+        // "Stream Padding MUST contain only null bytes."
+        while (stream_end >= 4 && read_u32_at(stream_end - 4) == 0)
+            stream_end -= 4;
+
+        if (stream_end == 0) {
+            if (!found_stream)
+                return Error::from_string_literal("XZ data does not contain any Streams");
+            break;
+        }
+
+        if (stream_end < sizeof(XzStreamHeader) + sizeof(XzStreamFooter))
+            return Error::from_string_literal("XZ data is too small to contain a Stream");
+
+        XzStreamFooter stream_footer {};
+        memcpy(&stream_footer, data.offset_pointer(stream_end - sizeof(XzStreamFooter)), sizeof(XzStreamFooter));
+        TRY(stream_footer.validate());
+
+        u64 const size_of_index = stream_footer.backward_size();
+        if (size_of_index > stream_end - sizeof(XzStreamHeader) - sizeof(XzStreamFooter))
+            return Error::from_string_literal("XZ index size in the stream footer is larger than the Stream");
+
+        auto const start_of_index = stream_end - sizeof(XzStreamFooter) - size_of_index;
+        FixedMemoryStream index_stream { data.slice(start_of_index, size_of_index) };
+
+        // 4.1. Index Indicator
+        if (TRY(index_stream.read_value<u8>()) != 0x00)
+            return Error::from_string_literal("XZ index does not start with an Index Indicator");
+
+        // 4.2. Number of Records
+        u64 const number_of_records = TRY(index_stream.read_value<XzMultibyteInteger>());
+
+        // 4.3. List of Records
+        Vector<BlockLocation> stream_blocks;
+        u64 size_of_blocks = 0;
+        for (u64 i = 0; i < number_of_records; i++) {
+            u64 const unpadded_size = TRY(index_stream.read_value<XzMultibyteInteger>());
+            u64 const uncompressed_size = TRY(index_stream.read_value<XzMultibyteInteger>());
+
+            if (unpadded_size < 5)
+                return Error::from_string_literal("XZ index contains a record with an unpadded size of less than five");
+
+            // Including the Block Padding, every Block is a multiple of four bytes in size (3.3. Block Padding).
+            auto const padded_size = (unpadded_size + 3) & ~static_cast<u64>(3);
+            if (padded_size > start_of_index - size_of_blocks)
+                return Error::from_string_literal("XZ index contains Blocks which are larger than the Stream");
+
+            TRY(stream_blocks.try_append({ .offset = size_of_blocks, .unpadded_size = unpadded_size, .uncompressed_size = uncompressed_size }));
+            size_of_blocks += padded_size;
+        }
+
+        // 4.4. Index Padding
+        while (MUST(index_stream.tell()) % 4 != 0) {
+            if (TRY(index_stream.read_value<u8>()) != 0)
+                return Error::from_string_literal("XZ index contains a non-null padding byte");
+        }
+
+        // 4.5. CRC32
+        Crypto::Checksum::CRC32 calculated_index_crc32 { data.slice(start_of_index, MUST(index_stream.tell())) };
+        u32 const stored_index_crc32 = TRY(index_stream.read_value<LittleEndian<u32>>());
+        if (calculated_index_crc32.digest() != stored_index_crc32)
+            return Error::from_string_literal("Stored XZ index CRC32 does not match the calculated CRC32");
+
+        if (!index_stream.is_eof())
+            return Error::from_string_literal("XZ index size does not match the stored size in the stream footer");
+
+        if (size_of_blocks + sizeof(XzStreamHeader) > start_of_index)
+            return Error::from_string_literal("XZ index contains Blocks which are larger than the Stream");
+
+        auto const start_of_stream = start_of_index - size_of_blocks - sizeof(XzStreamHeader);
+
+        XzStreamHeader stream_header {};
+        memcpy(&stream_header, data.offset_pointer(start_of_stream), sizeof(XzStreamHeader));
+        TRY(stream_header.validate());
+
+        // 2.1.2.3. Stream Flags
+        if (ReadonlyBytes { &stream_header.flags, sizeof(XzStreamFlags) } != ReadonlyBytes { &stream_footer.flags, sizeof(XzStreamFlags) })
+            return Error::from_string_literal("XZ stream header flags don't match the stream footer");
+
+        for (auto& block : stream_blocks) {
+            block.offset += start_of_stream + sizeof(XzStreamHeader);
+            block.stream_flags = stream_header.flags;
+        }
+        TRY(blocks.try_prepend(move(stream_blocks)));
+
+        found_stream = true;
+        stream_end = start_of_stream;
+    }
+
+    return blocks;
+}
+
+ErrorOr<void> XzDecompressor::decompress_block(ReadonlyBytes data, BlockLocation const& block, Bytes output)
+{
+    VERIFY(output.size() == block.uncompressed_size);
+
+    FixedMemoryStream block_stream { data.slice(block.offset, (block.unpadded_size + 3) & ~static_cast<u64>(3)) };
+    auto decompressor = TRY(XzDecompressor::create(MaybeOwned<Stream>(block_stream)));
+    decompressor->m_stream_flags = block.stream_flags;
+    decompressor->m_found_first_stream_header = true;
+
+    auto const encoded_block_header_size = TRY(decompressor->m_stream->read_value<u8>());
+    if (encoded_block_header_size == 0x00)
+        return Error::from_string_literal("XZ index lists a Block where there is none");
+
+    TRY(decompressor->load_next_block(encoded_block_header_size));
+
+    auto& block_data = *decompressor->m_current_block_stream;
+    size_t uncompressed_size = 0;
+    while (!block_data->is_eof()) {
+        if (uncompressed_size == output.size()) {
+            // The output is full, but the Block might still have to process its end marker.
+            u8 byte;
+            if (!TRY(block_data->read_some({ &byte, sizeof(byte) })).is_empty())
+                return Error::from_string_literal("Uncompressed size of XZ Block does not match the Index");
+            continue;
+        }
+
+        uncompressed_size += TRY(block_data->read_some(output.slice(uncompressed_size))).size();
+    }
+
+    decompressor->m_current_block_uncompressed_size = uncompressed_size;
+    TRY(decompressor->finish_current_block());
+
+    if (uncompressed_size != block.uncompressed_size)
+        return Error::from_string_literal("Uncompressed size of XZ Block does not match the Index");
+
+    if (decompressor->m_processed_blocks.first().unpadded_size != block.unpadded_size)
+        return Error::from_string_literal("Unpadded size of XZ Block does not match the Index");
+
+    return {};
+}
+
+ErrorOr<ByteBuffer> XzDecompressor::decompress_all_in_parallel(ReadonlyBytes data, size_t thread_count)
+{
+    auto blocks = TRY(locate_blocks(data));
+
+    thread_count = min(thread_count, blocks.size());
+    if (thread_count <= 1) {
+        FixedMemoryStream stream { data };
+        auto decompressor = TRY(XzDecompressor::create(MaybeOwned<Stream>(stream)));
+        return decompressor->read_until_eof();
+    }
+
+    u64 total_uncompressed_size = 0;
+    for (auto const& block : blocks)
+        total_uncompressed_size += block.uncompressed_size;
+
+    if (total_uncompressed_size > NumericLimits<size_t>::max())
+        return Error::from_string_literal("XZ data is too large to be decompressed into memory");
+
+    // Every Block is decompressed straight into its place in the output.
+    auto output = TRY(ByteBuffer::create_uninitialized(total_uncompressed_size));
+    Vector<Bytes> block_outputs;
+    TRY(block_outputs.try_ensure_capacity(blocks.size()));
+    size_t output_offset = 0;
+    for (auto const& block : blocks) {
+        block_outputs.unchecked_append(output.bytes().slice(output_offset, block.uncompressed_size));
+        output_offset += block.uncompressed_size;
+    }
+
+    Atomic<size_t> next_block_index { 0 };
+
+    auto decompress_blocks = [&]() -> ErrorOr<void> {
+        while (true) {
+            auto block_index = next_block_index.fetch_add(1);
+            if (block_index >= blocks.size())
+                return {};
+
+            TRY(decompress_block(data, blocks[block_index], block_outputs[block_index]));
+        }
+    };
+
+    Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>> workers;
+    TRY(workers.try_ensure_capacity(thread_count));
+
+    for (size_t i = 0; i < thread_count; ++i) {
+        auto worker = TRY(Threading::WorkerThread<Error>::create("XZ Worker"sv));
+        worker->start_task([&] { return decompress_blocks(); });
+        workers.unchecked_append(move(worker));
+    }
+
+    Optional<Error> error;
+    for (auto& worker : workers) {
+        auto result = worker->wait_until_task_is_finished();
+        if (result.is_error() && !error.has_value())
+            error = result.release_error();
+    }
+    if (error.has_value())
+        return error.release_value();
+
+    return output;
+}
+
+ErrorOr<NonnullOwnPtr<XzCompressor>> XzCompressor::create(MaybeOwned<Stream> stream, LzmaCompressorOptions const& options)
+{
+    auto compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) XzCompressor(move(stream), options)));
+
+    // 2.1.1. Stream Header
+    XzStreamHeader header {
+        .magic = { 0xFD, '7', 'z', 'X', 'Z', 0x00 },
+        .flags = stream_flags,
+        .flags_crc32 = Crypto::Checksum::CRC32({ &stream_flags, sizeof(stream_flags) }).digest(),
+    };
+    TRY(compressor->m_stream->write_value(header));
+
+    return compressor;
+}
+
+XzCompressor::XzCompressor(MaybeOwned<Stream> stream, LzmaCompressorOptions options)
+    : m_stream(move(stream))
+    , m_options(move(options))
+{
+}
+
+XzCompressor::~XzCompressor()
+{
+    if (!m_finished) {
+        // Note: We need a better API for specifying things like this.
+        finish().release_value_but_fixme_should_propagate_errors();
+    }
+}
+
+ErrorOr<void> XzCompressor::start_block()
+{
+    // 3.1. Block Header
+    AllocatingMemoryStream header_stream;
+
+    // Reserve the Block Header Size, which is filled in once we know the size.
+    TRY(header_stream.write_value<u8>(0));
+
+    // 3.1.2. Block Flags
+    // The sizes are not known up front, but they are optional anyways.
+    XzBlockFlags const flags {
+        .encoded_number_of_filters = 0,
+        .reserved = 0,
+        .compressed_size_present = false,
+        .uncompressed_size_present = false,
+    };
+    TRY(header_stream.write_value(flags));
+
+    // 3.1.5. List of Filter Flags
+    // 5.3.1. LZMA2
+    auto const properties = XzFilterLzma2Properties::for_dictionary_size(m_options.dictionary_size);
+    TRY(header_stream.write_value(XzMultibyteInteger { 0x21 }));
+    TRY(header_stream.write_value(XzMultibyteInteger { sizeof(properties) }));
+    TRY(header_stream.write_value(properties));
+
+    // 3.1.6. Header Padding
+    constexpr size_t size_of_crc32 = 4;
+    while ((header_stream.used_buffer_size() + size_of_crc32) % 4 != 0)
+        TRY(header_stream.write_value<u8>(0));
+
+    auto header = TRY(header_stream.read_until_eof());
+
+    // 3.1.1. Block Header Size
+    // "real_header_size = (encoded_header_size + 1) * 4;"
+    m_block_header_size = header.size() + size_of_crc32;
+    header[0] = m_block_header_size / 4 - 1;
+
+    // 3.1.7. CRC32
+    auto const header_crc32 = Crypto::Checksum::CRC32 { header }.digest();
+    TRY(m_stream->write_until_depleted(header));
+    TRY(m_stream->write_value<LittleEndian<u32>>(header_crc32));
+
+    // The encoded dictionary size may be rounded up, but there is no reason for the compressor to use the larger size.
+    m_block_compressor = TRY(Lzma2Compressor::create_from_raw_stream(MaybeOwned<Stream> { *m_stream }, m_options));
+    return {};
+}
+
+ErrorOr<Bytes> XzCompressor::read_some(Bytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+ErrorOr<size_t> XzCompressor::write_some(ReadonlyBytes bytes)
+{
+    if (m_finished)
+        return Error::from_string_literal("Tried to write to a finished XZ stream");
+
+    if (bytes.is_empty())
+        return 0;
+
+    if (!m_block_compressor)
+        TRY(start_block());
+
+    auto const processed_bytes = TRY(m_block_compressor->write_some(bytes));
+    m_check.update(bytes.trim(processed_bytes));
+    m_uncompressed_size += processed_bytes;
+    return processed_bytes;
+}
+
+ErrorOr<void> XzCompressor::finish()
+{
+    if (m_finished)
+        return Error::from_string_literal("Finished an XZ stream twice");
+    m_finished = true;
+
+    // 4. Index
+    AllocatingMemoryStream index_stream;
+
+    // 4.1. Index Indicator
+    TRY(index_stream.write_value<u8>(0));
+
+    if (m_block_compressor) {
+        TRY(m_block_compressor->finish());
+
+        // 3.3. Block Padding
+        u64 const unpadded_size_without_check = m_block_header_size + m_block_compressor->compressed_size();
+        for (size_t i = 0; (unpadded_size_without_check + i) % 4 != 0; i++)
+            TRY(m_stream->write_value<u8>(0));
+
+        // 3.4. Check
+        TRY(m_stream->write_value<LittleEndian<u32>>(m_check.digest()));
+
+        // 4.2. Number of Records
+        // 4.3. List of Records
+        TRY(index_stream.write_value(XzMultibyteInteger { 1 }));
+        TRY(index_stream.write_value(XzMultibyteInteger { unpadded_size_without_check + sizeof(u32) }));
+        TRY(index_stream.write_value(XzMultibyteInteger { m_uncompressed_size }));
+    } else {
+        TRY(index_stream.write_value(XzMultibyteInteger { 0 }));
+    }
+
+    // 4.4. Index Padding
+    while (index_stream.used_buffer_size() % 4 != 0)
+        TRY(index_stream.write_value<u8>(0));
+
+    auto index = TRY(index_stream.read_until_eof());
+
+    // 4.5. CRC32
+    TRY(m_stream->write_until_depleted(index));
+    TRY(m_stream->write_value<LittleEndian<u32>>(Crypto::Checksum::CRC32 { index }.digest()));
+
+    // 2.1.2. Stream Footer
+    // "real_backward_size = (stored_backward_size + 1) * 4;"
+    XzStreamFooter footer {
+        .size_and_flags_crc32 = 0,
+        .encoded_backward_size = static_cast<u32>((index.size() + sizeof(u32)) / 4 - 1),
+        .flags = stream_flags,
+        .magic = { 'Y', 'Z' },
+    };
+
+    Crypto::Checksum::CRC32 footer_crc32;
+    footer_crc32.update({ &footer.encoded_backward_size, sizeof(footer.encoded_backward_size) });
+    footer_crc32.update({ &footer.flags, sizeof(footer.flags) });
+    footer.size_and_flags_crc32 = footer_crc32.digest();
+    TRY(m_stream->write_value(footer));
+
+    return {};
+}
+
+bool XzCompressor::is_eof() const
+{
+    return true;
+}
+
+bool XzCompressor::is_open() const
+{
+    return !m_finished;
+}
+
+void XzCompressor::close()
+{
+    if (!m_finished) {
+        // Note: We need a better API for specifying things like this.
+        finish().release_value_but_fixme_should_propagate_errors();
+    }
+}
+
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/CircularBuffer.h>
 #include <AK/ConstrainedStream.h>
 #include <AK/CountingStream.h>
@@ -16,9 +17,13 @@
 #include <AK/OwnPtr.h>
 #include <AK/Stream.h>
 #include <AK/Vector.h>
+#include <LibCompress/Lzma.h>
+#include <LibCrypto/Checksum/CRC32.h>
 
 namespace Compress {
 
+class Lzma2Compressor;
+
 // This implementation is based on the "The .xz File Format" specification version 1.1.0:
 // https://tukaani.org/xz/xz-file-format-1.1.0.txt
 
@@ -35,6 +40,7 @@ public:
     constexpr operator u64() const { return m_value; }
 
     static ErrorOr<XzMultibyteInteger> read_from_stream(Stream& stream);
+    ErrorOr<void> write_to_stream(Stream& stream) const;
 
 private:
     u64 m_value { 0 };
@@ -96,6 +102,9 @@ struct [[gnu::packed]] XzFilterLzma2Properties {
 
     ErrorOr<void> validate() const;
     u32 dictionary_size() const;
+
+    // Returns the properties with the smallest dictionary size that is at least as large as the given one.
+    static XzFilterLzma2Properties for_dictionary_size(u32);
 };
 static_assert(sizeof(XzFilterLzma2Properties) == 1);
 
@@ -156,6 +165,10 @@ class XzDecompressor : public Stream {
 public:
     static ErrorOr<NonnullOwnPtr<XzDecompressor>> create(MaybeOwned<Stream>);
 
+    // Blocks are compressed independently of each other, and the Index of each Stream lists where its Blocks are.
+    // This reads all Indexes up front and decompresses the Blocks on up to thread_count threads.
+    static ErrorOr<ByteBuffer> decompress_all_in_parallel(ReadonlyBytes, size_t thread_count);
+
     virtual ErrorOr<Bytes> read_some(Bytes) override;
     virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
     virtual bool is_eof() const override;
@@ -165,6 +178,15 @@ public:
 private:
     XzDecompressor(NonnullOwnPtr<CountingStream>);
 
+    struct BlockLocation {
+        u64 offset {};
+        u64 unpadded_size {};
+        u64 uncompressed_size {};
+        XzStreamFlags stream_flags {};
+    };
+    static ErrorOr<Vector<BlockLocation>> locate_blocks(ReadonlyBytes);
+    static ErrorOr<void> decompress_block(ReadonlyBytes, BlockLocation const&, Bytes output);
+
     ErrorOr<bool> load_next_stream();
     ErrorOr<void> load_next_block(u8 encoded_block_header_size);
     ErrorOr<void> finish_current_block();
@@ -187,6 +209,41 @@ private:
     Vector<BlockMetadata> m_processed_blocks;
 };
 
+// Writes a single Stream containing a single LZMA2-compressed Block, with a CRC32 check of the uncompressed data.
+class XzCompressor : public Stream {
+public:
+    static ErrorOr<NonnullOwnPtr<XzCompressor>> create(MaybeOwned<Stream>, LzmaCompressorOptions const& = {});
+
+    /// Finishes the stream by writing the end of the Block, the Index and the Stream Footer.
+    ErrorOr<void> finish();
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+
+    virtual ~XzCompressor();
+
+private:
+    static constexpr XzStreamFlags stream_flags { .reserved = 0, .check_type = XzStreamCheckType::CRC32, .reserved_bits = 0 };
+
+    XzCompressor(MaybeOwned<Stream>, LzmaCompressorOptions);
+
+    ErrorOr<void> start_block();
+
+    MaybeOwned<Stream> m_stream;
+    LzmaCompressorOptions m_options;
+
+    // The Block is only started once there is data for it, since an empty Stream does not contain any Blocks.
+    OwnPtr<Lzma2Compressor> m_block_compressor;
+    u64 m_block_header_size { 0 };
+    u64 m_uncompressed_size { 0 };
+    Crypto::Checksum::CRC32 m_check;
+
+    bool m_finished { false };
+};
+
 }
 
 template<>
@@ -203,3 +260,8 @@ template<>
 struct AK::Traits<Compress::XzBlockFlags> : public AK::DefaultTraits<Compress::XzBlockFlags> {
     static constexpr bool is_trivially_serializable() { return true; }
 };
+
+template<>
+struct AK::Traits<Compress::XzFilterLzma2Properties> : public AK::DefaultTraits<Compress::XzFilterLzma2Properties> {
+    static constexpr bool is_trivially_serializable() { return true; }
+};
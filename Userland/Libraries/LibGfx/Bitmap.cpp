@@ -8,11 +8,14 @@
 #include <AK/Bitmap.h>
 #include <AK/ByteString.h>
 #include <AK/Checked.h>
+#include <AK/FixedArray.h>
 #include <AK/LexicalPath.h>
+#include <AK/Math.h>
 #include <AK/Memory.h>
 #include <AK/MemoryStream.h>
 #include <AK/Optional.h>
 #include <AK/Queue.h>
+#include <AK/SIMD.h>
 #include <AK/ScopeGuard.h>
 #include <AK/Try.h>
 #include <LibCore/File.h>
@@ -22,6 +25,7 @@
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibGfx/ShareableBitmap.h>
+#include <LibThreading/Thread.h>
 #include <errno.h>
 #include <stdio.h>
 
@@ -505,6 +509,207 @@ ErrorOr<NonnullRefPtr<Gfx::Bitmap>> Bitmap::scaled_to_size(Gfx::IntSize size) co
     return new_bitmap;
 }
 
+static float lanczos3(float x)
+{
+    x = fabsf(x);
+    if (x < NumericLimits<float>::epsilon())
+        return 1.0f;
+    if (x >= 3.0f)
+        return 0.0f;
+    float pi_x = AK::Pi<float> * x;
+    return 3.0f * sinf(pi_x) * sinf(pi_x / 3.0f) / (pi_x * pi_x);
+}
+
+// The cubic recommended by Mitchell and Netravali, with B = C = 1/3.
+static float mitchell(float x)
+{
+    constexpr float b = 1.0f / 3.0f;
+    constexpr float c = 1.0f / 3.0f;
+    x = fabsf(x);
+    if (x < 1.0f)
+        return ((12 - 9 * b - 6 * c) * x * x * x + (-18 + 12 * b + 6 * c) * x * x + (6 - 2 * b)) / 6;
+    if (x < 2.0f)
+        return ((-b - 6 * c) * x * x * x + (6 * b + 30 * c) * x * x + (-12 * b - 48 * c) * x + (8 * b + 24 * c)) / 6;
+    return 0.0f;
+}
+
+// The source pixels that make up each pixel of a resampled row or column, and how much each of them counts.
+// These only depend on the two lengths, so they're worked out once instead of for every pixel.
+struct ResamplingWeights {
+    struct Contribution {
+        int first_source_index { 0 };
+        int count { 0 };
+        size_t first_weight { 0 };
+    };
+
+    Vector<Contribution> contributions;
+    Vector<float> weights;
+};
+
+static ErrorOr<ResamplingWeights> compute_resampling_weights(int source_length, int destination_length, ResamplingFilter filter)
+{
+    float (*kernel)(float) = nullptr;
+    float radius = 0.0f;
+    switch (filter) {
+    case ResamplingFilter::Lanczos3:
+        kernel = lanczos3;
+        radius = 3.0f;
+        break;
+    case ResamplingFilter::Mitchell:
+        kernel = mitchell;
+        radius = 2.0f;
+        break;
+    }
+
+    // When shrinking, the kernel is stretched to cover every source pixel that falls into a destination pixel.
+    float ratio = static_cast<float>(source_length) / static_cast<float>(destination_length);
+    float kernel_scale = max(ratio, 1.0f);
+    float support = radius * kernel_scale;
+
+    ResamplingWeights result;
+    TRY(result.contributions.try_ensure_capacity(destination_length));
+    TRY(result.weights.try_ensure_capacity(destination_length * (static_cast<size_t>(ceilf(support)) * 2 + 1)));
+
+    for (int i = 0; i < destination_length; ++i) {
+        float center = (static_cast<float>(i) + 0.5f) * ratio;
+        int first = max(0, static_cast<int>(floorf(center - support)));
+        int last = min(source_length - 1, static_cast<int>(ceilf(center + support)));
+
+        ResamplingWeights::Contribution contribution { first, last - first + 1, result.weights.size() };
+        float total = 0.0f;
+        for (int j = first; j <= last; ++j) {
+            float weight = kernel((static_cast<float>(j) + 0.5f - center) / kernel_scale);
+            TRY(result.weights.try_append(weight));
+            total += weight;
+        }
+        // The kernel is cut off at the edges of the bitmap, so the weights that are left must still add up to 1.
+        if (total != 0.0f) {
+            for (int j = 0; j < contribution.count; ++j)
+                result.weights[contribution.first_weight + j] /= total;
+        }
+        result.contributions.unchecked_append(contribution);
+    }
+    return result;
+}
+
+// Splits rows into bands and processes them on as many threads as it's worth using for the given amount of work.
+template<typename Callback>
+static ErrorOr<void> process_rows_in_parallel(int row_count, size_t work_per_row, Callback callback)
+{
+    static constexpr size_t minimum_work_per_thread = 256 * 1024;
+
+    size_t thread_count = min<size_t>(Core::System::hardware_concurrency(), row_count * work_per_row / minimum_work_per_thread);
+    thread_count = min<size_t>(thread_count, row_count);
+    if (thread_count <= 1)
+        return callback(0, row_count);
+
+    struct Band {
+        int first_row { 0 };
+        int end_row { 0 };
+        RefPtr<Threading::Thread> thread {};
+        ErrorOr<void> result {};
+    };
+
+    Vector<Band> bands;
+    TRY(bands.try_ensure_capacity(thread_count));
+    int rows_per_thread = ceil_div(row_count, static_cast<int>(thread_count));
+    for (int first_row = 0; first_row < row_count; first_row += rows_per_thread)
+        bands.unchecked_append({ first_row, min(first_row + rows_per_thread, row_count) });
+
+    // This thread takes the first band itself instead of just waiting.
+    for (auto& band : bands.span().slice(1)) {
+        band.thread = Threading::Thread::construct([&band, &callback] {
+            band.result = callback(band.first_row, band.end_row);
+            return static_cast<intptr_t>(0);
+        },
+            "Resampler"sv);
+        band.thread->start();
+    }
+    bands.first().result = callback(bands.first().first_row, bands.first().end_row);
+
+    for (auto& band : bands.span().slice(1))
+        (void)band.thread->join();
+
+    for (auto& band : bands) {
+        if (band.result.is_error())
+            return band.result.release_error();
+    }
+    return {};
+}
+
+ErrorOr<NonnullRefPtr<Gfx::Bitmap>> Bitmap::scaled_to_size(Gfx::IntSize size, ResamplingFilter filter) const
+{
+    using AK::SIMD::f32x4;
+
+    auto new_bitmap = TRY(Gfx::Bitmap::create(format(), size, scale()));
+
+    auto old_width = physical_width();
+    auto old_height = physical_height();
+    auto new_width = new_bitmap->physical_width();
+    auto new_height = new_bitmap->physical_height();
+
+    auto horizontal_weights = TRY(compute_resampling_weights(old_width, new_width, filter));
+    auto vertical_weights = TRY(compute_resampling_weights(old_height, new_height, filter));
+
+    // Colors are filtered with premultiplied alpha, so that transparent pixels don't bleed their color into their neighbors.
+    auto to_channels = [](Color color) {
+        float alpha = color.alpha() / 255.0f;
+        return f32x4 { color.red() * alpha, color.green() * alpha, color.blue() * alpha, static_cast<float>(color.alpha()) };
+    };
+
+    // First resample every row of the bitmap to the new width...
+    auto intermediate = TRY(FixedArray<f32x4>::create(static_cast<size_t>(old_height) * new_width));
+    TRY(process_rows_in_parallel(old_height, horizontal_weights.weights.size(), [&](int first_row, int end_row) -> ErrorOr<void> {
+        auto source_row = TRY(FixedArray<f32x4>::create(old_width));
+        for (int y = first_row; y < end_row; ++y) {
+            for (int x = 0; x < old_width; ++x)
+                source_row[x] = to_channels(get_pixel(x, y));
+
+            auto* destination_row = intermediate.data() + static_cast<size_t>(y) * new_width;
+            for (int x = 0; x < new_width; ++x) {
+                auto const& contribution = horizontal_weights.contributions[x];
+                auto const* source = source_row.data() + contribution.first_source_index;
+                auto const* weights = horizontal_weights.weights.data() + contribution.first_weight;
+                f32x4 sum {};
+                for (int i = 0; i < contribution.count; ++i)
+                    sum += source[i] * weights[i];
+                destination_row[x] = sum;
+            }
+        }
+        return {};
+    }));
+
+    // ...and then every column of that to the new height, a whole row at a time.
+    TRY(process_rows_in_parallel(new_height, new_width * vertical_weights.weights.size() / new_height, [&](int first_row, int end_row) -> ErrorOr<void> {
+        auto sums = TRY(FixedArray<f32x4>::create(new_width));
+        for (int y = first_row; y < end_row; ++y) {
+            sums.fill_with(f32x4 {});
+            auto const& contribution = vertical_weights.contributions[y];
+            for (int i = 0; i < contribution.count; ++i) {
+                auto const* source_row = intermediate.data() + static_cast<size_t>(contribution.first_source_index + i) * new_width;
+                float weight = vertical_weights.weights[contribution.first_weight + i];
+                for (int x = 0; x < new_width; ++x)
+                    sums[x] += source_row[x] * weight;
+            }
+
+            for (int x = 0; x < new_width; ++x) {
+                // Lanczos and Mitchell both ring, so channels can end up slightly outside of what a color can hold.
+                auto sum = sums[x];
+                float alpha = clamp(sum[3], 0.0f, 255.0f);
+                if (alpha < 0.5f) {
+                    new_bitmap->set_pixel(x, y, Color::Transparent);
+                    continue;
+                }
+                auto channel = [&](float value) { return static_cast<u8>(clamp(value * 255.0f / alpha, 0.0f, 255.0f) + 0.5f); };
+                new_bitmap->set_pixel(x, y, Color(channel(sum[0]), channel(sum[1]), channel(sum[2]), static_cast<u8>(alpha + 0.5f)));
+            }
+        }
+        return {};
+    }));
+
+    return new_bitmap;
+}
+
 ErrorOr<NonnullRefPtr<Gfx::Bitmap>> Bitmap::cropped(Gfx::IntRect crop, Optional<BitmapFormat> new_bitmap_format) const
 {
     auto new_bitmap = TRY(Gfx::Bitmap::create(new_bitmap_format.value_or(format()), { crop.width(), crop.height() }, scale()));
@@ -94,6 +94,13 @@ enum class RotationDirection {
     Clockwise,
 };
 
+// Filters for resampling a whole bitmap to a new size with scaled_to_size().
+// Both are separable, so a bitmap is resampled horizontally and then vertically.
+enum class ResamplingFilter {
+    Lanczos3,
+    Mitchell,
+};
+
 class Bitmap : public RefCounted<Bitmap> {
 public:
     [[nodiscard]] static ErrorOr<NonnullRefPtr<Bitmap>> create(BitmapFormat, IntSize, int intrinsic_scale = 1);
@@ -124,6 +131,7 @@ public:
     ErrorOr<NonnullRefPtr<Gfx::Bitmap>> scaled(int sx, int sy) const;
     ErrorOr<NonnullRefPtr<Gfx::Bitmap>> scaled(float sx, float sy) const;
     ErrorOr<NonnullRefPtr<Gfx::Bitmap>> scaled_to_size(Gfx::IntSize) const;
+    ErrorOr<NonnullRefPtr<Gfx::Bitmap>> scaled_to_size(Gfx::IntSize, ResamplingFilter) const;
     ErrorOr<NonnullRefPtr<Gfx::Bitmap>> cropped(Gfx::IntRect, Optional<BitmapFormat> new_bitmap_format = {}) const;
     ErrorOr<NonnullRefPtr<Gfx::Bitmap>> to_bitmap_backed_by_anonymous_buffer() const;
     [[nodiscard]] ErrorOr<ByteBuffer> serialize_to_byte_buffer() const;
@@ -472,6 +472,10 @@ struct JPEGLoadingContext {
     HashMap<u8, HuffmanTable> ac_tables;
     Array<i16, 4> previous_dc_values {};
     MacroblockMeta mblock_meta;
+
+    // Each 8x8 block of coefficients is decoded to a square of this many pixels per side.
+    // It's smaller than 8 when the image is decoded at 1/2, 1/4 or 1/8 of its size.
+    u8 scaled_block_size { 8 };
     JPEGStream stream;
     JPEGDecoderOptions options;
 
@@ -1421,8 +1425,11 @@ static void dequantize(JPEGLoadingContext& context, Vector<Macroblock>& macroblo
                         u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
                         Macroblock& block = macroblocks[macroblock_index];
                         auto* block_component = get_component(block, i);
-                        for (u32 k = 0; k < 64; k++)
-                            block_component[k] *= table[k];
+                        // Coefficients of frequencies that are too high for the scaled block size are never used.
+                        for (u32 v = 0; v < context.scaled_block_size; v++) {
+                            for (u32 u = 0; u < context.scaled_block_size; u++)
+                                block_component[v * 8 + u] *= table[v * 8 + u];
+                        }
                     }
                 }
             }
@@ -1585,6 +1592,44 @@ static void inverse_dct_8x8(i16* block_component)
     }
 }
 
+// Decoding at 1/2, 1/4 or 1/8 of the size only uses the N×N lowest frequencies of each block, with an N-point IDCT.
+// That gives the values of the 8-point IDCT at the centers of each 8/N×8/N square of pixels, as libjpeg's jidctred.c does.
+// With N = 1, this is just the DC coefficient.
+template<u8 N>
+static void inverse_dct_reduced(i16* block_component)
+{
+    static auto const cosines = [] {
+        Array<float, N * N> cosines {};
+        for (u8 x = 0; x < N; ++x) {
+            for (u8 u = 0; u < N; ++u) {
+                float const scale = u == 0 ? AK::sqrt(0.5f) : 1.0f;
+                cosines[x * N + u] = scale / 2.0f * AK::cos(static_cast<float>((2 * x + 1) * u) * AK::Pi<float> / (2 * N));
+            }
+        }
+        return cosines;
+    }();
+
+    Array<float, N * N> rows {};
+    for (u8 v = 0; v < N; ++v) {
+        for (u8 x = 0; x < N; ++x) {
+            float sum = 0;
+            for (u8 u = 0; u < N; ++u)
+                sum += cosines[x * N + u] * block_component[v * 8 + u];
+            rows[v * N + x] = sum;
+        }
+    }
+
+    // The output is N×N pixels stored row by row, so it only overwrites coefficients that have been read already.
+    for (u8 y = 0; y < N; ++y) {
+        for (u8 x = 0; x < N; ++x) {
+            float sum = 0;
+            for (u8 v = 0; v < N; ++v)
+                sum += cosines[y * N + v] * rows[v * N + x];
+            block_component[y * N + x] = round_to<i16>(sum);
+        }
+    }
+}
+
 static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
 {
     for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
@@ -1596,7 +1641,22 @@ static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& m
                         u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
                         Macroblock& block = macroblocks[macroblock_index];
                         auto* block_component = get_component(block, component_i);
-                        inverse_dct_8x8(block_component);
+                        switch (context.scaled_block_size) {
+                        case 8:
+                            inverse_dct_8x8(block_component);
+                            break;
+                        case 4:
+                            inverse_dct_reduced<4>(block_component);
+                            break;
+                        case 2:
+                            inverse_dct_reduced<2>(block_component);
+                            break;
+                        case 1:
+                            inverse_dct_reduced<1>(block_component);
+                            break;
+                        default:
+                            VERIFY_NOT_REACHED();
+                        }
                     }
                 }
             }
@@ -1606,27 +1666,25 @@ static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& m
     // F.2.1.5 - Inverse DCT (IDCT)
     auto const level_shift = 1 << (context.frame.precision - 1);
     auto const max_value = (1 << context.frame.precision) - 1;
+    u8 const pixel_count = context.scaled_block_size * context.scaled_block_size;
     for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
             for (u8 vfactor_i = 0; vfactor_i < context.sampling_factors.vertical; ++vfactor_i) {
                 for (u8 hfactor_i = 0; hfactor_i < context.sampling_factors.horizontal; ++hfactor_i) {
                     u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hcursor + hfactor_i);
-                    for (u8 i = 0; i < 8; ++i) {
-                        for (u8 j = 0; j < 8; ++j) {
-
-                            // FIXME: This just truncate all coefficients, it's an easy way to support (read hack)
-                            //        12 bits JPEGs without rewriting all color transformations.
-                            auto const clamp_to_8_bits = [&](u16 color) -> u8 {
-                                if (context.frame.precision == 8)
-                                    return static_cast<u8>(color);
-                                return static_cast<u8>(color >> 4);
-                            };
-
-                            macroblocks[mb_index].r[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].r[i * 8 + j] + level_shift, 0, max_value));
-                            macroblocks[mb_index].g[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].g[i * 8 + j] + level_shift, 0, max_value));
-                            macroblocks[mb_index].b[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].b[i * 8 + j] + level_shift, 0, max_value));
-                            macroblocks[mb_index].k[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].k[i * 8 + j] + level_shift, 0, max_value));
-                        }
+                    for (u8 i = 0; i < pixel_count; ++i) {
+                        // FIXME: This just truncate all coefficients, it's an easy way to support (read hack)
+                        //        12 bits JPEGs without rewriting all color transformations.
+                        auto const clamp_to_8_bits = [&](u16 color) -> u8 {
+                            if (context.frame.precision == 8)
+                                return static_cast<u8>(color);
+                            return static_cast<u8>(color >> 4);
+                        };
+
+                        macroblocks[mb_index].r[i] = clamp_to_8_bits(clamp(macroblocks[mb_index].r[i] + level_shift, 0, max_value));
+                        macroblocks[mb_index].g[i] = clamp_to_8_bits(clamp(macroblocks[mb_index].g[i] + level_shift, 0, max_value));
+                        macroblocks[mb_index].b[i] = clamp_to_8_bits(clamp(macroblocks[mb_index].b[i] + level_shift, 0, max_value));
+                        macroblocks[mb_index].k[i] = clamp_to_8_bits(clamp(macroblocks[mb_index].k[i] + level_shift, 0, max_value));
                     }
                 }
             }
@@ -1644,6 +1702,7 @@ static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macrobloc
     // FIXME: Allow more combinations of sampling factors.
     // See https://calendar.perfplanet.com/2015/why-arent-your-images-using-chroma-subsampling/ for
     // subsampling factors visble on the web. In PDF files, YCCK 2111 and 2112 and CMYK 2111 and 2112 are also present.
+    u8 const block_size = context.scaled_block_size;
     for (u32 component_i = 0; component_i < context.components.size(); component_i++) {
         auto& component = context.components[component_i];
         if (component.sampling_factors == context.sampling_factors)
@@ -1661,13 +1720,14 @@ static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macrobloc
                         u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
                         Macroblock& block = macroblocks[macroblock_index];
                         auto* block_component_destination = get_component(block, component_i);
-                        for (u8 i = 7; i < 8; --i) {
-                            for (u8 j = 7; j < 8; --j) {
-                                u8 const pixel = i * 8 + j;
+                        for (u8 i = block_size - 1; i < block_size; --i) {
+                            for (u8 j = block_size - 1; j < block_size; --j) {
+                                u8 const pixel = i * block_size + j;
                                 // The component is 8x8 subsampled 2x2. Upsample its 2x2 4x4 tiles.
-                                u32 const component_pxrow = (i / context.sampling_factors.vertical) + 4 * vfactor_i;
-                                u32 const component_pxcol = (j / context.sampling_factors.horizontal) + 4 * hfactor_i;
-                                u32 const component_pixel = component_pxrow * 8 + component_pxcol;
+                                // When decoding at 1/8 of the size, the single pixel of the component covers all of its blocks.
+                                u32 const component_pxrow = (i / context.sampling_factors.vertical) + (block_size / context.sampling_factors.vertical) * vfactor_i;
+                                u32 const component_pxcol = (j / context.sampling_factors.horizontal) + (block_size / context.sampling_factors.horizontal) * hfactor_i;
+                                u32 const component_pixel = component_pxrow * block_size + component_pxcol;
                                 block_component_destination[pixel] = block_component_source[component_pixel];
                             }
                         }
@@ -1678,16 +1738,17 @@ static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macrobloc
     }
 }
 
-static void ycbcr_to_rgb(Vector<Macroblock>& macroblocks)
+static void ycbcr_to_rgb(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
 {
     // Conversion from YCbCr to RGB isn't specified in the first JPEG specification but in the JFIF extension:
     // See: https://www.itu.int/rec/dologin_pub.asp?lang=f&id=T-REC-T.871-201105-I!!PDF-E&type=items
     // 7 - Conversion to and from RGB
+    u8 const pixel_count = context.scaled_block_size * context.scaled_block_size;
     for (auto& macroblock : macroblocks) {
         auto* y = macroblock.y;
         auto* cb = macroblock.cb;
         auto* cr = macroblock.cr;
-        for (u8 i = 0; i < 64; ++i) {
+        for (u8 i = 0; i < pixel_count; ++i) {
             int r = y[i] + 1.402f * (cr[i] - 128);
             int g = y[i] - 0.3441f * (cb[i] - 128) - 0.7141f * (cr[i] - 128);
             int b = y[i] + 1.772f * (cb[i] - 128);
@@ -1709,8 +1770,9 @@ static void invert_colors_for_adobe_images(JPEGLoadingContext const& context, Ve
     // files: 0 represents 100% ink coverage, rather than 0% ink as you'd expect.
     // This is arguably a bug in Photoshop, but if you need to work with Photoshop
     // CMYK files, you will have to deal with it in your application.
+    u8 const pixel_count = context.scaled_block_size * context.scaled_block_size;
     for (auto& macroblock : macroblocks) {
-        for (u8 i = 0; i < 64; ++i) {
+        for (u8 i = 0; i < pixel_count; ++i) {
             macroblock.r[i] = 255 - macroblock.r[i];
             macroblock.g[i] = 255 - macroblock.g[i];
             macroblock.b[i] = 255 - macroblock.b[i];
@@ -1719,17 +1781,18 @@ static void invert_colors_for_adobe_images(JPEGLoadingContext const& context, Ve
     }
 }
 
-static void ycck_to_cmyk(Vector<Macroblock>& macroblocks)
+static void ycck_to_cmyk(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
 {
     // 7 - Conversions between colour encodings
     // YCCK is obtained from CMYK by converting the CMY channels to YCC channel.
 
     // To convert back into RGB, we only need the 3 first components, which are baseline YCbCr
-    ycbcr_to_rgb(macroblocks);
+    ycbcr_to_rgb(context, macroblocks);
 
     // RGB to CMY, as mentioned in https://www.smcm.iqfr.csic.es/docs/intel/ipp/ipp_manual/IPPI/ippi_ch15/functn_YCCKToCMYK_JPEG.htm#functn_YCCKToCMYK_JPEG
+    u8 const pixel_count = context.scaled_block_size * context.scaled_block_size;
     for (auto& macroblock : macroblocks) {
-        for (u8 i = 0; i < 64; ++i) {
+        for (u8 i = 0; i < pixel_count; ++i) {
             macroblock.r[i] = 255 - macroblock.r[i];
             macroblock.g[i] = 255 - macroblock.g[i];
             macroblock.b[i] = 255 - macroblock.b[i];
@@ -1756,10 +1819,10 @@ static ErrorOr<void> handle_color_transform(JPEGLoadingContext const& context, V
             }
             break;
         case ColorTransform::YCbCr:
-            ycbcr_to_rgb(macroblocks);
+            ycbcr_to_rgb(context, macroblocks);
             break;
         case ColorTransform::YCCK:
-            ycck_to_cmyk(macroblocks);
+            ycck_to_cmyk(context, macroblocks);
             break;
         }
 
@@ -1771,30 +1834,40 @@ static ErrorOr<void> handle_color_transform(JPEGLoadingContext const& context, V
     //      - 3 components means YCbCr
     //      - 4 components means CMYK (Nothing to do here).
     if (context.components.size() == 3)
-        ycbcr_to_rgb(macroblocks);
+        ycbcr_to_rgb(context, macroblocks);
 
     if (context.components.size() == 1) {
         // With Cb and Cr being equal to zero, this function assign the Y
         // value (luminosity) to R, G and B. Providing a proper conversion
         // from grayscale to RGB.
-        ycbcr_to_rgb(macroblocks);
+        ycbcr_to_rgb(context, macroblocks);
     }
 
     return {};
 }
 
-static ErrorOr<void> compose_bitmap(JPEGLoadingContext& context, Vector<Macroblock> const& macroblocks)
+static IntSize scaled_size(JPEGLoadingContext const& context)
 {
-    context.bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, { context.frame.width, context.frame.height }));
+    return {
+        ceil_div(context.frame.width * context.scaled_block_size, 8),
+        ceil_div(context.frame.height * context.scaled_block_size, 8),
+    };
+}
 
-    for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
-        u32 const block_row = y / 8;
-        u32 const pixel_row = y % 8;
-        for (u32 x = 0; x < context.frame.width; x++) {
-            u32 const block_column = x / 8;
+static ErrorOr<void> compose_bitmap(JPEGLoadingContext& context, Vector<Macroblock> const& macroblocks)
+{
+    auto const size = scaled_size(context);
+    u32 const block_size = context.scaled_block_size;
+    context.bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, size));
+
+    for (u32 y = size.height() - 1; y < static_cast<u32>(size.height()); y--) {
+        u32 const block_row = y / block_size;
+        u32 const pixel_row = y % block_size;
+        for (u32 x = 0; x < static_cast<u32>(size.width()); x++) {
+            u32 const block_column = x / block_size;
             auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
-            u32 const pixel_column = x % 8;
-            u32 const pixel_index = pixel_row * 8 + pixel_column;
+            u32 const pixel_column = x % block_size;
+            u32 const pixel_index = pixel_row * block_size + pixel_column;
             Color const color { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index] };
             context.bitmap->set_pixel(x, y, color);
         }
@@ -1808,16 +1881,18 @@ static ErrorOr<void> compose_cmyk_bitmap(JPEGLoadingContext& context, Vector<Mac
     if (context.options.cmyk == JPEGDecoderOptions::CMYK::Normal)
         invert_colors_for_adobe_images(context, macroblocks);
 
-    context.cmyk_bitmap = TRY(Gfx::CMYKBitmap::create_with_size({ context.frame.width, context.frame.height }));
+    auto const size = scaled_size(context);
+    u32 const block_size = context.scaled_block_size;
+    context.cmyk_bitmap = TRY(Gfx::CMYKBitmap::create_with_size(size));
 
-    for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
-        u32 const block_row = y / 8;
-        u32 const pixel_row = y % 8;
-        for (u32 x = 0; x < context.frame.width; x++) {
-            u32 const block_column = x / 8;
+    for (u32 y = size.height() - 1; y < static_cast<u32>(size.height()); y--) {
+        u32 const block_row = y / block_size;
+        u32 const pixel_row = y % block_size;
+        for (u32 x = 0; x < static_cast<u32>(size.width()); x++) {
+            u32 const block_column = x / block_size;
             auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
-            u32 const pixel_column = x % 8;
-            u32 const pixel_index = pixel_row * 8 + pixel_column;
+            u32 const pixel_column = x % block_size;
+            u32 const pixel_index = pixel_row * block_size + pixel_column;
             context.cmyk_bitmap->scanline(y)[x] = { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index], (u8)block.k[pixel_index] };
         }
     }
@@ -1982,8 +2057,20 @@ static ErrorOr<void> decode_jpeg(JPEGLoadingContext& context)
     return {};
 }
 
-JPEGImageDecoderPlugin::JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext> context)
+// Returns the smallest block size at which the decoded image is still at least as big as the ideal size.
+static u8 scaled_block_size_for_ideal_size(JPEGLoadingContext const& context, IntSize ideal_size)
+{
+    for (u8 block_size = 1; block_size < 8; block_size *= 2) {
+        if (ceil_div(context.frame.width * block_size, 8) >= ideal_size.width()
+            && ceil_div(context.frame.height * block_size, 8) >= ideal_size.height())
+            return block_size;
+    }
+    return 8;
+}
+
+JPEGImageDecoderPlugin::JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext> context, ReadonlyBytes data)
     : m_context(move(context))
+    , m_data(data)
 {
 }
 
@@ -2011,12 +2098,34 @@ ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create_with_o
 {
     auto stream = TRY(try_make<FixedMemoryStream>(data));
     auto context = TRY(JPEGLoadingContext::create(move(stream), options));
-    auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) JPEGImageDecoderPlugin(move(context))));
+    auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) JPEGImageDecoderPlugin(move(context), data)));
     TRY(decode_header(*plugin->m_context));
     return plugin;
 }
 
-ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+ErrorOr<void> JPEGImageDecoderPlugin::decode(u8 scaled_block_size)
+{
+    if (m_context->state == JPEGLoadingContext::State::BitmapDecoded) {
+        if (m_context->scaled_block_size >= scaled_block_size)
+            return {};
+
+        // The image was decoded at a smaller size before, and the coefficients weren't kept around. Start over.
+        auto stream = TRY(try_make<FixedMemoryStream>(m_data));
+        auto context = TRY(JPEGLoadingContext::create(move(stream), m_context->options));
+        TRY(decode_header(*context));
+        m_context = move(context);
+    }
+
+    m_context->scaled_block_size = scaled_block_size;
+    if (auto result = decode_jpeg(*m_context); result.is_error()) {
+        m_context->state = JPEGLoadingContext::State::Error;
+        return result.release_error();
+    }
+    m_context->state = JPEGLoadingContext::State::BitmapDecoded;
+    return {};
+}
+
+ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (index > 0)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Invalid frame index");
@@ -2024,13 +2133,8 @@ ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Option
     if (m_context->state == JPEGLoadingContext::State::Error)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
 
-    if (m_context->state < JPEGLoadingContext::State::BitmapDecoded) {
-        if (auto result = decode_jpeg(*m_context); result.is_error()) {
-            m_context->state = JPEGLoadingContext::State::Error;
-            return result.release_error();
-        }
-        m_context->state = JPEGLoadingContext::State::BitmapDecoded;
-    }
+    // The DCT makes it cheap to decode at 1/2, 1/4 or 1/8 of the size, so there's no need to decode more than is wanted.
+    TRY(decode(ideal_size.has_value() ? scaled_block_size_for_ideal_size(*m_context, *ideal_size) : 8));
 
     if (m_context->cmyk_bitmap && !m_context->bitmap)
         return ImageFrameDescriptor { TRY(m_context->cmyk_bitmap->to_low_quality_rgb()), 0 };
@@ -2068,13 +2172,7 @@ ErrorOr<NonnullRefPtr<CMYKBitmap>> JPEGImageDecoderPlugin::cmyk_frame()
 {
     VERIFY(natural_frame_format() == NaturalFrameFormat::CMYK);
 
-    if (m_context->state < JPEGLoadingContext::State::BitmapDecoded) {
-        if (auto result = decode_jpeg(*m_context); result.is_error()) {
-            m_context->state = JPEGLoadingContext::State::Error;
-            return result.release_error();
-        }
-        m_context->state = JPEGLoadingContext::State::BitmapDecoded;
-    }
+    TRY(decode(8));
 
     return *m_context->cmyk_bitmap;
 }
@@ -46,9 +46,12 @@ public:
     virtual ErrorOr<NonnullRefPtr<CMYKBitmap>> cmyk_frame() override;
 
 private:
-    JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext>);
+    JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext>, ReadonlyBytes);
+
+    ErrorOr<void> decode(u8 scaled_block_size);
 
     NonnullOwnPtr<JPEGLoadingContext> m_context;
+    ReadonlyBytes m_data;
 };
 
 }
@@ -16,11 +16,14 @@
 #include "Font/Font.h"
 #include <AK/Assertions.h>
 #include <AK/Debug.h>
+#include <AK/Endian.h>
 #include <AK/Function.h>
 #include <AK/Math.h>
 #include <AK/Memory.h>
 #include <AK/Queue.h>
 #include <AK/QuickSort.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Stack.h>
 #include <AK/StdLibExtras.h>
 #include <AK/StringBuilder.h>
@@ -52,6 +55,61 @@ ALWAYS_INLINE Color get_pixel(Gfx::Bitmap const& bitmap, int x, int y)
     return bitmap.get_pixel(x, y);
 }
 
+ALWAYS_INLINE static AK::SIMD::u32x4 load_pixels(ARGB32 const* pixels)
+{
+    AK::SIMD::u32x4 vector;
+    __builtin_memcpy(&vector, pixels, sizeof(vector));
+    return vector;
+}
+
+ALWAYS_INLINE static void store_pixels(ARGB32* pixels, AK::SIMD::u32x4 vector)
+{
+    __builtin_memcpy(pixels, &vector, sizeof(vector));
+}
+
+// When the destination is opaque, Color::blend() comes down to (destination * (255 - alpha) + source * alpha) / 255
+// for every channel, and the result is opaque as well. That can be done for four pixels at once.
+ALWAYS_INLINE static AK::SIMD::u32x4 blend_onto_opaque_pixels(AK::SIMD::u32x4 destination, AK::SIMD::u32x4 source)
+{
+    auto alpha = source >> 24;
+    auto inverse_alpha = 255 - alpha;
+    auto blend_channel = [&](u32 shift) {
+        auto value = ((destination >> shift) & 0xff) * inverse_alpha + ((source >> shift) & 0xff) * alpha;
+        // This divides by 255, and is exact for everything up to 255 * 255.
+        return ((value + 1 + (value >> 8)) >> 8) << shift;
+    };
+    return blend_channel(0) | blend_channel(8) | blend_channel(16) | 0xff000000;
+}
+
+enum class DestinationIsOpaque {
+    No,
+    Yes,
+};
+
+// Gives the same result as blending every source pixel onto the destination with Color::blend().
+// The source is either a row of pixels (source_step = 1), or a single pixel that is blended everywhere (source_step = 0).
+static void blend_row(ARGB32* destination, ARGB32 const* source, size_t source_step, int count, DestinationIsOpaque destination_is_opaque)
+{
+    auto blend_pixel = [&](int x) {
+        auto destination_color = destination_is_opaque == DestinationIsOpaque::Yes ? Color::from_rgb(destination[x]) : Color::from_argb(destination[x]);
+        destination[x] = destination_color.blend(Color::from_argb(source[x * source_step])).value();
+    };
+
+    int x = 0;
+    for (; x + 4 <= count; x += 4) {
+        auto destination_pixels = load_pixels(destination + x);
+        if (destination_is_opaque == DestinationIsOpaque::No && !AK::SIMD::all(destination_pixels >= 0xff000000)) {
+            for (int i = 0; i < 4; ++i)
+                blend_pixel(x + i);
+            continue;
+        }
+        auto source_pixels = source_step == 0 ? AK::SIMD::expand4(*source) : load_pixels(source + x);
+        store_pixels(destination + x, blend_onto_opaque_pixels(destination_pixels, source_pixels));
+    }
+    for (; x < count; ++x)
+        blend_pixel(x);
+}
+
 Painter::Painter(Gfx::Bitmap& bitmap)
     : m_target(bitmap)
 {
@@ -108,10 +166,10 @@ void Painter::fill_physical_rect(IntRect const& physical_rect, Color color)
     ARGB32* dst = m_target->scanline(physical_rect.top()) + physical_rect.left();
     size_t const dst_skip = m_target->pitch() / sizeof(ARGB32);
 
-    auto dst_format = target()->format();
+    auto destination_is_opaque = target()->format() == BitmapFormat::BGRx8888 ? DestinationIsOpaque::Yes : DestinationIsOpaque::No;
+    ARGB32 const source = color.value();
     for (int i = physical_rect.height() - 1; i >= 0; --i) {
-        for (int j = 0; j < physical_rect.width(); ++j)
-            dst[j] = color_for_format(dst_format, dst[j]).blend(color).value();
+        blend_row(dst, &source, 0, physical_rect.width(), destination_is_opaque);
         dst += dst_skip;
     }
 }
@@ -835,28 +893,32 @@ static void swap_red_and_blue_channels(Color& color)
     color = Color::from_argb(bgra);
 }
 
-// FIXME: This function is very unoptimized.
 template<BlitState::AlphaState has_alpha>
 static void do_blit_with_opacity(BlitState& state)
 {
+    // The alpha that a source pixel ends up with only depends on the alpha it started with.
+    Array<u8, 256> alpha_with_opacity;
+    for (size_t alpha = 0; alpha < alpha_with_opacity.size(); ++alpha) {
+        if constexpr (has_alpha & BlitState::SrcAlpha) {
+            float pixel_opacity = alpha / 255.0;
+            alpha_with_opacity[alpha] = 255 * (state.opacity * pixel_opacity);
+        } else {
+            alpha_with_opacity[alpha] = state.opacity * 255;
+        }
+    }
+
+    auto destination_is_opaque = (has_alpha & BlitState::DstAlpha) ? DestinationIsOpaque::No : DestinationIsOpaque::Yes;
+    Vector<ARGB32> source_row;
+    source_row.resize(state.column_count);
     for (int row = 0; row < state.row_count; ++row) {
         for (int x = 0; x < state.column_count; ++x) {
-            Color dest_color = (has_alpha & BlitState::DstAlpha) ? Color::from_argb(state.dst[x]) : Color::from_rgb(state.dst[x]);
-            if constexpr (has_alpha & BlitState::SrcAlpha) {
-                Color src_color_with_alpha = Color::from_argb(state.src[x]);
-                if (state.src_format == BitmapFormat::RGBA8888)
-                    swap_red_and_blue_channels(src_color_with_alpha);
-                float pixel_opacity = src_color_with_alpha.alpha() / 255.0;
-                src_color_with_alpha.set_alpha(255 * (state.opacity * pixel_opacity));
-                state.dst[x] = dest_color.blend(src_color_with_alpha).value();
-            } else {
-                Color src_color_with_alpha = Color::from_rgb(state.src[x]);
-                if (state.src_format == BitmapFormat::RGBA8888)
-                    swap_red_and_blue_channels(src_color_with_alpha);
-                src_color_with_alpha.set_alpha(state.opacity * 255);
-                state.dst[x] = dest_color.blend(src_color_with_alpha).value();
-            }
+            Color src_color_with_alpha = (has_alpha & BlitState::SrcAlpha) ? Color::from_argb(state.src[x]) : Color::from_rgb(state.src[x]);
+            if (state.src_format == BitmapFormat::RGBA8888)
+                swap_red_and_blue_channels(src_color_with_alpha);
+            src_color_with_alpha.set_alpha(alpha_with_opacity[src_color_with_alpha.alpha()]);
+            source_row[x] = src_color_with_alpha.value();
         }
+        blend_row(state.dst, source_row.data(), 1, state.column_count, destination_is_opaque);
         state.dst += state.dst_pitch;
         state.src += state.src_pitch;
     }
@@ -1107,6 +1169,43 @@ void Painter::blit(IntPoint position, Gfx::Bitmap const& source, IntRect const&
     VERIFY_NOT_REACHED();
 }
 
+// Colors that are being mixed are kept as {red, green, blue, alpha} vectors of floats, so all channels are mixed at once.
+ALWAYS_INLINE static AK::SIMD::f32x4 color_to_channels(Color color)
+{
+    auto bytes = bit_cast<AK::SIMD::u8x4>(AK::convert_between_host_and_little_endian(color.value()));
+    return __builtin_convertvector(__builtin_shufflevector(bytes, bytes, 2, 1, 0, 3), AK::SIMD::f32x4);
+}
+
+ALWAYS_INLINE static Color channels_to_color(AK::SIMD::f32x4 channels)
+{
+    auto bytes = __builtin_convertvector(channels, AK::SIMD::u8x4);
+    return Color::from_argb(AK::convert_between_host_and_little_endian(bit_cast<u32>(__builtin_shufflevector(bytes, bytes, 2, 1, 0, 3))));
+}
+
+// Does the same as Color::mixed_with(). Like round_to(), this rounds halfway cases to even, which adding and subtracting
+// 1.5 * 2^23 does for all the values that channels can have.
+ALWAYS_INLINE static AK::SIMD::f32x4 mix_channels(AK::SIMD::f32x4 first, AK::SIMD::f32x4 second, float weight)
+{
+    auto round = [](AK::SIMD::f32x4 channels) {
+        constexpr float rounding_constant = 12582912.f;
+        return (channels + rounding_constant) - rounding_constant;
+    };
+
+    if (first[3] == second[3] || (first[0] == second[0] && first[1] == second[1] && first[2] == second[2]))
+        return round(first + (second - first) * weight);
+
+    float mixed_alpha = first[3] + (second[3] - first[3]) * weight;
+    // The channels can't be divided by the alpha here, so leave this case to Color::mixed_with().
+    if (mixed_alpha == 0)
+        return color_to_channels(channels_to_color(first).mixed_with(channels_to_color(second), weight));
+
+    auto first_premultiplied = first * first[3];
+    auto second_premultiplied = second * second[3];
+    auto mixed = (first_premultiplied + (second_premultiplied - first_premultiplied) * weight) / mixed_alpha;
+    mixed[3] = mixed_alpha;
+    return round(mixed);
+}
+
 template<bool has_alpha_channel, typename GetPixel>
 ALWAYS_INLINE static void do_draw_integer_scaled_bitmap(Gfx::Bitmap& target, IntRect const& dst_rect, IntRect const& src_rect, Gfx::Bitmap const& source, int hfactor, int vfactor, GetPixel get_pixel, float opacity)
 {
@@ -1139,8 +1238,9 @@ ALWAYS_INLINE static void do_draw_box_sampled_scaled_bitmap(Gfx::Bitmap& target,
     float source_pixel_area = source_pixel_width * source_pixel_height;
     FloatRect const pixel_box = { 0.f, 0.f, 1.f, 1.f };
 
+    Vector<ARGB32> source_row;
+    source_row.resize(clipped_rect.width());
     for (int y = clipped_rect.top(); y < clipped_rect.bottom(); ++y) {
-        auto* scanline = reinterpret_cast<Color*>(target.scanline(y));
         for (int x = clipped_rect.left(); x < clipped_rect.right(); ++x) {
             // Project the destination pixel in the source image
             FloatRect const source_box = {
@@ -1151,11 +1251,8 @@ ALWAYS_INLINE static void do_draw_box_sampled_scaled_bitmap(Gfx::Bitmap& target,
             };
             IntRect enclosing_source_box = enclosing_int_rect(source_box).intersected(source.rect());
 
-            // Sum the contribution of all source pixels inside the projected pixel
-            float red_accumulator = 0.f;
-            float green_accumulator = 0.f;
-            float blue_accumulator = 0.f;
-            float total_area = 0.f;
+            // Sum the contribution of all source pixels inside the projected pixel, as red, green, blue and area.
+            AK::SIMD::f32x4 accumulator {};
             for (int sy = enclosing_source_box.y(); sy < enclosing_source_box.bottom(); ++sy) {
                 for (int sx = enclosing_source_box.x(); sx < enclosing_source_box.right(); ++sx) {
                     float area = source_box.intersected(pixel_box.translated(sx, sy)).size().area();
@@ -1163,25 +1260,26 @@ ALWAYS_INLINE static void do_draw_box_sampled_scaled_bitmap(Gfx::Bitmap& target,
                     auto pixel = get_pixel(source, sx, sy);
                     area *= pixel.alpha() / 255.f;
 
-                    red_accumulator += pixel.red() * area;
-                    green_accumulator += pixel.green() * area;
-                    blue_accumulator += pixel.blue() * area;
-                    total_area += area;
+                    accumulator += AK::SIMD::f32x4 { static_cast<float>(pixel.red()), static_cast<float>(pixel.green()), static_cast<float>(pixel.blue()), 1.f } * area;
                 }
             }
 
+            float total_area = accumulator[3];
+            auto channels = accumulator / total_area;
             Color src_pixel = {
-                round_to<u8>(min(red_accumulator / total_area, 255.f)),
-                round_to<u8>(min(green_accumulator / total_area, 255.f)),
-                round_to<u8>(min(blue_accumulator / total_area, 255.f)),
+                round_to<u8>(min(channels[0], 255.f)),
+                round_to<u8>(min(channels[1], 255.f)),
+                round_to<u8>(min(channels[2], 255.f)),
                 round_to<u8>(min(total_area * 255.f / source_pixel_area * opacity, 255.f)),
             };
-
-            if constexpr (has_alpha_channel)
-                scanline[x] = scanline[x].blend(src_pixel);
-            else
-                scanline[x] = src_pixel;
+            source_row[x - clipped_rect.left()] = src_pixel.value();
         }
+
+        auto* scanline = target.scanline(y) + clipped_rect.left();
+        if constexpr (has_alpha_channel)
+            blend_row(scanline, source_row.data(), 1, clipped_rect.width(), DestinationIsOpaque::No);
+        else
+            __builtin_memcpy(scanline, source_row.data(), source_row.size() * sizeof(ARGB32));
     }
 }
 
@@ -1220,8 +1318,28 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
     i64 src_left = src_rect.left() * shift;
     i64 src_top = src_rect.top() * shift;
 
+    // Which source pixels a destination pixel is blended from is the same for every row.
+    struct BilinearColumn {
+        int x0;
+        int x1;
+        float ratio;
+    };
+    Vector<BilinearColumn> bilinear_columns;
+    if constexpr (scaling_mode == Painter::ScalingMode::BilinearBlend) {
+        bilinear_columns.ensure_capacity(clipped_rect.width());
+        for (int x = clipped_rect.left(); x < clipped_rect.right(); ++x) {
+            auto shifted_x = (x - dst_rect.x()) * hscale + src_left + bilinear_offset_x;
+            bilinear_columns.unchecked_append({
+                .x0 = clamp(static_cast<int>(shifted_x >> 32), clipped_src_rect.left(), clipped_src_rect.right() - 1),
+                .x1 = clamp(static_cast<int>((shifted_x >> 32) + 1), clipped_src_rect.left(), clipped_src_rect.right() - 1),
+                .ratio = (shifted_x & fractional_mask) / static_cast<float>(shift),
+            });
+        }
+    }
+
+    Vector<ARGB32> source_row;
+    source_row.resize(clipped_rect.width());
     for (int y = clipped_rect.top(); y < clipped_rect.bottom(); ++y) {
-        auto* scanline = reinterpret_cast<Color*>(target.scanline(y));
         auto desired_y = (y - dst_rect.y()) * vscale + src_top;
 
         for (int x = clipped_rect.left(); x < clipped_rect.right(); ++x) {
@@ -1229,26 +1347,23 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
 
             Color src_pixel;
             if constexpr (scaling_mode == Painter::ScalingMode::BilinearBlend) {
-                auto shifted_x = desired_x + bilinear_offset_x;
                 auto shifted_y = desired_y + bilinear_offset_y;
 
-                auto scaled_x0 = clamp(shifted_x >> 32, clipped_src_rect.left(), clipped_src_rect.right() - 1);
-                auto scaled_x1 = clamp((shifted_x >> 32) + 1, clipped_src_rect.left(), clipped_src_rect.right() - 1);
+                auto& column = bilinear_columns[x - clipped_rect.left()];
                 auto scaled_y0 = clamp(shifted_y >> 32, clipped_src_rect.top(), clipped_src_rect.bottom() - 1);
                 auto scaled_y1 = clamp((shifted_y >> 32) + 1, clipped_src_rect.top(), clipped_src_rect.bottom() - 1);
 
-                float x_ratio = (shifted_x & fractional_mask) / static_cast<float>(shift);
                 float y_ratio = (shifted_y & fractional_mask) / static_cast<float>(shift);
 
-                auto top_left = get_pixel(source, scaled_x0, scaled_y0);
-                auto top_right = get_pixel(source, scaled_x1, scaled_y0);
-                auto bottom_left = get_pixel(source, scaled_x0, scaled_y1);
-                auto bottom_right = get_pixel(source, scaled_x1, scaled_y1);
+                auto top_left = color_to_channels(get_pixel(source, column.x0, scaled_y0));
+                auto top_right = color_to_channels(get_pixel(source, column.x1, scaled_y0));
+                auto bottom_left = color_to_channels(get_pixel(source, column.x0, scaled_y1));
+                auto bottom_right = color_to_channels(get_pixel(source, column.x1, scaled_y1));
 
-                auto top = top_left.mixed_with(top_right, x_ratio);
-                auto bottom = bottom_left.mixed_with(bottom_right, x_ratio);
+                auto top = mix_channels(top_left, top_right, column.ratio);
+                auto bottom = mix_channels(bottom_left, bottom_right, column.ratio);
 
-                src_pixel = top.mixed_with(bottom, y_ratio);
+                src_pixel = channels_to_color(mix_channels(top, bottom, y_ratio));
             } else if constexpr (scaling_mode == Painter::ScalingMode::SmoothPixels) {
                 auto scaled_x1 = clamp(desired_x >> 32, clipped_src_rect.left(), clipped_src_rect.right() - 1);
                 auto scaled_x0 = clamp(scaled_x1 - 1, clipped_src_rect.left(), clipped_src_rect.right() - 1);
@@ -1279,11 +1394,14 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
             if (has_opacity)
                 src_pixel.set_alpha(src_pixel.alpha() * opacity);
 
-            if constexpr (has_alpha_channel)
-                scanline[x] = scanline[x].blend(src_pixel);
-            else
-                scanline[x] = src_pixel;
+            source_row[x - clipped_rect.left()] = src_pixel.value();
         }
+
+        auto* scanline = target.scanline(y) + clipped_rect.left();
+        if constexpr (has_alpha_channel)
+            blend_row(scanline, source_row.data(), 1, clipped_rect.width(), DestinationIsOpaque::No);
+        else
+            __builtin_memcpy(scanline, source_row.data(), source_row.size() * sizeof(ARGB32));
     }
 }
 
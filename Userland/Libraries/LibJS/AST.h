@@ -102,6 +102,10 @@ public:
 protected:
     explicit ASTNode(SourceRange);
 
+    // Nodes that bytecode can refer to call these, so that cached bytecode can find them. See SourceCode::enable_node_index().
+    void add_to_node_index() const { m_source_code->add_to_node_index({}, *this); }
+    void remove_from_node_index() const { m_source_code->remove_from_node_index({}, *this); }
+
 private:
     // NOTE: These members are carefully ordered so that `m_start_offset` is packed with the padding after RefCounted::m_ref_count.
     //       This creates a 4-byte padding hole after `m_end_offset` which is used to pack subclasses better.
@@ -331,10 +335,16 @@ public:
         return index;
     }
 
+    virtual ~ScopeNode() override
+    {
+        remove_from_node_index();
+    }
+
 protected:
     explicit ScopeNode(SourceRange source_range)
         : Statement(move(source_range))
     {
+        add_to_node_index();
     }
 
 private:
@@ -782,6 +792,12 @@ public:
         : Expression(move(source_range))
         , FunctionNode(move(name), move(source_text), move(body), move(parameters), function_length, kind, is_strict_mode, might_need_arguments_object, contains_direct_call_to_eval, is_arrow_function, move(local_variables_names), uses_this)
     {
+        add_to_node_index();
+    }
+
+    virtual ~FunctionExpression() override
+    {
+        remove_from_node_index();
     }
 
     virtual void dump(int indent) const override;
@@ -1416,6 +1432,12 @@ public:
         , m_super_class(move(super_class))
         , m_elements(move(elements))
     {
+        add_to_node_index();
+    }
+
+    virtual ~ClassExpression() override
+    {
+        remove_from_node_index();
     }
 
     StringView name() const { return m_name ? m_name->string().view() : ""sv; }
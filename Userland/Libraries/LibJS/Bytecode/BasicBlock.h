@@ -13,6 +13,12 @@
 
 namespace JS::Bytecode {
 
+class InstructionStreamRewriter;
+
+namespace Passes {
+class EliminateUnreachableBlocks;
+}
+
 struct UnwindInfo {
     JS::GCPtr<Executable const> executable;
     JS::GCPtr<Environment> lexical_environment;
@@ -24,9 +30,15 @@ class BasicBlock {
     AK_MAKE_NONCOPYABLE(BasicBlock);
 
 public:
-    static NonnullOwnPtr<BasicBlock> create(String name);
+    static NonnullOwnPtr<BasicBlock> create(u32 index, String name);
     ~BasicBlock();
 
+    // The position of this block in its executable. Blocks are numbered in the order they are created in, so a jump to a
+    // block with a lower or equal index is (most likely) the back edge of a loop. Removing unreachable blocks renumbers
+    // the remaining ones, but never reorders them.
+    u32 index() const { return m_index; }
+    void set_index(Badge<Passes::EliminateUnreachableBlocks>, u32 index) { m_index = index; }
+
     void dump(Executable const&) const;
     ReadonlyBytes instruction_stream() const { return m_buffer.span(); }
     u8* data() { return m_buffer.data(); }
@@ -35,6 +47,9 @@ public:
 
     void grow(size_t additional_size);
 
+    // NOTE: The instructions in the old stream are not destroyed, the rewriter has already moved or destroyed all of them.
+    void set_instruction_stream(Badge<InstructionStreamRewriter>, Vector<u8> buffer) { m_buffer = move(buffer); }
+
     void terminate(Badge<Generator>) { m_terminated = true; }
     bool is_terminated() const { return m_terminated; }
 
@@ -47,8 +62,9 @@ public:
     BasicBlock const* finalizer() const { return m_finalizer; }
 
 private:
-    explicit BasicBlock(String name);
+    BasicBlock(u32 index, String name);
 
+    u32 m_index { 0 };
     Vector<u8> m_buffer;
     BasicBlock const* m_handler { nullptr };
     BasicBlock const* m_finalizer { nullptr };
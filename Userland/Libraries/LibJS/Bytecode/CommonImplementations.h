@@ -142,16 +142,24 @@ inline ThrowCompletionOr<Value> get_by_value(VM& vm, Optional<DeprecatedFlyStrin
         auto& object = base_value.as_object();
         auto index = static_cast<u32>(property_key_value.as_i32());
 
-        auto const* object_storage = object.indexed_properties().storage();
+        auto const* object_storage = static_cast<Object const&>(object).indexed_properties().storage();
 
         // For "non-typed arrays":
         if (!object.may_interfere_with_indexed_property_access()
             && object_storage) {
-            auto maybe_value = object_storage->get(index);
-            if (maybe_value.has_value()) {
-                auto value = maybe_value->value;
-                if (!value.is_accessor())
+            if (object_storage->is_simple_storage()) {
+                auto const& storage = static_cast<SimpleIndexedPropertyStorage const&>(*object_storage);
+                auto value = storage.element_at(index);
+                // Arrays of numbers can't hold accessors.
+                if (!value.is_empty() && (storage.holds_only_numbers() || !value.is_accessor()))
                     return value;
+            } else {
+                auto maybe_value = object_storage->get(index);
+                if (maybe_value.has_value()) {
+                    auto value = maybe_value->value;
+                    if (!value.is_accessor())
+                        return value;
+                }
             }
         }
 
@@ -428,13 +436,11 @@ inline ThrowCompletionOr<void> put_by_value(VM& vm, Value base, Optional<Depreca
         if (storage
             && storage->is_simple_storage()
             && !object.may_interfere_with_indexed_property_access()) {
-            auto maybe_value = storage->get(index);
-            if (maybe_value.has_value()) {
-                auto existing_value = maybe_value->value;
-                if (!existing_value.is_accessor()) {
-                    storage->put(index, value);
-                    return {};
-                }
+            auto& simple_storage = static_cast<SimpleIndexedPropertyStorage&>(*storage);
+            auto existing_value = simple_storage.element_at(index);
+            if (!existing_value.is_empty() && (simple_storage.holds_only_numbers() || !existing_value.is_accessor())) {
+                simple_storage.overwrite_element(index, value);
+                return {};
             }
         }
 
@@ -71,6 +71,12 @@ public:
     size_t number_of_registers { 0 };
     bool is_strict_mode { false };
 
+    // These are used to decide when this executable is hot enough to be compiled to native code.
+    u32 invocation_count { 0 };
+    u32 back_edge_count { 0 };
+    bool did_try_jit_compilation { false };
+    OwnPtr<JIT::NativeExecutable> native_executable;
+
     ByteString const& get_string(StringTableIndex index) const { return string_table->get(index); }
     DeprecatedFlyString const& get_identifier(IdentifierTableIndex index) const { return identifier_table->get(index); }
 
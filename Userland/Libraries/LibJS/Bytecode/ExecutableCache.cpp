@@ -0,0 +1,527 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/HashMap.h>
+#include <AK/MemoryStream.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
+#include <LibCore/System.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/RegexTable.h>
+#include <LibJS/Heap/MarkedVector.h>
+#include <LibJS/Runtime/BigInt.h>
+#include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/SourceCode.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace JS::Bytecode {
+
+static constexpr u32 cache_file_magic = 0x43424a4c; // "LJBC"
+
+// Bump this whenever the layout of an instruction changes without changing its size, or when this file format changes.
+static constexpr u64 cache_format_version = 1;
+
+static constexpr u64 cache_format_fingerprint()
+{
+    u64 fingerprint = cache_format_version;
+    auto mix = [&](u64 value) { fingerprint = (fingerprint ^ value) * 0x100000001b3; };
+#define __BYTECODE_OP(op) mix(sizeof(Op::op));
+    ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    mix(sizeof(Value));
+    mix(sizeof(Operand));
+    mix(sizeof(Label));
+    mix(sizeof(Instruction));
+    return fingerprint;
+}
+
+static constexpr size_t number_of_instruction_types = 0
+#define __BYTECODE_OP(op) +1
+    ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    ;
+
+// Labels are stored as block indices, and patched back into pointers when loading.
+static_assert(sizeof(Label) == sizeof(BasicBlock const*));
+
+enum class ConstantTag : u8 {
+    NonCellValue,
+    String,
+    BigInt,
+};
+
+enum class NodeKind : u8 {
+    FunctionExpression,
+    ClassExpression,
+    ScopeNode,
+};
+
+struct NodeReference {
+    NodeKind kind;
+    u32 start_offset;
+    u32 end_offset;
+};
+
+static bool is_node_of_kind(ASTNode const& node, NodeKind kind)
+{
+    switch (kind) {
+    case NodeKind::FunctionExpression:
+        return node.is_function_expression();
+    case NodeKind::ClassExpression:
+        return node.is_class_expression();
+    case NodeKind::ScopeNode:
+        return node.is_scope_node();
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static ASTNode const* find_node(SourceCode const& source_code, NodeReference const& reference)
+{
+    ASTNode const* found_node = nullptr;
+    for (auto const* node : source_code.indexed_nodes_starting_at(reference.start_offset)) {
+        if (node->end_offset() != reference.end_offset || !is_node_of_kind(*node, reference.kind))
+            continue;
+        // Nodes of the same kind with the same source range can't be told apart, so don't pick either of them.
+        if (found_node)
+            return nullptr;
+        found_node = node;
+    }
+    return found_node;
+}
+
+static bool is_valid_instruction_stream(ReadonlyBytes bytes)
+{
+    size_t offset = 0;
+    while (offset < bytes.size()) {
+        if (bytes.size() - offset < sizeof(Instruction))
+            return false;
+        auto const& instruction = *reinterpret_cast<Instruction const*>(bytes.offset_pointer(offset));
+        if (static_cast<size_t>(to_underlying(instruction.type())) >= number_of_instruction_types)
+            return false;
+        if (instruction.length() < sizeof(Instruction) || instruction.length() > bytes.size() - offset)
+            return false;
+        offset += instruction.length();
+    }
+    return true;
+}
+
+static ErrorOr<void> write_string(Stream& stream, StringView string)
+{
+    TRY(stream.write_value<u32>(string.length()));
+    TRY(stream.write_until_depleted(string.bytes()));
+    return {};
+}
+
+static ErrorOr<StringView> read_string(FixedMemoryStream& stream)
+{
+    auto length = TRY(stream.read_value<u32>());
+    auto bytes = TRY(stream.read_in_place<u8 const>(length));
+    return StringView { bytes };
+}
+
+ExecutableCache* ExecutableCache::the()
+{
+    static OwnPtr<ExecutableCache> s_the = []() -> OwnPtr<ExecutableCache> {
+        auto const* directory = getenv("LIBJS_BYTECODE_CACHE");
+        if (!directory || !*directory)
+            return nullptr;
+        if (auto result = Core::Directory::create(ByteString { directory }, Core::Directory::CreateDirectories::Yes); result.is_error()) {
+            dbgln("Not using bytecode cache directory {}: {}", directory, result.error());
+            return nullptr;
+        }
+        return adopt_own(*new ExecutableCache(directory));
+    }();
+    return s_the.ptr();
+}
+
+ExecutableCache::ExecutableCache(ByteString directory)
+    : m_directory(move(directory))
+{
+}
+
+ByteString ExecutableCache::path_for(ASTNode const& node, FunctionKind kind) const
+{
+    auto const& source_code = node.source_code();
+    return ByteString::formatted("{}/{}-{}-{}-{}-{}-{}.bytecode",
+        m_directory,
+        source_code.content_hash(),
+        source_code.is_indexed_as_module() ? "module"sv : "script"sv,
+        node.is_program() ? "program"sv : "function"sv,
+        node.start_offset(),
+        node.end_offset(),
+        to_underlying(kind));
+}
+
+GCPtr<Executable> ExecutableCache::load(VM& vm, ASTNode const& node, FunctionKind kind)
+{
+    if (!node.source_code().has_node_index())
+        return nullptr;
+    auto executable = try_load(vm, node, kind);
+    if (executable.is_error()) {
+        dbgln_if(JS_BYTECODE_DEBUG, "Bytecode cache miss for {}: {}", path_for(node, kind), executable.error());
+        return nullptr;
+    }
+    return executable.release_value();
+}
+
+void ExecutableCache::store(Executable const& executable, ASTNode const& node, FunctionKind kind)
+{
+    if (!node.source_code().has_node_index())
+        return;
+    if (auto result = try_store(executable, node, kind); result.is_error())
+        dbgln_if(JS_BYTECODE_DEBUG, "Not caching bytecode for {}: {}", path_for(node, kind), result.error());
+}
+
+ErrorOr<void> ExecutableCache::try_store(Executable const& executable, ASTNode const& node, FunctionKind kind)
+{
+    auto const& source_code = node.source_code();
+
+    HashMap<BasicBlock const*, u32> block_indices;
+    for (size_t i = 0; i < executable.basic_blocks.size(); ++i)
+        block_indices.set(executable.basic_blocks[i].ptr(), i);
+
+    auto block_index = [&](BasicBlock const* block) -> i32 {
+        if (!block)
+            return -1;
+        return static_cast<i32>(block_indices.get(block).value());
+    };
+
+    // First make sure that everything the instructions refer to can be found again when loading.
+    Vector<Vector<u32>> label_targets_per_block;
+    Vector<Vector<NodeReference>> node_references_per_block;
+    for (auto const& block : executable.basic_blocks) {
+        Vector<u32> label_targets;
+        Vector<NodeReference> node_references;
+
+        auto add_node_reference = [&](ASTNode const& referenced_node, NodeKind node_kind) -> ErrorOr<void> {
+            NodeReference reference { node_kind, referenced_node.start_offset(), referenced_node.end_offset() };
+            if (&referenced_node.source_code() != &source_code || find_node(source_code, reference) != &referenced_node)
+                return AK::Error::from_string_literal("Instruction refers to an AST node that can't be found by its offsets");
+            node_references.append(reference);
+            return {};
+        };
+
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            auto const& instruction = *it;
+            const_cast<Instruction&>(instruction).visit_labels([&](Label& label) {
+                label_targets.append(block_index(&label.block()));
+            });
+
+            switch (instruction.type()) {
+            case Instruction::Type::NewFunction:
+                TRY(add_node_reference(static_cast<Op::NewFunction const&>(instruction).function_node(), NodeKind::FunctionExpression));
+                break;
+            case Instruction::Type::NewClass:
+                TRY(add_node_reference(static_cast<Op::NewClass const&>(instruction).class_expression(), NodeKind::ClassExpression));
+                break;
+            case Instruction::Type::BlockDeclarationInstantiation:
+                TRY(add_node_reference(static_cast<Op::BlockDeclarationInstantiation const&>(instruction).scope_node(), NodeKind::ScopeNode));
+                break;
+            case Instruction::Type::NewPrimitiveArray:
+                for (auto value : static_cast<Op::NewPrimitiveArray const&>(instruction).elements()) {
+                    if (value.is_cell())
+                        return AK::Error::from_string_literal("NewPrimitiveArray with a cell element");
+                }
+                break;
+            case Instruction::Type::IteratorClose:
+            case Instruction::Type::AsyncIteratorClose: {
+                auto const& completion_value = instruction.type() == Instruction::Type::IteratorClose
+                    ? static_cast<Op::IteratorClose const&>(instruction).completion_value()
+                    : static_cast<Op::AsyncIteratorClose const&>(instruction).completion_value();
+                if (completion_value.has_value() && completion_value->is_cell())
+                    return AK::Error::from_string_literal("Iterator close with a cell completion value");
+                break;
+            }
+            case Instruction::Type::Dump:
+                return AK::Error::from_string_literal("Dump instructions point into the program image");
+            default:
+                break;
+            }
+        }
+
+        label_targets_per_block.append(move(label_targets));
+        node_references_per_block.append(move(node_references));
+    }
+
+    for (auto constant : executable.constants) {
+        if (!constant.is_cell() || constant.is_bigint())
+            continue;
+        if (!constant.is_string() || !(constant.as_string().has_byte_string() || constant.as_string().has_utf8_string()))
+            return AK::Error::from_string_literal("Constant can't be serialized");
+    }
+
+    // Write to a temporary file first, so that nobody can load a partially written executable.
+    auto path = path_for(node, kind);
+    auto temporary_path = ByteString::formatted("{}.{}.tmp", path, getpid());
+    auto file = TRY(Core::OutputBufferedFile::create(TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate))));
+
+    TRY(file->write_value(cache_file_magic));
+    TRY(file->write_value(cache_format_fingerprint()));
+
+    TRY(file->write_value<u8>(executable.is_strict_mode));
+    TRY(file->write_value<u32>(executable.number_of_registers));
+    TRY(file->write_value<u32>(executable.property_lookup_caches.size()));
+    TRY(file->write_value<u32>(executable.global_variable_caches.size()));
+    TRY(file->write_value<u32>(executable.environment_variable_caches.size()));
+
+    TRY(file->write_value<u32>(executable.identifier_table->size()));
+    for (size_t i = 0; i < executable.identifier_table->size(); ++i)
+        TRY(write_string(*file, executable.identifier_table->get(i)));
+
+    TRY(file->write_value<u32>(executable.string_table->size()));
+    for (size_t i = 0; i < executable.string_table->size(); ++i)
+        TRY(write_string(*file, executable.string_table->get(i)));
+
+    TRY(file->write_value<u32>(executable.regex_table->size()));
+    for (size_t i = 0; i < executable.regex_table->size(); ++i) {
+        auto const& regex = executable.regex_table->get(i);
+        TRY(write_string(*file, regex.pattern));
+        TRY(file->write_value(to_underlying(regex.flags.value())));
+    }
+
+    TRY(file->write_value<u32>(executable.constants.size()));
+    for (auto constant : executable.constants) {
+        if (!constant.is_cell()) {
+            TRY(file->write_value(ConstantTag::NonCellValue));
+            TRY(file->write_value(constant.encoded()));
+        } else if (constant.is_bigint()) {
+            TRY(file->write_value(ConstantTag::BigInt));
+            TRY(write_string(*file, constant.as_bigint().big_integer().to_base_deprecated(10)));
+        } else {
+            auto const& string = constant.as_string();
+            TRY(file->write_value(ConstantTag::String));
+            if (string.has_byte_string())
+                TRY(write_string(*file, string.byte_string()));
+            else
+                TRY(write_string(*file, string.utf8_string_view()));
+        }
+    }
+
+    TRY(file->write_value<u32>(executable.basic_blocks.size()));
+    for (size_t i = 0; i < executable.basic_blocks.size(); ++i) {
+        auto const& block = *executable.basic_blocks[i];
+        TRY(write_string(*file, block.name()));
+        TRY(file->write_value(block_index(block.handler())));
+        TRY(file->write_value(block_index(block.finalizer())));
+
+        TRY(file->write_value<u32>(block.size()));
+        TRY(file->write_until_depleted(block.instruction_stream()));
+
+        TRY(file->write_value<u32>(label_targets_per_block[i].size()));
+        for (auto target : label_targets_per_block[i])
+            TRY(file->write_value(target));
+
+        TRY(file->write_value<u32>(node_references_per_block[i].size()));
+        for (auto const& reference : node_references_per_block[i]) {
+            TRY(file->write_value(reference.kind));
+            TRY(file->write_value(reference.start_offset));
+            TRY(file->write_value(reference.end_offset));
+        }
+    }
+
+    TRY(file->flush_buffer());
+    file->close();
+    TRY(Core::System::rename(temporary_path, path));
+    return {};
+}
+
+ErrorOr<NonnullGCPtr<Executable>> ExecutableCache::try_load(VM& vm, ASTNode const& node, FunctionKind kind)
+{
+    auto const& source_code = node.source_code();
+
+    auto mapped_file = TRY(Core::MappedFile::map(path_for(node, kind)));
+    FixedMemoryStream stream { mapped_file->bytes() };
+
+    if (TRY(stream.read_value<u32>()) != cache_file_magic || TRY(stream.read_value<u64>()) != cache_format_fingerprint())
+        return AK::Error::from_string_literal("Cache file is from a different bytecode format");
+
+    bool is_strict_mode = TRY(stream.read_value<u8>());
+    auto number_of_registers = TRY(stream.read_value<u32>());
+    auto number_of_property_lookup_caches = TRY(stream.read_value<u32>());
+    auto number_of_global_variable_caches = TRY(stream.read_value<u32>());
+    auto number_of_environment_variable_caches = TRY(stream.read_value<u32>());
+
+    auto identifier_table = make<IdentifierTable>();
+    for (auto count = TRY(stream.read_value<u32>()); count > 0; --count)
+        identifier_table->insert(TRY(read_string(stream)));
+
+    auto string_table = make<StringTable>();
+    for (auto count = TRY(stream.read_value<u32>()); count > 0; --count)
+        string_table->insert(TRY(read_string(stream)));
+
+    auto regex_table = make<RegexTable>();
+    for (auto count = TRY(stream.read_value<u32>()); count > 0; --count) {
+        ByteString pattern = TRY(read_string(stream));
+        regex::RegexOptions<ECMAScriptFlags> flags { static_cast<ECMAScriptFlags>(TRY(stream.read_value<regex::FlagsUnderlyingType>())) };
+        auto parsed_regex = Regex<ECMA262>::parse_pattern(pattern, flags);
+        regex_table->insert(ParsedRegex { move(parsed_regex), move(pattern), flags });
+    }
+
+    MarkedVector<Value> constants(vm.heap());
+    for (auto count = TRY(stream.read_value<u32>()); count > 0; --count) {
+        switch (TRY(stream.read_value<ConstantTag>())) {
+        case ConstantTag::NonCellValue: {
+            auto value = bit_cast<Value>(TRY(stream.read_value<u64>()));
+            if (value.is_cell())
+                return AK::Error::from_string_literal("Unexpected cell constant");
+            constants.append(value);
+            break;
+        }
+        case ConstantTag::String:
+            constants.append(PrimitiveString::create(vm, ByteString { TRY(read_string(stream)) }));
+            break;
+        case ConstantTag::BigInt:
+            constants.append(BigInt::create(vm, TRY(Crypto::SignedBigInteger::from_base(10, TRY(read_string(stream))))));
+            break;
+        default:
+            return AK::Error::from_string_literal("Unknown constant tag");
+        }
+    }
+
+    struct BlockRelocations {
+        i32 handler { -1 };
+        i32 finalizer { -1 };
+        Vector<u32> label_targets;
+        Vector<NodeReference> node_references;
+    };
+
+    auto block_count = TRY(stream.read_value<u32>());
+    Vector<NonnullOwnPtr<BasicBlock>> basic_blocks;
+    Vector<BlockRelocations> relocations;
+    TRY(basic_blocks.try_ensure_capacity(block_count));
+    TRY(relocations.try_ensure_capacity(block_count));
+
+    for (u32 i = 0; i < block_count; ++i) {
+        auto name = TRY(String::from_utf8(TRY(read_string(stream))));
+        BlockRelocations block_relocations;
+        block_relocations.handler = TRY(stream.read_value<i32>());
+        block_relocations.finalizer = TRY(stream.read_value<i32>());
+
+        // Check the instruction stream before handing it to a BasicBlock, which walks it to destroy the instructions.
+        auto instruction_stream = TRY(stream.read_in_place<u8 const>(TRY(stream.read_value<u32>())));
+        Vector<u8> aligned_instruction_stream;
+        TRY(aligned_instruction_stream.try_append(instruction_stream.data(), instruction_stream.size()));
+        if (!is_valid_instruction_stream(aligned_instruction_stream))
+            return AK::Error::from_string_literal("Invalid instruction stream");
+
+        auto block = BasicBlock::create(i, move(name));
+        block->grow(aligned_instruction_stream.size());
+        memcpy(block->data(), aligned_instruction_stream.data(), aligned_instruction_stream.size());
+
+        for (auto count = TRY(stream.read_value<u32>()); count > 0; --count) {
+            auto target = TRY(stream.read_value<u32>());
+            if (target >= block_count)
+                return AK::Error::from_string_literal("Label refers to a block that doesn't exist");
+            block_relocations.label_targets.append(target);
+        }
+        for (auto count = TRY(stream.read_value<u32>()); count > 0; --count) {
+            NodeReference reference;
+            reference.kind = TRY(stream.read_value<NodeKind>());
+            reference.start_offset = TRY(stream.read_value<u32>());
+            reference.end_offset = TRY(stream.read_value<u32>());
+            block_relocations.node_references.append(reference);
+        }
+
+        basic_blocks.unchecked_append(move(block));
+        relocations.unchecked_append(move(block_relocations));
+    }
+
+    auto block_at = [&](i32 index) -> ErrorOr<BasicBlock const*> {
+        if (index < 0)
+            return nullptr;
+        if (static_cast<u32>(index) >= block_count)
+            return AK::Error::from_string_literal("Block index out of range");
+        return basic_blocks[index].ptr();
+    };
+
+    // Point labels back at the blocks, and the instructions that refer to AST nodes at the nodes of the fresh parse.
+    for (size_t i = 0; i < basic_blocks.size(); ++i) {
+        auto& block = *basic_blocks[i];
+        auto const& block_relocations = relocations[i];
+
+        if (auto const* handler = TRY(block_at(block_relocations.handler)))
+            block.set_handler(*handler);
+        if (auto const* finalizer = TRY(block_at(block_relocations.finalizer)))
+            block.set_finalizer(*finalizer);
+
+        size_t next_label = 0;
+        size_t next_node_reference = 0;
+        auto take_node = [&]() -> ErrorOr<ASTNode const*> {
+            if (next_node_reference >= block_relocations.node_references.size())
+                return AK::Error::from_string_literal("Missing AST node reference");
+            auto const* referenced_node = find_node(source_code, block_relocations.node_references[next_node_reference++]);
+            if (!referenced_node)
+                return AK::Error::from_string_literal("AST node not found");
+            return referenced_node;
+        };
+
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+            auto& instruction = const_cast<Instruction&>(*it);
+
+            bool has_all_labels = true;
+            instruction.visit_labels([&](Label& label) {
+                if (next_label >= block_relocations.label_targets.size()) {
+                    has_all_labels = false;
+                    return;
+                }
+                label = Label { *basic_blocks[block_relocations.label_targets[next_label++]] };
+            });
+            if (!has_all_labels)
+                return AK::Error::from_string_literal("Missing label");
+
+            auto source_record = instruction.source_record();
+            switch (instruction.type()) {
+            case Instruction::Type::NewFunction: {
+                auto& new_function = static_cast<Op::NewFunction&>(instruction);
+                auto const& function_node = static_cast<FunctionExpression const&>(*TRY(take_node()));
+                new (&new_function) Op::NewFunction(new_function.dst(), function_node, new_function.lhs_name(), new_function.home_object());
+                break;
+            }
+            case Instruction::Type::NewClass: {
+                auto& new_class = static_cast<Op::NewClass&>(instruction);
+                auto const& class_expression = static_cast<ClassExpression const&>(*TRY(take_node()));
+                new (&new_class) Op::NewClass(new_class.dst(), new_class.super_class(), class_expression, new_class.lhs_name());
+                break;
+            }
+            case Instruction::Type::BlockDeclarationInstantiation: {
+                auto const& scope_node = static_cast<ScopeNode const&>(*TRY(take_node()));
+                new (&instruction) Op::BlockDeclarationInstantiation(scope_node);
+                break;
+            }
+            default:
+                break;
+            }
+            instruction.set_source_record(source_record);
+        }
+
+        if (next_label != block_relocations.label_targets.size() || next_node_reference != block_relocations.node_references.size())
+            return AK::Error::from_string_literal("Unused relocations");
+    }
+
+    return vm.heap().allocate_without_realm<Executable>(
+        move(identifier_table),
+        move(string_table),
+        move(regex_table),
+        move(constants),
+        source_code,
+        number_of_property_lookup_caches,
+        number_of_global_variable_caches,
+        number_of_environment_variable_caches,
+        number_of_registers,
+        move(basic_blocks),
+        is_strict_mode);
+}
+
+}
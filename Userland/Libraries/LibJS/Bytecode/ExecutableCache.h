@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Error.h>
+#include <LibJS/Forward.h>
+#include <LibJS/Heap/GCPtr.h>
+#include <LibJS/Runtime/FunctionKind.h>
+
+namespace JS::Bytecode {
+
+// An on-disk cache of generated bytecode, enabled by pointing LIBJS_BYTECODE_CACHE at a directory.
+//
+// Executables are stored in one file each, keyed by a hash of the whole source code and the position of the node they
+// were generated for. Only code parsed with Parser::allow_bytecode_caching() (i.e. scripts and modules) is cached.
+//
+// The code is still parsed when a cached executable is used, since instructions like NewFunction refer to AST nodes,
+// which are found in the fresh AST again by their source offsets. So what this saves is the bytecode generation.
+//
+// NOTE: Cache files are trusted, as the instruction stream is loaded as-is. Don't point this at a shared directory.
+class ExecutableCache {
+public:
+    // Returns nullptr if the cache isn't enabled.
+    static ExecutableCache* the();
+
+    GCPtr<Executable> load(VM&, ASTNode const&, FunctionKind);
+    void store(Executable const&, ASTNode const&, FunctionKind);
+
+private:
+    explicit ExecutableCache(ByteString directory);
+
+    ByteString path_for(ASTNode const&, FunctionKind) const;
+
+    ErrorOr<NonnullGCPtr<Executable>> try_load(VM&, ASTNode const&, FunctionKind);
+    ErrorOr<void> try_store(Executable const&, ASTNode const&, FunctionKind);
+
+    ByteString m_directory;
+};
+
+}
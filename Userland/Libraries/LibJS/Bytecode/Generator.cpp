@@ -7,9 +7,11 @@
 #include <AK/TemporaryChange.h>
 #include <LibJS/AST.h>
 #include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
 #include <LibJS/Bytecode/Register.h>
 #include <LibJS/Runtime/VM.h>
 
@@ -24,8 +26,33 @@ Generator::Generator(VM& vm)
 {
 }
 
+static PassManager& optimization_pipeline()
+{
+    static auto pipeline = [] {
+        auto pipeline = make<PassManager>();
+        pipeline->add<Passes::GenerateCFG>();
+        pipeline->add<Passes::EliminateUnreachableBlocks>();
+        pipeline->add<Passes::ThreadJumps>();
+        pipeline->add<Passes::FoldConstants>();
+        pipeline->add<Passes::EliminateRedundantMoves>();
+        // Threading and folding jumps may have left blocks behind that nothing jumps to anymore.
+        pipeline->add<Passes::GenerateCFG>();
+        pipeline->add<Passes::EliminateUnreachableBlocks>();
+        pipeline->add<Passes::GenerateCFG>();
+        pipeline->add<Passes::AllocateRegisters>();
+        return pipeline;
+    }();
+    return *pipeline;
+}
+
 CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::generate(VM& vm, ASTNode const& node, ReadonlySpan<FunctionParameter> parameters, FunctionKind enclosing_function_kind)
 {
+    auto* cache = ExecutableCache::the();
+    if (cache) {
+        if (auto executable = cache->load(vm, node, enclosing_function_kind))
+            return *executable;
+    }
+
     Generator generator(vm);
 
     for (auto const& parameter : parameters) {
@@ -86,6 +113,11 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::generate(VM& vm, ASTN
         move(generator.m_root_basic_blocks),
         is_strict_mode);
 
+    optimization_pipeline().perform(*executable);
+
+    if (cache)
+        cache->store(*executable, node, enclosing_function_kind);
+
     return executable;
 }
 
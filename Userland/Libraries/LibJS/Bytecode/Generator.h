@@ -152,7 +152,7 @@ public:
     {
         if (name.is_empty())
             name = MUST(String::number(m_next_block++));
-        auto block = BasicBlock::create(name);
+        auto block = BasicBlock::create(m_root_basic_blocks.size(), name);
         if (auto const* context = m_current_unwind_context) {
             if (context->handler().has_value())
                 block->set_handler(context->handler().value().block());
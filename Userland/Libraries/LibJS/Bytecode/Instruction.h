@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Forward.h>
+#include <AK/Function.h>
 #include <AK/Span.h>
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Forward.h>
@@ -139,6 +140,10 @@ public:
     ThrowCompletionOr<void> execute(Bytecode::Interpreter&) const;
     static void destroy(Instruction&);
 
+    // These visit the jump targets and the operands of this instruction, for passes that rewrite them in place.
+    void visit_labels(Function<void(Label&)> visitor);
+    void visit_operands(Function<void(Operand&)> visitor);
+
     // FIXME: Find a better way to organize this information
     void set_source_record(SourceRecord rec) { m_source_record = rec; }
     SourceRecord source_record() const { return m_source_record; }
@@ -150,6 +155,9 @@ protected:
     {
     }
 
+    void visit_labels_impl(Function<void(Label&)>) { }
+    void visit_operands_impl(Function<void(Operand&)>) { }
+
 private:
     SourceRecord m_source_record {};
     Type m_type {};
@@ -15,6 +15,8 @@
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/JIT/NativeExecutable.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/BigInt.h>
@@ -304,6 +306,14 @@ ThrowCompletionOr<Value> Interpreter::run(SourceTextModule& module)
     return js_undefined();
 }
 
+ALWAYS_INLINE void Interpreter::jump_to(BasicBlock const& block)
+{
+    // Blocks are numbered in the order they were created, so jumping backwards is most likely the end of a loop.
+    if (block.index() <= m_current_block->index())
+        JIT::Compiler::did_take_back_edge(*m_current_executable);
+    m_current_block = &block;
+}
+
 void Interpreter::run_bytecode()
 {
     auto* locals = vm().running_execution_context().locals.data();
@@ -313,6 +323,13 @@ void Interpreter::run_bytecode()
         auto pc = InstructionStreamIterator { m_current_block->instruction_stream(), m_current_executable };
         TemporaryChange temp_change { m_pc, Optional<InstructionStreamIterator&>(pc) };
 
+        // Once the executable has been compiled to native code, it runs there until it ends, returns or throws.
+        // This also happens in the middle of a run, after a hot loop has caused the compilation.
+        if (m_current_executable->native_executable) {
+            m_current_executable->native_executable->run(*this, vm().running_execution_context(), *m_current_block);
+            return;
+        }
+
         bool will_return = false;
         bool will_yield = false;
 
@@ -332,25 +349,25 @@ void Interpreter::run_bytecode()
                 accumulator = get(static_cast<Op::End const&>(instruction).value());
                 return;
             case Instruction::Type::Jump:
-                m_current_block = &static_cast<Op::Jump const&>(instruction).true_target()->block();
+                jump_to(static_cast<Op::Jump const&>(instruction).true_target()->block());
                 goto start;
             case Instruction::Type::JumpIf:
                 if (get(static_cast<Op::JumpIf const&>(instruction).condition()).to_boolean())
-                    m_current_block = &static_cast<Op::JumpIf const&>(instruction).true_target()->block();
+                    jump_to(static_cast<Op::JumpIf const&>(instruction).true_target()->block());
                 else
-                    m_current_block = &static_cast<Op::JumpIf const&>(instruction).false_target()->block();
+                    jump_to(static_cast<Op::JumpIf const&>(instruction).false_target()->block());
                 goto start;
             case Instruction::Type::JumpNullish:
                 if (get(static_cast<Op::JumpNullish const&>(instruction).condition()).is_nullish())
-                    m_current_block = &static_cast<Op::Jump const&>(instruction).true_target()->block();
+                    jump_to(static_cast<Op::Jump const&>(instruction).true_target()->block());
                 else
-                    m_current_block = &static_cast<Op::Jump const&>(instruction).false_target()->block();
+                    jump_to(static_cast<Op::Jump const&>(instruction).false_target()->block());
                 goto start;
             case Instruction::Type::JumpUndefined:
                 if (get(static_cast<Op::JumpUndefined const&>(instruction).condition()).is_undefined())
-                    m_current_block = &static_cast<Op::Jump const&>(instruction).true_target()->block();
+                    jump_to(static_cast<Op::Jump const&>(instruction).true_target()->block());
                 else
-                    m_current_block = &static_cast<Op::Jump const&>(instruction).false_target()->block();
+                    jump_to(static_cast<Op::Jump const&>(instruction).false_target()->block());
                 goto start;
             case Instruction::Type::EnterUnwindContext:
                 enter_unwind_context();
@@ -446,6 +463,13 @@ void Interpreter::run_bytecode()
     }
 }
 
+void Interpreter::set_current_instruction(BasicBlock const& block, Instruction const& instruction)
+{
+    m_current_block = &block;
+    auto offset = reinterpret_cast<u8 const*>(&instruction) - block.instruction_stream().data();
+    m_pc.value() = InstructionStreamIterator { block.instruction_stream(), m_current_executable, static_cast<size_t>(offset) };
+}
+
 Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& executable, BasicBlock const* entry_point)
 {
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter will run unit {:p}", &executable);
@@ -468,6 +492,8 @@ Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& exe
 
     running_execution_context.executable = &executable;
 
+    JIT::Compiler::did_invoke(executable);
+
     run_bytecode();
 
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter did run unit {:p}", &executable);
@@ -669,7 +695,8 @@ ThrowCompletionOr<void> Mul::execute_impl(Bytecode::Interpreter& interpreter) co
 
     if (lhs.is_number() && rhs.is_number()) {
         if (lhs.is_int32() && rhs.is_int32()) {
-            if (!Checked<i32>::multiplication_would_overflow(lhs.as_i32(), rhs.as_i32())) {
+            // NOTE: A zero result may have to be -0, which only the double multiplication below gets right.
+            if (!Checked<i32>::multiplication_would_overflow(lhs.as_i32(), rhs.as_i32()) && lhs.as_i32() != 0 && rhs.as_i32() != 0) {
                 interpreter.set(m_dst, Value(lhs.as_i32() * rhs.as_i32()));
                 return {};
             }
@@ -78,11 +78,16 @@ public:
     BasicBlock const& current_block() const { return *m_current_block; }
     Optional<InstructionStreamIterator const&> instruction_stream_iterator() const { return m_pc; }
 
+    // Used by native code to let the interpreter know which instruction it is executing, for source ranges of errors
+    // and stack traces.
+    void set_current_instruction(BasicBlock const&, Instruction const&);
+
     Vector<Value>& registers() { return vm().running_execution_context().registers; }
     Vector<Value> const& registers() const { return vm().running_execution_context().registers; }
 
 private:
     void run_bytecode();
+    void jump_to(BasicBlock const&);
 
     VM& m_vm;
     BasicBlock const* m_scheduled_jump { nullptr };
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+class RegisterSet {
+public:
+    explicit RegisterSet(size_t size)
+    {
+        m_words.resize(ceil_div(size, bits_per_word));
+    }
+
+    bool contains(u32 index) const { return m_words[index / bits_per_word] & (1ull << (index % bits_per_word)); }
+    void set(u32 index) { m_words[index / bits_per_word] |= 1ull << (index % bits_per_word); }
+    void remove(u32 index) { m_words[index / bits_per_word] &= ~(1ull << (index % bits_per_word)); }
+
+    void merge(RegisterSet const& other)
+    {
+        for (size_t i = 0; i < m_words.size(); ++i)
+            m_words[i] |= other.m_words[i];
+    }
+
+    template<typename Callback>
+    void for_each(Callback callback) const
+    {
+        for (size_t i = 0; i < m_words.size(); ++i) {
+            for (auto word = m_words[i]; word != 0; word &= word - 1)
+                callback(i * bits_per_word + count_trailing_zeroes(word));
+        }
+    }
+
+    bool operator==(RegisterSet const&) const = default;
+
+private:
+    static constexpr size_t bits_per_word = 64;
+    Vector<u64> m_words;
+};
+
+// How many of the operands an instruction visits first are only written to, and not read. Anything else is assumed to be
+// read, which errs on the side of keeping registers alive.
+static size_t written_operand_count(Instruction::Type type)
+{
+    switch (type) {
+    case Instruction::Type::GetCalleeAndThisFromEnvironment:
+        return 2;
+#define __COMMON_OP(OpTitleCase, ...) case Instruction::Type::OpTitleCase:
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(__COMMON_OP)
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITHOUT_FAST_PATH(__COMMON_OP)
+        JS_ENUMERATE_COMMON_UNARY_OPS(__COMMON_OP)
+#undef __COMMON_OP
+    case Instruction::Type::Call:
+    case Instruction::Type::CallWithArgumentArray:
+    case Instruction::Type::Catch:
+    case Instruction::Type::CopyObjectExcludingProperties:
+    case Instruction::Type::DeleteById:
+    case Instruction::Type::DeleteByIdWithThis:
+    case Instruction::Type::DeleteByValue:
+    case Instruction::Type::DeleteByValueWithThis:
+    case Instruction::Type::DeleteVariable:
+    case Instruction::Type::GetById:
+    case Instruction::Type::GetByIdWithThis:
+    case Instruction::Type::GetByValue:
+    case Instruction::Type::GetByValueWithThis:
+    case Instruction::Type::GetGlobal:
+    case Instruction::Type::GetImportMeta:
+    case Instruction::Type::GetIterator:
+    case Instruction::Type::GetMethod:
+    case Instruction::Type::GetNewTarget:
+    case Instruction::Type::GetNextMethodFromIteratorRecord:
+    case Instruction::Type::GetObjectFromIteratorRecord:
+    case Instruction::Type::GetObjectPropertyIterator:
+    case Instruction::Type::GetPrivateById:
+    case Instruction::Type::GetVariable:
+    case Instruction::Type::HasPrivateId:
+    case Instruction::Type::ImportCall:
+    case Instruction::Type::IteratorNext:
+    case Instruction::Type::IteratorToArray:
+    case Instruction::Type::Mov:
+    case Instruction::Type::NewArray:
+    case Instruction::Type::NewClass:
+    case Instruction::Type::NewFunction:
+    case Instruction::Type::NewObject:
+    case Instruction::Type::NewPrimitiveArray:
+    case Instruction::Type::NewRegExp:
+    case Instruction::Type::NewTypeError:
+    case Instruction::Type::PostfixDecrement:
+    case Instruction::Type::PostfixIncrement:
+    case Instruction::Type::ResolveSuperBase:
+    case Instruction::Type::ResolveThisBinding:
+    case Instruction::Type::SuperCallWithArgumentArray:
+    case Instruction::Type::TypeofVariable:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static bool is_allocatable(Operand operand)
+{
+    return operand.is_register() && operand.index() >= Register::reserved_register_count;
+}
+
+// Calls the callbacks with the registers that the instruction writes and reads. A register can be both.
+template<typename DefinitionCallback, typename UseCallback>
+static void for_each_definition_and_use(Instruction& instruction, DefinitionCallback on_definition, UseCallback on_use)
+{
+    size_t operands_left_to_write = written_operand_count(instruction.type());
+    instruction.visit_operands([&](Operand& operand) {
+        bool is_definition = operands_left_to_write > 0;
+        if (is_definition)
+            --operands_left_to_write;
+        if (!is_allocatable(operand))
+            return;
+        if (is_definition)
+            on_definition(operand.index());
+        else
+            on_use(operand.index());
+    });
+
+    // The registers between the ends of an element range are read too.
+    if (instruction.type() == Instruction::Type::NewArray) {
+        auto const& new_array = static_cast<Op::NewArray const&>(instruction);
+        if (new_array.element_count() != 0) {
+            for (auto i = new_array.start().index(); i <= new_array.end().index(); ++i)
+                on_use(i);
+        }
+    }
+}
+
+void AllocateRegisters::perform(PassPipelineExecutable& executable)
+{
+    VERIFY(executable.cfg.has_value());
+
+    auto& basic_blocks = executable.executable.basic_blocks;
+    auto const register_count = executable.executable.number_of_registers;
+    if (register_count <= Register::reserved_register_count)
+        return;
+
+    HashMap<BasicBlock const*, size_t> block_indices;
+    for (size_t i = 0; i < basic_blocks.size(); ++i)
+        block_indices.set(basic_blocks[i].ptr(), i);
+
+    Vector<RegisterSet> live_in;
+    Vector<RegisterSet> live_out;
+    for (size_t i = 0; i < basic_blocks.size(); ++i) {
+        live_in.append(RegisterSet(register_count));
+        live_out.append(RegisterSet(register_count));
+    }
+
+    // Any instruction may throw, so whatever the handler or finalizer needs is live everywhere in the block.
+    auto live_on_exception = [&](BasicBlock const& block) {
+        RegisterSet live(register_count);
+        if (auto const* handler = block.handler())
+            live.merge(live_in[block_indices.get(handler).value()]);
+        if (auto const* finalizer = block.finalizer())
+            live.merge(live_in[block_indices.get(finalizer).value()]);
+        return live;
+    };
+
+    // Walks the block backwards from the registers that are live at its end.
+    auto live_at_start_of_block = [&](size_t block_index) {
+        auto& block = *basic_blocks[block_index];
+        auto exception_live = live_on_exception(block);
+        auto live = live_out[block_index];
+        auto instructions = instructions_of(block);
+        for (size_t i = instructions.size(); i > 0; --i) {
+            auto& instruction = *instructions[i - 1];
+            RegisterSet uses(register_count);
+            for_each_definition_and_use(
+                instruction,
+                [&](u32 index) { live.remove(index); },
+                [&](u32 index) { uses.set(index); });
+            live.merge(uses);
+            live.merge(exception_live);
+        }
+        return live;
+    };
+
+    for (bool did_change = true; did_change;) {
+        did_change = false;
+        for (size_t i = basic_blocks.size(); i > 0; --i) {
+            auto block_index = i - 1;
+            RegisterSet out(register_count);
+            for (auto const* successor : executable.cfg->get(basic_blocks[block_index].ptr()).value())
+                out.merge(live_in[block_indices.get(successor).value()]);
+            live_out[block_index] = move(out);
+
+            auto in = live_at_start_of_block(block_index);
+            if (in != live_in[block_index]) {
+                live_in[block_index] = move(in);
+                did_change = true;
+            }
+        }
+    }
+
+    // Number all instructions in order, and find the range of positions each register is live in. Registers whose
+    // ranges don't overlap can share a slot.
+    struct LiveRange {
+        u32 register_index { 0 };
+        size_t start { NumericLimits<size_t>::max() };
+        size_t end { 0 };
+        bool is_used { false };
+
+        void extend(size_t position)
+        {
+            start = min(start, position);
+            end = max(end, position);
+            is_used = true;
+        }
+    };
+    Vector<LiveRange> ranges;
+    ranges.resize(register_count);
+    for (u32 i = 0; i < register_count; ++i)
+        ranges[i].register_index = i;
+
+    // The registers of an element range have to stay in the same order, so they keep their slot.
+    RegisterSet pinned(register_count);
+
+    size_t position = 0;
+    for (size_t block_index = 0; block_index < basic_blocks.size(); ++block_index) {
+        auto block_start = position;
+        auto instructions = instructions_of(*basic_blocks[block_index]);
+        auto block_end = block_start + max(instructions.size(), static_cast<size_t>(1)) - 1;
+        position = block_end + 1;
+
+        // Whatever is live somewhere in the middle of a block is either live at one of its ends, or is written or read there.
+        live_in[block_index].for_each([&](u32 index) { ranges[index].extend(block_start); });
+        live_out[block_index].for_each([&](u32 index) { ranges[index].extend(block_end); });
+        for (size_t i = 0; i < instructions.size(); ++i) {
+            auto& instruction = *instructions[i];
+            auto extend = [&](u32 index) { ranges[index].extend(block_start + i); };
+            for_each_definition_and_use(instruction, extend, extend);
+            if (instruction.type() == Instruction::Type::NewArray) {
+                auto const& new_array = static_cast<Op::NewArray const&>(instruction);
+                if (new_array.element_count() != 0) {
+                    for (auto index = new_array.start().index(); index <= new_array.end().index(); ++index)
+                        pinned.set(index);
+                }
+            }
+        }
+    }
+
+    // A simple linear scan: give every range the lowest slot that is free for all of it.
+    struct Slot {
+        Optional<size_t> end_of_last_range;
+        Optional<LiveRange> pinned_range;
+
+        bool can_hold(LiveRange const& range) const
+        {
+            if (end_of_last_range.has_value() && *end_of_last_range >= range.start)
+                return false;
+            if (pinned_range.has_value() && pinned_range->start <= range.end && range.start <= pinned_range->end)
+                return false;
+            return true;
+        }
+    };
+    Vector<Slot> slots;
+    slots.resize(register_count);
+
+    Vector<u32> new_index;
+    new_index.resize(register_count);
+    for (u32 i = 0; i < Register::reserved_register_count; ++i)
+        new_index[i] = i;
+
+    u32 slot_count = Register::reserved_register_count;
+    Vector<LiveRange> ranges_to_allocate;
+    for (auto const& range : ranges) {
+        if (range.register_index < Register::reserved_register_count || !range.is_used)
+            continue;
+        if (pinned.contains(range.register_index)) {
+            slots[range.register_index].pinned_range = range;
+            new_index[range.register_index] = range.register_index;
+            slot_count = max(slot_count, range.register_index + 1);
+            continue;
+        }
+        ranges_to_allocate.append(range);
+    }
+    quick_sort(ranges_to_allocate, [](auto const& a, auto const& b) { return a.start < b.start; });
+
+    for (auto const& range : ranges_to_allocate) {
+        for (u32 slot = Register::reserved_register_count; slot < register_count; ++slot) {
+            if (!slots[slot].can_hold(range))
+                continue;
+            slots[slot].end_of_last_range = range.end;
+            new_index[range.register_index] = slot;
+            slot_count = max(slot_count, slot + 1);
+            break;
+        }
+    }
+
+    for (auto& block : basic_blocks) {
+        for (auto* instruction : instructions_of(*block)) {
+            instruction->visit_operands([&](Operand& operand) {
+                if (is_allocatable(operand))
+                    operand = Operand(Operand::Type::Register, new_index[operand.index()]);
+            });
+        }
+    }
+    executable.executable.number_of_registers = slot_count;
+}
+
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+static bool is_temporary(Operand operand)
+{
+    return operand.is_register() && operand.index() >= Register::reserved_register_count;
+}
+
+// SetLocal names its local by index instead of with an operand.
+static bool mentions(Instruction& instruction, Operand operand)
+{
+    if (instruction.type() == Instruction::Type::SetLocal && static_cast<Op::SetLocal const&>(instruction).dst() == operand)
+        return true;
+    bool found = false;
+    instruction.visit_operands([&](Operand& other) {
+        if (other == operand)
+            found = true;
+    });
+    return found;
+}
+
+void EliminateRedundantMoves::perform(PassPipelineExecutable& executable)
+{
+    // How often every register is mentioned in the whole executable. A temporary register that is only mentioned by
+    // the move into it is never read, and one mentioned twice by two moves is only used to pass a value along.
+    Vector<u32> mentions_of_register;
+    mentions_of_register.resize(executable.executable.number_of_registers);
+
+    for (auto& block : executable.executable.basic_blocks) {
+        for (auto* instruction : instructions_of(*block)) {
+            instruction->visit_operands([&](Operand& operand) {
+                if (operand.is_register())
+                    ++mentions_of_register[operand.index()];
+            });
+
+            // The registers between the ends of an element range are read without being mentioned, so keep them all.
+            if (instruction->type() == Instruction::Type::NewArray) {
+                auto const& new_array = static_cast<Op::NewArray const&>(*instruction);
+                if (new_array.element_count() == 0)
+                    continue;
+                for (auto i = new_array.start().index(); i <= new_array.end().index(); ++i)
+                    mentions_of_register[i] += 2;
+            }
+        }
+    }
+
+    auto forget_mention = [&](Operand operand) {
+        if (operand.is_register())
+            --mentions_of_register[operand.index()];
+    };
+
+    // Removing a move can leave its source register unread as well, so keep going until nothing changes.
+    for (bool did_change = true; did_change;) {
+        did_change = false;
+
+        for (auto& block : executable.executable.basic_blocks) {
+            auto instructions = instructions_of(*block);
+            Vector<bool> is_removed;
+            is_removed.resize(instructions.size());
+
+            for (size_t i = 0; i < instructions.size(); ++i) {
+                if (instructions[i]->type() != Instruction::Type::Mov)
+                    continue;
+                auto const& mov = static_cast<Op::Mov const&>(*instructions[i]);
+                auto dst = mov.dst();
+                auto src = mov.src();
+
+                if (dst == src || (is_temporary(dst) && mentions_of_register[dst.index()] == 1)) {
+                    forget_mention(dst);
+                    forget_mention(src);
+                    is_removed[i] = true;
+                    continue;
+                }
+
+                // Mov temp, src; ...; Mov other, temp => Mov other, src, as long as nothing in between touches src.
+                // The interpreter writes to the reserved registers behind the scenes, so those have to be moved right away.
+                if (!is_temporary(dst) || mentions_of_register[dst.index()] != 2)
+                    continue;
+                for (size_t j = i + 1; j < instructions.size(); ++j) {
+                    auto& instruction = *instructions[j];
+                    if (!mentions(instruction, dst)) {
+                        if (mentions(instruction, src) || (src.is_register() && !is_temporary(src)))
+                            break;
+                        continue;
+                    }
+                    if (instruction.type() != Instruction::Type::Mov || static_cast<Op::Mov const&>(instruction).src() != dst)
+                        break;
+                    instruction.visit_operands([&](Operand& operand) {
+                        if (operand == dst)
+                            operand = src;
+                    });
+                    mentions_of_register[dst.index()] = 0;
+                    is_removed[i] = true;
+                    break;
+                }
+            }
+
+            if (!is_removed.contains_slow(true))
+                continue;
+
+            InstructionStreamRewriter rewriter(*block);
+            for (size_t i = 0; i < instructions.size(); ++i) {
+                if (is_removed[i])
+                    rewriter.remove(*instructions[i]);
+                else
+                    rewriter.keep(*instructions[i]);
+            }
+            rewriter.finish();
+            did_change = true;
+        }
+    }
+}
+
+}
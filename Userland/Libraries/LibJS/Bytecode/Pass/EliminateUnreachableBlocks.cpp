@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+void EliminateUnreachableBlocks::perform(PassPipelineExecutable& executable)
+{
+    VERIFY(executable.cfg.has_value());
+
+    auto& basic_blocks = executable.executable.basic_blocks;
+    if (basic_blocks.is_empty())
+        return;
+
+    HashTable<BasicBlock const*> reachable_blocks;
+    Vector<BasicBlock const*> blocks_to_visit;
+    blocks_to_visit.append(basic_blocks.first().ptr());
+    reachable_blocks.set(basic_blocks.first().ptr());
+
+    while (!blocks_to_visit.is_empty()) {
+        auto const* block = blocks_to_visit.take_last();
+        for (auto const* successor : executable.cfg->get(block).value()) {
+            if (reachable_blocks.set(successor) == HashSetResult::InsertedNewEntry)
+                blocks_to_visit.append(successor);
+        }
+    }
+
+    if (reachable_blocks.size() == basic_blocks.size())
+        return;
+
+    // Unreachable blocks may only refer to reachable ones, never the other way around, so they can just be dropped.
+    basic_blocks.remove_all_matching([&](auto const& block) {
+        return !reachable_blocks.contains(block.ptr());
+    });
+    for (size_t i = 0; i < basic_blocks.size(); ++i)
+        basic_blocks[i]->set_index({}, i);
+
+    executable.cfg.clear();
+    executable.inverted_cfg.clear();
+}
+
+}
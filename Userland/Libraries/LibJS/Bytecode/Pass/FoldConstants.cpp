@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Runtime/ValueInlines.h>
+
+namespace JS::Bytecode::Passes {
+
+// Operations on primitives that aren't cells can't call into user code, and they don't throw either.
+static bool is_foldable(Value value)
+{
+    return !value.is_empty() && !value.is_cell();
+}
+
+static Optional<Value> fold_binary_op(VM& vm, Instruction::Type type, Value lhs, Value rhs)
+{
+    auto result = [&]() -> ThrowCompletionOr<Optional<Value>> {
+        switch (type) {
+#define __FOLD_BINARY_OP(OpTitleCase, op_snake_case) \
+    case Instruction::Type::OpTitleCase:             \
+        return TRY(JS::op_snake_case(vm, lhs, rhs));
+            JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(__FOLD_BINARY_OP)
+            __FOLD_BINARY_OP(Div, div)
+            __FOLD_BINARY_OP(Exp, exp)
+            __FOLD_BINARY_OP(Mod, mod)
+#undef __FOLD_BINARY_OP
+        case Instruction::Type::LooselyEquals:
+            return Value(TRY(is_loosely_equal(vm, lhs, rhs)));
+        case Instruction::Type::LooselyInequals:
+            return Value(!TRY(is_loosely_equal(vm, lhs, rhs)));
+        case Instruction::Type::StrictlyEquals:
+            return Value(is_strictly_equal(lhs, rhs));
+        case Instruction::Type::StrictlyInequals:
+            return Value(!is_strictly_equal(lhs, rhs));
+        default:
+            // In and InstanceOf throw for anything that isn't an object.
+            return OptionalNone {};
+        }
+    }();
+    if (result.is_error() || !result.value().has_value() || !is_foldable(*result.value()))
+        return {};
+    return result.release_value();
+}
+
+static Optional<Value> fold_unary_op(VM& vm, Instruction::Type type, Value value)
+{
+    auto result = [&]() -> ThrowCompletionOr<Optional<Value>> {
+        switch (type) {
+        case Instruction::Type::BitwiseNot:
+            return TRY(bitwise_not(vm, value));
+        case Instruction::Type::Not:
+            return Value(!value.to_boolean());
+        case Instruction::Type::UnaryPlus:
+            return TRY(unary_plus(vm, value));
+        case Instruction::Type::UnaryMinus:
+            return TRY(unary_minus(vm, value));
+        default:
+            // Typeof produces a string, which would have to be allocated.
+            return OptionalNone {};
+        }
+    }();
+    if (result.is_error() || !result.value().has_value() || !is_foldable(*result.value()))
+        return {};
+    return result.release_value();
+}
+
+static bool is_binary_op(Instruction::Type type)
+{
+    switch (type) {
+#define __BINARY_OP(OpTitleCase, ...) case Instruction::Type::OpTitleCase:
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(__BINARY_OP)
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITHOUT_FAST_PATH(__BINARY_OP)
+#undef __BINARY_OP
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool is_unary_op(Instruction::Type type)
+{
+    switch (type) {
+#define __UNARY_OP(OpTitleCase, ...) case Instruction::Type::OpTitleCase:
+        JS_ENUMERATE_COMMON_UNARY_OPS(__UNARY_OP)
+#undef __UNARY_OP
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool is_conditional_jump(Instruction::Type type)
+{
+    return type == Instruction::Type::JumpIf
+        || type == Instruction::Type::JumpNullish
+        || type == Instruction::Type::JumpUndefined;
+}
+
+static Operand add_constant(Executable& executable, Value value)
+{
+    for (size_t i = 0; i < executable.constants.size(); ++i) {
+        if (executable.constants[i] == value)
+            return Operand(Operand::Type::Constant, i);
+    }
+    executable.constants.append(value);
+    return Operand(Operand::Type::Constant, executable.constants.size() - 1);
+}
+
+void FoldConstants::perform(PassPipelineExecutable& executable)
+{
+    auto& vm = executable.executable.vm();
+    auto const& constants = executable.executable.constants;
+    bool did_change_control_flow = false;
+
+    auto constant_value = [&](Operand operand) -> Optional<Value> {
+        if (!operand.is_constant())
+            return {};
+        return constants[operand.index()];
+    };
+
+    for (auto& block : executable.executable.basic_blocks) {
+        // Registers that are known to hold a constant at this point of the block, because one was moved into them.
+        HashMap<u32, Operand> constant_registers;
+
+        auto forget_register = [&](Operand operand) {
+            if (operand.is_register())
+                constant_registers.remove(operand.index());
+        };
+
+        InstructionStreamRewriter rewriter(*block);
+        for (auto* instruction : instructions_of(*block)) {
+            auto type = instruction->type();
+            bool has_dst = type == Instruction::Type::Mov || is_binary_op(type) || is_unary_op(type);
+
+            if (!has_dst && !is_conditional_jump(type)) {
+                // Anything else may write to any of its operands.
+                instruction->visit_operands([&](Operand& operand) { forget_register(operand); });
+                rewriter.keep(*instruction);
+                continue;
+            }
+
+            // The destination comes first, everything after it is only read.
+            Vector<Operand, 3> operands;
+            instruction->visit_operands([&](Operand& operand) {
+                bool is_dst = has_dst && operands.is_empty();
+                if (!is_dst && operand.is_register()) {
+                    if (auto constant = constant_registers.get(operand.index()); constant.has_value())
+                        operand = *constant;
+                }
+                operands.append(operand);
+            });
+
+            if (is_conditional_jump(type)) {
+                auto value = constant_value(operands[0]);
+                if (!value.has_value()) {
+                    rewriter.keep(*instruction);
+                    continue;
+                }
+
+                // Checking the condition has no side effects, whatever the constant is.
+                bool is_taken = false;
+                if (type == Instruction::Type::JumpIf)
+                    is_taken = value->to_boolean();
+                else if (type == Instruction::Type::JumpNullish)
+                    is_taken = value->is_nullish();
+                else
+                    is_taken = value->is_undefined();
+                auto const& jump = static_cast<Op::Jump const&>(*instruction);
+                rewriter.replace<Op::Jump>(*instruction, is_taken ? *jump.true_target() : *jump.false_target());
+                did_change_control_flow = true;
+                continue;
+            }
+
+            auto dst = operands[0];
+            Optional<Value> result;
+            if (type == Instruction::Type::Mov) {
+                if (operands[1].is_constant())
+                    result = constants[operands[1].index()];
+            } else if (is_binary_op(type)) {
+                auto lhs = constant_value(operands[1]);
+                auto rhs = constant_value(operands[2]);
+                if (lhs.has_value() && rhs.has_value() && is_foldable(*lhs) && is_foldable(*rhs))
+                    result = fold_binary_op(vm, type, *lhs, *rhs);
+            } else {
+                auto src = constant_value(operands[1]);
+                if (src.has_value() && is_foldable(*src))
+                    result = fold_unary_op(vm, type, *src);
+            }
+
+            Optional<Operand> constant_in_dst;
+            if (type == Instruction::Type::Mov) {
+                if (result.has_value())
+                    constant_in_dst = operands[1];
+                rewriter.keep(*instruction);
+            } else if (result.has_value()) {
+                constant_in_dst = add_constant(executable.executable, *result);
+                rewriter.replace<Op::Mov>(*instruction, dst, *constant_in_dst);
+            } else {
+                rewriter.keep(*instruction);
+            }
+
+            if (!dst.is_register())
+                continue;
+            // The interpreter itself writes to the reserved registers, so what they hold is never known for sure.
+            if (dst.index() < Register::reserved_register_count || !constant_in_dst.has_value())
+                constant_registers.remove(dst.index());
+            else
+                constant_registers.set(dst.index(), *constant_in_dst);
+        }
+        rewriter.finish();
+    }
+
+    if (did_change_control_flow) {
+        executable.cfg.clear();
+        executable.inverted_cfg.clear();
+    }
+}
+
+}
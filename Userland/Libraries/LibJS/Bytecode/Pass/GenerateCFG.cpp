@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+void GenerateCFG::perform(PassPipelineExecutable& executable)
+{
+    HashMap<BasicBlock const*, HashTable<BasicBlock const*>> cfg;
+    HashMap<BasicBlock const*, HashTable<BasicBlock const*>> inverted_cfg;
+
+    // A ContinuePendingUnwind goes on to whatever jump was scheduled before its finalizer was entered.
+    Vector<BasicBlock const*> scheduled_jump_targets;
+    for (auto& block : executable.executable.basic_blocks) {
+        for (auto* instruction : instructions_of(*block)) {
+            if (instruction->type() == Instruction::Type::ScheduleJump)
+                scheduled_jump_targets.append(&static_cast<Op::ScheduleJump const&>(*instruction).target().block());
+        }
+    }
+
+    for (auto& block : executable.executable.basic_blocks) {
+        auto& successors = cfg.ensure(block.ptr());
+        inverted_cfg.ensure(block.ptr());
+
+        auto add_successor = [&](BasicBlock const& successor) {
+            successors.set(&successor);
+            inverted_cfg.ensure(&successor).set(block.ptr());
+        };
+
+        // Any instruction may throw, and a block that ends with a finalizer (e.g. by returning) continues there.
+        if (auto const* handler = block->handler())
+            add_successor(*handler);
+        if (auto const* finalizer = block->finalizer())
+            add_successor(*finalizer);
+
+        for (auto* instruction : instructions_of(*block)) {
+            instruction->visit_labels([&](Label& label) {
+                add_successor(label.block());
+            });
+            if (instruction->type() == Instruction::Type::ContinuePendingUnwind) {
+                for (auto const* target : scheduled_jump_targets)
+                    add_successor(*target);
+            }
+        }
+    }
+
+    executable.cfg = move(cfg);
+    executable.inverted_cfg = move(inverted_cfg);
+}
+
+}
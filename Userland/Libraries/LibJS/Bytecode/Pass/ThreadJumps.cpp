@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// If the block does nothing but jump somewhere else, returns where it jumps to.
+static BasicBlock const* forwarding_target(BasicBlock const& block)
+{
+    InstructionStreamIterator it(block.instruction_stream());
+    if (it.at_end() || (*it).type() != Instruction::Type::Jump)
+        return nullptr;
+    return &static_cast<Op::Jump const&>(*it).true_target()->block();
+}
+
+void ThreadJumps::perform(PassPipelineExecutable& executable)
+{
+    auto& basic_blocks = executable.executable.basic_blocks;
+    auto const block_count = basic_blocks.size();
+    bool did_change = false;
+
+    auto thread = [&](BasicBlock const& target) -> BasicBlock const& {
+        auto const* result = &target;
+        for (size_t steps = 0; steps < block_count; ++steps) {
+            auto const* next = forwarding_target(*result);
+            if (!next || next == result)
+                break;
+            result = next;
+        }
+        if (result != &target)
+            did_change = true;
+        return *result;
+    };
+
+    for (auto& block : basic_blocks) {
+        auto instructions = instructions_of(*block);
+        if (instructions.is_empty())
+            continue;
+
+        // Only jumps are threaded: they leave the block right away, without running the block's finalizer. The other
+        // instructions with labels enter unwind contexts or resume in a specific block, which a jump there must not skip.
+        auto& last = *instructions.last();
+        switch (last.type()) {
+        case Instruction::Type::Jump:
+        case Instruction::Type::JumpIf:
+        case Instruction::Type::JumpNullish:
+        case Instruction::Type::JumpUndefined:
+            last.visit_labels([&](Label& label) {
+                label = Label { thread(label.block()) };
+            });
+            break;
+        default:
+            continue;
+        }
+
+        // A conditional jump that goes to the same place either way doesn't need to look at its condition.
+        if (last.type() == Instruction::Type::Jump)
+            continue;
+        auto const& jump = static_cast<Op::Jump const&>(last);
+        if (&jump.true_target()->block() != &jump.false_target()->block())
+            continue;
+
+        InstructionStreamRewriter rewriter(*block);
+        for (auto* instruction : instructions) {
+            if (instruction == &last)
+                rewriter.replace<Op::Jump>(*instruction, *jump.true_target());
+            else
+                rewriter.keep(*instruction);
+        }
+        rewriter.finish();
+        did_change = true;
+    }
+
+    if (did_change) {
+        executable.cfg.clear();
+        executable.inverted_cfg.clear();
+    }
+}
+
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Instruction.h>
+
+namespace JS::Bytecode {
+
+struct PassPipelineExecutable {
+    Executable& executable;
+
+    // The successors and predecessors of every block, including the edges to exception handlers and finalizers.
+    // Passes that change control flow clear these, and GenerateCFG has to run again before they are used.
+    Optional<HashMap<BasicBlock const*, HashTable<BasicBlock const*>>> cfg {};
+    Optional<HashMap<BasicBlock const*, HashTable<BasicBlock const*>>> inverted_cfg {};
+};
+
+class Pass {
+public:
+    Pass() = default;
+    virtual ~Pass() = default;
+
+    virtual void perform(PassPipelineExecutable&) = 0;
+};
+
+class PassManager : public Pass {
+public:
+    PassManager() = default;
+    ~PassManager() override = default;
+
+    template<typename PassT, typename... Args>
+    void add(Args&&... args) { m_passes.append(make<PassT>(forward<Args>(args)...)); }
+
+    void perform(Executable& executable)
+    {
+        PassPipelineExecutable pipeline_executable { executable };
+        perform(pipeline_executable);
+    }
+
+    virtual void perform(PassPipelineExecutable& executable) override
+    {
+        for (auto& pass : m_passes)
+            pass->perform(executable);
+    }
+
+private:
+    Vector<NonnullOwnPtr<Pass>> m_passes;
+};
+
+// Builds a new instruction stream for a basic block. Every instruction of the old stream has to be handed to exactly one of
+// keep(), replace() or remove(), in order, after which finish() puts the new stream in place.
+class InstructionStreamRewriter {
+public:
+    explicit InstructionStreamRewriter(BasicBlock& block)
+        : m_block(block)
+    {
+        m_buffer.ensure_capacity(block.size());
+    }
+
+    // Instructions are relocated bitwise, just like the block's own buffer does when it grows.
+    void keep(Instruction& instruction)
+    {
+        m_buffer.append(reinterpret_cast<u8 const*>(&instruction), instruction.length());
+    }
+
+    void remove(Instruction& instruction)
+    {
+        Instruction::destroy(instruction);
+    }
+
+    template<typename OpType, typename... Args>
+    void replace(Instruction& instruction, Args&&... args)
+    {
+        static_assert(sizeof(OpType) % alignof(void*) == 0);
+
+        // The arguments may refer to the old instruction, so it can only be destroyed once the new one is built.
+        size_t slot_offset = m_buffer.size();
+        m_buffer.resize(slot_offset + sizeof(OpType));
+        auto* op = new (m_buffer.data() + slot_offset) OpType(forward<Args>(args)...);
+        op->set_source_record(instruction.source_record());
+        Instruction::destroy(instruction);
+    }
+
+    void finish()
+    {
+        m_block.set_instruction_stream({}, move(m_buffer));
+    }
+
+private:
+    BasicBlock& m_block;
+    Vector<u8> m_buffer;
+};
+
+// Returns the instructions of a block, so they can be rewritten while walking over them.
+inline Vector<Instruction*> instructions_of(BasicBlock& block)
+{
+    Vector<Instruction*> instructions;
+    for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it)
+        instructions.append(const_cast<Instruction*>(&*it));
+    return instructions;
+}
+
+namespace Passes {
+
+// Finds the successors of every block: jump targets, exception handlers and finalizers, the continuations of Yield and
+// Await, and the targets of scheduled jumps, which any ContinuePendingUnwind may go on to.
+class GenerateCFG : public Pass {
+public:
+    GenerateCFG() = default;
+    ~GenerateCFG() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Removes the blocks that can't be reached from the entry block, and renumbers the rest without reordering them.
+class EliminateUnreachableBlocks : public Pass {
+public:
+    EliminateUnreachableBlocks() = default;
+    ~EliminateUnreachableBlocks() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Points jumps to blocks that consist of nothing but another jump straight at the final target.
+class ThreadJumps : public Pass {
+public:
+    ThreadJumps() = default;
+    ~ThreadJumps() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Evaluates arithmetic, comparisons and conditional jumps on constant primitive operands ahead of time, and propagates
+// constants that were moved into a register to later uses in the same block.
+class FoldConstants : public Pass {
+public:
+    FoldConstants() = default;
+    ~FoldConstants() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Removes moves of a value onto itself and moves into registers that are never read, and forwards the source of a move
+// into a temporary register to the one move that reads it.
+class EliminateRedundantMoves : public Pass {
+public:
+    EliminateRedundantMoves() = default;
+    ~EliminateRedundantMoves() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Computes the liveness of every register, and lets registers that are never live at the same time share a slot, which
+// shrinks the register file the interpreter has to allocate for every call.
+class AllocateRegisters : public Pass {
+public:
+    AllocateRegisters() = default;
+    ~AllocateRegisters() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+}
+
+}
@@ -319,9 +319,14 @@ class Executable;
 class Generator;
 class Instruction;
 class Interpreter;
+class Label;
 class Operand;
 class RegexTable;
 class Register;
 }
 
+namespace JIT {
+class NativeExecutable;
+}
+
 }
@@ -27,6 +27,13 @@ public:                                            \
     }                                              \
     friend class JS::Heap;
 
+// Declares that every store of a reference to another cell into the members of this exact class (and not of any
+// classes inheriting from it) is followed by a call to Cell::write_barrier(). This allows the garbage collector to skip
+// old cells of this class when collecting the young generation, unless they have been written to in the meantime.
+// Classes without it are always treated as if they had been written to, which is correct but slower.
+#define JS_DECLARE_WRITE_BARRIERS(ClassName) \
+    using CellTypeWithWriteBarriers = ClassName
+
 class Cell {
     AK_MAKE_NONCOPYABLE(Cell);
     AK_MAKE_NONMOVABLE(Cell);
@@ -46,6 +53,28 @@ public:
     State state() const { return m_state; }
     void set_state(State state) { m_state = state; }
 
+    // Cells start out in the young generation, and are moved to the old generation once they survive a garbage
+    // collection. See Heap::collect_garbage() for how the generations are used.
+    bool is_old() const { return m_generation_flags & GenerationFlags::Old; }
+
+    // Must be called after storing a reference to another cell into a cell that declares JS_DECLARE_WRITE_BARRIERS.
+    ALWAYS_INLINE void write_barrier()
+    {
+        if (m_generation_flags == (GenerationFlags::Old | GenerationFlags::HasWriteBarriers)) [[unlikely]]
+            remember();
+    }
+
+    enum GenerationFlags : u8 {
+        Old = 1 << 0,
+        HasWriteBarriers = 1 << 1,
+        Remembered = 1 << 2,
+    };
+    u8 generation_flags() const { return m_generation_flags; }
+    void set_generation_flags(Badge<Heap>, u8 flags) { m_generation_flags = flags; }
+
+    // NOTE: This is used by the LibJS JIT to inline the write barrier check.
+    static constexpr size_t generation_flags_offset() { return __builtin_offsetof(Cell, m_generation_flags); }
+
     virtual StringView class_name() const = 0;
 
     class Visitor {
@@ -168,9 +197,12 @@ protected:
     void set_overrides_must_survive_garbage_collection(bool b) { m_overrides_must_survive_garbage_collection = b; }
 
 private:
+    void remember();
+
     bool m_mark : 1 { false };
     bool m_overrides_must_survive_garbage_collection : 1 { false };
     State m_state : 1 { State::Live };
+    u8 m_generation_flags { 0 };
 };
 
 }
@@ -76,6 +76,14 @@ void Heap::will_allocate(size_t size)
     if (should_collect_on_every_allocation()) {
         m_allocated_bytes_since_last_gc = 0;
         collect_garbage();
+    } else if (m_allocated_bytes_since_last_gc + size > young_generation_bytes_threshold() && !young_generation_collection_is_too_expensive()) {
+        m_allocated_bytes_since_last_gc = 0;
+        // Most cells die young, so it's usually enough to only look at the cells allocated since the last collection.
+        // The old generation only needs to be looked at once it has grown as much as a full collection would allow.
+        if (m_promoted_bytes_since_last_full_gc > m_gc_bytes_threshold)
+            collect_garbage();
+        else
+            collect_garbage(CollectionType::CollectYoungGeneration);
     } else if (m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold) {
         m_allocated_bytes_since_last_gc = 0;
         collect_garbage();
@@ -277,15 +285,25 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     if (print_report)
         collection_measurement_timer.start();
 
-    if (collection_type == CollectionType::CollectGarbage) {
+    if (collection_type != CollectionType::CollectEverything) {
         if (m_gc_deferrals) {
+            // A full collection takes precedence over a young generation one if both were requested.
+            if (!m_should_gc_when_deferral_ends || collection_type == CollectionType::CollectGarbage)
+                m_collection_type_when_deferral_ends = collection_type;
             m_should_gc_when_deferral_ends = true;
             return;
         }
         HashMap<Cell*, HeapRoot> roots;
         gather_roots(roots);
-        mark_live_cells(roots);
+        mark_live_cells(roots, collection_type);
     }
+
+    if (collection_type == CollectionType::CollectYoungGeneration) {
+        finalize_unmarked_young_cells();
+        sweep_dead_young_cells(print_report, collection_measurement_timer);
+        return;
+    }
+
     finalize_unmarked_cells();
     sweep_dead_cells(print_report, collection_measurement_timer);
 }
@@ -375,13 +393,7 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
         }
     }
 
-    HashTable<HeapBlock*> all_live_heap_blocks;
-    for_each_block([&](auto& block) {
-        all_live_heap_blocks.set(&block);
-        return IterationDecision::Continue;
-    });
-
-    for_each_cell_among_possible_pointers(all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr possible_pointer) {
+    for_each_cell_among_possible_pointers(m_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr possible_pointer) {
         if (cell->state() == Cell::State::Live) {
             dbgln_if(HEAP_DEBUG, "  ?-> {}", (void const*)cell);
             roots.set(cell, *possible_pointers.get(possible_pointer));
@@ -393,14 +405,12 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots, bool young_generation_only)
         : m_heap(heap)
+        , m_young_generation_only(young_generation_only)
+        , m_all_live_heap_blocks(heap.m_live_heap_blocks)
     {
         m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
 
         for (auto* root : roots.keys()) {
             visit(root);
@@ -411,6 +421,9 @@ public:
     {
         if (cell.is_marked())
             return;
+        // Old cells are not going to be collected, and the references from them to young cells are roots already.
+        if (m_young_generation_only && cell.is_old())
+            return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
 
         cell.set_marked(true);
@@ -430,6 +443,8 @@ public:
                 return;
             if (cell->state() != Cell::State::Live)
                 return;
+            if (m_young_generation_only && cell->is_old())
+                return;
             cell->set_marked(true);
             m_work_queue.append(*cell);
         });
@@ -444,20 +459,41 @@ public:
 
 private:
     Heap& m_heap;
+    bool m_young_generation_only { false };
     Vector<NonnullGCPtr<Cell>> m_work_queue;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
+    HashTable<HeapBlock*> const& m_all_live_heap_blocks;
     FlatPtr m_min_block_address;
     FlatPtr m_max_block_address;
 };
 
-void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
+void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots, CollectionType collection_type)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
-    MarkingVisitor visitor(*this, roots);
+    bool const young_generation_only = collection_type == CollectionType::CollectYoungGeneration;
+    MarkingVisitor visitor(*this, roots, young_generation_only);
+
+    if (young_generation_only) {
+        // We don't know which old cells are still alive, so anything they point to has to be kept alive as well.
+        for (auto& cell : m_remembered_cells)
+            cell->visit_edges(visitor);
+        for (auto& cell : m_old_cells_without_write_barriers)
+            cell->visit_edges(visitor);
+    }
 
     visitor.mark_all_live_cells();
 
+    if (young_generation_only) {
+        // Uprooted old cells were not marked, they have to stay around until the next full collection.
+        m_uprooted_cells.remove_all_matching([](auto& inverse_root) {
+            if (inverse_root->is_old())
+                return false;
+            inverse_root->set_marked(false);
+            return true;
+        });
+        return;
+    }
+
     for (auto& inverse_root : m_uprooted_cells)
         inverse_root->set_marked(false);
 
@@ -482,6 +518,26 @@ void Heap::finalize_unmarked_cells()
     });
 }
 
+void Heap::finalize_unmarked_young_cells()
+{
+    for (auto* block : m_blocks_with_young_cells) {
+        block->for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            if (!cell->is_old() && !cell->is_marked() && !cell_must_survive_garbage_collection(*cell))
+                cell->finalize();
+        });
+    }
+}
+
+void Heap::promote_to_old_generation(Cell& cell)
+{
+    auto has_write_barriers = cell.generation_flags() & Cell::GenerationFlags::HasWriteBarriers;
+    cell.set_generation_flags({}, Cell::GenerationFlags::Old | has_write_barriers);
+    if (!has_write_barriers) {
+        m_old_cells_without_write_barriers.append(cell);
+        m_old_cell_bytes_without_write_barriers += HeapBlock::from_cell(&cell)->cell_size();
+    }
+}
+
 void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
@@ -493,9 +549,17 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
     size_t collected_cell_bytes = 0;
     size_t live_cell_bytes = 0;
 
+    // Every surviving cell becomes old, so these are rebuilt from scratch.
+    m_remembered_cells.clear();
+    m_old_cells_without_write_barriers.clear();
+    m_old_cell_bytes_without_write_barriers = 0;
+    m_blocks_with_young_cells.clear();
+    m_promoted_bytes_since_last_full_gc = 0;
+
     for_each_block([&](auto& block) {
         bool block_has_live_cells = false;
         bool block_was_full = block.is_full();
+        block.set_has_young_cells(false);
         block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
             if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
                 dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
@@ -504,6 +568,7 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
                 collected_cell_bytes += block.cell_size();
             } else {
                 cell->set_marked(false);
+                promote_to_old_generation(*cell);
                 block_has_live_cells = true;
                 ++live_cells;
                 live_cell_bytes += block.cell_size();
@@ -521,6 +586,7 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
 
     for (auto* block : empty_blocks) {
         dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
+        m_live_heap_blocks.remove(block);
         block->cell_allocator().block_did_become_empty({}, *block);
     }
 
@@ -548,6 +614,7 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
 
         dbgln("Garbage collection report");
         dbgln("=============================================");
+        dbgln("     Collection: Full");
         dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
         dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
@@ -557,6 +624,80 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
     }
 }
 
+void Heap::sweep_dead_young_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+{
+    dbgln_if(HEAP_DEBUG, "sweep_dead_young_cells:");
+    Vector<HeapBlock*, 32> empty_blocks;
+    Vector<HeapBlock*, 32> full_blocks_that_became_usable;
+
+    size_t collected_cells = 0;
+    size_t promoted_cells = 0;
+    size_t collected_cell_bytes = 0;
+    size_t promoted_cell_bytes = 0;
+
+    for (auto* block : m_blocks_with_young_cells) {
+        bool block_has_live_cells = false;
+        bool block_was_full = block->is_full();
+        block->set_has_young_cells(false);
+        block->for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (cell->is_old()) {
+                block_has_live_cells = true;
+                return;
+            }
+            if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
+                dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+                block->deallocate(cell);
+                ++collected_cells;
+                collected_cell_bytes += block->cell_size();
+            } else {
+                cell->set_marked(false);
+                promote_to_old_generation(*cell);
+                block_has_live_cells = true;
+                ++promoted_cells;
+                promoted_cell_bytes += block->cell_size();
+            }
+        });
+        if (!block_has_live_cells)
+            empty_blocks.append(block);
+        else if (block_was_full != block->is_full())
+            full_blocks_that_became_usable.append(block);
+    }
+    m_blocks_with_young_cells.clear();
+
+    for (auto& cell : m_remembered_cells)
+        cell->set_generation_flags({}, cell->generation_flags() & ~Cell::GenerationFlags::Remembered);
+    m_remembered_cells.clear();
+
+    for (auto& weak_container : m_weak_containers)
+        weak_container.remove_dead_cells({});
+
+    for (auto* block : empty_blocks) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
+        m_live_heap_blocks.remove(block);
+        block->cell_allocator().block_did_become_empty({}, *block);
+    }
+
+    for (auto* block : full_blocks_that_became_usable) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock usable again @ {}: cell_size={}", block, block->cell_size());
+        block->cell_allocator().block_did_become_usable({}, *block);
+    }
+
+    m_promoted_bytes_since_last_full_gc += promoted_cell_bytes;
+
+    if (print_report) {
+        Duration const time_spent = measurement_timer.elapsed_time();
+
+        dbgln("Garbage collection report");
+        dbgln("=============================================");
+        dbgln("     Collection: Young generation");
+        dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
+        dbgln(" Promoted cells: {} ({} bytes)", promoted_cells, promoted_cell_bytes);
+        dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
+        dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
+        dbgln("=============================================");
+    }
+}
+
 void Heap::defer_gc()
 {
     ++m_gc_deferrals;
@@ -569,7 +710,7 @@ void Heap::undefer_gc()
 
     if (!m_gc_deferrals) {
         if (m_should_gc_when_deferral_ends)
-            collect_garbage();
+            collect_garbage(m_collection_type_when_deferral_ends);
         m_should_gc_when_deferral_ends = false;
     }
 }
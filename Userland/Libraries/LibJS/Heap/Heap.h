@@ -42,6 +42,7 @@ public:
         auto* memory = allocate_cell<T>();
         defer_gc();
         new (memory) T(forward<Args>(args)...);
+        did_construct_cell<T>(*memory);
         undefer_gc();
         return *static_cast<T*>(memory);
     }
@@ -52,6 +53,7 @@ public:
         auto* memory = allocate_cell<T>();
         defer_gc();
         new (memory) T(forward<Args>(args)...);
+        did_construct_cell<T>(*memory);
         undefer_gc();
         auto* cell = static_cast<T*>(memory);
         memory->initialize(realm);
@@ -61,6 +63,7 @@ public:
     enum class CollectionType {
         CollectGarbage,
         CollectEverything,
+        CollectYoungGeneration,
     };
 
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
@@ -85,6 +88,10 @@ public:
     void did_destroy_execution_context(Badge<ExecutionContext>, ExecutionContext&);
 
     void register_cell_allocator(Badge<CellAllocator>, CellAllocator&);
+    void did_create_block(Badge<CellAllocator>, HeapBlock&);
+    void did_allocate_first_young_cell_in_block(Badge<CellAllocator>, HeapBlock&);
+
+    void remember_cell(Badge<Cell>, Cell&);
 
     void uproot_cell(Cell* cell);
 
@@ -110,15 +117,36 @@ private:
         return allocator_for_size(sizeof(T)).allocate_cell(*this);
     }
 
+    template<typename T>
+    void did_construct_cell(Cell& cell)
+    {
+        // Subclasses may add members of their own without write barriers, so only the declaring class itself counts.
+        if constexpr (requires { typename T::CellTypeWithWriteBarriers; }) {
+            if constexpr (IsSame<T, typename T::CellTypeWithWriteBarriers>)
+                cell.set_generation_flags({}, Cell::GenerationFlags::HasWriteBarriers);
+        }
+    }
+
     void will_allocate(size_t);
 
+    // Every young generation collection visits all remembered cells in full, so the young generation grows with the
+    // heap to keep that cost in proportion to the work a full collection would do instead.
+    size_t young_generation_bytes_threshold() const { return max(YOUNG_GENERATION_MIN_BYTES_THRESHOLD, m_gc_bytes_threshold / 8); }
+
+    // Every young generation collection also has to visit all old cells without write barriers. Once they take up more
+    // of the heap than the young generation does, collecting everything less often is cheaper than that.
+    bool young_generation_collection_is_too_expensive() const { return m_old_cell_bytes_without_write_barriers > young_generation_bytes_threshold(); }
+
     void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address);
     void gather_roots(HashMap<Cell*, HeapRoot>&);
     void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
-    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
+    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells, CollectionType);
     void finalize_unmarked_cells();
+    void finalize_unmarked_young_cells();
     void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+    void sweep_dead_young_cells(bool print_report, Core::ElapsedTimer const&);
+    void promote_to_old_generation(Cell&);
 
     ALWAYS_INLINE CellAllocator& allocator_for_size(size_t cell_size)
     {
@@ -144,6 +172,9 @@ private:
     size_t m_gc_bytes_threshold { GC_MIN_BYTES_THRESHOLD };
     size_t m_allocated_bytes_since_last_gc { 0 };
 
+    static constexpr size_t YOUNG_GENERATION_MIN_BYTES_THRESHOLD { 1 * 1024 * 1024 };
+    size_t m_promoted_bytes_since_last_full_gc { 0 };
+
     bool m_should_collect_on_every_allocation { false };
 
     Vector<NonnullOwnPtr<CellAllocator>> m_size_based_cell_allocators;
@@ -156,8 +187,20 @@ private:
 
     Vector<GCPtr<Cell>> m_uprooted_cells;
 
+    // Old cells that may point to young cells, their edges are roots when collecting the young generation.
+    Vector<NonnullGCPtr<Cell>> m_remembered_cells;
+    Vector<NonnullGCPtr<Cell>> m_old_cells_without_write_barriers;
+    size_t m_old_cell_bytes_without_write_barriers { 0 };
+
+    Vector<HeapBlock*> m_blocks_with_young_cells;
+
+    // Kept up to date as blocks come and go, so that collecting the young generation doesn't have to look at every block
+    // to tell whether a possible pointer points into the heap.
+    HashTable<HeapBlock*> m_live_heap_blocks;
+
     size_t m_gc_deferrals { 0 };
     bool m_should_gc_when_deferral_ends { false };
+    CollectionType m_collection_type_when_deferral_ends { CollectionType::CollectGarbage };
 
     bool m_collecting_garbage { false };
 };
@@ -215,4 +258,20 @@ inline void Heap::register_cell_allocator(Badge<CellAllocator>, CellAllocator& a
     m_all_cell_allocators.append(allocator);
 }
 
+inline void Heap::did_create_block(Badge<CellAllocator>, HeapBlock& block)
+{
+    m_live_heap_blocks.set(&block);
+}
+
+inline void Heap::did_allocate_first_young_cell_in_block(Badge<CellAllocator>, HeapBlock& block)
+{
+    m_blocks_with_young_cells.append(&block);
+}
+
+inline void Heap::remember_cell(Badge<Cell>, Cell& cell)
+{
+    cell.set_generation_flags({}, cell.generation_flags() | Cell::GenerationFlags::Remembered);
+    m_remembered_cells.append(cell);
+}
+
 }
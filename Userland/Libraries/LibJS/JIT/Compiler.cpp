@@ -0,0 +1,699 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Format.h>
+#include <AK/NumericLimits.h>
+#include <AK/WeakPtr.h>
+#include <LibJIT/Assembler.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/JIT/NativeExecutable.h>
+#include <LibJS/Runtime/ExecutionContext.h>
+#include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/ValueInlines.h>
+#include <stdlib.h>
+
+namespace JS::JIT {
+
+enum class Mode {
+    Off,
+    Tiered,
+    Eager,
+};
+
+static Mode mode_from_environment()
+{
+#ifdef AK_OS_SERENITY
+    // Making the generated code executable needs the prot_exec promise, which processes that run JavaScript don't pledge.
+    return Mode::Off;
+#else
+    auto const* value = getenv("LIBJS_JIT");
+    if (!value)
+        return Mode::Tiered;
+    auto mode = StringView { value, strlen(value) };
+    if (mode == "off"sv || mode == "0"sv)
+        return Mode::Off;
+    if (mode == "eager"sv)
+        return Mode::Eager;
+    return Mode::Tiered;
+#endif
+}
+
+static Mode const s_mode = mode_from_environment();
+
+u32 Compiler::s_invocation_threshold = s_mode == Mode::Eager ? 1 : default_invocation_threshold;
+u32 Compiler::s_back_edge_threshold = s_mode == Mode::Eager ? 1 : default_back_edge_threshold;
+
+void Compiler::compile_if_possible(Bytecode::Executable& executable)
+{
+    if (s_mode == Mode::Off || executable.did_try_jit_compilation)
+        return;
+    executable.did_try_jit_compilation = true;
+    executable.native_executable = compile(executable);
+}
+
+#ifdef JIT_ARCH_SUPPORTED
+
+using Assembler = ::JIT::Assembler;
+using Reg = Assembler::Reg;
+using Condition = Assembler::Condition;
+
+// These hold their values for the whole run of the native code. All of them are callee-saved, so they survive calls
+// into C++. Note that R12 and R13 can't be used as the base of a memory operand by our assembler.
+static constexpr Reg REGISTERS_BASE = Reg::RBX;
+static constexpr Reg LOCALS_BASE = Reg::R15;
+static constexpr Reg EXECUTION_CONTEXT = Reg::R14;
+static constexpr Reg INTERPRETER = Reg::R13;
+
+static constexpr Reg ARG0 = Reg::RDI;
+static constexpr Reg ARG1 = Reg::RSI;
+static constexpr Reg ARG2 = Reg::RDX;
+static constexpr Reg RETURN_VALUE = Reg::RAX;
+
+static constexpr Reg GPR0 = Reg::RAX;
+static constexpr Reg GPR1 = Reg::RCX;
+static constexpr Reg GPR2 = Reg::RDX;
+static constexpr Reg SCRATCH = Reg::R11;
+
+static auto reg(Reg r) { return Assembler::Operand::Register(r); }
+static auto imm(u64 value) { return Assembler::Operand::Imm(value); }
+static auto mem(Reg base, u64 offset) { return Assembler::Operand::Mem64BaseAndOffset(base, offset); }
+
+// Executes a single instruction through the interpreter, for everything that doesn't have a native implementation.
+// Returns true if the instruction threw an exception, which has been stored in the exception register.
+static u64 cxx_execute_instruction(Bytecode::Interpreter& interpreter, Bytecode::BasicBlock const& block, Bytecode::Instruction const& instruction)
+{
+    interpreter.set_current_instruction(block, instruction);
+    auto result = instruction.execute(interpreter);
+    if (result.is_error()) [[unlikely]] {
+        interpreter.reg(Bytecode::Register::exception()) = *result.throw_completion().value();
+        return true;
+    }
+    return false;
+}
+
+static u64 cxx_to_boolean(u64 encoded_value)
+{
+    return bit_cast<Value>(encoded_value).to_boolean();
+}
+
+class CodeGenerator {
+public:
+    CodeGenerator(Bytecode::Executable& executable, Vector<u8>& output)
+        : m_executable(executable)
+        , m_assembler(output)
+        , m_output(output)
+    {
+    }
+
+    Vector<size_t> generate();
+
+private:
+    void load_operand(Reg, Bytecode::Operand);
+    void store_operand(Bytecode::Operand, Reg);
+    void reload_base_pointers();
+    void jump_unless_int32(Reg, Assembler::Label&);
+    void box_int32(Reg);
+    Assembler::Label& label_for(Bytecode::Label const&);
+
+    void compile_instruction(Bytecode::Instruction const&);
+    void compile_generic(Bytecode::Instruction const&);
+
+    void compile_jump_if(Bytecode::Op::JumpIf const&);
+    void compile_jump_nullish(Bytecode::Op::JumpNullish const&);
+    void compile_jump_undefined(Bytecode::Op::JumpUndefined const&);
+
+    enum class Int32Operation {
+        Add,
+        Sub,
+        Mul,
+        BitwiseAnd,
+        BitwiseOr,
+        BitwiseXor,
+        LeftShift,
+        RightShift,
+        UnsignedRightShift,
+    };
+    void compile_int32_arithmetic(Bytecode::Instruction const&, Bytecode::Operand dst, Bytecode::Operand lhs, Bytecode::Operand rhs, Int32Operation);
+    void compile_int32_comparison(Bytecode::Instruction const&, Bytecode::Operand dst, Bytecode::Operand lhs, Bytecode::Operand rhs, Condition);
+    void compile_increment_or_decrement(Bytecode::Instruction const&, Bytecode::Operand dst, Bytecode::Operand src, bool increment, bool is_postfix);
+
+    void compile_get_by_id(Bytecode::Op::GetById const&);
+    void compile_put_by_id(Bytecode::Op::PutById const&);
+    void load_object_with_cached_shape(Reg object, u32 cache_index, Assembler::Label& slow_case);
+    void load_cached_property_slot(Reg object, u32 cache_index);
+
+    Bytecode::Executable& m_executable;
+    Assembler m_assembler;
+    Vector<u8>& m_output;
+
+    Vector<Assembler::Label> m_block_labels;
+    Assembler::Label m_exit_label;
+    Bytecode::BasicBlock const* m_current_block { nullptr };
+};
+
+Vector<size_t> CodeGenerator::generate()
+{
+    m_block_labels.resize(m_executable.basic_blocks.size());
+
+    // Prologue: Set up the registers we keep for the whole run, then jump to the block we were asked to start at.
+    m_assembler.enter();
+    m_assembler.mov(reg(INTERPRETER), reg(ARG0));
+    m_assembler.mov(reg(EXECUTION_CONTEXT), reg(ARG1));
+    reload_base_pointers();
+    m_assembler.jump(reg(ARG2));
+
+    Vector<size_t> block_entry_offsets;
+    block_entry_offsets.ensure_capacity(m_executable.basic_blocks.size());
+
+    for (auto const& block : m_executable.basic_blocks) {
+        m_current_block = block;
+        block_entry_offsets.unchecked_append(m_output.size());
+        m_block_labels[block->index()].link(m_assembler);
+
+        Bytecode::InstructionStreamIterator it { block->instruction_stream(), &m_executable };
+        while (!it.at_end()) {
+            compile_instruction(*it);
+            ++it;
+        }
+
+        // Falling off the end of a block ends the executable, same as in the interpreter.
+        m_assembler.jump(m_exit_label);
+    }
+
+    m_exit_label.link(m_assembler);
+    m_assembler.exit();
+
+    return block_entry_offsets;
+}
+
+void CodeGenerator::load_operand(Reg dst, Bytecode::Operand operand)
+{
+    switch (operand.type()) {
+    case Bytecode::Operand::Type::Register:
+        m_assembler.mov(reg(dst), mem(REGISTERS_BASE, operand.index() * sizeof(Value)));
+        return;
+    case Bytecode::Operand::Type::Local:
+        m_assembler.mov(reg(dst), mem(LOCALS_BASE, operand.index() * sizeof(Value)));
+        return;
+    case Bytecode::Operand::Type::Constant:
+        // The constants are kept alive by the executable, which also owns this code.
+        m_assembler.mov(reg(dst), imm(m_executable.constants[operand.index()].encoded()));
+        return;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void CodeGenerator::store_operand(Bytecode::Operand operand, Reg src)
+{
+    switch (operand.type()) {
+    case Bytecode::Operand::Type::Register:
+        m_assembler.mov(mem(REGISTERS_BASE, operand.index() * sizeof(Value)), reg(src));
+        return;
+    case Bytecode::Operand::Type::Local:
+        m_assembler.mov(mem(LOCALS_BASE, operand.index() * sizeof(Value)), reg(src));
+        return;
+    case Bytecode::Operand::Type::Constant:
+        break;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void CodeGenerator::reload_base_pointers()
+{
+    // The vectors holding the registers and locals are not supposed to be resized while the executable is running,
+    // but this is cheap compared to the calls after which we do it, so let's not rely on that.
+    m_assembler.mov(reg(REGISTERS_BASE), mem(EXECUTION_CONTEXT, __builtin_offsetof(ExecutionContext, registers) + Vector<Value>::outline_buffer_offset()));
+    m_assembler.mov(reg(LOCALS_BASE), mem(EXECUTION_CONTEXT, __builtin_offsetof(ExecutionContext, locals) + Vector<Value>::outline_buffer_offset()));
+}
+
+void CodeGenerator::jump_unless_int32(Reg value, Assembler::Label& label)
+{
+    m_assembler.mov(reg(SCRATCH), reg(value));
+    m_assembler.shift_right(reg(SCRATCH), imm(TAG_SHIFT));
+    m_assembler.cmp(reg(SCRATCH), imm(INT32_TAG));
+    m_assembler.jump_if(Condition::NotEqualTo, label);
+}
+
+void CodeGenerator::box_int32(Reg value)
+{
+    // The upper half of the register has to be clear already, which is the case after any 32-bit operation.
+    m_assembler.mov(reg(SCRATCH), imm(SHIFTED_INT32_TAG));
+    m_assembler.bitwise_or(reg(value), reg(SCRATCH));
+}
+
+Assembler::Label& CodeGenerator::label_for(Bytecode::Label const& label)
+{
+    return m_block_labels[label.block().index()];
+}
+
+void CodeGenerator::compile_generic(Bytecode::Instruction const& instruction)
+{
+    m_assembler.mov(reg(ARG0), reg(INTERPRETER));
+    m_assembler.mov(reg(ARG1), imm(bit_cast<u64>(m_current_block)));
+    m_assembler.mov(reg(ARG2), imm(bit_cast<u64>(&instruction)));
+    m_assembler.native_call(bit_cast<u64>(&cxx_execute_instruction));
+    reload_base_pointers();
+
+    // There are no exception handlers in the executables we compile, so any exception ends the executable.
+    m_assembler.cmp(reg(RETURN_VALUE), imm(0));
+    m_assembler.jump_if(Condition::NotEqualTo, m_exit_label);
+}
+
+void CodeGenerator::compile_instruction(Bytecode::Instruction const& instruction)
+{
+    using Type = Bytecode::Instruction::Type;
+
+    switch (instruction.type()) {
+    case Type::Mov: {
+        auto const& mov = static_cast<Bytecode::Op::Mov const&>(instruction);
+        load_operand(GPR0, mov.src());
+        store_operand(mov.dst(), GPR0);
+        return;
+    }
+    case Type::SetLocal: {
+        auto const& set_local = static_cast<Bytecode::Op::SetLocal const&>(instruction);
+        load_operand(GPR0, set_local.src());
+        store_operand(set_local.dst(), GPR0);
+        return;
+    }
+    case Type::End:
+        load_operand(GPR0, static_cast<Bytecode::Op::End const&>(instruction).value());
+        store_operand(Bytecode::Operand(Bytecode::Register::accumulator()), GPR0);
+        m_assembler.jump(m_exit_label);
+        return;
+    case Type::Return:
+        compile_generic(instruction);
+        m_assembler.jump(m_exit_label);
+        return;
+    case Type::Jump:
+        m_assembler.jump(label_for(*static_cast<Bytecode::Op::Jump const&>(instruction).true_target()));
+        return;
+    case Type::JumpIf:
+        compile_jump_if(static_cast<Bytecode::Op::JumpIf const&>(instruction));
+        return;
+    case Type::JumpNullish:
+        compile_jump_nullish(static_cast<Bytecode::Op::JumpNullish const&>(instruction));
+        return;
+    case Type::JumpUndefined:
+        compile_jump_undefined(static_cast<Bytecode::Op::JumpUndefined const&>(instruction));
+        return;
+
+#    define COMPILE_INT32_ARITHMETIC(OpTitleCase)                                                              \
+    case Type::OpTitleCase: {                                                                                   \
+        auto const& op = static_cast<Bytecode::Op::OpTitleCase const&>(instruction);                            \
+        compile_int32_arithmetic(instruction, op.dst(), op.lhs(), op.rhs(), Int32Operation::OpTitleCase); \
+        return;                                                                                                 \
+    }
+        COMPILE_INT32_ARITHMETIC(Add)
+        COMPILE_INT32_ARITHMETIC(Sub)
+        COMPILE_INT32_ARITHMETIC(Mul)
+        COMPILE_INT32_ARITHMETIC(BitwiseAnd)
+        COMPILE_INT32_ARITHMETIC(BitwiseOr)
+        COMPILE_INT32_ARITHMETIC(BitwiseXor)
+        COMPILE_INT32_ARITHMETIC(LeftShift)
+        COMPILE_INT32_ARITHMETIC(RightShift)
+        COMPILE_INT32_ARITHMETIC(UnsignedRightShift)
+#    undef COMPILE_INT32_ARITHMETIC
+
+#    define COMPILE_INT32_COMPARISON(OpTitleCase, condition)                                   \
+    case Type::OpTitleCase: {                                                                   \
+        auto const& op = static_cast<Bytecode::Op::OpTitleCase const&>(instruction);            \
+        compile_int32_comparison(instruction, op.dst(), op.lhs(), op.rhs(), Condition::condition); \
+        return;                                                                                 \
+    }
+        COMPILE_INT32_COMPARISON(LessThan, SignedLessThan)
+        COMPILE_INT32_COMPARISON(LessThanEquals, SignedLessThanOrEqualTo)
+        COMPILE_INT32_COMPARISON(GreaterThan, SignedGreaterThan)
+        COMPILE_INT32_COMPARISON(GreaterThanEquals, SignedGreaterThanOrEqualTo)
+        COMPILE_INT32_COMPARISON(StrictlyEquals, EqualTo)
+        COMPILE_INT32_COMPARISON(StrictlyInequals, NotEqualTo)
+#    undef COMPILE_INT32_COMPARISON
+
+    case Type::Increment: {
+        auto dst = static_cast<Bytecode::Op::Increment const&>(instruction).dst();
+        compile_increment_or_decrement(instruction, dst, dst, true, false);
+        return;
+    }
+    case Type::Decrement: {
+        auto dst = static_cast<Bytecode::Op::Decrement const&>(instruction).dst();
+        compile_increment_or_decrement(instruction, dst, dst, false, false);
+        return;
+    }
+    case Type::PostfixIncrement: {
+        auto const& op = static_cast<Bytecode::Op::PostfixIncrement const&>(instruction);
+        compile_increment_or_decrement(instruction, op.dst(), op.src(), true, true);
+        return;
+    }
+    case Type::PostfixDecrement: {
+        auto const& op = static_cast<Bytecode::Op::PostfixDecrement const&>(instruction);
+        compile_increment_or_decrement(instruction, op.dst(), op.src(), false, true);
+        return;
+    }
+    case Type::GetById:
+        compile_get_by_id(static_cast<Bytecode::Op::GetById const&>(instruction));
+        return;
+    case Type::PutById:
+        compile_put_by_id(static_cast<Bytecode::Op::PutById const&>(instruction));
+        return;
+    default:
+        compile_generic(instruction);
+        return;
+    }
+}
+
+void CodeGenerator::compile_jump_if(Bytecode::Op::JumpIf const& op)
+{
+    auto& true_label = label_for(*op.true_target());
+    auto& false_label = label_for(*op.false_target());
+
+    load_operand(GPR0, op.condition());
+
+    // Booleans and Int32s are checked inline, everything else goes through Value::to_boolean().
+    Assembler::Label not_boolean;
+    m_assembler.mov(reg(GPR1), reg(GPR0));
+    m_assembler.shift_right(reg(GPR1), imm(TAG_SHIFT));
+    m_assembler.cmp(reg(GPR1), imm(BOOLEAN_TAG));
+    m_assembler.jump_if(Condition::NotEqualTo, not_boolean);
+    m_assembler.test(reg(GPR0), imm(1));
+    m_assembler.jump_if(Condition::NotEqualTo, true_label);
+    m_assembler.jump(false_label);
+
+    not_boolean.link(m_assembler);
+    Assembler::Label not_int32;
+    m_assembler.cmp(reg(GPR1), imm(INT32_TAG));
+    m_assembler.jump_if(Condition::NotEqualTo, not_int32);
+    m_assembler.mov32(reg(GPR0), reg(GPR0));
+    m_assembler.cmp(reg(GPR0), imm(0));
+    m_assembler.jump_if(Condition::NotEqualTo, true_label);
+    m_assembler.jump(false_label);
+
+    not_int32.link(m_assembler);
+    m_assembler.mov(reg(ARG0), reg(GPR0));
+    m_assembler.native_call(bit_cast<u64>(&cxx_to_boolean));
+    m_assembler.cmp(reg(RETURN_VALUE), imm(0));
+    m_assembler.jump_if(Condition::NotEqualTo, true_label);
+    m_assembler.jump(false_label);
+}
+
+void CodeGenerator::compile_jump_nullish(Bytecode::Op::JumpNullish const& op)
+{
+    load_operand(GPR0, op.condition());
+    m_assembler.shift_right(reg(GPR0), imm(TAG_SHIFT));
+    m_assembler.bitwise_and(reg(GPR0), imm(IS_NULLISH_EXTRACT_PATTERN));
+    m_assembler.cmp(reg(GPR0), imm(IS_NULLISH_PATTERN));
+    m_assembler.jump_if(Condition::EqualTo, label_for(*op.true_target()));
+    m_assembler.jump(label_for(*op.false_target()));
+}
+
+void CodeGenerator::compile_jump_undefined(Bytecode::Op::JumpUndefined const& op)
+{
+    load_operand(GPR0, op.condition());
+    m_assembler.mov(reg(GPR1), imm(js_undefined().encoded()));
+    m_assembler.cmp(reg(GPR0), reg(GPR1));
+    m_assembler.jump_if(Condition::EqualTo, label_for(*op.true_target()));
+    m_assembler.jump(label_for(*op.false_target()));
+}
+
+void CodeGenerator::compile_int32_arithmetic(Bytecode::Instruction const& instruction, Bytecode::Operand dst, Bytecode::Operand lhs, Bytecode::Operand rhs, Int32Operation operation)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_operand(GPR0, lhs);
+    load_operand(GPR1, rhs);
+    jump_unless_int32(GPR0, slow_case);
+    jump_unless_int32(GPR1, slow_case);
+
+    // Anything that doesn't fit into an Int32 is left to the interpreter, which will produce a double.
+    switch (operation) {
+    case Int32Operation::Add:
+        m_assembler.add32(reg(GPR0), reg(GPR1), slow_case);
+        box_int32(GPR0);
+        break;
+    case Int32Operation::Sub:
+        m_assembler.sub32(reg(GPR0), reg(GPR1), slow_case);
+        box_int32(GPR0);
+        break;
+    case Int32Operation::Mul:
+        m_assembler.mul32(reg(GPR0), reg(GPR1), slow_case);
+        // A zero result might have to be -0, which is not an Int32.
+        m_assembler.cmp(reg(GPR0), imm(0));
+        m_assembler.jump_if(Condition::EqualTo, slow_case);
+        box_int32(GPR0);
+        break;
+    case Int32Operation::BitwiseAnd:
+        // Both values have the same tag, which survives ANDing or ORing them together.
+        m_assembler.bitwise_and(reg(GPR0), reg(GPR1));
+        break;
+    case Int32Operation::BitwiseOr:
+        m_assembler.bitwise_or(reg(GPR0), reg(GPR1));
+        break;
+    case Int32Operation::BitwiseXor:
+        m_assembler.bitwise_xor32(reg(GPR0), reg(GPR1));
+        box_int32(GPR0);
+        break;
+    case Int32Operation::LeftShift:
+        // The shift count is taken from CL, and masked to five bits just like ECMAScript requires.
+        m_assembler.shift_left32(reg(GPR0), {});
+        box_int32(GPR0);
+        break;
+    case Int32Operation::RightShift:
+        m_assembler.arithmetic_right_shift32(reg(GPR0), {});
+        box_int32(GPR0);
+        break;
+    case Int32Operation::UnsignedRightShift:
+        m_assembler.shift_right32(reg(GPR0), {});
+        // The result is unsigned, so it only fits into an Int32 if the highest bit is clear.
+        m_assembler.cmp(reg(GPR0), imm(NumericLimits<i32>::max()));
+        m_assembler.jump_if(Condition::UnsignedGreaterThan, slow_case);
+        box_int32(GPR0);
+        break;
+    }
+
+    store_operand(dst, GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(instruction);
+    done.link(m_assembler);
+}
+
+void CodeGenerator::compile_int32_comparison(Bytecode::Instruction const& instruction, Bytecode::Operand dst, Bytecode::Operand lhs, Bytecode::Operand rhs, Condition condition)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_operand(GPR0, lhs);
+    load_operand(GPR1, rhs);
+    jump_unless_int32(GPR0, slow_case);
+    jump_unless_int32(GPR1, slow_case);
+
+    m_assembler.sign_extend_32_to_64_bits(GPR0);
+    m_assembler.sign_extend_32_to_64_bits(GPR1);
+
+    // The lowest byte of the boolean tag is zero, so SETcc turns it into the boxed result.
+    m_assembler.mov(reg(GPR2), imm(SHIFTED_BOOLEAN_TAG));
+    m_assembler.cmp(reg(GPR0), reg(GPR1));
+    m_assembler.set_if(condition, reg(GPR2));
+    store_operand(dst, GPR2);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(instruction);
+    done.link(m_assembler);
+}
+
+void CodeGenerator::compile_increment_or_decrement(Bytecode::Instruction const& instruction, Bytecode::Operand dst, Bytecode::Operand src, bool increment, bool is_postfix)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_operand(GPR0, src);
+    jump_unless_int32(GPR0, slow_case);
+
+    // The postfix variants store the old value before updating the source operand.
+    m_assembler.mov(reg(GPR1), reg(GPR0));
+    if (increment)
+        m_assembler.inc32(reg(GPR0), slow_case);
+    else
+        m_assembler.dec32(reg(GPR0), slow_case);
+    box_int32(GPR0);
+
+    if (is_postfix) {
+        store_operand(dst, GPR1);
+        store_operand(src, GPR0);
+    } else {
+        store_operand(dst, GPR0);
+    }
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(instruction);
+    done.link(m_assembler);
+}
+
+void CodeGenerator::load_object_with_cached_shape(Reg object, u32 cache_index, Assembler::Label& slow_case)
+{
+    // if (!value.is_object()) goto slow_case;
+    m_assembler.mov(reg(GPR2), reg(object));
+    m_assembler.shift_right(reg(GPR2), imm(TAG_SHIFT));
+    m_assembler.cmp(reg(GPR2), imm(OBJECT_TAG));
+    m_assembler.jump_if(Condition::NotEqualTo, slow_case);
+
+    // object = value.as_object(), by sign-extending the pointer from the lower 48 bits.
+    m_assembler.shift_left(reg(object), imm(16));
+    m_assembler.arithmetic_right_shift(reg(object), imm(16));
+
+    // if (cache.shape != &object->shape()) goto slow_case;
+    // The cache only holds a weak pointer to the shape, which consists of a pointer to the WeakLink.
+    static_assert(sizeof(WeakPtr<Shape>) == sizeof(void*));
+    auto& cache = m_executable.property_lookup_caches[cache_index];
+    m_assembler.mov(reg(GPR2), imm(bit_cast<u64>(&cache)));
+    m_assembler.mov(reg(GPR2), mem(GPR2, __builtin_offsetof(Bytecode::PropertyLookupCache, shape)));
+    m_assembler.cmp(reg(GPR2), imm(0));
+    m_assembler.jump_if(Condition::EqualTo, slow_case);
+    m_assembler.mov(reg(GPR2), mem(GPR2, AK::WeakLink::ptr_offset()));
+    m_assembler.mov(reg(SCRATCH), mem(object, Object::shape_offset()));
+    m_assembler.cmp(reg(SCRATCH), reg(GPR2));
+    m_assembler.jump_if(Condition::NotEqualTo, slow_case);
+}
+
+void CodeGenerator::load_cached_property_slot(Reg object, u32 cache_index)
+{
+    // object = &object->m_storage[cache.property_offset.value()]
+    // The value of an Optional is stored at its very beginning.
+    auto& cache = m_executable.property_lookup_caches[cache_index];
+    m_assembler.mov(reg(GPR2), imm(bit_cast<u64>(&cache)));
+    m_assembler.mov32(reg(GPR2), mem(GPR2, __builtin_offsetof(Bytecode::PropertyLookupCache, property_offset)));
+    m_assembler.shift_left(reg(GPR2), imm(3));
+    m_assembler.mov(reg(object), mem(object, Object::storage_offset() + Vector<Value>::outline_buffer_offset()));
+    m_assembler.add(reg(object), reg(GPR2));
+}
+
+void CodeGenerator::compile_get_by_id(Bytecode::Op::GetById const& op)
+{
+    // The magical length property of arrays is not cached, and is handled by the interpreter's fast path instead.
+    if (m_executable.get_identifier(op.property()) == "length"sv) {
+        compile_generic(op);
+        return;
+    }
+
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_operand(GPR0, op.base());
+    load_object_with_cached_shape(GPR0, op.cache_index(), slow_case);
+    load_cached_property_slot(GPR0, op.cache_index());
+    m_assembler.mov(reg(GPR0), mem(GPR0, 0));
+    store_operand(op.dst(), GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(op);
+    done.link(m_assembler);
+}
+
+void CodeGenerator::compile_put_by_id(Bytecode::Op::PutById const& op)
+{
+    if (op.kind() != Bytecode::Op::PropertyKind::KeyValue) {
+        compile_generic(op);
+        return;
+    }
+
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    Assembler::Label no_write_barrier;
+
+    load_operand(GPR0, op.base());
+    load_object_with_cached_shape(GPR0, op.cache_index(), slow_case);
+    load_operand(GPR1, op.src());
+
+    // Storing a cell into an old object needs a write barrier, so leave that to Object::put_direct().
+    // if (value.is_cell() && object->generation_flags() == (Old | HasWriteBarriers)) goto slow_case;
+    m_assembler.mov(reg(GPR2), reg(GPR1));
+    m_assembler.shift_right(reg(GPR2), imm(TAG_SHIFT));
+    m_assembler.bitwise_and(reg(GPR2), imm(IS_CELL_PATTERN));
+    m_assembler.cmp(reg(GPR2), imm(IS_CELL_PATTERN));
+    m_assembler.jump_if(Condition::NotEqualTo, no_write_barrier);
+    m_assembler.mov8(reg(GPR2), mem(GPR0, Cell::generation_flags_offset()));
+    m_assembler.cmp(reg(GPR2), imm(Cell::GenerationFlags::Old | Cell::GenerationFlags::HasWriteBarriers));
+    m_assembler.jump_if(Condition::EqualTo, slow_case);
+    no_write_barrier.link(m_assembler);
+
+    load_cached_property_slot(GPR0, op.cache_index());
+    m_assembler.mov(mem(GPR0, 0), reg(GPR1));
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(op);
+    done.link(m_assembler);
+}
+
+static bool can_compile(Bytecode::Executable const& executable)
+{
+    for (size_t i = 0; i < executable.basic_blocks.size(); ++i) {
+        auto const& block = *executable.basic_blocks[i];
+        if (block.index() != i)
+            return false;
+
+        // Unwinding is deeply tied to the interpreter's dispatch loop, so anything that might involve it is not supported.
+        if (block.handler() || block.finalizer())
+            return false;
+
+        Bytecode::InstructionStreamIterator it { block.instruction_stream(), &executable };
+        while (!it.at_end()) {
+            switch ((*it).type()) {
+            case Bytecode::Instruction::Type::Await:
+            case Bytecode::Instruction::Type::Catch:
+            case Bytecode::Instruction::Type::ContinuePendingUnwind:
+            case Bytecode::Instruction::Type::EnterUnwindContext:
+            case Bytecode::Instruction::Type::LeaveFinally:
+            case Bytecode::Instruction::Type::LeaveUnwindContext:
+            case Bytecode::Instruction::Type::RestoreScheduledJump:
+            case Bytecode::Instruction::Type::ScheduleJump:
+            case Bytecode::Instruction::Type::Yield:
+                return false;
+            default:
+                break;
+            }
+            ++it;
+        }
+    }
+    return true;
+}
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable& executable)
+{
+    if (!can_compile(executable)) {
+        dbgln_if(JIT_DEBUG, "JIT: Can't compile executable \"{}\"", executable.name);
+        return nullptr;
+    }
+
+    Vector<u8> code;
+    CodeGenerator generator(executable, code);
+    auto block_entry_offsets = generator.generate();
+
+    auto native_executable = NativeExecutable::create(code, move(block_entry_offsets));
+    dbgln_if(JIT_DEBUG, "JIT: Compiled executable \"{}\" into {} bytes of native code", executable.name, code.size());
+    return native_executable;
+}
+
+#else
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable&)
+{
+    return nullptr;
+}
+
+#endif
+
+}
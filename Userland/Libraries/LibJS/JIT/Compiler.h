@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/OwnPtr.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Forward.h>
+
+namespace JS::JIT {
+
+// The baseline JIT translates the instructions of an executable one by one into machine code. Common cases like Int32
+// arithmetic, comparisons, jumps and cached property accesses are handled inline, everything else calls back into the
+// interpreter's implementation of the instruction. All values stay in the registers and locals of the execution
+// context, so execution can switch from the interpreter to native code at the start of any basic block.
+class Compiler {
+public:
+    // An executable is compiled once it has been run this many times, or once this many jumps back to the start
+    // of a loop have been taken in it. These can be changed with the LIBJS_JIT environment variable:
+    // "off" disables the JIT, "eager" compiles every executable the first time it is run.
+    // The JIT is always off on SerenityOS, where mapping the generated code as executable needs the prot_exec promise.
+    static constexpr u32 default_invocation_threshold = 16;
+    static constexpr u32 default_back_edge_threshold = 1000;
+
+    ALWAYS_INLINE static void did_invoke(Bytecode::Executable& executable)
+    {
+        if (++executable.invocation_count == s_invocation_threshold) [[unlikely]]
+            compile_if_possible(executable);
+    }
+
+    ALWAYS_INLINE static void did_take_back_edge(Bytecode::Executable& executable)
+    {
+        if (++executable.back_edge_count == s_back_edge_threshold) [[unlikely]]
+            compile_if_possible(executable);
+    }
+
+    // Returns null if the JIT does not support the platform or some of the instructions in the executable.
+    static OwnPtr<NativeExecutable> compile(Bytecode::Executable&);
+
+private:
+    static void compile_if_possible(Bytecode::Executable&);
+
+    static u32 s_invocation_threshold;
+    static u32 s_back_edge_threshold;
+};
+
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/JIT/NativeExecutable.h>
+#include <sys/mman.h>
+
+namespace JS::JIT {
+
+OwnPtr<NativeExecutable> NativeExecutable::create(ReadonlyBytes code, Vector<size_t> block_entry_offsets)
+{
+    auto* memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (memory == MAP_FAILED)
+        return nullptr;
+
+    memcpy(memory, code.data(), code.size());
+
+    // The code is never modified after this point, so the memory doesn't have to stay writable.
+    if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) < 0) {
+        munmap(memory, code.size());
+        return nullptr;
+    }
+
+    auto executable = adopt_own_if_nonnull(new (nothrow) NativeExecutable(memory, code.size(), move(block_entry_offsets)));
+    if (!executable)
+        munmap(memory, code.size());
+    return executable;
+}
+
+NativeExecutable::NativeExecutable(void* code, size_t size, Vector<size_t> block_entry_offsets)
+    : m_code(code)
+    , m_size(size)
+    , m_block_entry_offsets(move(block_entry_offsets))
+{
+}
+
+NativeExecutable::~NativeExecutable()
+{
+    munmap(m_code, m_size);
+}
+
+void NativeExecutable::run(Bytecode::Interpreter& interpreter, ExecutionContext& context, Bytecode::BasicBlock const& entry_block) const
+{
+    // The generated code starts with a common prologue, which jumps to the entry point that is passed in.
+    using EntryFunction = void (*)(Bytecode::Interpreter&, ExecutionContext&, FlatPtr entry_point);
+    auto const entry_point = bit_cast<FlatPtr>(m_code) + m_block_entry_offsets[entry_block.index()];
+    bit_cast<EntryFunction>(m_code)(interpreter, context, entry_point);
+}
+
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+
+namespace JS::JIT {
+
+// The machine code generated for a Bytecode::Executable. Execution can be entered at the start of any basic block,
+// which allows switching over from the interpreter in the middle of a hot loop.
+class NativeExecutable {
+    AK_MAKE_NONCOPYABLE(NativeExecutable);
+    AK_MAKE_NONMOVABLE(NativeExecutable);
+
+public:
+    static OwnPtr<NativeExecutable> create(ReadonlyBytes code, Vector<size_t> block_entry_offsets);
+    ~NativeExecutable();
+
+    // Runs the code from the start of the given block until the executable returns, ends or throws an exception,
+    // exactly like Bytecode::Interpreter::run_bytecode() would.
+    void run(Bytecode::Interpreter&, ExecutionContext&, Bytecode::BasicBlock const& entry_block) const;
+
+    size_t code_size() const { return m_size; }
+
+private:
+    NativeExecutable(void* code, size_t size, Vector<size_t> block_entry_offsets);
+
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    Vector<size_t> m_block_entry_offsets;
+};
+
+}
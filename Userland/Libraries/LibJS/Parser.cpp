@@ -16,6 +16,7 @@
 #include <AK/ScopeGuard.h>
 #include <AK/StdLibExtras.h>
 #include <AK/TemporaryChange.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Runtime/RegExpObject.h>
 #include <LibRegex/Regex.h>
 
@@ -709,6 +710,12 @@ bool Parser::parse_directive(ScopeNode& body)
     return found_use_strict;
 }
 
+void Parser::allow_bytecode_caching()
+{
+    if (Bytecode::ExecutableCache::the())
+        m_source_code->enable_node_index(m_program_type == Program::Type::Module);
+}
+
 NonnullRefPtr<Program> Parser::parse_program(bool starts_in_strict_mode)
 {
     auto rule_start = push_start();
@@ -57,6 +57,10 @@ public:
 
     NonnullRefPtr<Program> parse_program(bool starts_in_strict_mode = false);
 
+    // Lets the bytecode generated for the parsed code be stored in (and loaded from) the on-disk bytecode cache, if it is
+    // enabled. This must be called before parsing anything.
+    void allow_bytecode_caching();
+
     template<typename FunctionNodeType>
     NonnullRefPtr<FunctionNodeType> parse_function_node(u16 parse_options = FunctionNodeParseOptions::CheckForFunctionAndName, Optional<Position> const& function_start = {});
     Vector<FunctionParameter> parse_formal_parameters(int& function_length, u16 parse_options = 0);
@@ -190,6 +190,12 @@ ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM& vm, Object co
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
+        // OPTIMIZATION: Own elements can be read straight out of the storage.
+        if (auto value = fast_own_element(object, k); !value.is_empty()) {
+            items.append(value);
+            continue;
+        }
+
         bool k_read;
 
         // b. If holes is skip-holes, then
@@ -22,6 +22,7 @@ namespace JS {
 class Array : public Object {
     JS_OBJECT(Array, Object);
     JS_DECLARE_ALLOCATOR(Array);
+    JS_DECLARE_WRITE_BARRIERS(Array);
 
 public:
     static ThrowCompletionOr<NonnullGCPtr<Array>> create(Realm&, u64 length, Object* prototype = nullptr);
@@ -66,4 +67,32 @@ enum class Holes {
 ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM&, Object const&, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes);
 ThrowCompletionOr<double> compare_array_elements(VM&, Value x, Value y, FunctionObject* comparefn);
 
+// OPTIMIZATION: An element in the simple storage of an object that doesn't intercept indexed property access is an own
+// data property, so HasProperty() is true for it and Get() returns it. Returns an empty value when that isn't known.
+inline Value fast_own_element(Object const& object, size_t index)
+{
+    if (object.may_interfere_with_indexed_property_access() || index >= NumericLimits<u32>::max())
+        return {};
+    auto const* storage = object.indexed_properties().storage();
+    if (!storage || !storage->is_simple_storage())
+        return {};
+    auto const& simple_storage = static_cast<SimpleIndexedPropertyStorage const&>(*storage);
+    auto value = simple_storage.element_at(index);
+    if (!simple_storage.holds_only_numbers() && value.is_accessor())
+        return {};
+    return value;
+}
+
+// OPTIMIZATION: Whether every element below the length is known to be a number, without looking at any of them.
+inline bool holds_only_numbers_below(Object const& object, size_t length)
+{
+    if (object.may_interfere_with_indexed_property_access())
+        return false;
+    auto const* storage = object.indexed_properties().storage();
+    if (!storage || !storage->is_simple_storage())
+        return false;
+    auto const& simple_storage = static_cast<SimpleIndexedPropertyStorage const&>(*storage);
+    return simple_storage.is_packed() && simple_storage.holds_only_numbers() && length <= simple_storage.array_like_size();
+}
+
 }
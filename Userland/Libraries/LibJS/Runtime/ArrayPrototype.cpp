@@ -416,12 +416,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::filter)
         auto property_key = PropertyKey { k };
 
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
+        // OPTIMIZATION: Own elements are known to be present, and don't have to be looked up again below.
+        // NOTE: The callback may change the array, so this has to be checked for every element.
+        auto k_value = fast_own_element(object, k);
+        auto k_present = !k_value.is_empty() || TRY(object->has_property(property_key));
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(k));
+            if (k_value.is_empty())
+                k_value = TRY(object->get(k));
 
             // ii. Let selected be ToBoolean(? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »)).
             auto selected = TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object)).to_boolean();
@@ -742,8 +746,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = from_argument;
     }
     auto value_to_find = vm.argument(0);
+
+    // OPTIMIZATION: Only a number can be found in an array of numbers.
+    if (!value_to_find.is_number() && holds_only_numbers_below(this_object, length))
+        return Value(false);
+
     for (u64 i = from_index; i < length; ++i) {
-        auto element = TRY(this_object->get(i));
+        auto element = fast_own_element(this_object, i);
+        if (element.is_empty())
+            element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
             return Value(true);
     }
@@ -795,17 +806,24 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // OPTIMIZATION: Only a number can be found in an array of numbers.
+    if (!search_element.is_number() && holds_only_numbers_below(object, length))
+        return Value(-1);
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
 
         // a. Let kPresent be ? HasProperty(O, ! ToString(𝔽(k))).
-        auto k_present = TRY(object->has_property(property_key));
+        // OPTIMIZATION: Own elements are known to be present, and don't have to be looked up again below.
+        auto element_k = fast_own_element(object, k);
+        auto k_present = !element_k.is_empty() || TRY(object->has_property(property_key));
 
         // b. If kPresent is true, then
         if (k_present) {
             // i. Let elementK be ? Get(O, ! ToString(𝔽(k))).
-            auto element_k = TRY(object->get(property_key));
+            if (element_k.is_empty())
+                element_k = TRY(object->get(property_key));
 
             // ii. Let same be IsStrictlyEqual(searchElement, elementK).
             auto same = is_strictly_equal(search_element, element_k);
@@ -959,12 +977,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
         auto property_key = PropertyKey { k };
 
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
+        // OPTIMIZATION: Own elements are known to be present, and don't have to be looked up again below.
+        // NOTE: The callback may change the array, so this has to be checked for every element.
+        auto k_value = fast_own_element(object, k);
+        auto k_present = !k_value.is_empty() || TRY(object->has_property(property_key));
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
+            if (k_value.is_empty())
+                k_value = TRY(object->get(property_key));
 
             // ii. Let mappedValue be ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
             auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
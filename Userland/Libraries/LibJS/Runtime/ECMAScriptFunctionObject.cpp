@@ -74,6 +74,7 @@ ECMAScriptFunctionObject::ECMAScriptFunctionObject(DeprecatedFlyString name, Byt
     , m_might_need_arguments_object(might_need_arguments_object)
     , m_contains_direct_call_to_eval(contains_direct_call_to_eval)
     , m_is_arrow_function(is_arrow_function)
+    , m_uses_this(uses_this == UsesThis::Yes)
     , m_kind(kind)
 {
     // NOTE: This logic is from OrdinaryFunctionCreate, https://tc39.es/ecma262/#sec-ordinaryfunctioncreate
@@ -101,9 +102,17 @@ ECMAScriptFunctionObject::ECMAScriptFunctionObject(DeprecatedFlyString name, Byt
             return false;
         return true;
     });
+}
 
-    // NOTE: The following steps are from FunctionDeclarationInstantiation that could be executed once
-    //       and then reused in all subsequent function instantiations.
+// NOTE: The following steps are from FunctionDeclarationInstantiation that could be executed once and then reused in all
+//       subsequent function instantiations. Many functions are never called, so this is done on the first call instead
+//       of when the function object is created.
+//       The body has still been parsed into a full AST by then: the parser's scope analysis and early errors need
+//       every reference inside it, so only this setup is deferred, not parsing.
+void ECMAScriptFunctionObject::prepare_function_declaration_instantiation()
+{
+    VERIFY(!m_did_prepare_function_declaration_instantiation);
+    m_did_prepare_function_declaration_instantiation = true;
 
     // 2. Let code be func.[[ECMAScriptCode]].
     ScopeNode const* scope_body = nullptr;
@@ -328,7 +337,7 @@ ECMAScriptFunctionObject::ECMAScriptFunctionObject(DeprecatedFlyString name, Byt
         }));
     }
 
-    m_function_environment_needed = m_arguments_object_needed || m_function_environment_bindings_count > 0 || m_var_environment_bindings_count > 0 || m_lex_environment_bindings_count > 0 || uses_this == UsesThis::Yes || m_contains_direct_call_to_eval;
+    m_function_environment_needed = m_arguments_object_needed || m_function_environment_bindings_count > 0 || m_var_environment_bindings_count > 0 || m_lex_environment_bindings_count > 0 || m_uses_this || m_contains_direct_call_to_eval;
 }
 
 void ECMAScriptFunctionObject::initialize(Realm& realm)
@@ -342,6 +351,7 @@ void ECMAScriptFunctionObject::initialize(Realm& realm)
     //       are defined in the spec.
 
     m_name_string = PrimitiveString::create(vm, m_name);
+    write_barrier();
 
     MUST(define_property_or_throw(vm.names.length, { .value = Value(m_function_length), .writable = false, .enumerable = false, .configurable = true }));
     MUST(define_property_or_throw(vm.names.name, { .value = m_name_string, .writable = false, .enumerable = false, .configurable = true }));
@@ -563,6 +573,7 @@ void ECMAScriptFunctionObject::make_method(Object& home_object)
 {
     // 1. Set F.[[HomeObject]] to homeObject.
     m_home_object = &home_object;
+    write_barrier();
 
     // 2. Return unused.
 }
@@ -957,6 +968,9 @@ ThrowCompletionOr<void> ECMAScriptFunctionObject::prepare_for_ordinary_call(Exec
 {
     auto& vm = this->vm();
 
+    if (!m_did_prepare_function_declaration_instantiation) [[unlikely]]
+        prepare_function_declaration_instantiation();
+
     // Non-standard
     callee_context.is_strict_mode = m_strict;
 
@@ -1223,6 +1237,7 @@ Completion ECMAScriptFunctionObject::ordinary_call_evaluate_body()
             } else {
                 m_default_parameter_bytecode_executables.append(*parameter.bytecode_executable);
             }
+            write_barrier();
         }
     }
 
@@ -1241,6 +1256,7 @@ Completion ECMAScriptFunctionObject::ordinary_call_evaluate_body()
         if (!m_ecmascript_code->bytecode_executable())
             const_cast<Statement&>(*m_ecmascript_code).set_bytecode_executable(TRY(Bytecode::compile(vm, *m_ecmascript_code, m_formal_parameters, m_kind, m_name)));
         m_bytecode_executable = m_ecmascript_code->bytecode_executable();
+        write_barrier();
     }
 
     if (m_kind == FunctionKind::Async) {
@@ -1284,6 +1300,7 @@ void ECMAScriptFunctionObject::set_name(DeprecatedFlyString const& name)
     auto& vm = this->vm();
     m_name = name;
     m_name_string = PrimitiveString::create(vm, m_name);
+    write_barrier();
     MUST(define_property_or_throw(vm.names.name, { .value = m_name_string, .writable = false, .enumerable = false, .configurable = true }));
 }
 }
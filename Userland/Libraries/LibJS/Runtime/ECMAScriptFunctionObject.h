@@ -25,6 +25,7 @@ void async_function_start(VM&, PromiseCapability const&, T const& async_function
 class ECMAScriptFunctionObject final : public FunctionObject {
     JS_OBJECT(ECMAScriptFunctionObject, FunctionObject);
     JS_DECLARE_ALLOCATOR(ECMAScriptFunctionObject);
+    JS_DECLARE_WRITE_BARRIERS(ECMAScriptFunctionObject);
 
 public:
     enum class ConstructorKind : u8 {
@@ -71,16 +72,28 @@ public:
     ThisMode this_mode() const { return m_this_mode; }
 
     Object* home_object() const { return m_home_object; }
-    void set_home_object(Object* home_object) { m_home_object = home_object; }
+    void set_home_object(Object* home_object)
+    {
+        m_home_object = home_object;
+        write_barrier();
+    }
 
     ByteString const& source_text() const { return m_source_text; }
     void set_source_text(ByteString source_text) { m_source_text = move(source_text); }
 
     Vector<ClassFieldDefinition> const& fields() const { return m_fields; }
-    void add_field(ClassFieldDefinition field) { m_fields.append(move(field)); }
+    void add_field(ClassFieldDefinition field)
+    {
+        m_fields.append(move(field));
+        write_barrier();
+    }
 
     Vector<PrivateElement> const& private_methods() const { return m_private_methods; }
-    void add_private_method(PrivateElement method) { m_private_methods.append(move(method)); }
+    void add_private_method(PrivateElement method)
+    {
+        m_private_methods.append(move(method));
+        write_barrier();
+    }
 
     // This is for IsSimpleParameterList (static semantics)
     bool has_simple_parameter_list() const { return m_has_simple_parameter_list; }
@@ -94,7 +107,11 @@ public:
 
     // This is used by LibWeb to disassociate event handler attribute callback functions from the nearest script on the call stack.
     // https://html.spec.whatwg.org/multipage/webappapis.html#getting-the-current-value-of-the-event-handler Step 3.11
-    void set_script_or_module(ScriptOrModule script_or_module) { m_script_or_module = move(script_or_module); }
+    void set_script_or_module(ScriptOrModule script_or_module)
+    {
+        m_script_or_module = move(script_or_module);
+        write_barrier();
+    }
 
     Variant<PropertyKey, PrivateName, Empty> const& class_field_initializer_name() const { return m_class_field_initializer_name; }
 
@@ -109,6 +126,7 @@ private:
     virtual bool is_ecmascript_function_object() const override { return true; }
     virtual void visit_edges(Visitor&) override;
 
+    void prepare_function_declaration_instantiation();
     ThrowCompletionOr<void> prepare_for_ordinary_call(ExecutionContext& callee_context, Object* new_target);
     void ordinary_call_bind_this(ExecutionContext&, Value this_argument);
 
@@ -143,6 +161,8 @@ private:
     bool m_contains_direct_call_to_eval : 1 { true };
     bool m_is_arrow_function : 1 { false };
     bool m_has_simple_parameter_list : 1 { false };
+    bool m_uses_this : 1 { false };
+    bool m_did_prepare_function_declaration_instantiation : 1 { false };
     FunctionKind m_kind : 3 { FunctionKind::Normal };
 
     struct VariableNameToInitialize {
@@ -14,6 +14,7 @@ namespace JS {
 class FunctionEnvironment final : public DeclarativeEnvironment {
     JS_ENVIRONMENT(FunctionEnvironment, DeclarativeEnvironment);
     JS_DECLARE_ALLOCATOR(FunctionEnvironment);
+    JS_DECLARE_WRITE_BARRIERS(FunctionEnvironment);
 
 public:
     enum class ThisBindingStatus : u8 {
@@ -29,13 +30,18 @@ public:
 
     ECMAScriptFunctionObject& function_object() { return *m_function_object; }
     ECMAScriptFunctionObject const& function_object() const { return *m_function_object; }
-    void set_function_object(ECMAScriptFunctionObject& function) { m_function_object = &function; }
+    void set_function_object(ECMAScriptFunctionObject& function)
+    {
+        m_function_object = &function;
+        write_barrier();
+    }
 
     Value new_target() const { return m_new_target; }
     void set_new_target(Value new_target)
     {
         VERIFY(!new_target.is_empty());
         m_new_target = new_target;
+        write_barrier();
     }
 
     // Abstract operations
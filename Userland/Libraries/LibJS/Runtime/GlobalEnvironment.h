@@ -13,6 +13,7 @@ namespace JS {
 class GlobalEnvironment final : public Environment {
     JS_ENVIRONMENT(GlobalEnvironment, Environment);
     JS_DECLARE_ALLOCATOR(GlobalEnvironment);
+    JS_DECLARE_WRITE_BARRIERS(GlobalEnvironment);
 
 public:
     virtual bool has_this_binding() const final { return true; }
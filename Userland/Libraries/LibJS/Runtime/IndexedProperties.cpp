@@ -18,6 +18,25 @@ SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initi
     , m_array_size(initial_values.size())
     , m_packed_elements(move(initial_values))
 {
+    for (auto value : m_packed_elements) {
+        if (value.is_empty())
+            m_is_holey = true;
+        else
+            include_in_element_type(value);
+    }
+}
+
+SimpleIndexedPropertyStorage::ElementKind SimpleIndexedPropertyStorage::element_kind() const
+{
+    switch (m_element_type) {
+    case ElementType::Int32:
+        return m_is_holey ? ElementKind::HoleyInt32 : ElementKind::PackedInt32;
+    case ElementType::Double:
+        return m_is_holey ? ElementKind::HoleyDouble : ElementKind::PackedDouble;
+    case ElementType::Value:
+        return m_is_holey ? ElementKind::HoleyValue : ElementKind::PackedValue;
+    }
+    VERIFY_NOT_REACHED();
 }
 
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
@@ -50,16 +69,25 @@ void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttribute
     VERIFY(attributes == default_attributes);
 
     if (index >= m_array_size) {
+        // Writing past the end leaves holes behind, appending doesn't.
+        if (index > m_array_size)
+            m_is_holey = true;
         m_array_size = index + 1;
         grow_storage_if_needed();
     }
     m_packed_elements[index] = value;
+
+    if (value.is_empty())
+        m_is_holey = true;
+    else
+        include_in_element_type(value);
 }
 
 void SimpleIndexedPropertyStorage::remove(u32 index)
 {
     VERIFY(index < m_array_size);
     m_packed_elements[index] = {};
+    m_is_holey = true;
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_first()
@@ -78,6 +106,8 @@ ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 
 bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
+    if (new_size > m_array_size)
+        m_is_holey = true;
     m_array_size = new_size;
     m_packed_elements.resize_and_keep_capacity(new_size);
     return true;
@@ -56,6 +56,17 @@ private:
 
 class SimpleIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
+    // What kind of values the elements are known to be. A packed storage has no holes below its array-like size. Kinds
+    // only ever get more general: Int32 to Double to Value, and packed to holey.
+    enum class ElementKind : u8 {
+        PackedInt32,
+        PackedDouble,
+        PackedValue,
+        HoleyInt32,
+        HoleyDouble,
+        HoleyValue,
+    };
+
     SimpleIndexedPropertyStorage()
         : IndexedPropertyStorage(IsSimpleStorage::Yes) {};
     explicit SimpleIndexedPropertyStorage(Vector<Value>&& initial_values);
@@ -74,13 +85,49 @@ public:
 
     Vector<Value> const& elements() const { return m_packed_elements; }
 
+    ElementKind element_kind() const;
+    bool is_packed() const { return !m_is_holey; }
+    bool holds_only_int32s() const { return m_element_type == ElementType::Int32; }
+    bool holds_only_numbers() const { return m_element_type != ElementType::Value; }
+
+    // OPTIMIZATION: These skip the virtual calls and the Optional of get() and put(), for the interpreter's fast paths.
+    // Returns an empty value for holes.
+    ALWAYS_INLINE Value element_at(u32 index) const
+    {
+        if (index >= m_array_size)
+            return {};
+        return m_packed_elements.data()[index];
+    }
+
+    // The index must already have an element.
+    ALWAYS_INLINE void overwrite_element(u32 index, Value value)
+    {
+        m_packed_elements.data()[index] = value;
+        include_in_element_type(value);
+    }
+
 private:
     friend GenericIndexedPropertyStorage;
 
+    enum class ElementType : u8 {
+        Int32,
+        Double,
+        Value,
+    };
+
+    ALWAYS_INLINE void include_in_element_type(Value value)
+    {
+        if (m_element_type == ElementType::Value || value.is_int32())
+            return;
+        m_element_type = value.is_number() ? ElementType::Double : ElementType::Value;
+    }
+
     void grow_storage_if_needed();
 
     size_t m_array_size { 0 };
     Vector<Value> m_packed_elements;
+    ElementType m_element_type { ElementType::Int32 };
+    bool m_is_holey { false };
 };
 
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
@@ -158,6 +205,16 @@ public:
 
     Vector<u32> indices() const;
 
+    // OPTIMIZATION: Arrays of numbers don't have to be visited by the garbage collector.
+    bool may_contain_cells() const
+    {
+        if (!m_storage)
+            return false;
+        if (!m_storage->is_simple_storage())
+            return true;
+        return !static_cast<SimpleIndexedPropertyStorage const&>(*m_storage).holds_only_numbers();
+    }
+
     template<typename Callback>
     void for_each_value(Callback callback)
     {
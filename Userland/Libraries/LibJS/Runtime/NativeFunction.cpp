@@ -21,6 +21,7 @@ void NativeFunction::initialize(Realm& realm)
 {
     Base::initialize(realm);
     m_name_string = PrimitiveString::create(vm(), m_name);
+    write_barrier();
 }
 
 void NativeFunction::visit_edges(Cell::Visitor& visitor)
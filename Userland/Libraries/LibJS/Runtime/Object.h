@@ -54,6 +54,7 @@ struct CacheablePropertyMetadata {
 class Object : public Cell {
     JS_CELL(Object, Cell);
     JS_DECLARE_ALLOCATOR(Object);
+    JS_DECLARE_WRITE_BARRIERS(Object);
 
 public:
     static NonnullGCPtr<Object> create(Realm&, Object* prototype);
@@ -202,15 +203,36 @@ public:
     virtual void visit_edges(Cell::Visitor&) override;
 
     Value get_direct(size_t index) const { return m_storage[index]; }
-    void put_direct(size_t index, Value value) { m_storage[index] = value; }
+    void put_direct(size_t index, Value value)
+    {
+        m_storage[index] = value;
+        if (value.is_cell())
+            write_barrier();
+    }
 
     IndexedProperties const& indexed_properties() const { return m_indexed_properties; }
-    IndexedProperties& indexed_properties() { return m_indexed_properties; }
-    void set_indexed_property_elements(Vector<Value>&& values) { m_indexed_properties = IndexedProperties(move(values)); }
+
+    // NOTE: The caller may store values into the returned properties, so this has to assume that it does.
+    //       The reference must not be held across allocations.
+    IndexedProperties& indexed_properties()
+    {
+        write_barrier();
+        return m_indexed_properties;
+    }
+
+    void set_indexed_property_elements(Vector<Value>&& values)
+    {
+        m_indexed_properties = IndexedProperties(move(values));
+        write_barrier();
+    }
 
     Shape& shape() { return *m_shape; }
     Shape const& shape() const { return *m_shape; }
 
+    // NOTE: These are used by the JIT to access the shape and the property storage from native code.
+    static constexpr size_t shape_offset() { return __builtin_offsetof(Object, m_shape); }
+    static constexpr size_t storage_offset() { return __builtin_offsetof(Object, m_storage); }
+
     template<typename T>
     bool fast_is() const = delete;
 
@@ -245,7 +267,11 @@ protected:
     bool m_is_typed_array { false };
 
 private:
-    void set_shape(Shape& shape) { m_shape = &shape; }
+    void set_shape(Shape& shape)
+    {
+        m_shape = &shape;
+        write_barrier();
+    }
 
     Object* prototype() { return shape().prototype(); }
 
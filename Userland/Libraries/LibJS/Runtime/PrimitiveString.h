@@ -23,6 +23,8 @@ namespace JS {
 class PrimitiveString final : public Cell {
     JS_CELL(PrimitiveString, Cell);
     JS_DECLARE_ALLOCATOR(PrimitiveString);
+    // NOTE: The rope halves are only ever assigned by the constructor, so there is nothing to put write barriers on.
+    JS_DECLARE_WRITE_BARRIERS(PrimitiveString);
 
 public:
     [[nodiscard]] static NonnullGCPtr<PrimitiveString> create(VM&, Utf16String);
@@ -46,6 +46,7 @@ private:
 class PromiseResolvingElementFunction : public NativeFunction {
     JS_OBJECT(PromiseResolvingElementFunction, NativeFunction);
     JS_DECLARE_ALLOCATOR(PromiseResolvingElementFunction);
+    JS_DECLARE_WRITE_BARRIERS(PromiseResolvingElementFunction);
 
 public:
     virtual void initialize(Realm&) override;
@@ -73,6 +74,7 @@ private:
 class PromiseAllResolveElementFunction final : public PromiseResolvingElementFunction {
     JS_OBJECT(PromiseAllResolveElementFunction, NativeFunction);
     JS_DECLARE_ALLOCATOR(PromiseAllResolveElementFunction);
+    JS_DECLARE_WRITE_BARRIERS(PromiseAllResolveElementFunction);
 
 public:
     static NonnullGCPtr<PromiseAllResolveElementFunction> create(Realm&, size_t, PromiseValueList&, NonnullGCPtr<PromiseCapability const>, RemainingElements&);
@@ -89,6 +91,7 @@ private:
 class PromiseAllSettledResolveElementFunction final : public PromiseResolvingElementFunction {
     JS_OBJECT(PromiseResolvingFunction, NativeFunction);
     JS_DECLARE_ALLOCATOR(PromiseAllSettledResolveElementFunction);
+    JS_DECLARE_WRITE_BARRIERS(PromiseAllSettledResolveElementFunction);
 
 public:
     static NonnullGCPtr<PromiseAllSettledResolveElementFunction> create(Realm&, size_t, PromiseValueList&, NonnullGCPtr<PromiseCapability const>, RemainingElements&);
@@ -105,6 +108,7 @@ private:
 class PromiseAllSettledRejectElementFunction final : public PromiseResolvingElementFunction {
     JS_OBJECT(PromiseAllSettledRejectElementFunction, PromiseResolvingElementFunction);
     JS_DECLARE_ALLOCATOR(PromiseAllSettledRejectElementFunction);
+    JS_DECLARE_WRITE_BARRIERS(PromiseAllSettledRejectElementFunction);
 
 public:
     static NonnullGCPtr<PromiseAllSettledRejectElementFunction> create(Realm&, size_t, PromiseValueList&, NonnullGCPtr<PromiseCapability const>, RemainingElements&);
@@ -121,6 +125,7 @@ private:
 class PromiseAnyRejectElementFunction final : public PromiseResolvingElementFunction {
     JS_OBJECT(PromiseAnyRejectElementFunction, PromiseResolvingElementFunction);
     JS_DECLARE_ALLOCATOR(PromiseAnyRejectElementFunction);
+    JS_DECLARE_WRITE_BARRIERS(PromiseAnyRejectElementFunction);
 
 public:
     static NonnullGCPtr<PromiseAnyRejectElementFunction> create(Realm&, size_t, PromiseValueList&, NonnullGCPtr<PromiseCapability const>, RemainingElements&);
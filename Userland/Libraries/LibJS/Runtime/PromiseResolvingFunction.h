@@ -26,6 +26,7 @@ protected:
 class PromiseResolvingFunction final : public NativeFunction {
     JS_OBJECT(PromiseResolvingFunction, NativeFunction);
     JS_DECLARE_ALLOCATOR(PromiseResolvingFunction);
+    JS_DECLARE_WRITE_BARRIERS(PromiseResolvingFunction);
 
 public:
     using FunctionType = Function<Value(VM&, Promise&, AlreadyResolved&)>;
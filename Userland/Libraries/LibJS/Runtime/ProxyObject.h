@@ -15,6 +15,7 @@ namespace JS {
 class ProxyObject final : public FunctionObject {
     JS_OBJECT(ProxyObject, FunctionObject);
     JS_DECLARE_ALLOCATOR(ProxyObject);
+    JS_DECLARE_WRITE_BARRIERS(ProxyObject);
 
 public:
     static NonnullGCPtr<ProxyObject> create(Realm&, Object& target, Object& handler);
@@ -39,6 +39,7 @@ class Shape final
     , public Weakable<Shape> {
     JS_CELL(Shape, Cell);
     JS_DECLARE_ALLOCATOR(Shape);
+    JS_DECLARE_WRITE_BARRIERS(Shape);
 
 public:
     virtual ~Shape() override = default;
@@ -85,7 +86,11 @@ public:
         PropertyMetadata value;
     };
 
-    void set_prototype_without_transition(Object* new_prototype) { m_prototype = new_prototype; }
+    void set_prototype_without_transition(Object* new_prototype)
+    {
+        m_prototype = new_prototype;
+        write_barrier();
+    }
 
 private:
     explicit Shape(Realm&);
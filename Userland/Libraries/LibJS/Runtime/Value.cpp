@@ -1804,10 +1804,11 @@ ThrowCompletionOr<Value> sub(VM& vm, Value lhs, Value rhs)
 ThrowCompletionOr<Value> mul(VM& vm, Value lhs, Value rhs)
 {
     // OPTIMIZATION: Fast path for multiplication of two Int32 values.
+    //               A zero result may have to be -0, which only the slow path produces.
     if (lhs.is_int32() && rhs.is_int32()) {
         Checked<i32> result = lhs.as_i32();
         result *= rhs.as_i32();
-        if (!result.has_overflow())
+        if (!result.has_overflow() && result.value() != 0)
             return result.value();
     }
 
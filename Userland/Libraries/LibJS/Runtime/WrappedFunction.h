@@ -14,6 +14,7 @@ namespace JS {
 class WrappedFunction final : public FunctionObject {
     JS_OBJECT(WrappedFunction, FunctionObject);
     JS_DECLARE_ALLOCATOR(WrappedFunction);
+    JS_DECLARE_WRITE_BARRIERS(WrappedFunction);
 
 public:
     static ThrowCompletionOr<NonnullGCPtr<WrappedFunction>> create(Realm&, Realm& caller_realm, FunctionObject& target_function);
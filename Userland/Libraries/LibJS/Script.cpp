@@ -19,6 +19,7 @@ Result<NonnullGCPtr<Script>, Vector<ParserError>> Script::parse(StringView sourc
 {
     // 1. Let script be ParseText(sourceText, Script).
     auto parser = Parser(Lexer(source_text, filename, line_number_offset));
+    parser.allow_bytecode_caching();
     auto script = parser.parse_program();
 
     // 2. If script is a List of errors, return body.
@@ -5,7 +5,10 @@
  */
 
 #include <AK/BinarySearch.h>
+#include <AK/StringBuilder.h>
 #include <AK/Utf8View.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibJS/AST.h>
 #include <LibJS/SourceCode.h>
 #include <LibJS/SourceRange.h>
 #include <LibJS/Token.h>
@@ -33,6 +36,54 @@ String const& SourceCode::code() const
     return m_code;
 }
 
+ByteString const& SourceCode::content_hash() const
+{
+    if (m_content_hash.is_empty()) {
+        auto digest = Crypto::Hash::SHA256::hash(m_code.bytes_as_string_view());
+        StringBuilder builder;
+        for (auto byte : digest.bytes())
+            builder.appendff("{:02x}", byte);
+        m_content_hash = builder.to_byte_string();
+    }
+    return m_content_hash;
+}
+
+void SourceCode::enable_node_index(bool is_module) const
+{
+    VERIFY(!m_node_index);
+    m_node_index = make<NodeIndex>();
+    m_node_index->is_module = is_module;
+}
+
+void SourceCode::add_to_node_index(Badge<ASTNode>, ASTNode const& node) const
+{
+    if (!m_node_index)
+        return;
+    m_node_index->nodes_by_start_offset.ensure(node.start_offset()).append(&node);
+}
+
+void SourceCode::remove_from_node_index(Badge<ASTNode>, ASTNode const& node) const
+{
+    if (!m_node_index)
+        return;
+    auto it = m_node_index->nodes_by_start_offset.find(node.start_offset());
+    if (it == m_node_index->nodes_by_start_offset.end())
+        return;
+    it->value.remove_first_matching([&](auto const* indexed_node) { return indexed_node == &node; });
+    if (it->value.is_empty())
+        m_node_index->nodes_by_start_offset.remove(it);
+}
+
+ReadonlySpan<ASTNode const*> SourceCode::indexed_nodes_starting_at(u32 start_offset) const
+{
+    if (!m_node_index)
+        return {};
+    auto it = m_node_index->nodes_by_start_offset.find(start_offset);
+    if (it == m_node_index->nodes_by_start_offset.end())
+        return {};
+    return it->value.span();
+}
+
 void SourceCode::fill_position_cache() const
 {
     constexpr size_t minimum_distance_between_cached_positions = 10000;
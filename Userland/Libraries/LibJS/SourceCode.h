@@ -6,6 +6,10 @@
 
 #pragma once
 
+#include <AK/Badge.h>
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
 #include <LibJS/Forward.h>
@@ -22,6 +26,20 @@ public:
 
     SourceRange range_from_offsets(u32 start_offset, u32 end_offset) const;
 
+    // A hex-encoded SHA-256 digest of the code, computed on first use.
+    ByteString const& content_hash() const;
+
+    // Cached bytecode refers to AST nodes by their source offsets (see Bytecode::ExecutableCache). When this is enabled
+    // before parsing, the kinds of nodes that bytecode can refer to add themselves to an index, so that they can be
+    // found again when the cached bytecode is loaded.
+    void enable_node_index(bool is_module) const;
+    bool has_node_index() const { return m_node_index; }
+    bool is_indexed_as_module() const { return m_node_index && m_node_index->is_module; }
+
+    void add_to_node_index(Badge<ASTNode>, ASTNode const&) const;
+    void remove_from_node_index(Badge<ASTNode>, ASTNode const&) const;
+    ReadonlySpan<ASTNode const*> indexed_nodes_starting_at(u32 start_offset) const;
+
 private:
     SourceCode(String filename, String code);
 
@@ -33,6 +51,14 @@ private:
     // line:column they map to. This can then be binary-searched.
     void fill_position_cache() const;
     Vector<Position> mutable m_cached_positions;
+
+    ByteString mutable m_content_hash;
+
+    struct NodeIndex {
+        bool is_module { false };
+        HashMap<u32, Vector<ASTNode const*, 1>> nodes_by_start_offset;
+    };
+    OwnPtr<NodeIndex> mutable m_node_index;
 };
 
 }
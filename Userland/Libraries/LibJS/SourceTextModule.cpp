@@ -128,6 +128,7 @@ Result<NonnullGCPtr<SourceTextModule>, Vector<ParserError>> SourceTextModule::pa
 {
     // 1. Let body be ParseText(sourceText, Module).
     auto parser = Parser(Lexer(source_text, filename), Program::Type::Module);
+    parser.allow_bytecode_caching();
     auto body = parser.parse_program();
 
     // 2. If body is a List of errors, return body.
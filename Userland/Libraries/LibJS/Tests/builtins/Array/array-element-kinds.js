@@ -0,0 +1,97 @@
+describe("arrays keep working as their elements change kind", () => {
+    test("numbers that stop being small integers", () => {
+        const a = [1, 2, 3];
+        a[1] = 2.5;
+        expect(a).toEqual([1, 2.5, 3]);
+        a[2] = "three";
+        expect(a).toEqual([1, 2.5, "three"]);
+        a[0] = 1;
+        expect(a.indexOf(1)).toBe(0);
+        expect(a.indexOf("three")).toBe(2);
+        expect(a.includes(2.5)).toBeTrue();
+    });
+
+    test("objects stored in arrays of numbers stay alive", () => {
+        const a = [1, 2, 3];
+        a[1] = { value: 42 };
+        gc();
+        expect(a[1].value).toBe(42);
+    });
+
+    test("holes made by deleting, growing and writing past the end", () => {
+        const a = [1, 2, 3];
+        delete a[1];
+        expect(1 in a).toBeFalse();
+        expect(a.indexOf(undefined)).toBe(-1);
+        expect(a.includes(undefined)).toBeTrue();
+
+        const b = [1, 2];
+        b.length = 4;
+        const doubled = b.map(x => x * 2);
+        expect(doubled).toHaveLength(4);
+        expect(doubled[1]).toBe(4);
+        expect(2 in doubled).toBeFalse();
+
+        const c = [1];
+        c[3] = 4;
+        expect(c.filter(() => true)).toEqual([1, 4]);
+        c.sort((x, y) => y - x);
+        expect(c).toHaveLength(4);
+        expect(c[0]).toBe(4);
+        expect(c[1]).toBe(1);
+        expect(2 in c).toBeFalse();
+    });
+
+    test("holes read through to the prototype", () => {
+        const a = [1, , 3];
+        Array.prototype[1] = "from prototype";
+        try {
+            expect(a.indexOf("from prototype")).toBe(1);
+            expect(a.includes("from prototype")).toBeTrue();
+            expect(a.map(x => x)).toEqual([1, "from prototype", 3]);
+        } finally {
+            delete Array.prototype[1];
+        }
+    });
+
+    test("elements past the length of an array of numbers come from the prototype", () => {
+        const a = [1, 2];
+        const object = { length: 3, __proto__: a };
+        Array.prototype[2] = "from prototype";
+        try {
+            expect(Array.prototype.indexOf.call(a, "from prototype")).toBe(-1);
+            expect(Array.prototype.indexOf.call(object, "from prototype")).toBe(2);
+        } finally {
+            delete Array.prototype[2];
+        }
+    });
+
+    test("callbacks that change the array", () => {
+        const a = [1, 2, 3, 4];
+        const seen = [];
+        a.map((x, i) => {
+            seen.push(x);
+            if (i === 0) {
+                a[1] = "changed";
+                delete a[2];
+            }
+        });
+        expect(seen).toEqual([1, "changed", 4]);
+
+        const b = [1, 2, 3];
+        expect(
+            b.filter((x, i) => {
+                if (i === 0) b.length = 1;
+                return true;
+            })
+        ).toEqual([1]);
+    });
+
+    test("sorting arrays of numbers", () => {
+        expect([3, 1, 2].sort()).toEqual([1, 2, 3]);
+        expect([10, 9, 1].sort()).toEqual([1, 10, 9]);
+        expect([0.5, -1, 2.25].sort((x, y) => x - y)).toEqual([-1, 0.5, 2.25]);
+        expect([NaN, 1].includes(NaN)).toBeTrue();
+        expect([NaN, 1].indexOf(NaN)).toBe(-1);
+    });
+});
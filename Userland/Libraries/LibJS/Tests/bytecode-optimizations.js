@@ -0,0 +1,122 @@
+// The bytecode of every function is optimized before it runs: constants are folded, jumps threaded, moves removed and
+// registers shared. None of that may change what the code does.
+
+test("operations on constants give the same results as at runtime", () => {
+    expect(1 + 2 * 3).toBe(7);
+    expect(2 ** 10).toBe(1024);
+    expect(1 / 0).toBe(Infinity);
+    expect(-0).toBe(-0);
+    expect(0 * -1).toBe(-0);
+    const [zero, minusOne] = [0, -1];
+    expect(zero * minusOne).toBe(-0);
+    expect(7 % -3).toBe(1);
+    expect(1 << 31).toBe(-2147483648);
+    expect(-1 >>> 0).toBe(4294967295);
+    expect(~5).toBe(-6);
+    expect(!0).toBeTrue();
+    expect(+true).toBe(1);
+    expect(-null).toBe(-0);
+    expect(undefined + 1).toBeNaN();
+    expect(NaN === NaN).toBeFalse();
+    expect(0 === -0).toBeTrue();
+    expect(null == undefined).toBeTrue();
+    expect(null === undefined).toBeFalse();
+    expect(true == 1).toBeTrue();
+    expect(1 < 2 && 2 <= 2 && 3 > 2 && 3 >= 3).toBeTrue();
+    expect("a" + 1).toBe("a1");
+    expect(typeof 1).toBe("number");
+    expect(() => 1 in 2).toThrow(TypeError);
+    expect(() => 1 instanceof 2).toThrow(TypeError);
+});
+
+test("branches on constant conditions", () => {
+    let taken = [];
+    if (1) taken.push("if");
+    else taken.push("else");
+    while (0) taken.push("while");
+    if (null ?? true) taken.push("nullish");
+    do taken.push("do");
+    while (false);
+    expect(taken).toEqual(["if", "nullish", "do"]);
+});
+
+test("values stay alive across handlers and finalizers", () => {
+    function run() {
+        const log = [];
+        for (let i = 0; i < 4; ++i) {
+            const before = i * 10;
+            try {
+                if (i === 1) continue;
+                if (i === 2) throw before + 1;
+                if (i === 3) break;
+                log.push(before);
+            } catch (e) {
+                log.push(`caught ${e} after ${before}`);
+            } finally {
+                log.push(`finally ${before}`);
+            }
+        }
+        return log;
+    }
+
+    expect(run()).toEqual([
+        0,
+        "finally 0",
+        "finally 10",
+        "caught 21 after 20",
+        "finally 20",
+        "finally 30",
+    ]);
+
+    function returnFromTry() {
+        const kept = [1, 2, 3];
+        try {
+            return kept.length;
+        } finally {
+            kept.push(4);
+        }
+    }
+    expect(returnFromTry()).toBe(3);
+});
+
+test("values stay alive across yield and await", () => {
+    function* counter() {
+        let a = 1;
+        let b = 2;
+        const first = yield a + b;
+        const second = yield first * b;
+        return [a, b, first, second];
+    }
+
+    const generator = counter();
+    expect(generator.next().value).toBe(3);
+    expect(generator.next(5).value).toBe(10);
+    expect(generator.next(7)).toEqual({ value: [1, 2, 5, 7], done: true });
+
+    let result;
+    async function add(x) {
+        const y = x + 1;
+        const z = await y;
+        result = [x, y, z];
+    }
+    add(1);
+    runQueuedPromiseJobs();
+    expect(result).toEqual([1, 2, 2]);
+});
+
+test("many temporaries and array spreads", () => {
+    function build(x) {
+        const rest = [x + 4, x + 5];
+        return [x, x + 1, ...[x + 2, x + 3], ...rest, (x + 6) * 1, String(x + 7)];
+    }
+
+    expect(build(0)).toEqual([0, 1, 2, 3, 4, 5, 6, "7"]);
+    expect(Math.max(...[1, 2, 3], 4, ...[5])).toBe(5);
+
+    const closures = [];
+    for (let i = 0; i < 3; ++i) {
+        const doubled = i * 2;
+        closures.push(() => doubled);
+    }
+    expect(closures.map(f => f())).toEqual([0, 2, 4]);
+});
@@ -0,0 +1,40 @@
+test("function objects created from the same code are set up independently on their first call", () => {
+    const makeCounter = () =>
+        function counter(step) {
+            var total = 0;
+            for (const value of arguments) total += value;
+            return total + step;
+        };
+
+    const uncalled = makeCounter();
+    const called = makeCounter();
+    expect(called(1, 2, 3)).toBe(7);
+    expect(called(4)).toBe(8);
+    expect(uncalled(10)).toBe(20);
+});
+
+test("block-level functions are hoisted in a function that is called long after it was created", () => {
+    function sloppy() {
+        {
+            function inner() {
+                return "inner";
+            }
+        }
+        return inner();
+    }
+
+    for (let i = 0; i < 10; ++i) new Function("return 1")();
+    expect(sloppy()).toBe("inner");
+});
+
+test("constructors are set up on their first construction", () => {
+    function Point(x, y) {
+        this.x = x;
+        this.y = y;
+    }
+
+    const point = new Point(1, 2);
+    expect(point.x).toBe(1);
+    expect(point.y).toBe(2);
+    expect(Point(3, 4)).toBeUndefined();
+});
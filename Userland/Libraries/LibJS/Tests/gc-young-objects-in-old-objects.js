@@ -0,0 +1,92 @@
+// Objects that survived a garbage collection are not looked at again by most of the following ones, unless references
+// to younger objects are stored into them. This allocates enough to make them old, and then keeps storing new objects.
+
+function allocateGarbage() {
+    let garbage;
+    for (let i = 0; i < 20000; ++i) garbage = { i, values: [i, i + 1] };
+    return garbage;
+}
+
+test("New objects stored into old objects survive", () => {
+    const object = {};
+    const array = [];
+    const pushed = [];
+    const map = new Map();
+    allocateGarbage();
+    gc();
+
+    for (let i = 0; i < 50; ++i) {
+        object["property" + (i % 5)] = { value: i };
+        object.latest = [i];
+        array[i % 10] = { value: i };
+        pushed.push({ value: i });
+        map.set(i % 10, { value: i });
+        allocateGarbage();
+    }
+
+    expect(object.property4.value).toBe(49);
+    expect(object.latest[0]).toBe(49);
+    expect(array[9].value).toBe(49);
+    expect(pushed[49].value).toBe(49);
+    expect(map.get(9).value).toBe(49);
+});
+
+test("New objects stored into old bindings survive", () => {
+    let binding = null;
+    const setBinding = value => {
+        binding = value;
+    };
+    allocateGarbage();
+    gc();
+
+    for (let i = 0; i < 50; ++i) {
+        setBinding({ value: i });
+        allocateGarbage();
+    }
+
+    expect(binding.value).toBe(49);
+});
+
+test("New objects stored into old objects by hot code survive", () => {
+    function put(object, value) {
+        for (let i = 0; i < 2000; ++i) object.x = value;
+    }
+
+    const object = { x: null };
+    put(object, {});
+    allocateGarbage();
+    gc();
+
+    for (let i = 0; i < 50; ++i) {
+        put(object, { value: i });
+        allocateGarbage();
+    }
+
+    expect(object.x.value).toBe(49);
+});
+
+test("Private fields and prototypes of old objects", () => {
+    class WithPrivateField {
+        #field = null;
+        set(value) {
+            this.#field = value;
+        }
+        get() {
+            return this.#field;
+        }
+    }
+
+    const object = new WithPrivateField();
+    const withPrototype = {};
+    allocateGarbage();
+    gc();
+
+    for (let i = 0; i < 50; ++i) {
+        object.set({ value: i });
+        Object.setPrototypeOf(withPrototype, { value: i });
+        allocateGarbage();
+    }
+
+    expect(object.get().value).toBe(49);
+    expect(withPrototype.value).toBe(49);
+});
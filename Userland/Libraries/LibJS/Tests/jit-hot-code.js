@@ -0,0 +1,118 @@
+// These loops run often enough for their functions to be compiled to native code, so they exercise the JIT's fast
+// paths, as well as the switch back to the generic implementation once a fast path doesn't apply anymore.
+
+test("Int32 arithmetic overflowing into doubles", () => {
+    function sum(count, start) {
+        let result = start;
+        for (let i = 0; i < count; ++i) result = result + i;
+        return result;
+    }
+
+    expect(sum(2000, 0)).toBe(1999000);
+    expect(sum(2000, 2147483000)).toBe(2147483000 + 1999000);
+    expect(sum(2000, 0.5)).toBe(1999000.5);
+    expect(sum(3, "x")).toBe("x012");
+});
+
+test("Int32 multiplication producing negative zero", () => {
+    function multiply(a, b) {
+        let result;
+        for (let i = 0; i < 2000; ++i) result = a * b;
+        return result;
+    }
+
+    expect(multiply(6, 7)).toBe(42);
+    expect(multiply(0, -5)).toBe(-0);
+    expect(multiply(65536, 65536)).toBe(4294967296);
+});
+
+test("Bitwise operations and shifts", () => {
+    let results = [];
+    for (let i = 0; i < 2000; ++i) {
+        results = [i & 0xff, i | 0x100, i ^ -1, i << 30, -i >> 1, -i >>> 0, i >>> 1];
+    }
+
+    expect(results).toEqual([0xcf, 0x7cf, -2000, -1073741824, -1000, 4294965297, 999]);
+    expect(-1 >>> 0).toBe(4294967295);
+});
+
+test("Comparisons of Int32s and other values", () => {
+    function count(values, limit) {
+        let below = 0;
+        for (let j = 0; j < 500; ++j) {
+            for (let i = 0; i < values.length; ++i) {
+                if (values[i] < limit) ++below;
+                if (values[i] === limit) ++below;
+            }
+        }
+        return below / 500;
+    }
+
+    expect(count([1, 2, 3, 4], 3)).toBe(3);
+    expect(count([1.5, 2.5, 3, "2"], 3)).toBe(4);
+    expect(count([NaN, undefined, null], 0)).toBe(0);
+});
+
+test("Increment and decrement at the Int32 limits", () => {
+    let a = 2147483600;
+    let b = -2147483600;
+    for (let i = 0; i < 2000; ++i) {
+        a++;
+        b--;
+    }
+
+    expect(a).toBe(2147485600);
+    expect(b).toBe(-2147485600);
+});
+
+test("Property accesses after the shape changed", () => {
+    function get(object) {
+        let result;
+        for (let i = 0; i < 2000; ++i) result = object.x;
+        return result;
+    }
+
+    function put(object, value) {
+        for (let i = 0; i < 2000; ++i) object.x = value;
+    }
+
+    let a = { x: 1, y: 2 };
+    let b = { y: 2, x: 3 };
+    expect(get(a)).toBe(1);
+    expect(get(b)).toBe(3);
+    put(a, 4);
+    put(b, 5);
+    expect(a.x).toBe(4);
+    expect(b.x).toBe(5);
+
+    let setterValue;
+    let c = {
+        get x() {
+            return 6;
+        },
+        set x(value) {
+            setterValue = value;
+        },
+    };
+    expect(get(c)).toBe(6);
+    put(c, 7);
+    expect(setterValue).toBe(7);
+
+    expect(get(42)).toBeUndefined();
+    expect(get("string")).toBeUndefined();
+});
+
+test("Exceptions thrown from hot code", () => {
+    function access(values) {
+        let result = 0;
+        for (let i = 0; i < values.length; ++i) result += values[i].x;
+        return result;
+    }
+
+    let values = [];
+    for (let i = 0; i < 2000; ++i) values.push({ x: 1 });
+    expect(access(values)).toBe(2000);
+
+    values.push(null);
+    expect(() => access(values)).toThrowWithMessage(TypeError, "null");
+});
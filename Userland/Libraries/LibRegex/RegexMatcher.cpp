@@ -7,9 +7,11 @@
 #include <AK/BumpAllocator.h>
 #include <AK/ByteString.h>
 #include <AK/Debug.h>
+#include <AK/MemMem.h>
 #include <AK/StringBuilder.h>
 #include <LibRegex/RegexMatcher.h>
 #include <LibRegex/RegexParser.h>
+#include <string.h>
 
 #if REGEX_DEBUG
 #    include <LibRegex/RegexDebug.h>
@@ -114,6 +116,36 @@ RegexResult Matcher<Parser>::match(RegexStringView view, Optional<typename Parse
     return match(views, regex_options);
 }
 
+// Looks for the first byte of the needle with memchr(), which is a lot faster than comparing byte by byte, as long as it
+// doesn't keep stopping at bytes that aren't followed by the rest of the needle.
+static Optional<size_t> find_bytes(StringView haystack, StringView needle)
+{
+    VERIFY(!needle.is_empty());
+    auto const* characters = haystack.characters_without_null_termination();
+
+    size_t offset = 0;
+    size_t false_candidates = 0;
+    while (offset + needle.length() <= haystack.length()) {
+        if (false_candidates > 16 && false_candidates * 16 > offset) {
+            auto rest = haystack.substring_view(offset);
+            auto found = AK::memmem_optional(rest.characters_without_null_termination(), rest.length(), needle.characters_without_null_termination(), needle.length());
+            if (!found.has_value())
+                return {};
+            return offset + *found;
+        }
+
+        auto const* candidate = static_cast<char const*>(memchr(characters + offset, needle[0], haystack.length() - offset - needle.length() + 1));
+        if (!candidate)
+            return {};
+        size_t candidate_offset = candidate - characters;
+        if (haystack.substring_view(candidate_offset, needle.length()) == needle)
+            return candidate_offset;
+        ++false_candidates;
+        offset = candidate_offset + 1;
+    }
+    return {};
+}
+
 template<typename Parser>
 RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optional<typename ParserTraits<Parser>::OptionsType> regex_options) const
 {
@@ -185,6 +217,47 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
 
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
 
+    // When matching bytes, skip ahead with a byte search to where a match could start.
+    auto const& optimization_data = m_pattern->parser_result.optimization_data;
+    auto can_search_for_bytes = !input.regex_options.has_flag_set(AllFlags::Insensitive) && !unicode
+        && (optimization_data.literal_prefix.has_value() || optimization_data.required_literal.has_value() || !optimization_data.starting_bytes.is_empty());
+    Array<bool, 256> can_start_with {};
+    for (auto byte : optimization_data.starting_bytes)
+        can_start_with[byte] = true;
+
+    Optional<size_t> required_literal_position;
+    auto find_possible_start = [&](StringView haystack, size_t from) -> Optional<size_t> {
+        if (optimization_data.required_literal.has_value() && (!required_literal_position.has_value() || *required_literal_position < from)) {
+            auto position = find_bytes(haystack.substring_view(from), *optimization_data.required_literal);
+            if (!position.has_value())
+                return {};
+            required_literal_position = from + *position;
+        }
+
+        if (optimization_data.literal_prefix.has_value()) {
+            auto position = find_bytes(haystack.substring_view(from), *optimization_data.literal_prefix);
+            if (!position.has_value())
+                return {};
+            return from + *position;
+        }
+
+        if (optimization_data.starting_bytes.size() == 1) {
+            auto const* start = static_cast<char const*>(memchr(haystack.characters_without_null_termination() + from, optimization_data.starting_bytes.first(), haystack.length() - from));
+            if (!start)
+                return {};
+            return start - haystack.characters_without_null_termination();
+        }
+        if (!optimization_data.starting_bytes.is_empty()) {
+            for (auto position = from; position < haystack.length(); ++position) {
+                if (can_start_with[static_cast<u8>(haystack[position])])
+                    return position;
+            }
+            return {};
+        }
+
+        return from;
+    };
+
     for (auto const& view : views) {
         if (lines_to_skip != 0) {
             ++input.line;
@@ -199,6 +272,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
         state.string_position = view_index;
         state.string_position_in_code_units = view_index;
         bool succeeded = false;
+        required_literal_position.clear();
 
         if (view_index == view_length && m_pattern->parser_result.match_length_minimum == 0) {
             // Run the code until it tries to consume something.
@@ -232,6 +306,13 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
         }
 
         for (; view_index <= view_length; ++view_index) {
+            if (can_search_for_bytes && view.is_string_view()) {
+                auto possible_start = find_possible_start(view.string_view(), view_index);
+                if (!possible_start.has_value() || (!continue_search && *possible_start != view_index))
+                    break;
+                view_index = *possible_start;
+            }
+
             if (view_index == view_length && input.regex_options.has_flag_set(AllFlags::Multiline))
                 break;
 
@@ -253,7 +334,17 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             state.instruction_position = 0;
             state.repetition_marks.clear();
 
-            auto success = execute(input, state, operations);
+            bool success;
+            if (m_pike_vm && continue_search) {
+                // Instead of trying every position in turn, find the leftmost match in one go.
+                auto start = m_pike_vm->search(m_pattern->parser_result.bytecode, input, state, operations);
+                if (!start.has_value() || (*start == view_length && input.regex_options.has_flag_set(AllFlags::Multiline)))
+                    break;
+                view_index = *start;
+                success = true;
+            } else {
+                success = execute(input, state, operations);
+            }
             if (success) {
                 succeeded = true;
 
@@ -439,6 +530,9 @@ bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t
         return true;
     }
 
+    if (m_pike_vm)
+        return m_pike_vm->match(m_pattern->parser_result.bytecode, input, state, operations);
+
     BumpAllocatedLinkedList<MatchState> states_to_try_next;
 #if REGEX_DEBUG
     size_t recursion_level = 0;
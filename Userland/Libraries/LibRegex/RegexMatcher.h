@@ -10,6 +10,7 @@
 #include "RegexMatch.h"
 #include "RegexOptions.h"
 #include "RegexParser.h"
+#include "RegexPikeVM.h"
 
 #include <AK/Forward.h>
 #include <AK/GenericLexer.h>
@@ -56,6 +57,9 @@ public:
         : m_pattern(pattern)
         , m_regex_options(regex_options.value_or({}))
     {
+        // A substring search is faster still, so there's no need to run anything for those.
+        if (!pattern->parser_result.optimization_data.pure_substring_search.has_value())
+            m_pike_vm = PikeVM::create(pattern->parser_result.bytecode);
     }
     ~Matcher() = default;
 
@@ -77,6 +81,7 @@ private:
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
+    OwnPtr<PikeVM> m_pike_vm;
 };
 
 template<class Parser>
@@ -232,6 +237,7 @@ private:
     void run_optimization_passes();
     void attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&);
     bool attempt_rewrite_entire_match_as_substring_search(BasicBlockList const&);
+    void find_literals_for_prefiltering();
 };
 
 // free standing functions for match, search and has_match
@@ -37,6 +37,8 @@ void Regex<Parser>::run_optimization_passes()
     attempt_rewrite_loops_as_atomic_groups(blocks);
 
     parser_result.bytecode.flatten();
+
+    find_literals_for_prefiltering();
 }
 
 template<typename Parser>
@@ -572,6 +574,248 @@ bool Regex<Parser>::attempt_rewrite_entire_match_as_substring_search(BasicBlockL
     return true;
 }
 
+// Returns the bytes that the compare matches one after the other, if that's all it does.
+static Optional<ByteString> literal_bytes_of(OpCode_Compare const& compare)
+{
+    if (compare.arguments_count() != 1)
+        return {};
+
+    StringBuilder builder;
+    for (auto& flat_compare : compare.flat_compares()) {
+        if (flat_compare.type != CharacterCompareType::Char || flat_compare.value > 0xff)
+            return {};
+        builder.append(static_cast<char>(flat_compare.value));
+    }
+    return builder.to_byte_string();
+}
+
+template<typename Parser>
+void Regex<Parser>::find_literals_for_prefiltering()
+{
+    // Finding where a match could start with a plain byte search is a lot faster than running the VM at every position.
+    // Note that these only hold when matching bytes, i.e. not when matching unicode or ignoring case.
+    auto& bytecode = parser_result.bytecode;
+    auto& optimization_data = parser_result.optimization_data;
+
+    struct Instruction {
+        OpCodeId opcode_id { OpCodeId::Exit };
+        size_t position { 0 };
+        Optional<size_t> target_position {};
+        bool falls_through { true };
+        Optional<ByteString> literal {};
+    };
+    Vector<Instruction> instructions;
+    HashMap<size_t, size_t> instruction_at_position;
+
+    auto bytecode_size = bytecode.size();
+    MatchState state;
+    while (state.instruction_position < bytecode_size) {
+        auto& opcode = bytecode.get_opcode(state);
+        auto position = state.instruction_position;
+        Instruction instruction { .opcode_id = opcode.opcode_id(), .position = position };
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+            instruction.literal = literal_bytes_of(static_cast<OpCode_Compare const&>(opcode));
+            break;
+        case OpCodeId::Jump:
+            instruction.target_position = position + opcode.size() + static_cast<OpCode_Jump const&>(opcode).offset();
+            instruction.falls_through = false;
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            instruction.target_position = position + opcode.size() + static_cast<OpCode_ForkJump const&>(opcode).offset();
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            instruction.target_position = position + opcode.size() + static_cast<OpCode_ForkStay const&>(opcode).offset();
+            break;
+        case OpCodeId::JumpNonEmpty:
+            instruction.target_position = position + opcode.size() + static_cast<OpCode_JumpNonEmpty const&>(opcode).offset();
+            break;
+        case OpCodeId::Repeat:
+            instruction.target_position = position - static_cast<OpCode_Repeat const&>(opcode).offset();
+            break;
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::Checkpoint:
+        case OpCodeId::ResetRepeat:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+            break;
+        default:
+            // Lookarounds look at parts of the input that aren't part of the match.
+            return;
+        }
+
+        instruction_at_position.set(position, instructions.size());
+        instructions.append(move(instruction));
+        state.instruction_position += opcode.size();
+    }
+
+    // The instruction after the last one stands for the end of the pattern.
+    auto const end = instructions.size();
+    Vector<Optional<size_t>> targets;
+    Vector<bool> is_jump_target;
+    is_jump_target.resize(end + 1);
+    for (auto const& instruction : instructions) {
+        if (!instruction.target_position.has_value()) {
+            targets.append({});
+            continue;
+        }
+        auto target_position = *instruction.target_position;
+        size_t target = end;
+        if (target_position < bytecode_size) {
+            auto index = instruction_at_position.get(target_position);
+            if (!index.has_value())
+                return;
+            target = *index;
+        }
+        targets.append(target);
+        is_jump_target[target] = true;
+    }
+
+    auto for_each_successor = [&](size_t index, auto callback) {
+        if (instructions[index].falls_through)
+            callback(index + 1);
+        if (targets[index].has_value())
+            callback(*targets[index]);
+    };
+
+    auto is_zero_width_without_branches = [&](Instruction const& instruction) {
+        return instruction.opcode_id != OpCodeId::Compare && instruction.falls_through && !instruction.target_position.has_value();
+    };
+
+    // Whatever the first instructions match unconditionally is what every match starts with.
+    StringBuilder prefix;
+    for (auto const& instruction : instructions) {
+        if (instruction.literal.has_value())
+            prefix.append(*instruction.literal);
+        else if (!is_zero_width_without_branches(instruction))
+            break;
+    }
+    if (!prefix.is_empty())
+        optimization_data.literal_prefix = prefix.to_byte_string();
+
+    // A run of literals that can only be entered from the start has to be matched as a whole. If every way through the
+    // pattern goes through it, every match contains it.
+    struct Run {
+        size_t first_instruction { 0 };
+        ByteString bytes;
+    };
+    Vector<Run> runs;
+    for (size_t i = 0; i < end; ++i) {
+        if (!instructions[i].literal.has_value())
+            continue;
+        StringBuilder bytes;
+        auto first_instruction = i;
+        for (; i < end; ++i) {
+            if (i != first_instruction && is_jump_target[i])
+                break;
+            if (instructions[i].literal.has_value())
+                bytes.append(*instructions[i].literal);
+            else if (!is_zero_width_without_branches(instructions[i]))
+                break;
+        }
+        runs.append({ first_instruction, bytes.to_byte_string() });
+        --i;
+    }
+    quick_sort(runs, [](auto const& a, auto const& b) { return a.bytes.length() > b.bytes.length(); });
+
+    auto can_reach_end_without = [&](size_t avoided_instruction) {
+        if (avoided_instruction == 0)
+            return false;
+        Vector<bool> seen;
+        seen.resize(end + 1);
+        Vector<size_t> to_visit { 0 };
+        seen[0] = true;
+        while (!to_visit.is_empty()) {
+            auto index = to_visit.take_last();
+            if (index == end)
+                return true;
+            for_each_successor(index, [&](size_t successor) {
+                if (successor == avoided_instruction || seen[successor])
+                    return;
+                seen[successor] = true;
+                to_visit.append(successor);
+            });
+        }
+        return false;
+    };
+
+    static constexpr size_t max_instructions_to_look_through = 4096;
+    if (end <= max_instructions_to_look_through) {
+        for (auto const& run : runs) {
+            if (can_reach_end_without(run.first_instruction))
+                continue;
+            if (!optimization_data.literal_prefix.has_value() || !optimization_data.literal_prefix->contains(run.bytes))
+                optimization_data.required_literal = run.bytes;
+            break;
+        }
+    }
+
+    if (optimization_data.literal_prefix.has_value())
+        return;
+
+    // Otherwise, look at all the compares that could come first.
+    static constexpr size_t max_starting_bytes = 16;
+    Array<bool, 256> can_start_with {};
+    size_t starting_byte_count = 0;
+    auto add_starting_bytes = [&](u32 from, u32 to) {
+        if (to > 0xff)
+            return false;
+        for (auto byte = from; byte <= to; ++byte) {
+            if (can_start_with[byte])
+                continue;
+            can_start_with[byte] = true;
+            if (++starting_byte_count > max_starting_bytes)
+                return false;
+        }
+        return true;
+    };
+
+    Vector<bool> seen;
+    seen.resize(end + 1);
+    Vector<size_t> to_visit { 0 };
+    seen[0] = true;
+    while (!to_visit.is_empty()) {
+        auto index = to_visit.take_last();
+        // The pattern could match without consuming anything.
+        if (index == end)
+            return;
+
+        if (instructions[index].opcode_id == OpCodeId::Compare) {
+            state.instruction_position = instructions[index].position;
+            auto& compare = static_cast<OpCode_Compare const&>(bytecode.get_opcode(state));
+            for (auto& flat_compare : compare.flat_compares()) {
+                bool is_small_enough = false;
+                if (flat_compare.type == CharacterCompareType::Char)
+                    is_small_enough = add_starting_bytes(flat_compare.value, flat_compare.value);
+                else if (flat_compare.type == CharacterCompareType::CharRange)
+                    is_small_enough = add_starting_bytes(CharRange(flat_compare.value).from, CharRange(flat_compare.value).to);
+                if (!is_small_enough)
+                    return;
+            }
+            continue;
+        }
+
+        for_each_successor(index, [&](size_t successor) {
+            if (seen[successor])
+                return;
+            seen[successor] = true;
+            to_visit.append(successor);
+        });
+    }
+
+    for (size_t byte = 0; byte < can_start_with.size(); ++byte) {
+        if (can_start_with[byte])
+            optimization_data.starting_bytes.append(byte);
+    }
+}
+
 template<typename Parser>
 void Regex<Parser>::attempt_rewrite_loops_as_atomic_groups(BasicBlockList const& basic_blocks)
 {
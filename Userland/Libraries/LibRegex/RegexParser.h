@@ -58,6 +58,12 @@ public:
 
         struct {
             Optional<ByteString> pure_substring_search;
+            // Bytes that every match starts with.
+            Optional<ByteString> literal_prefix;
+            // Bytes that every match contains somewhere.
+            Optional<ByteString> required_literal;
+            // The first byte of every match is one of these.
+            Vector<u8> starting_bytes;
         } optimization_data {};
     };
 
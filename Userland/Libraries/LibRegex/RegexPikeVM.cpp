@@ -0,0 +1,483 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <LibRegex/RegexPikeVM.h>
+
+namespace regex {
+
+// How many characters of the input can be looked up in the compare cache.
+static constexpr size_t compare_cache_characters = 128;
+
+// Returns whether the compare only ever looks at a single character, or nothing if it has to look at something a thread
+// doesn't keep track of.
+static Optional<bool> compare_looks_at_single_character(ByteCode const& bytecode, size_t position, size_t argument_count)
+{
+    bool looks_at_single_character = true;
+    size_t offset = position + 3;
+    for (size_t i = 0; i < argument_count; ++i) {
+        switch (static_cast<CharacterCompareType>(bytecode.at(offset++))) {
+        case CharacterCompareType::Inverse:
+        case CharacterCompareType::TemporaryInverse:
+        case CharacterCompareType::AnyChar:
+        case CharacterCompareType::And:
+        case CharacterCompareType::Or:
+        case CharacterCompareType::EndAndOr:
+            break;
+        case CharacterCompareType::Char:
+        case CharacterCompareType::CharClass:
+        case CharacterCompareType::CharRange:
+        case CharacterCompareType::Property:
+        case CharacterCompareType::GeneralCategory:
+        case CharacterCompareType::Script:
+        case CharacterCompareType::ScriptExtension:
+            ++offset;
+            break;
+        case CharacterCompareType::LookupTable: {
+            auto count = bytecode.at(offset++);
+            offset += count;
+            break;
+        }
+        case CharacterCompareType::String: {
+            auto length = bytecode.at(offset++);
+            offset += length;
+            looks_at_single_character = false;
+            break;
+        }
+        default:
+            // Backreferences need to know what the capture groups matched.
+            return {};
+        }
+    }
+    return looks_at_single_character;
+}
+
+OwnPtr<PikeVM> PikeVM::create(ByteCode const& bytecode)
+{
+    auto vm = adopt_own(*new PikeVM);
+
+    HashMap<size_t, size_t> instruction_at_position;
+    HashMap<size_t, size_t> checkpoint_slots;
+    HashMap<size_t, size_t> repetition_slots;
+    HashMap<size_t, size_t> capture_group_slots;
+    Vector<ssize_t> target_positions;
+
+    auto slot_for = [&](HashMap<size_t, size_t>& slots, size_t id, size_t slot_count = 1) {
+        return slots.ensure(id, [&] {
+            auto slot = vm->m_slot_count;
+            vm->m_slot_count += slot_count;
+            return slot;
+        });
+    };
+
+    auto bytecode_size = bytecode.size();
+    MatchState state;
+    while (state.instruction_position < bytecode_size) {
+        auto& opcode = bytecode.get_opcode(state);
+        auto position = state.instruction_position;
+
+        Instruction instruction { .opcode_id = opcode.opcode_id(), .position = position };
+        ssize_t target_position = -1;
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            auto const& compare = static_cast<OpCode_Compare const&>(opcode);
+            auto looks_at_single_character = compare_looks_at_single_character(bytecode, position, compare.arguments_count());
+            if (!looks_at_single_character.has_value())
+                return nullptr;
+            if (*looks_at_single_character)
+                instruction.compare_cache_index = vm->m_cacheable_compare_count++;
+            break;
+        }
+        case OpCodeId::Jump:
+            target_position = position + opcode.size() + static_cast<OpCode_Jump const&>(opcode).offset();
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            target_position = position + opcode.size() + static_cast<OpCode_ForkJump const&>(opcode).offset();
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            target_position = position + opcode.size() + static_cast<OpCode_ForkStay const&>(opcode).offset();
+            break;
+        case OpCodeId::JumpNonEmpty: {
+            auto const& jump = static_cast<OpCode_JumpNonEmpty const&>(opcode);
+            target_position = position + opcode.size() + jump.offset();
+            instruction.form = jump.form();
+            instruction.slot = slot_for(checkpoint_slots, jump.checkpoint());
+            break;
+        }
+        case OpCodeId::Checkpoint:
+            instruction.slot = slot_for(checkpoint_slots, static_cast<OpCode_Checkpoint const&>(opcode).id());
+            break;
+        case OpCodeId::Repeat: {
+            auto const& repeat = static_cast<OpCode_Repeat const&>(opcode);
+            target_position = static_cast<ssize_t>(position) - static_cast<ssize_t>(repeat.offset());
+            instruction.count = repeat.count();
+            instruction.slot = slot_for(repetition_slots, repeat.id());
+            break;
+        }
+        case OpCodeId::ResetRepeat:
+            instruction.slot = slot_for(repetition_slots, static_cast<OpCode_ResetRepeat const&>(opcode).id());
+            break;
+        case OpCodeId::SaveLeftCaptureGroup:
+            instruction.slot = slot_for(capture_group_slots, static_cast<OpCode_SaveLeftCaptureGroup const&>(opcode).id(), 3);
+            break;
+        case OpCodeId::SaveRightCaptureGroup:
+            instruction.slot = slot_for(capture_group_slots, static_cast<OpCode_SaveRightCaptureGroup const&>(opcode).id(), 3);
+            break;
+        case OpCodeId::SaveRightNamedCaptureGroup:
+            instruction.slot = slot_for(capture_group_slots, static_cast<OpCode_SaveRightNamedCaptureGroup const&>(opcode).id(), 3);
+            break;
+        case OpCodeId::ClearCaptureGroup:
+            instruction.slot = slot_for(capture_group_slots, static_cast<OpCode_ClearCaptureGroup const&>(opcode).id(), 3);
+            break;
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+            break;
+        default:
+            // Lookaround moves back and forth in the input, which threads that all advance together can't do.
+            return nullptr;
+        }
+
+        instruction_at_position.set(position, vm->m_instructions.size());
+        vm->m_instructions.append(instruction);
+        target_positions.append(target_position);
+        state.instruction_position += opcode.size();
+    }
+
+    for (size_t i = 0; i < vm->m_instructions.size(); ++i) {
+        auto& instruction = vm->m_instructions[i];
+        instruction.next = i + 1;
+
+        auto target_position = target_positions[i];
+        if (target_position < 0)
+            continue;
+        // Like the backtracking VM, running off the end of the bytecode means that the pattern has matched.
+        if (static_cast<size_t>(target_position) >= bytecode_size) {
+            instruction.target = vm->end();
+            continue;
+        }
+        auto target = instruction_at_position.get(target_position);
+        if (!target.has_value())
+            return nullptr;
+        instruction.target = *target;
+    }
+
+    for (auto const& entry : repetition_slots)
+        vm->m_repetition_slots.append(entry.value);
+    for (auto const& entry : capture_group_slots)
+        vm->m_capture_groups.append({ entry.key, entry.value });
+
+    return vm;
+}
+
+bool PikeVM::match(ByteCode const& bytecode, MatchInput const& input, MatchState& state, size_t& operations) const
+{
+    return run(bytecode, input, state, operations, Anchored::Yes).has_value();
+}
+
+Optional<size_t> PikeVM::search(ByteCode const& bytecode, MatchInput const& input, MatchState& state, size_t& operations) const
+{
+    return run(bytecode, input, state, operations, Anchored::No);
+}
+
+struct CounterStateTraits : public DefaultTraits<Vector<size_t>> {
+    static unsigned hash(Vector<size_t> const& key)
+    {
+        unsigned hash = 0;
+        for (auto value : key)
+            hash = pair_int_hash(hash, u64_hash(value));
+        return hash;
+    }
+};
+
+Optional<size_t> PikeVM::run(ByteCode const& bytecode, MatchInput const& input, MatchState& state, size_t& operations, Anchored anchored) const
+{
+    using Slots = Vector<size_t, 8>;
+    struct Thread {
+        size_t instruction { 0 };
+        // Compares that consume more than one character leave the thread waiting for the others to catch up.
+        size_t characters_to_skip { 0 };
+        Slots slots;
+    };
+
+    if (!m_compare_cache_options.has_value() || *m_compare_cache_options != input.regex_options.value()) {
+        m_compare_cache.clear_with_capacity();
+        m_compare_cache.resize(m_cacheable_compare_count * compare_cache_characters);
+        m_compare_cache_options = input.regex_options.value();
+    }
+
+    auto const length = input.view.length();
+    auto const length_in_code_units = input.view.length_in_code_units();
+    size_t position = state.string_position;
+    size_t position_in_code_units = state.string_position_in_code_units;
+
+    // The threads that are at the current and at the next position, from the highest to the lowest priority.
+    Vector<Thread> current_threads;
+    Vector<Thread> next_threads;
+    Vector<Thread> alternatives;
+
+    // A thread that reaches an instruction another thread has already reached at this position would do everything
+    // the same from here on, only with a lower priority. Counted repetitions change what comes next, so they're part
+    // of what has been reached if there are any.
+    Vector<size_t> step_of_last_visit;
+    step_of_last_visit.resize(end() + 1);
+    HashTable<Vector<size_t>, CounterStateTraits> visited_with_counters;
+    size_t step = 0;
+
+    auto mark_visited = [&](Thread const& thread) {
+        if (m_repetition_slots.is_empty()) {
+            if (step_of_last_visit[thread.instruction] == step)
+                return false;
+            step_of_last_visit[thread.instruction] = step;
+            return true;
+        }
+        Vector<size_t> key;
+        key.ensure_capacity(m_repetition_slots.size() + 1);
+        key.unchecked_append(thread.instruction);
+        for (auto slot : m_repetition_slots)
+            key.unchecked_append(thread.slots[slot]);
+        return visited_with_counters.set(move(key)) == HashSetResult::InsertedNewEntry;
+    };
+
+    // Runs a compare or an assertion at the current position, and returns how many characters it consumed.
+    MatchState scratch_state;
+    auto evaluate = [&](Instruction const& instruction) -> Optional<size_t> {
+        u8* cached_result = nullptr;
+        if (instruction.compare_cache_index.has_value() && position_in_code_units < length_in_code_units) {
+            auto character = input.view.code_unit_at(position_in_code_units);
+            if (character < compare_cache_characters) {
+                cached_result = &m_compare_cache[*instruction.compare_cache_index * compare_cache_characters + character];
+                if (*cached_result == 1)
+                    return {};
+                if (*cached_result != 0)
+                    return *cached_result - 2;
+            }
+        }
+
+        scratch_state.string_position = position;
+        scratch_state.string_position_in_code_units = position_in_code_units;
+        scratch_state.instruction_position = instruction.position;
+        Optional<size_t> consumed;
+        if (bytecode.get_opcode(scratch_state).execute(input, scratch_state) == ExecutionResult::Continue)
+            consumed = scratch_state.string_position - position;
+
+        if (cached_result)
+            *cached_result = consumed.has_value() ? *consumed + 2 : 1;
+        return consumed;
+    };
+
+    Optional<Slots> matched_slots;
+    size_t match_end = 0;
+    size_t match_end_in_code_units = 0;
+
+    // Follows the thread up to where it has to look at the next character, going down the alternatives in the order
+    // the backtracking VM would. Returns true if it reaches the end of the pattern.
+    auto follow = [&](Thread thread) {
+        alternatives.clear_with_capacity();
+        alternatives.append(move(thread));
+        while (!alternatives.is_empty()) {
+            auto path = alternatives.take_last();
+            while (mark_visited(path)) {
+                ++operations;
+                if (path.instruction == end()) {
+                    matched_slots = move(path.slots);
+                    match_end = position;
+                    match_end_in_code_units = position_in_code_units;
+                    return true;
+                }
+
+                auto const& instruction = m_instructions[path.instruction];
+                auto fork = [&](size_t preferred, size_t other) {
+                    alternatives.append({ other, 0, path.slots });
+                    path.instruction = preferred;
+                };
+
+                bool is_dead = false;
+                switch (instruction.opcode_id) {
+                case OpCodeId::Compare: {
+                    auto consumed = evaluate(instruction);
+                    if (!consumed.has_value()) {
+                        is_dead = true;
+                    } else if (*consumed == 0) {
+                        path.instruction = instruction.next;
+                    } else {
+                        next_threads.append({ instruction.next, *consumed - 1, move(path.slots) });
+                        is_dead = true;
+                    }
+                    break;
+                }
+                case OpCodeId::CheckBegin:
+                case OpCodeId::CheckEnd:
+                case OpCodeId::CheckBoundary:
+                    if (evaluate(instruction).has_value())
+                        path.instruction = instruction.next;
+                    else
+                        is_dead = true;
+                    break;
+                case OpCodeId::Jump:
+                    path.instruction = instruction.target;
+                    break;
+                case OpCodeId::ForkJump:
+                case OpCodeId::ForkReplaceJump:
+                    fork(instruction.target, instruction.next);
+                    break;
+                case OpCodeId::ForkStay:
+                case OpCodeId::ForkReplaceStay:
+                    fork(instruction.next, instruction.target);
+                    break;
+                case OpCodeId::JumpNonEmpty: {
+                    // Loops only go around again if the last time around consumed something.
+                    auto checkpoint = path.slots[instruction.slot];
+                    if (checkpoint == 0 || checkpoint == position + 1) {
+                        path.instruction = instruction.next;
+                        break;
+                    }
+                    switch (instruction.form) {
+                    case OpCodeId::Jump:
+                        path.instruction = instruction.target;
+                        break;
+                    case OpCodeId::ForkJump:
+                    case OpCodeId::ForkReplaceJump:
+                        fork(instruction.target, instruction.next);
+                        break;
+                    case OpCodeId::ForkStay:
+                    case OpCodeId::ForkReplaceStay:
+                        fork(instruction.next, instruction.target);
+                        break;
+                    default:
+                        path.instruction = instruction.next;
+                        break;
+                    }
+                    break;
+                }
+                case OpCodeId::Checkpoint:
+                    path.slots[instruction.slot] = position + 1;
+                    path.instruction = instruction.next;
+                    break;
+                case OpCodeId::Repeat: {
+                    auto& counter = path.slots[instruction.slot];
+                    if (counter == instruction.count - 1) {
+                        counter = 0;
+                        path.instruction = instruction.next;
+                    } else {
+                        ++counter;
+                        path.instruction = instruction.target;
+                    }
+                    break;
+                }
+                case OpCodeId::ResetRepeat:
+                    path.slots[instruction.slot] = 0;
+                    path.instruction = instruction.next;
+                    break;
+                case OpCodeId::SaveLeftCaptureGroup:
+                    path.slots[instruction.slot] = position;
+                    path.instruction = instruction.next;
+                    break;
+                case OpCodeId::SaveRightCaptureGroup:
+                case OpCodeId::SaveRightNamedCaptureGroup:
+                    if (position < path.slots[instruction.slot]) {
+                        is_dead = true;
+                        break;
+                    }
+                    path.slots[instruction.slot + 1] = instruction.position + 1;
+                    path.slots[instruction.slot + 2] = position;
+                    path.instruction = instruction.next;
+                    break;
+                case OpCodeId::ClearCaptureGroup:
+                    path.slots[instruction.slot] = 0;
+                    path.slots[instruction.slot + 1] = instruction.position + 1;
+                    path.instruction = instruction.next;
+                    break;
+                default:
+                    VERIFY_NOT_REACHED();
+                }
+
+                if (is_dead)
+                    break;
+            }
+        }
+        return false;
+    };
+
+    bool may_start_here = true;
+    for (;;) {
+        ++step;
+        if (!visited_with_counters.is_empty())
+            visited_with_counters.clear();
+
+        // A match that starts here has a lower priority than any that started earlier.
+        if (may_start_here && !matched_slots.has_value()) {
+            Thread thread;
+            thread.slots.resize(m_slot_count);
+            thread.slots[0] = position;
+            current_threads.append(move(thread));
+        }
+
+        for (auto& thread : current_threads) {
+            if (thread.characters_to_skip > 0) {
+                --thread.characters_to_skip;
+                next_threads.append(move(thread));
+                continue;
+            }
+            // Any thread after this one would only find a match the backtracking VM wouldn't get to.
+            if (follow(move(thread)))
+                break;
+        }
+        current_threads.clear_with_capacity();
+
+        if (anchored == Anchored::Yes)
+            may_start_here = false;
+        if (next_threads.is_empty() && (matched_slots.has_value() || !may_start_here))
+            break;
+        if (position >= length)
+            break;
+
+        // Like advance_string_position(), as the positions may disagree on a string that isn't valid in its encoding.
+        if (!input.view.unicode())
+            ++position_in_code_units;
+        else if (position_in_code_units < length_in_code_units)
+            position_in_code_units += input.view.length_of_code_point(input.view[position_in_code_units]);
+        ++position;
+        swap(current_threads, next_threads);
+    }
+
+    if (!matched_slots.has_value())
+        return {};
+
+    auto const& slots = *matched_slots;
+    if (!m_capture_groups.is_empty()) {
+        while (state.capture_group_matches.size() <= input.match_index)
+            state.capture_group_matches.empend();
+        state.capture_group_matches.mutable_at(input.match_index).clear();
+
+        for (auto const& group : m_capture_groups) {
+            auto last_operation = slots[group.slot + 1];
+            if (last_operation == 0)
+                continue;
+
+            auto& groups = state.capture_group_matches.mutable_at(input.match_index);
+            if (group.id >= groups.size())
+                groups.resize(group.id + 1);
+            groups[group.id].left_column = slots[group.slot];
+
+            // Let the instruction that saved or cleared the group last fill it in, so it ends up exactly like it would
+            // have with the backtracking VM.
+            state.string_position = slots[group.slot + 2];
+            state.instruction_position = last_operation - 1;
+            bytecode.get_opcode(state).execute(input, state);
+        }
+    }
+
+    state.string_position = match_end;
+    state.string_position_in_code_units = match_end_in_code_units;
+    return slots[0];
+}
+
+}
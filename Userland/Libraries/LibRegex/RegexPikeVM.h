@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+#include "RegexMatch.h"
+#include "RegexOptions.h"
+
+#include <AK/Optional.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+// Runs the bytecode of patterns that never have to look back at the input (no backreferences or lookaround) as an NFA.
+// Every way the pattern could go is followed through the input at the same time, so each character is looked at once
+// per thread instead of once per backtracking attempt, and matching takes time linear in the length of the input.
+// The threads are kept in the order in which the backtracking VM would try them, so the same match is found.
+class PikeVM {
+public:
+    // Returns nothing if the bytecode does something that can't be run this way.
+    static OwnPtr<PikeVM> create(ByteCode const&);
+
+    // Like Matcher::execute(), only finds matches that start right at the current position of the state.
+    bool match(ByteCode const&, MatchInput const&, MatchState&, size_t& operations) const;
+
+    // Finds the leftmost match that starts at or after the current position of the state, and returns where it starts.
+    Optional<size_t> search(ByteCode const&, MatchInput const&, MatchState&, size_t& operations) const;
+
+private:
+    PikeVM() = default;
+
+    struct Instruction {
+        OpCodeId opcode_id { OpCodeId::Exit };
+        size_t position { 0 };
+        size_t next { 0 };
+        size_t target { 0 };
+        size_t slot { 0 };
+        u64 count { 0 };
+        OpCodeId form { OpCodeId::Jump };
+        Optional<size_t> compare_cache_index {};
+    };
+
+    struct CaptureGroup {
+        size_t id { 0 };
+        size_t slot { 0 };
+    };
+
+    enum class Anchored {
+        No,
+        Yes,
+    };
+
+    Optional<size_t> run(ByteCode const&, MatchInput const&, MatchState&, size_t& operations, Anchored) const;
+
+    // The instruction after the last one stands for reaching the end of the pattern.
+    Vector<Instruction> m_instructions;
+    size_t end() const { return m_instructions.size(); }
+
+    // Each thread keeps where its match started, the positions of its checkpoints, the counters of its repetitions,
+    // and its capture groups in a flat list of slots.
+    size_t m_slot_count { 1 };
+    Vector<size_t> m_repetition_slots;
+    Vector<CaptureGroup> m_capture_groups;
+
+    // What the compares that look at a single character gave for every ASCII character, filled in as they're needed.
+    size_t m_cacheable_compare_count { 0 };
+    mutable Vector<u8> m_compare_cache;
+    mutable Optional<AllFlags> m_compare_cache_options;
+};
+
+}
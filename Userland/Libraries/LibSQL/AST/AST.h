@@ -9,6 +9,7 @@
 #pragma once
 
 #include <AK/ByteString.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/RefPtr.h>
@@ -985,7 +986,14 @@ public:
 
     virtual ResultOr<ResultSet> execute(ExecutionContext&) const override;
 
+    // Executes the statement once for each set of placeholder values, inserting all resulting rows at once.
+    ResultOr<ResultSet> execute_batch(NonnullRefPtr<Database>, ReadonlySpan<Vector<Value>> placeholder_value_sets) const;
+
 private:
+    ResultOr<void> validate_column_names(NonnullRefPtr<TableDef> const&) const;
+    ResultOr<void> evaluate_rows(ExecutionContext&, NonnullRefPtr<TableDef> const&, Vector<Row>&) const;
+    ResultOr<ResultSet> insert_rows(NonnullRefPtr<Database> const&, Vector<Row>) const;
+
     RefPtr<CommonTableExpressionList> m_common_table_expression_list;
     ConflictResolution m_conflict_resolution;
     ByteString m_schema_name;
@@ -1082,6 +1090,8 @@ public:
     RefPtr<LimitClause> const& limit_clause() const { return m_limit_clause; }
     ResultOr<ResultSet> execute(ExecutionContext&) const override;
 
+    ResultOr<NonnullOwnPtr<Operator<ResultRow>>> create_operator_tree(ExecutionContext&, Vector<ByteString>& column_names) const;
+
 private:
     RefPtr<CommonTableExpressionList> m_common_table_expression_list;
     bool m_select_all;
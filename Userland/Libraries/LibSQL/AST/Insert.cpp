@@ -15,17 +15,53 @@ namespace SQL::AST {
 ResultOr<ResultSet> Insert::execute(ExecutionContext& context) const
 {
     auto table_def = TRY(context.database->get_table(m_schema_name, m_table_name));
+    TRY(validate_column_names(table_def));
 
+    Vector<Row> rows;
+    TRY(evaluate_rows(context, table_def, rows));
+
+    return insert_rows(context.database, move(rows));
+}
+
+ResultOr<ResultSet> Insert::execute_batch(NonnullRefPtr<Database> database, ReadonlySpan<Vector<Value>> placeholder_value_sets) const
+{
+    auto table_def = TRY(database->get_table(m_schema_name, m_table_name));
+    TRY(validate_column_names(table_def));
+
+    Vector<Row> rows;
+    TRY(rows.try_ensure_capacity(placeholder_value_sets.size() * m_chained_expressions.size()));
+
+    for (auto const& placeholder_values : placeholder_value_sets) {
+        ExecutionContext context { database, this, placeholder_values, nullptr };
+        TRY(evaluate_rows(context, table_def, rows));
+    }
+
+    auto result = TRY(insert_rows(database, move(rows)));
+
+    // FIXME: When transactional sessions are supported, don't auto-commit modifications.
+    TRY(database->commit());
+
+    return result;
+}
+
+ResultOr<void> Insert::validate_column_names(NonnullRefPtr<TableDef> const& table_def) const
+{
     Row row(table_def);
     for (auto& column : m_column_names) {
         if (!row.has(column))
             return Result { SQLCommand::Insert, SQLErrorCode::ColumnDoesNotExist, column };
     }
 
-    ResultSet result { SQLCommand::Insert };
-    TRY(result.try_ensure_capacity(m_chained_expressions.size()));
+    return {};
+}
+
+ResultOr<void> Insert::evaluate_rows(ExecutionContext& context, NonnullRefPtr<TableDef> const& table_def, Vector<Row>& rows) const
+{
+    TRY(rows.try_ensure_capacity(rows.size() + m_chained_expressions.size()));
 
     for (auto& row_expr : m_chained_expressions) {
+        Row row(table_def);
+
         for (auto& column_def : table_def->columns()) {
             if (!m_column_names.contains_slow(column_def->name()))
                 row[column_def->name()] = column_def->default_value();
@@ -51,10 +87,22 @@ ResultOr<ResultSet> Insert::execute(ExecutionContext& context) const
             row[element_index] = move(values[ix]);
         }
 
-        TRY(context.database->insert(row));
-        result.insert_row(row, {});
+        rows.unchecked_append(move(row));
     }
 
+    return {};
+}
+
+ResultOr<ResultSet> Insert::insert_rows(NonnullRefPtr<Database> const& database, Vector<Row> rows) const
+{
+    TRY(database->bulk_insert(rows));
+
+    ResultSet result { SQLCommand::Insert };
+    TRY(result.try_ensure_capacity(rows.size()));
+
+    for (auto& row : rows)
+        result.insert_row(row, {});
+
     return result;
 }
 
@@ -0,0 +1,447 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashFunctions.h>
+#include <AK/QuickSort.h>
+#include <AK/ScopeGuard.h>
+#include <LibSQL/AST/Operator.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/Meta.h>
+#include <LibSQL/Row.h>
+
+namespace SQL::AST {
+
+ResultOr<Optional<Tuple>> UnityRow::next(ExecutionContext&)
+{
+    if (m_exhausted)
+        return Optional<Tuple> {};
+
+    m_exhausted = true;
+    return m_row;
+}
+
+TableScan::TableScan(NonnullRefPtr<TableDef> table, Vector<ColumnPredicate> predicates)
+    : m_table(move(table))
+    , m_predicates(move(predicates))
+{
+}
+
+ResultOr<void> TableScan::evaluate_predicate_values(ExecutionContext& context)
+{
+    // The predicate values do not depend on the current row, so they are only evaluated once.
+    auto* current_row = exchange(context.current_row, nullptr);
+    ScopeGuard restore_current_row = [&] { context.current_row = current_row; };
+
+    TRY(m_predicate_values.try_ensure_capacity(m_predicates.size()));
+    for (auto const& predicate : m_predicates)
+        m_predicate_values.unchecked_append(TRY(predicate.value->evaluate(context)));
+
+    return {};
+}
+
+bool TableScan::matches_predicates(Row const& row) const
+{
+    for (size_t i = 0; i < m_predicates.size(); ++i) {
+        auto const& predicate = m_predicates[i];
+        auto const& column_value = row[predicate.column_index];
+        auto const& value = m_predicate_values[i];
+
+        // Compare in the order the operands were written, exactly as BinaryOperatorExpression::evaluate would.
+        auto comparison = predicate.column_is_lhs ? column_value.compare(value) : value.compare(column_value);
+
+        bool matches = false;
+        switch (predicate.type) {
+        case BinaryOperator::Equals:
+            matches = comparison == 0;
+            break;
+        case BinaryOperator::LessThan:
+            matches = comparison < 0;
+            break;
+        case BinaryOperator::LessThanEquals:
+            matches = comparison <= 0;
+            break;
+        case BinaryOperator::GreaterThan:
+            matches = comparison > 0;
+            break;
+        case BinaryOperator::GreaterThanEquals:
+            matches = comparison >= 0;
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+
+        if (!matches)
+            return false;
+    }
+
+    return true;
+}
+
+TableScan::~TableScan()
+{
+    stop_reading_blocks();
+}
+
+void TableScan::stop_reading_blocks()
+{
+    m_next_block_index = 0;
+    if (m_database)
+        m_database->unregister_open_table_scan(*this);
+    m_database = nullptr;
+}
+
+ResultOr<Optional<Tuple>> TableScan::next(ExecutionContext& context)
+{
+    if (!m_started) {
+        TRY(evaluate_predicate_values(context));
+        m_next_block_index = m_table->block_index();
+        m_started = true;
+
+        if (m_next_block_index != 0) {
+            m_database = context.database;
+            m_database->register_open_table_scan(*this);
+        }
+    }
+
+    while (m_next_block_index != 0) {
+        auto row = m_database->read_row(*m_table, m_next_block_index);
+        m_next_block_index = row.next_block_index();
+        if (m_next_block_index == 0)
+            stop_reading_blocks();
+
+        if (matches_predicates(row))
+            return Tuple { row };
+    }
+
+    if (m_remaining_row_index < m_remaining_rows.size())
+        return Tuple { m_remaining_rows[m_remaining_row_index++] };
+
+    return Optional<Tuple> {};
+}
+
+void TableScan::read_remaining_rows()
+{
+    VERIFY(m_database);
+
+    while (m_next_block_index != 0) {
+        auto row = m_database->read_row(*m_table, m_next_block_index);
+        m_next_block_index = row.next_block_index();
+
+        if (matches_predicates(row))
+            m_remaining_rows.append(move(row));
+    }
+
+    stop_reading_blocks();
+}
+
+ResultOr<Optional<Tuple>> CrossJoin::next(ExecutionContext& context)
+{
+    if (!m_started) {
+        m_outer_row = TRY(m_outer->next(context));
+
+        // Peek at the following outer row: the inner rows only have to be kept around if they are
+        // going to be joined with more than one outer row.
+        m_next_outer_row = TRY(m_outer->next(context));
+        m_started = true;
+    }
+
+    for (;;) {
+        if (!m_outer_row.has_value())
+            return Optional<Tuple> {};
+        if (m_inner_exhausted && m_inner_rows.is_empty())
+            return Optional<Tuple> {};
+
+        Optional<Tuple> inner_row;
+
+        if (!m_inner_exhausted) {
+            inner_row = TRY(m_inner->next(context));
+
+            if (!inner_row.has_value())
+                m_inner_exhausted = true;
+            else if (m_next_outer_row.has_value())
+                TRY(m_inner_rows.try_append(*inner_row));
+        } else if (m_inner_index < m_inner_rows.size()) {
+            inner_row = m_inner_rows[m_inner_index++];
+        }
+
+        if (inner_row.has_value()) {
+            // All outer rows share a descriptor which already describes the inner columns as well,
+            // so extending a copy of the outer row only appends the values.
+            Tuple row = *m_outer_row;
+            row.extend(*inner_row);
+            return row;
+        }
+
+        m_outer_row = m_next_outer_row;
+        if (m_outer_row.has_value())
+            m_next_outer_row = TRY(m_outer->next(context));
+
+        m_inner_index = 0;
+    }
+}
+
+static u32 hash_join_key(Value const& value)
+{
+    // Integers compare equal by value regardless of how they are stored, so hash them by value as well.
+    if (value.is_int()) {
+        if (auto signed_value = value.to_int<i64>(); signed_value.has_value())
+            return u64_hash(static_cast<u64>(*signed_value));
+        return u64_hash(value.to_int<u64>().value());
+    }
+
+    return value.hash();
+}
+
+Optional<u32> HashJoin::hash_keys(Tuple const& row, bool outer) const
+{
+    u32 hash = 0;
+
+    for (auto const& key : m_keys) {
+        auto const& value = row[outer ? key.outer_column_index : key.inner_column_index];
+
+        // NULL is not equal to anything, not even to NULL.
+        if (value.is_null())
+            return {};
+
+        hash = pair_int_hash(hash, hash_join_key(value));
+    }
+
+    return hash;
+}
+
+bool HashJoin::keys_match(Tuple const& outer_row, Tuple const& inner_row) const
+{
+    for (auto const& key : m_keys) {
+        if (outer_row[key.outer_column_index].compare(inner_row[key.inner_column_index]) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+ResultOr<void> HashJoin::build_hash_table(ExecutionContext& context)
+{
+    for (;;) {
+        auto row = TRY(m_inner->next(context));
+        if (!row.has_value())
+            break;
+
+        auto hash = hash_keys(*row, false);
+        if (!hash.has_value())
+            continue;
+
+        TRY(m_hash_table.ensure(*hash).try_append(m_inner_rows.size()));
+        TRY(m_inner_rows.try_append(row.release_value()));
+    }
+
+    m_hash_table_built = true;
+    return {};
+}
+
+ResultOr<Optional<Tuple>> HashJoin::next(ExecutionContext& context)
+{
+    if (!m_hash_table_built)
+        TRY(build_hash_table(context));
+
+    for (;;) {
+        if (m_candidates) {
+            while (m_candidate_index < m_candidates->size()) {
+                auto const& inner_row = m_inner_rows[(*m_candidates)[m_candidate_index++]];
+                if (!keys_match(*m_outer_row, inner_row))
+                    continue;
+
+                Tuple row = *m_outer_row;
+                row.extend(inner_row);
+                return row;
+            }
+
+            m_candidates = nullptr;
+        }
+
+        if (m_inner_rows.is_empty())
+            return Optional<Tuple> {};
+
+        m_outer_row = TRY(m_outer->next(context));
+        if (!m_outer_row.has_value())
+            return Optional<Tuple> {};
+
+        auto hash = hash_keys(*m_outer_row, true);
+        if (!hash.has_value())
+            continue;
+
+        if (auto candidates = m_hash_table.find(*hash); candidates != m_hash_table.end()) {
+            m_candidates = &candidates->value;
+            m_candidate_index = 0;
+        }
+    }
+}
+
+ResultOr<void> SortMergeJoin::sort_inputs(ExecutionContext& context)
+{
+    auto read_input = [&](RowOperator& input, Vector<Tuple>& rows, size_t key_column_index) -> ResultOr<void> {
+        for (;;) {
+            auto row = TRY(input.next(context));
+            if (!row.has_value())
+                return {};
+
+            // NULL is not equal to anything, not even to NULL.
+            if (!(*row)[key_column_index].is_null())
+                TRY(rows.try_append(row.release_value()));
+        }
+    };
+
+    TRY(read_input(*m_inner, m_inner_rows, m_key.inner_column_index));
+    if (!m_inner_rows.is_empty())
+        TRY(read_input(*m_outer, m_outer_rows, m_key.outer_column_index));
+
+    quick_sort(m_outer_rows, [&](auto const& a, auto const& b) {
+        return a[m_key.outer_column_index].compare(b[m_key.outer_column_index]) < 0;
+    });
+    quick_sort(m_inner_rows, [&](auto const& a, auto const& b) {
+        return a[m_key.inner_column_index].compare(b[m_key.inner_column_index]) < 0;
+    });
+
+    m_inputs_sorted = true;
+    return {};
+}
+
+ResultOr<Optional<Tuple>> SortMergeJoin::next(ExecutionContext& context)
+{
+    if (!m_inputs_sorted)
+        TRY(sort_inputs(context));
+
+    for (;;) {
+        if (m_inner_position < m_inner_group_end) {
+            Tuple row = m_outer_rows[m_outer_position - 1];
+            row.extend(m_inner_rows[m_inner_position++]);
+            return row;
+        }
+
+        if (m_outer_position == m_outer_rows.size())
+            return Optional<Tuple> {};
+
+        auto const& outer_key = m_outer_rows[m_outer_position++][m_key.outer_column_index];
+        auto inner_key = [&](size_t index) -> Value const& { return m_inner_rows[index][m_key.inner_column_index]; };
+
+        // Both sides are sorted, so the group of inner rows matching the outer key only ever moves forward.
+        while (m_inner_group_start < m_inner_rows.size() && inner_key(m_inner_group_start).compare(outer_key) < 0)
+            ++m_inner_group_start;
+
+        m_inner_group_end = m_inner_group_start;
+        while (m_inner_group_end < m_inner_rows.size() && inner_key(m_inner_group_end).compare(outer_key) == 0)
+            ++m_inner_group_end;
+
+        m_inner_position = m_inner_group_start;
+    }
+}
+
+ResultOr<Optional<Tuple>> Filter::next(ExecutionContext& context)
+{
+    for (;;) {
+        auto row = TRY(m_source->next(context));
+        if (!row.has_value())
+            return Optional<Tuple> {};
+
+        context.current_row = &row.value();
+
+        auto result = TRY(m_predicate->evaluate(context)).to_bool();
+        if (result.has_value() && result.value())
+            return row;
+    }
+}
+
+Project::Project(NonnullOwnPtr<RowOperator> source, Vector<NonnullRefPtr<ResultColumn const>> columns, Vector<NonnullRefPtr<OrderingTerm const>> ordering_terms)
+    : m_source(move(source))
+    , m_columns(move(columns))
+    , m_ordering_terms(move(ordering_terms))
+{
+    auto sort_descriptor = adopt_ref(*new TupleDescriptor);
+    for (auto const& term : m_ordering_terms)
+        sort_descriptor->append(TupleElementDescriptor { .order = term->order() });
+    m_sort_key = Tuple { sort_descriptor };
+}
+
+ResultOr<Optional<ResultRow>> Project::next(ExecutionContext& context)
+{
+    auto row = TRY(m_source->next(context));
+    if (!row.has_value())
+        return Optional<ResultRow> {};
+
+    context.current_row = &row.value();
+
+    m_row.clear();
+    for (auto const& column : m_columns)
+        m_row.append(TRY(column->expression()->evaluate(context)));
+
+    m_sort_key.clear();
+    for (auto const& term : m_ordering_terms)
+        m_sort_key.append(TRY(term->expression()->evaluate(context)));
+
+    return ResultRow { m_row, m_sort_key };
+}
+
+ResultOr<Optional<ResultRow>> Sort::next(ExecutionContext& context)
+{
+    if (!m_rows_sorted) {
+        for (;;) {
+            auto row = TRY(m_source->next(context));
+            if (!row.has_value())
+                break;
+
+            m_rows.insert_row(row->row, row->sort_key);
+        }
+
+        m_rows_sorted = true;
+    }
+
+    if (m_position == m_rows.size())
+        return Optional<ResultRow> {};
+
+    return move(m_rows[m_position++]);
+}
+
+ResultOr<Optional<ResultRow>> Limit::next(ExecutionContext& context)
+{
+    for (; m_offset > 0; --m_offset) {
+        if (!TRY(m_source->next(context)).has_value())
+            return Optional<ResultRow> {};
+    }
+
+    // Stop pulling from the source as soon as the limit is reached, so that rows beyond it are never read.
+    if (m_produced == m_limit)
+        return Optional<ResultRow> {};
+
+    auto row = TRY(m_source->next(context));
+    if (row.has_value())
+        ++m_produced;
+
+    return row;
+}
+
+ResultOr<NonnullOwnPtr<Cursor>> Cursor::create(NonnullRefPtr<Database> database, NonnullRefPtr<Select const> statement, Vector<Value> placeholder_values)
+{
+    auto cursor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Cursor(move(database), move(statement), move(placeholder_values))));
+    cursor->m_root = TRY(cursor->m_statement->create_operator_tree(cursor->m_context, cursor->m_column_names));
+    return cursor;
+}
+
+Cursor::Cursor(NonnullRefPtr<Database> database, NonnullRefPtr<Select const> statement, Vector<Value> placeholder_values)
+    : m_statement(move(statement))
+    , m_placeholder_values(move(placeholder_values))
+    , m_context { move(database), m_statement.ptr(), m_placeholder_values.span(), nullptr }
+{
+}
+
+ResultOr<Optional<Tuple>> Cursor::next()
+{
+    auto row = TRY(m_root->next(m_context));
+    if (!row.has_value())
+        return Optional<Tuple> {};
+
+    return move(row->row);
+}
+
+}
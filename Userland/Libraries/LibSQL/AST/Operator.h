@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/Forward.h>
+#include <LibSQL/Heap.h>
+#include <LibSQL/Result.h>
+#include <LibSQL/ResultSet.h>
+#include <LibSQL/Tuple.h>
+
+namespace SQL::AST {
+
+/**
+ * A SELECT statement is executed as a tree of pull-based operators. Each call
+ * to next() produces at most one row, so rows flow through the tree one at a
+ * time instead of being materialized by every stage. Operators which need to
+ * see their whole input before producing output (e.g. Sort) buffer internally.
+ *
+ * RowOperators produce rows shaped like the tables in the FROM clause, which
+ * expressions in WHERE and ORDER BY are evaluated against. ResultOperators
+ * produce the projected result rows (and their sort keys).
+ */
+template<typename T>
+class Operator {
+public:
+    virtual ~Operator() = default;
+
+    // Returns the next row, or an empty Optional once the operator is exhausted.
+    virtual ResultOr<Optional<T>> next(ExecutionContext&) = 0;
+};
+
+using RowOperator = Operator<Tuple>;
+using ResultOperator = Operator<ResultRow>;
+
+// A comparison between a single column of one table and an expression which does not depend on
+// the current row. These are checked while scanning that table, so that rows which can not
+// possibly satisfy the WHERE clause never enter the cartesian product.
+struct ColumnPredicate {
+    size_t column_index { 0 };
+    BinaryOperator type { BinaryOperator::Equals };
+    NonnullRefPtr<Expression const> value;
+    bool column_is_lhs { true };
+};
+
+// Produces a single row holding no table columns, which seeds the cartesian product of the
+// tables in the FROM clause.
+class UnityRow final : public RowOperator {
+public:
+    explicit UnityRow(Tuple row)
+        : m_row(move(row))
+    {
+    }
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    Tuple m_row;
+    bool m_exhausted { false };
+};
+
+// Walks the rows of a table one heap block at a time. If the table is modified before the scan is done,
+// the rows that haven't been produced yet are read into memory first.
+class TableScan final
+    : public RowOperator
+    , public OpenTableScan {
+public:
+    TableScan(NonnullRefPtr<TableDef>, Vector<ColumnPredicate>);
+    virtual ~TableScan() override;
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+    virtual TableDef const& table() const override { return m_table; }
+    virtual void read_remaining_rows() override;
+
+private:
+    ResultOr<void> evaluate_predicate_values(ExecutionContext&);
+    bool matches_predicates(Row const&) const;
+    void stop_reading_blocks();
+
+    NonnullRefPtr<TableDef> m_table;
+    Vector<ColumnPredicate> m_predicates;
+    Vector<Value> m_predicate_values;
+    RefPtr<Database> m_database;
+    Block::Index m_next_block_index { 0 };
+    bool m_started { false };
+
+    Vector<Row> m_remaining_rows;
+    size_t m_remaining_row_index { 0 };
+};
+
+// Extends each row of its outer operator with every row of the inner operator. The outer rows are
+// streamed, the inner rows are buffered on the first pass if there is more than one outer row.
+class CrossJoin final : public RowOperator {
+public:
+    CrossJoin(NonnullOwnPtr<RowOperator> outer, NonnullOwnPtr<RowOperator> inner)
+        : m_outer(move(outer))
+        , m_inner(move(inner))
+    {
+    }
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    NonnullOwnPtr<RowOperator> m_outer;
+    NonnullOwnPtr<RowOperator> m_inner;
+
+    Optional<Tuple> m_outer_row;
+    Optional<Tuple> m_next_outer_row;
+    bool m_started { false };
+
+    Vector<Tuple> m_inner_rows;
+    size_t m_inner_index { 0 };
+    bool m_inner_exhausted { false };
+};
+
+// An equality between a column of the rows produced by the outer operator of a join, and a column of
+// the rows produced by its inner operator.
+struct JoinKey {
+    size_t outer_column_index { 0 };
+    size_t inner_column_index { 0 };
+};
+
+// Joins its outer rows with the inner rows whose keys are equal, by building a hash table of the inner
+// rows. Only usable if the key columns hold values of the same type, which Value::hash() supports.
+class HashJoin final : public RowOperator {
+public:
+    HashJoin(NonnullOwnPtr<RowOperator> outer, NonnullOwnPtr<RowOperator> inner, Vector<JoinKey> keys)
+        : m_outer(move(outer))
+        , m_inner(move(inner))
+        , m_keys(move(keys))
+    {
+    }
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    ResultOr<void> build_hash_table(ExecutionContext&);
+    Optional<u32> hash_keys(Tuple const&, bool outer) const;
+    bool keys_match(Tuple const& outer_row, Tuple const& inner_row) const;
+
+    NonnullOwnPtr<RowOperator> m_outer;
+    NonnullOwnPtr<RowOperator> m_inner;
+    Vector<JoinKey> m_keys;
+
+    Vector<Tuple> m_inner_rows;
+    HashMap<u32, Vector<size_t>> m_hash_table;
+    bool m_hash_table_built { false };
+
+    Optional<Tuple> m_outer_row;
+    Vector<size_t> const* m_candidates { nullptr };
+    size_t m_candidate_index { 0 };
+};
+
+// Joins its outer rows with the inner rows whose keys are equal, by sorting both sides on the key and
+// merging them. Used for keys which can not be hashed, like floating point columns.
+class SortMergeJoin final : public RowOperator {
+public:
+    SortMergeJoin(NonnullOwnPtr<RowOperator> outer, NonnullOwnPtr<RowOperator> inner, JoinKey key)
+        : m_outer(move(outer))
+        , m_inner(move(inner))
+        , m_key(key)
+    {
+    }
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    ResultOr<void> sort_inputs(ExecutionContext&);
+
+    NonnullOwnPtr<RowOperator> m_outer;
+    NonnullOwnPtr<RowOperator> m_inner;
+    JoinKey m_key;
+
+    Vector<Tuple> m_outer_rows;
+    Vector<Tuple> m_inner_rows;
+    bool m_inputs_sorted { false };
+
+    size_t m_outer_position { 0 };
+    size_t m_inner_group_start { 0 };
+    size_t m_inner_group_end { 0 };
+    size_t m_inner_position { 0 };
+};
+
+class Filter final : public RowOperator {
+public:
+    Filter(NonnullOwnPtr<RowOperator> source, NonnullRefPtr<Expression const> predicate)
+        : m_source(move(source))
+        , m_predicate(move(predicate))
+    {
+    }
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    NonnullOwnPtr<RowOperator> m_source;
+    NonnullRefPtr<Expression const> m_predicate;
+};
+
+class Project final : public ResultOperator {
+public:
+    Project(NonnullOwnPtr<RowOperator> source, Vector<NonnullRefPtr<ResultColumn const>> columns, Vector<NonnullRefPtr<OrderingTerm const>> ordering_terms);
+
+    virtual ResultOr<Optional<ResultRow>> next(ExecutionContext&) override;
+
+private:
+    NonnullOwnPtr<RowOperator> m_source;
+    Vector<NonnullRefPtr<ResultColumn const>> m_columns;
+    Vector<NonnullRefPtr<OrderingTerm const>> m_ordering_terms;
+
+    Tuple m_row;
+    Tuple m_sort_key;
+};
+
+class Sort final : public ResultOperator {
+public:
+    explicit Sort(NonnullOwnPtr<ResultOperator> source)
+        : m_source(move(source))
+    {
+    }
+
+    virtual ResultOr<Optional<ResultRow>> next(ExecutionContext&) override;
+
+private:
+    NonnullOwnPtr<ResultOperator> m_source;
+
+    ResultSet m_rows { SQLCommand::Select };
+    bool m_rows_sorted { false };
+    size_t m_position { 0 };
+};
+
+class Limit final : public ResultOperator {
+public:
+    Limit(NonnullOwnPtr<ResultOperator> source, size_t offset, size_t limit)
+        : m_source(move(source))
+        , m_offset(offset)
+        , m_limit(limit)
+    {
+    }
+
+    virtual ResultOr<Optional<ResultRow>> next(ExecutionContext&) override;
+
+private:
+    NonnullOwnPtr<ResultOperator> m_source;
+    size_t m_offset { 0 };
+    size_t m_limit { 0 };
+    size_t m_produced { 0 };
+};
+
+/**
+ * A Cursor owns everything needed to pull the results of a SELECT statement
+ * incrementally, long after the call which created it has returned.
+ */
+class Cursor {
+public:
+    static ResultOr<NonnullOwnPtr<Cursor>> create(NonnullRefPtr<Database>, NonnullRefPtr<Select const>, Vector<Value> placeholder_values);
+
+    Vector<ByteString> const& column_names() const { return m_column_names; }
+
+    // Returns the next result row, or an empty Optional once all rows have been produced.
+    ResultOr<Optional<Tuple>> next();
+
+private:
+    Cursor(NonnullRefPtr<Database>, NonnullRefPtr<Select const>, Vector<Value> placeholder_values);
+
+    NonnullRefPtr<Select const> m_statement;
+    Vector<Value> m_placeholder_values;
+    ExecutionContext m_context;
+
+    Vector<ByteString> m_column_names;
+    OwnPtr<ResultOperator> m_root;
+};
+
+}
@@ -6,12 +6,195 @@
 
 #include <AK/NumericLimits.h>
 #include <LibSQL/AST/AST.h>
+#include <LibSQL/AST/Operator.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Meta.h>
 #include <LibSQL/Row.h>
 
 namespace SQL::AST {
 
+static bool is_row_independent_expression(Expression const& expression)
+{
+    if (is<NumericLiteral>(expression) || is<StringLiteral>(expression) || is<BooleanLiteral>(expression) || is<Placeholder>(expression))
+        return true;
+
+    if (is<UnaryOperatorExpression>(expression)) {
+        auto const& unary_expression = verify_cast<UnaryOperatorExpression>(expression);
+        return unary_expression.type() == UnaryOperator::Minus && is_row_independent_expression(*unary_expression.expression());
+    }
+
+    return false;
+}
+
+static bool is_comparison(BinaryOperator type)
+{
+    switch (type) {
+    case BinaryOperator::Equals:
+    case BinaryOperator::LessThan:
+    case BinaryOperator::LessThanEquals:
+    case BinaryOperator::GreaterThan:
+    case BinaryOperator::GreaterThanEquals:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static void collect_conjuncts(Expression const& expression, Vector<Expression const&>& conjuncts)
+{
+    if (is<BinaryOperatorExpression>(expression)) {
+        auto const& binary_expression = verify_cast<BinaryOperatorExpression>(expression);
+
+        if (binary_expression.type() == BinaryOperator::And) {
+            collect_conjuncts(*binary_expression.lhs(), conjuncts);
+            collect_conjuncts(*binary_expression.rhs(), conjuncts);
+            return;
+        }
+    }
+
+    // A parenthesized list is only truthy if each of its elements is.
+    if (is<ChainedExpression>(expression)) {
+        for (auto const& element : verify_cast<ChainedExpression>(expression).expressions())
+            collect_conjuncts(*element, conjuncts);
+        return;
+    }
+
+    conjuncts.append(expression);
+}
+
+struct ResolvedColumn {
+    size_t table_index { 0 };
+    size_t column_index { 0 };
+};
+
+// Resolves a column name to (table, column) the same way ColumnNameExpression::evaluate does. Names
+// which would be ambiguous at evaluation time are not resolved, so that the error is still raised.
+static Optional<ResolvedColumn> resolve_column(ColumnNameExpression const& column, Vector<NonnullRefPtr<TableDef>> const& tables)
+{
+    Optional<ResolvedColumn> resolved;
+
+    for (size_t table_index = 0; table_index < tables.size(); ++table_index) {
+        auto const& table = tables[table_index];
+        if (!column.table_name().is_empty() && table->name() != column.table_name())
+            continue;
+
+        for (size_t column_index = 0; column_index < table->columns().size(); ++column_index) {
+            if (table->columns()[column_index]->name() != column.column_name())
+                continue;
+            if (resolved.has_value())
+                return {};
+
+            resolved = ResolvedColumn { table_index, column_index };
+        }
+    }
+
+    return resolved;
+}
+
+static Vector<Vector<ColumnPredicate>> plan_column_predicates(Expression const& where_clause, Vector<NonnullRefPtr<TableDef>> const& tables)
+{
+    Vector<Vector<ColumnPredicate>> predicates;
+    predicates.resize(tables.size());
+
+    Vector<Expression const&> conjuncts;
+    collect_conjuncts(where_clause, conjuncts);
+
+    for (auto const& conjunct : conjuncts) {
+        if (!is<BinaryOperatorExpression>(conjunct))
+            continue;
+
+        auto const& binary_expression = verify_cast<BinaryOperatorExpression>(conjunct);
+        if (!is_comparison(binary_expression.type()))
+            continue;
+
+        auto const* column_expression = binary_expression.lhs().ptr();
+        auto const* value_expression = binary_expression.rhs().ptr();
+        bool column_is_lhs = true;
+
+        if (!is<ColumnNameExpression>(*column_expression)) {
+            swap(column_expression, value_expression);
+            column_is_lhs = false;
+        }
+        if (!is<ColumnNameExpression>(*column_expression) || !is_row_independent_expression(*value_expression))
+            continue;
+
+        auto column = resolve_column(verify_cast<ColumnNameExpression>(*column_expression), tables);
+        if (!column.has_value())
+            continue;
+
+        predicates[column->table_index].append({ column->column_index, binary_expression.type(), *value_expression, column_is_lhs });
+    }
+
+    return predicates;
+}
+
+struct JoinPlan {
+    Vector<JoinKey> hash_keys;
+    Optional<JoinKey> sort_merge_key;
+};
+
+// Finds the equalities between columns of two different tables in the WHERE clause. Each of them becomes a key of
+// the join which adds the later of the two tables to the rows produced from the earlier tables.
+static Vector<JoinPlan> plan_joins(Expression const& where_clause, Vector<NonnullRefPtr<TableDef>> const& tables)
+{
+    Vector<JoinPlan> joins;
+    joins.resize(tables.size());
+
+    // The index of each table's first column in the rows of the cartesian product, after the "__unity__" column.
+    Vector<size_t> column_offsets;
+    size_t column_offset = 1;
+    for (auto const& table : tables) {
+        column_offsets.append(column_offset);
+        column_offset += table->num_columns();
+    }
+
+    Vector<Expression const&> conjuncts;
+    collect_conjuncts(where_clause, conjuncts);
+
+    for (auto const& conjunct : conjuncts) {
+        if (!is<BinaryOperatorExpression>(conjunct))
+            continue;
+
+        auto const& binary_expression = verify_cast<BinaryOperatorExpression>(conjunct);
+        if (binary_expression.type() != BinaryOperator::Equals)
+            continue;
+        if (!is<ColumnNameExpression>(*binary_expression.lhs()) || !is<ColumnNameExpression>(*binary_expression.rhs()))
+            continue;
+
+        auto outer = resolve_column(verify_cast<ColumnNameExpression>(*binary_expression.lhs()), tables);
+        auto inner = resolve_column(verify_cast<ColumnNameExpression>(*binary_expression.rhs()), tables);
+        if (!outer.has_value() || !inner.has_value() || outer->table_index == inner->table_index)
+            continue;
+        if (outer->table_index > inner->table_index)
+            swap(outer, inner);
+
+        // Values of different types may compare equal without hashing or sorting alike, so those are
+        // left to the nested loop.
+        auto type = tables[outer->table_index]->columns()[outer->column_index]->type();
+        if (tables[inner->table_index]->columns()[inner->column_index]->type() != type)
+            continue;
+
+        JoinKey key { column_offsets[outer->table_index] + outer->column_index, inner->column_index };
+        auto& join = joins[inner->table_index];
+
+        switch (type) {
+        case SQLType::Text:
+        case SQLType::Integer:
+        case SQLType::Boolean:
+            join.hash_keys.append(key);
+            break;
+        case SQLType::Float:
+            if (!join.sort_merge_key.has_value())
+                join.sort_merge_key = key;
+            break;
+        default:
+            break;
+        }
+    }
+
+    return joins;
+}
+
 static ByteString result_column_name(ResultColumn const& column, size_t column_index)
 {
     auto fallback_column_name = [column_index]() {
@@ -37,10 +220,11 @@ static ByteString result_column_name(ResultColumn const& column, size_t column_i
     return fallback_column_name();
 }
 
-ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
+ResultOr<NonnullOwnPtr<Operator<ResultRow>>> Select::create_operator_tree(ExecutionContext& context, Vector<ByteString>& column_names) const
 {
     Vector<NonnullRefPtr<ResultColumn const>> columns;
-    Vector<ByteString> column_names;
+    Vector<NonnullRefPtr<TableDef>> tables;
+    TRY(tables.try_ensure_capacity(table_or_subquery_list().size()));
 
     auto const& result_column_list = this->result_column_list();
     VERIFY(!result_column_list.is_empty());
@@ -64,6 +248,8 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
                 column_names.unchecked_append(col->name());
             }
         }
+
+        tables.unchecked_append(move(table_def));
     }
 
     if (result_column_list.size() != 1 || result_column_list[0]->type() != ResultType::All) {
@@ -83,72 +269,57 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
         }
     }
 
-    ResultSet result { SQLCommand::Select, move(column_names) };
+    Vector<Vector<ColumnPredicate>> column_predicates;
+    if (where_clause())
+        column_predicates = plan_column_predicates(*where_clause(), tables);
+    else
+        column_predicates.resize(tables.size());
+
+    Vector<JoinPlan> joins;
+    if (where_clause())
+        joins = plan_joins(*where_clause(), tables);
+    else
+        joins.resize(tables.size());
 
+    // Every row of the cartesian product shares this descriptor, which covers the columns of all tables.
     auto descriptor = adopt_ref(*new TupleDescriptor);
-    Tuple tuple(descriptor);
-    Vector<Tuple> rows;
+    Tuple unity(descriptor);
     descriptor->empend("__unity__"sv);
-    tuple.append(Value { true });
-    rows.append(tuple);
+    unity.append(Value { true });
 
-    for (auto& table_descriptor : table_or_subquery_list()) {
-        if (!table_descriptor->is_table())
-            return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
+    NonnullOwnPtr<RowOperator> rows = TRY(adopt_nonnull_own_or_enomem(new (nothrow) UnityRow(move(unity))));
 
-        auto table_def = TRY(context.database->get_table(table_descriptor->schema_name(), table_descriptor->table_name()));
+    for (size_t table_index = 0; table_index < tables.size(); ++table_index) {
+        auto& table_def = tables[table_index];
         if (table_def->num_columns() == 0)
             continue;
 
-        auto old_descriptor_size = descriptor->size();
         descriptor->extend(table_def->to_tuple_descriptor());
 
-        while (!rows.is_empty() && (rows.first().size() == old_descriptor_size)) {
-            auto cartesian_row = rows.take_first();
-            auto table_rows = TRY(context.database->select_all(*table_def));
-
-            for (auto& table_row : table_rows) {
-                auto new_row = cartesian_row;
-                new_row.extend(table_row);
-                rows.append(new_row);
-            }
-        }
-    }
+        auto scan = TRY(adopt_nonnull_own_or_enomem(new (nothrow) TableScan(table_def, move(column_predicates[table_index]))));
+        auto& join = joins[table_index];
 
-    bool has_ordering { false };
-    auto sort_descriptor = adopt_ref(*new TupleDescriptor);
-    for (auto& term : m_ordering_term_list) {
-        sort_descriptor->append(TupleElementDescriptor { .order = term->order() });
-        has_ordering = true;
+        // The WHERE clause is still evaluated on every joined row, so the join only has to narrow down the rows.
+        if (!join.hash_keys.is_empty())
+            rows = TRY(adopt_nonnull_own_or_enomem(new (nothrow) HashJoin(move(rows), move(scan), move(join.hash_keys))));
+        else if (join.sort_merge_key.has_value())
+            rows = TRY(adopt_nonnull_own_or_enomem(new (nothrow) SortMergeJoin(move(rows), move(scan), *join.sort_merge_key)));
+        else
+            rows = TRY(adopt_nonnull_own_or_enomem(new (nothrow) CrossJoin(move(rows), move(scan))));
     }
-    Tuple sort_key(sort_descriptor);
-
-    for (auto& row : rows) {
-        context.current_row = &row;
 
-        if (where_clause()) {
-            auto where_result = TRY(where_clause()->evaluate(context)).to_bool();
-            if (!where_result.has_value() || !where_result.value())
-                continue;
-        }
-
-        tuple.clear();
+    if (where_clause())
+        rows = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Filter(move(rows), *where_clause())));
 
-        for (auto& col : columns) {
-            auto value = TRY(col->expression()->evaluate(context));
-            tuple.append(value);
-        }
+    Vector<NonnullRefPtr<OrderingTerm const>> ordering_terms;
+    TRY(ordering_terms.try_ensure_capacity(m_ordering_term_list.size()));
+    for (auto const& term : m_ordering_term_list)
+        ordering_terms.unchecked_append(term);
 
-        if (has_ordering) {
-            sort_key.clear();
-            for (auto& term : m_ordering_term_list) {
-                auto value = TRY(term->expression()->evaluate(context));
-                sort_key.append(value);
-            }
-        }
+    NonnullOwnPtr<ResultOperator> results = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Project(move(rows), move(columns), move(ordering_terms))));
 
-        result.insert_row(tuple, sort_key);
-    }
+    if (!m_ordering_term_list.is_empty())
+        results = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Sort(move(results))));
 
     if (m_limit_clause != nullptr) {
         size_t limit_value = NumericLimits<size_t>::max();
@@ -174,7 +345,25 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
             }
         }
 
-        result.limit(offset_value, limit_value);
+        results = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Limit(move(results), offset_value, limit_value)));
+    }
+
+    return results;
+}
+
+ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
+{
+    Vector<ByteString> column_names;
+    auto results = TRY(create_operator_tree(context, column_names));
+
+    ResultSet result { SQLCommand::Select, move(column_names) };
+
+    for (;;) {
+        auto row = TRY(results->next(context));
+        if (!row.has_value())
+            break;
+
+        TRY(result.try_append(row.release_value()));
     }
 
     return result;
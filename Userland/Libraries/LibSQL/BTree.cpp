@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <LibSQL/BTree.h>
 #include <LibSQL/Meta.h>
 
@@ -103,6 +104,93 @@ BTreeIterator BTree::find(Key const& key)
     return end();
 }
 
+bool BTree::bulk_load(ReadonlySpan<Key> keys)
+{
+    if (!m_root)
+        initialize_root();
+    if (m_root->size() > 0)
+        return false;
+
+    for (size_t ix = 1; ix < keys.size(); ++ix) {
+        if (keys[ix] < keys[ix - 1] || (unique() && keys[ix] == keys[ix - 1]))
+            return false;
+    }
+    if (keys.is_empty())
+        return true;
+
+    // The rightmost node of each level of the tree is still being filled, the leaf at the bottom.
+    Vector<OwnPtr<TreeNode>> levels;
+    levels.append(make<TreeNode>(*this, nullptr, static_cast<Block::Index>(0)));
+
+    for (auto const& key : keys) {
+        auto& leaf = *levels[0];
+
+        if (leaf.size() >= 2 && leaf.length() + sizeof(u32) + key.length() > Block::DATA_SIZE) {
+            // The leaf is full. Its last key moves up to separate it from the next leaf, which starts with
+            // this key.
+            auto separator = leaf.m_entries.take_last();
+            leaf.m_down.take_last();
+            auto leaf_index = bulk_load_write_node(leaf);
+
+            levels[0] = make<TreeNode>(*this, nullptr, static_cast<Block::Index>(0));
+            bulk_load_separator(levels, 1, separator, leaf_index);
+        }
+
+        auto& current_leaf = *levels[0];
+        current_leaf.m_entries.append(key);
+        current_leaf.m_down.append(DownPointer(&current_leaf, static_cast<Block::Index>(0)));
+    }
+
+    // Every node above the leaves now ends with a separator, which is missing the node to its right.
+    for (size_t level = 0; level < levels.size() - 1; ++level) {
+        auto node_index = bulk_load_write_node(*levels[level]);
+        auto& parent = *levels[level + 1];
+        parent.m_down.append(DownPointer(&parent, node_index));
+    }
+
+    m_root = levels.take_last();
+    m_root->set_block_index(block_index());
+    serializer().serialize_and_write(*m_root);
+    m_root->dump_if(SQL_DEBUG, "bulk_load");
+    return true;
+}
+
+void BTree::bulk_load_separator(Vector<OwnPtr<TreeNode>>& levels, size_t level, Key const& separator, Block::Index left)
+{
+    if (level == levels.size()) {
+        levels.append(make<TreeNode>(*this, static_cast<Block::Index>(0)));
+        levels.last()->m_is_leaf = false;
+    }
+
+    auto* node = levels[level].ptr();
+    node->m_down.append(DownPointer(node, left));
+
+    if (node->size() >= 2 && node->length() + sizeof(u32) + separator.length() > Block::DATA_SIZE) {
+        // The node is full. Its last key moves up a level, and its last child becomes the first child of
+        // the next node on this level.
+        auto right = node->m_down.take_last();
+        auto median = node->m_entries.take_last();
+        auto node_index = bulk_load_write_node(*node);
+
+        levels[level] = make<TreeNode>(*this, static_cast<Block::Index>(0));
+        node = levels[level].ptr();
+        node->m_is_leaf = false;
+        node->m_down.append(DownPointer(node, right.block_index()));
+
+        bulk_load_separator(levels, level + 1, median, node_index);
+    }
+
+    node->m_entries.append(separator);
+}
+
+Block::Index BTree::bulk_load_write_node(TreeNode& node)
+{
+    node.set_block_index(request_new_block_index());
+    node.dump_if(SQL_DEBUG, "bulk_load");
+    serializer().serialize_and_write(node);
+    return node.block_index();
+}
+
 void BTree::list_tree()
 {
     if (!m_root)
@@ -101,6 +101,11 @@ public:
     bool update_key_pointer(Key const&);
     Optional<u32> get(Key&);
     BTreeIterator find(Key const& key);
+
+    // Fills an empty tree with keys which are already in sort order. The tree is built bottom-up, one
+    // densely packed node at a time, instead of splitting nodes over and over as individual inserts do.
+    // Returns false if the tree is not empty or the keys are not sorted.
+    bool bulk_load(ReadonlySpan<Key>);
     BTreeIterator begin();
     static BTreeIterator end();
     void list_tree();
@@ -111,6 +116,10 @@ private:
     BTree(Serializer&, NonnullRefPtr<TupleDescriptor> const&, bool unique, Block::Index);
     void initialize_root();
     TreeNode* new_root();
+
+    void bulk_load_separator(Vector<OwnPtr<TreeNode>>& levels, size_t level, Key const& separator, Block::Index left);
+    Block::Index bulk_load_write_node(TreeNode&);
+
     OwnPtr<TreeNode> m_root { nullptr };
 
     friend BTreeIterator;
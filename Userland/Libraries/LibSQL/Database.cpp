@@ -6,6 +6,7 @@
  */
 
 #include <AK/ByteString.h>
+#include <LibCore/EventLoop.h>
 #include <LibSQL/BTree.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Heap.h>
@@ -83,10 +84,49 @@ Database::~Database() = default;
 ErrorOr<void> Database::commit()
 {
     VERIFY(is_open());
-    TRY(m_heap->flush());
+
+    if (!m_group_commit_enabled)
+        return m_heap->flush();
+
+    // Defer syncing the log until control returns to the event loop, so that every commit made
+    // in the meantime becomes durable with the same sync.
+    TRY(m_heap->log_uncommitted_blocks());
+    if (m_heap->has_unsynced_blocks() && !m_group_commit_pending) {
+        m_group_commit_pending = true;
+        Core::deferred_invoke([database = NonnullRefPtr(*this)] { database->complete_group_commit(); });
+    }
+
     return {};
 }
 
+void Database::when_durable(Function<void(ErrorOr<void>)> callback)
+{
+    if (!m_group_commit_pending) {
+        callback({});
+        return;
+    }
+
+    m_durability_callbacks.append(move(callback));
+}
+
+void Database::complete_group_commit()
+{
+    VERIFY(m_group_commit_pending);
+    m_group_commit_pending = false;
+
+    auto result = m_heap->sync_log();
+    if (result.is_error())
+        warnln("Database::complete_group_commit(): {}", result.error());
+
+    auto callbacks = move(m_durability_callbacks);
+    for (auto& callback : callbacks) {
+        if (result.is_error())
+            callback(Error::copy(result.error()));
+        else
+            callback({});
+    }
+}
+
 ResultOr<void> Database::add_schema(SchemaDef const& schema)
 {
     VERIFY(is_open());
@@ -193,17 +233,50 @@ ErrorOr<Vector<Row>> Database::match(TableDef& table, Key const& key)
     // use the index instead of scanning the table.
     for (auto block_index = table.block_index(); block_index;) {
         auto row = m_serializer.deserialize_block<Row>(block_index, table, block_index);
-        if (row.match(key))
-            ret.append(row);
-        block_index = ret.last().next_block_index();
+        block_index = row.next_block_index();
+
+        if (row.match(key) == 0)
+            TRY(ret.try_append(move(row)));
     }
     return ret;
 }
 
+Row Database::read_row(TableDef& table, Block::Index block_index)
+{
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
+    return m_serializer.deserialize_block<Row>(block_index, table, block_index);
+}
+
+void Database::register_open_table_scan(OpenTableScan& scan)
+{
+    m_open_table_scans.set(&scan);
+}
+
+void Database::unregister_open_table_scan(OpenTableScan& scan)
+{
+    m_open_table_scans.remove(&scan);
+}
+
+void Database::table_will_be_modified(TableDef const& table)
+{
+    if (m_open_table_scans.is_empty())
+        return;
+
+    // Scans that read their remaining rows don't need to be told about further modifications, and unregister.
+    Vector<OpenTableScan*> scans;
+    for (auto* scan : m_open_table_scans) {
+        if (scan->table().hash() == table.hash())
+            scans.append(scan);
+    }
+    for (auto* scan : scans)
+        scan->read_remaining_rows();
+}
+
 ErrorOr<void> Database::insert(Row& row)
 {
     VERIFY(m_table_cache.get(row.table().key().hash()).has_value());
     // TODO: implement table constraints such as unique, foreign key, etc.
+    table_will_be_modified(row.table());
 
     row.set_block_index(m_heap->request_new_block_index());
     row.set_next_block_index(row.table().block_index());
@@ -218,10 +291,46 @@ ErrorOr<void> Database::insert(Row& row)
     return {};
 }
 
+ErrorOr<void> Database::bulk_insert(Span<Row> rows)
+{
+    if (rows.is_empty())
+        return {};
+
+    auto& table = rows.first().table();
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
+    // TODO: implement table constraints such as unique, foreign key, etc.
+    table_will_be_modified(table);
+
+    // Chain the rows the same way inserting them one by one would, so they are scanned in the same order.
+    // FIXME: Each row still gets a block of its own. Packing several rows into one block needs row
+    //        addresses which point into a block, instead of the block indices rows are known by now.
+    auto next_block_index = table.block_index();
+    for (auto& row : rows) {
+        VERIFY(&row.table() == &table);
+
+        row.set_block_index(m_heap->request_new_block_index());
+        row.set_next_block_index(next_block_index);
+        m_serializer.reset();
+        m_serializer.serialize_and_write<Tuple>(row);
+
+        next_block_index = row.block_index();
+    }
+
+    // TODO update indexes defined on table. Keys for an index which is still empty can be sorted and passed to
+    //      BTree::bulk_load() instead of being inserted one at a time.
+
+    auto table_key = table.key();
+    table_key.set_block_index(next_block_index);
+    VERIFY(m_tables->update_key_pointer(table_key));
+    table.set_block_index(next_block_index);
+    return {};
+}
+
 ErrorOr<void> Database::remove(Row& row)
 {
     auto& table = row.table();
     VERIFY(m_table_cache.get(table.key().hash()).has_value());
+    table_will_be_modified(table);
 
     TRY(m_heap->free_storage(row.block_index()));
 
@@ -253,6 +362,7 @@ ErrorOr<void> Database::update(Row& tuple)
 {
     VERIFY(m_table_cache.get(tuple.table().key().hash()).has_value());
     // TODO: implement table constraints such as unique, foreign key, etc.
+    table_will_be_modified(tuple.table());
 
     m_serializer.reset();
     m_serializer.serialize_and_write<Tuple>(tuple);
@@ -8,6 +8,8 @@
 #pragma once
 
 #include <AK/ByteString.h>
+#include <AK/Function.h>
+#include <AK/HashTable.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefPtr.h>
 #include <LibSQL/Forward.h>
@@ -18,6 +20,22 @@
 
 namespace SQL {
 
+/**
+ * Something that walks the chain of heap blocks holding the rows of a table
+ * over a longer time, e.g. the scan of a SELECT statement whose results are
+ * streamed to a client across turns of the event loop.
+ */
+class OpenTableScan {
+public:
+    virtual ~OpenTableScan() = default;
+
+    virtual TableDef const& table() const = 0;
+
+    // Called before the table is modified. Removing rows frees their blocks, which later insertions
+    // may reuse, so the scan has to read the rows it hasn't reached yet while they are still intact.
+    virtual void read_remaining_rows() = 0;
+};
+
 /**
  * A Database object logically connects a Heap with the SQL data we want
  * to store in it. It has BTree pointers for B-Trees holding the definitions
@@ -31,6 +49,15 @@ public:
     ResultOr<void> open();
     bool is_open() const { return m_open; }
     ErrorOr<void> commit();
+
+    // With group commit enabled, commit() does not wait for the modifications to become durable.
+    // Instead, the commits made during one pass of the event loop are synced together afterwards.
+    void enable_group_commit() { m_group_commit_enabled = true; }
+    bool group_commit_enabled() const { return m_group_commit_enabled; }
+
+    // Invokes the callback once all previous commits are durable.
+    void when_durable(Function<void(ErrorOr<void>)>);
+
     ErrorOr<size_t> file_size_in_bytes() const { return m_heap->file_size_in_bytes(); }
 
     ResultOr<void> add_schema(SchemaDef const&);
@@ -43,14 +70,28 @@ public:
 
     ErrorOr<Vector<Row>> select_all(TableDef&);
     ErrorOr<Vector<Row>> match(TableDef&, Key const&);
+    Row read_row(TableDef&, Block::Index);
     ErrorOr<void> insert(Row&);
+
+    // Inserts rows of the same table in one go, updating the table's entry in the catalog only once.
+    // Like insert(), this stores every row in a block of its own.
+    ErrorOr<void> bulk_insert(Span<Row>);
     ErrorOr<void> remove(Row&);
     ErrorOr<void> update(Row&);
 
+    void register_open_table_scan(OpenTableScan&);
+    void unregister_open_table_scan(OpenTableScan&);
+
 private:
     explicit Database(NonnullRefPtr<Heap>);
 
+    void complete_group_commit();
+    void table_will_be_modified(TableDef const&);
+
     bool m_open { false };
+    bool m_group_commit_enabled { false };
+    bool m_group_commit_pending { false };
+    Vector<Function<void(ErrorOr<void>)>> m_durability_callbacks;
     NonnullRefPtr<Heap> m_heap;
     Serializer m_serializer;
     RefPtr<BTree> m_schemas;
@@ -59,6 +100,8 @@ private:
 
     HashMap<u32, NonnullRefPtr<SchemaDef>> m_schema_cache;
     HashMap<u32, NonnullRefPtr<TableDef>> m_table_cache;
+
+    HashTable<OpenTableScan*> m_open_table_scans;
 };
 
 }
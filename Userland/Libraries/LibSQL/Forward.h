@@ -47,6 +47,7 @@ class ColumnNameExpression;
 class CommonTableExpression;
 class CommonTableExpressionList;
 class CreateTable;
+class Cursor;
 class Delete;
 class DropColumn;
 class DropTable;
@@ -70,6 +71,8 @@ class NestedExpression;
 class NullExpression;
 class NullLiteral;
 class NumericLiteral;
+template<typename T>
+class Operator;
 class OrderingTerm;
 class Parser;
 class QualifiedTableName;
@@ -14,53 +14,78 @@
 
 namespace SQL {
 
-ErrorOr<NonnullRefPtr<Heap>> Heap::create(ByteString file_name)
+ErrorOr<NonnullRefPtr<Heap>> Heap::create(ByteString file_name, u32 page_size, size_t page_cache_size_in_bytes)
 {
-    return adopt_nonnull_ref_or_enomem(new (nothrow) Heap(move(file_name)));
+    return adopt_nonnull_ref_or_enomem(new (nothrow) Heap(move(file_name), page_size, page_cache_size_in_bytes));
 }
 
-Heap::Heap(ByteString file_name)
+Heap::Heap(ByteString file_name, u32 page_size, size_t page_cache_size_in_bytes)
     : m_name(move(file_name))
+    , m_page_size(page_size)
+    , m_page_cache_size_in_bytes(page_cache_size_in_bytes)
 {
 }
 
 Heap::~Heap()
 {
-    if (m_file && !m_write_ahead_log.is_empty()) {
-        if (auto maybe_error = flush(); maybe_error.is_error())
-            warnln("~Heap({}): {}", name(), maybe_error.error());
-    }
+    if (!m_file)
+        return;
+
+    if (auto maybe_error = flush(); maybe_error.is_error())
+        warnln("~Heap({}): {}", name(), maybe_error.error());
+    else if (auto maybe_error = checkpoint(); maybe_error.is_error())
+        warnln("~Heap({}): {}", name(), maybe_error.error());
+
+    close();
 }
 
 ErrorOr<void> Heap::open()
 {
     VERIFY(!m_file);
 
-    size_t file_size = 0;
     struct stat stat_buffer;
     if (stat(name().characters(), &stat_buffer) != 0) {
         if (errno != ENOENT) {
             warnln("Heap::open({}): could not stat: {}"sv, name(), strerror(errno));
             return Error::from_string_literal("Heap::open(): could not stat file");
         }
+
+        // A log left behind next to a Heap file which has since been deleted must not be replayed into a new one.
+        if (auto result = Core::System::unlink(log_name()); result.is_error() && result.error().code() != ENOENT)
+            return result.release_error();
     } else if (!S_ISREG(stat_buffer.st_mode)) {
         warnln("Heap::open({}): can only use regular files"sv, name());
         return Error::from_string_literal("Heap::open(): can only use regular files");
-    } else {
-        file_size = stat_buffer.st_size;
     }
 
+    m_file = TRY(Core::File::open(name(), Core::File::OpenMode::ReadWrite));
+    m_page_cache = TRY(PageCache::create(*m_file, Block::SIZE, m_page_size, m_page_cache_size_in_bytes));
+
+    // Make sure that this is a Heap file before a log is created next to it, let alone replayed into it. An empty file
+    // may be a Heap which crashed before its first checkpoint, so its zero block can only be checked after recovery.
+    auto file_size = TRY(m_file->seek(0, SeekMode::FromEndPosition));
+    if (file_size > 0) {
+        if (auto error_maybe = read_zero_block(); error_maybe.is_error()) {
+            close();
+            return error_maybe.release_error();
+        }
+    }
+
+    if (auto error_maybe = recover_from_log(); error_maybe.is_error()) {
+        close();
+        return error_maybe.release_error();
+    }
+
+    // Recovery may have written blocks to the file, so only look at its size and zero block now.
+    file_size = TRY(m_file->seek(0, SeekMode::FromEndPosition));
     if (file_size > 0) {
         m_next_block = file_size / Block::SIZE;
         m_highest_block_written = m_next_block - 1;
     }
 
-    auto file = TRY(Core::File::open(name(), Core::File::OpenMode::ReadWrite));
-    m_file = TRY(Core::InputBufferedFile::create(move(file)));
-
     if (file_size > 0) {
         if (auto error_maybe = read_zero_block(); error_maybe.is_error()) {
-            m_file = nullptr;
+            close();
             return error_maybe.release_error();
         }
     } else {
@@ -70,7 +95,8 @@ ErrorOr<void> Heap::open()
     // FIXME: We should more gracefully handle version incompatibilities. For now, we drop the database.
     if (m_version != VERSION) {
         dbgln_if(SQL_DEBUG, "Heap file {} opened has incompatible version {}. Deleting for version {}.", name(), m_version, VERSION);
-        m_file = nullptr;
+        m_uncommitted_blocks.clear();
+        close();
 
         TRY(Core::System::unlink(name()));
         return open();
@@ -89,15 +115,43 @@ ErrorOr<void> Heap::open()
     return {};
 }
 
+void Heap::close()
+{
+    // A log which still holds transactions is needed to recover them the next time the Heap is opened, an empty one
+    // is not needed by anything.
+    if (m_log && m_log->size_in_bytes() == 0) {
+        if (auto result = Core::System::unlink(log_name()); result.is_error())
+            warnln("Heap::close({}): {}", name(), result.error());
+    }
+    m_log = nullptr;
+    m_page_cache = nullptr;
+    m_file = nullptr;
+}
+
+ErrorOr<void> Heap::recover_from_log()
+{
+    m_log = TRY(WriteAheadLog::open(log_name(), Block::SIZE));
+    if (m_log->size_in_bytes() == 0)
+        return {};
+
+    dbgln_if(SQL_DEBUG, "Heap file {}: replaying {} bytes of write-ahead log", name(), m_log->size_in_bytes());
+    TRY(m_log->replay([&](Block::Index index, ReadonlyBytes data) {
+        return m_page_cache->write_block(index, data);
+    }));
+
+    return checkpoint();
+}
+
 ErrorOr<size_t> Heap::file_size_in_bytes() const
 {
-    TRY(m_file->seek(0, SeekMode::FromEndPosition));
-    return TRY(m_file->tell());
+    // Blocks which were committed may still be waiting for a checkpoint, so this is the size the file will have after the next one.
+    auto file_size = TRY(m_file->seek(0, SeekMode::FromEndPosition));
+    return max(file_size, (static_cast<size_t>(m_highest_block_written) + 1) * Block::SIZE);
 }
 
 bool Heap::has_block(Block::Index index) const
 {
-    return (index <= m_highest_block_written || m_write_ahead_log.contains(index))
+    return (index <= m_highest_block_written || m_uncommitted_blocks.contains(index) || m_unsynced_blocks.contains(index))
         && !m_free_block_indices.contains_slow(index);
 }
 
@@ -177,12 +231,13 @@ ErrorOr<ByteBuffer> Heap::read_raw_block(Block::Index index)
     VERIFY(m_file);
     VERIFY(index < m_next_block);
 
-    if (auto wal_entry = m_write_ahead_log.get(index); wal_entry.has_value())
-        return wal_entry.value();
+    if (auto block = m_uncommitted_blocks.get(index); block.has_value())
+        return block.value();
+    if (auto block = m_unsynced_blocks.get(index); block.has_value())
+        return block.value();
 
-    TRY(m_file->seek(index * Block::SIZE, SeekMode::SetPosition));
     auto buffer = TRY(ByteBuffer::create_uninitialized(Block::SIZE));
-    TRY(m_file->read_until_filled(buffer));
+    TRY(m_page_cache->read_block(index, buffer));
     return buffer;
 }
 
@@ -205,8 +260,7 @@ ErrorOr<void> Heap::write_raw_block(Block::Index index, ReadonlyBytes data)
     VERIFY(m_file);
     VERIFY(data.size() == Block::SIZE);
 
-    TRY(m_file->seek(index * Block::SIZE, SeekMode::SetPosition));
-    TRY(m_file->write_until_depleted(data));
+    TRY(m_page_cache->write_block(index, data));
 
     if (index > m_highest_block_written)
         m_highest_block_written = index;
@@ -214,13 +268,13 @@ ErrorOr<void> Heap::write_raw_block(Block::Index index, ReadonlyBytes data)
     return {};
 }
 
-ErrorOr<void> Heap::write_raw_block_to_wal(Block::Index index, ByteBuffer&& data)
+ErrorOr<void> Heap::stage_raw_block(Block::Index index, ByteBuffer&& data)
 {
     dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, index);
     VERIFY(index < m_next_block);
     VERIFY(data.size() == Block::SIZE);
 
-    TRY(m_write_ahead_log.try_set(index, move(data)));
+    TRY(m_uncommitted_blocks.try_set(index, move(data)));
 
     return {};
 }
@@ -242,7 +296,7 @@ ErrorOr<void> Heap::write_block(Block const& block)
 
     block.data().bytes().copy_to(heap_data.bytes().slice(Block::HEADER_SIZE));
 
-    return write_raw_block_to_wal(block.index(), move(heap_data));
+    return stage_raw_block(block.index(), move(heap_data));
 }
 
 ErrorOr<void> Heap::free_storage(Block::Index index)
@@ -268,23 +322,64 @@ ErrorOr<void> Heap::free_block(Block const& block)
 
     // Zero out freed blocks to facilitate a free block scan upon opening the database later
     auto zeroed_data = TRY(ByteBuffer::create_zeroed(Block::SIZE));
-    TRY(write_raw_block_to_wal(index, move(zeroed_data)));
+    TRY(stage_raw_block(index, move(zeroed_data)));
 
     return m_free_block_indices.try_append(index);
 }
 
 ErrorOr<void> Heap::flush()
+{
+    TRY(log_uncommitted_blocks());
+    TRY(sync_log());
+    return {};
+}
+
+ErrorOr<void> Heap::log_uncommitted_blocks()
 {
     VERIFY(m_file);
-    auto indices = m_write_ahead_log.keys();
+    if (m_uncommitted_blocks.is_empty())
+        return {};
+
+    TRY(m_log->append_transaction(m_uncommitted_blocks));
+
+    TRY(m_unsynced_blocks.try_ensure_capacity(m_unsynced_blocks.size() + m_uncommitted_blocks.size()));
+    for (auto& it : m_uncommitted_blocks)
+        m_unsynced_blocks.set(it.key, move(it.value));
+    m_uncommitted_blocks.clear();
+
+    return {};
+}
+
+ErrorOr<void> Heap::sync_log()
+{
+    VERIFY(m_file);
+    TRY(m_log->sync());
+
+    // The log now holds these blocks durably, so they may be written to the Heap file whenever the page cache sees fit.
+    auto indices = m_unsynced_blocks.keys();
     quick_sort(indices);
     for (auto index : indices) {
         dbgln_if(SQL_DEBUG, "Flushing block {}", index);
-        auto& data = m_write_ahead_log.get(index).value();
-        TRY(write_raw_block(index, data));
+        TRY(write_raw_block(index, m_unsynced_blocks.get(index).value()));
     }
-    m_write_ahead_log.clear();
-    dbgln_if(SQL_DEBUG, "WAL flushed; new number of blocks = {}", m_highest_block_written);
+    m_unsynced_blocks.clear();
+
+    if (m_log->size_in_bytes() >= CHECKPOINT_THRESHOLD_IN_BYTES)
+        TRY(checkpoint());
+
+    return {};
+}
+
+ErrorOr<void> Heap::checkpoint()
+{
+    VERIFY(m_file);
+    VERIFY(m_unsynced_blocks.is_empty());
+
+    TRY(m_page_cache->flush());
+    TRY(Core::System::fsync(m_file->fd()));
+    TRY(m_log->reset());
+
+    dbgln_if(SQL_DEBUG, "Checkpoint; new number of blocks = {}", m_highest_block_written);
     return {};
 }
 
@@ -348,7 +443,7 @@ ErrorOr<void> Heap::update_zero_block()
     buffer_bytes.overwrite(TABLE_COLUMNS_ROOT_OFFSET, &m_table_columns_root, sizeof(u32));
     buffer_bytes.overwrite(USER_VALUES_OFFSET, m_user_values.data(), m_user_values.size() * sizeof(u32));
 
-    return write_raw_block_to_wal(0, move(buffer));
+    return stage_raw_block(0, move(buffer));
 }
 
 ErrorOr<void> Heap::initialize_zero_block()
@@ -14,6 +14,8 @@
 #include <AK/RefCounted.h>
 #include <AK/Vector.h>
 #include <LibCore/File.h>
+#include <LibSQL/PageCache.h>
+#include <LibSQL/WriteAheadLog.h>
 
 namespace SQL {
 
@@ -63,15 +65,29 @@ private:
  *
  * A Heap can be thought of the backing storage of a single database. It's
  * assumed that a single SQL database is backed by a single Heap.
+ *
+ * All file access goes through a PageCache, which reads and writes the file in
+ * pages of a configurable size holding multiple Blocks each.
+ *
+ * Modified Blocks are kept in memory until they are committed by flush(), which
+ * appends them to a WriteAheadLog next to the Heap file. Blocks only reach the
+ * Heap file after the log has been synced, and the log is emptied again by a
+ * checkpoint once it grows too large. Closing the Heap checkpoints and removes
+ * the log. Opening a Heap replays whatever is left in its log, to recover from
+ * a crash.
  */
 class Heap : public RefCounted<Heap> {
 public:
     static constexpr u32 VERSION = 5;
+    static constexpr u64 CHECKPOINT_THRESHOLD_IN_BYTES = 4 * MiB;
 
-    static ErrorOr<NonnullRefPtr<Heap>> create(ByteString);
+    static ErrorOr<NonnullRefPtr<Heap>> create(ByteString, u32 page_size = PageCache::DEFAULT_PAGE_SIZE, size_t page_cache_size_in_bytes = PageCache::DEFAULT_CAPACITY_IN_BYTES);
     virtual ~Heap();
 
     ByteString const& name() const { return m_name; }
+    u32 page_size() const { return m_page_size; }
+    PageCache::Statistics page_cache_statistics() const { return m_page_cache ? m_page_cache->statistics() : PageCache::Statistics {}; }
+    size_t log_sync_count() const { return m_log ? m_log->sync_count() : 0; }
 
     ErrorOr<void> open();
     ErrorOr<size_t> file_size_in_bytes() const;
@@ -119,14 +135,23 @@ public:
     ErrorOr<void> write_storage(Block::Index, ReadonlyBytes);
     ErrorOr<void> free_storage(Block::Index);
 
+    // Commits all modified blocks and waits for them to become durable.
     ErrorOr<void> flush();
 
+    // flush() split in two, so that the log can be synced once for multiple commits.
+    ErrorOr<void> log_uncommitted_blocks();
+    ErrorOr<void> sync_log();
+    bool has_unsynced_blocks() const { return !m_unsynced_blocks.is_empty(); }
+
+    // Writes all synced blocks to the Heap file and empties the log.
+    ErrorOr<void> checkpoint();
+
 private:
-    explicit Heap(ByteString);
+    Heap(ByteString, u32 page_size, size_t page_cache_size_in_bytes);
 
     ErrorOr<ByteBuffer> read_raw_block(Block::Index);
     ErrorOr<void> write_raw_block(Block::Index, ReadonlyBytes);
-    ErrorOr<void> write_raw_block_to_wal(Block::Index, ByteBuffer&&);
+    ErrorOr<void> stage_raw_block(Block::Index, ByteBuffer&&);
 
     ErrorOr<Block> read_block(Block::Index);
     ErrorOr<void> write_block(Block const&);
@@ -136,9 +161,17 @@ private:
     ErrorOr<void> initialize_zero_block();
     ErrorOr<void> update_zero_block();
 
+    ByteString log_name() const { return ByteString::formatted("{}.wal", name()); }
+    ErrorOr<void> recover_from_log();
+    void close();
+
     ByteString m_name;
 
-    OwnPtr<Core::InputBufferedFile> m_file;
+    OwnPtr<Core::File> m_file;
+    OwnPtr<PageCache> m_page_cache;
+    OwnPtr<WriteAheadLog> m_log;
+    u32 m_page_size { PageCache::DEFAULT_PAGE_SIZE };
+    size_t m_page_cache_size_in_bytes { PageCache::DEFAULT_CAPACITY_IN_BYTES };
     Block::Index m_highest_block_written { 0 };
     Block::Index m_next_block { 1 };
     Block::Index m_schemas_root { 0 };
@@ -146,7 +179,13 @@ private:
     Block::Index m_table_columns_root { 0 };
     u32 m_version { VERSION };
     Array<u32, 16> m_user_values { 0 };
-    HashMap<Block::Index, ByteBuffer> m_write_ahead_log;
+
+    // Blocks which were modified since the last commit.
+    HashMap<Block::Index, ByteBuffer> m_uncommitted_blocks;
+
+    // Blocks which were committed to the log, but which may not be written to the Heap file before the log is synced.
+    HashMap<Block::Index, ByteBuffer> m_unsynced_blocks;
+
     Vector<Block::Index> m_free_block_indices;
 };
 
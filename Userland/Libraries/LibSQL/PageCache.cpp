@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Format.h>
+#include <AK/QuickSort.h>
+#include <LibSQL/PageCache.h>
+
+namespace SQL {
+
+ErrorOr<NonnullOwnPtr<PageCache>> PageCache::create(Core::File& file, u32 block_size, u32 page_size, size_t capacity_in_bytes)
+{
+    VERIFY(block_size > 0);
+    VERIFY(is_power_of_two(page_size));
+    VERIFY(page_size >= block_size && page_size % block_size == 0);
+
+    auto capacity = max(capacity_in_bytes / page_size, static_cast<size_t>(1));
+    return adopt_nonnull_own_or_enomem(new (nothrow) PageCache(file, block_size, page_size, capacity));
+}
+
+PageCache::PageCache(Core::File& file, u32 block_size, u32 page_size, size_t capacity)
+    : m_file(file)
+    , m_block_size(block_size)
+    , m_page_size(page_size)
+    , m_capacity(capacity)
+{
+}
+
+PageCache::~PageCache() = default;
+
+ErrorOr<void> PageCache::read_block(u32 block_index, Bytes buffer)
+{
+    VERIFY(buffer.size() == m_block_size);
+
+    auto offset = static_cast<u64>(block_index) * m_block_size;
+    auto* page = TRY(ensure_page(offset / m_page_size));
+    auto offset_in_page = offset % m_page_size;
+
+    if (offset_in_page + m_block_size > page->size)
+        return Error::from_string_literal("PageCache::read_block(): block lies beyond the end of the file");
+
+    page->data.bytes().slice(offset_in_page, m_block_size).copy_to(buffer);
+    return {};
+}
+
+ErrorOr<void> PageCache::write_block(u32 block_index, ReadonlyBytes data)
+{
+    VERIFY(data.size() == m_block_size);
+
+    auto offset = static_cast<u64>(block_index) * m_block_size;
+    auto* page = TRY(ensure_page(offset / m_page_size));
+    auto offset_in_page = offset % m_page_size;
+
+    page->data.overwrite(offset_in_page, data.data(), m_block_size);
+    page->size = max(page->size, offset_in_page + m_block_size);
+    page->dirty = true;
+    return {};
+}
+
+ErrorOr<void> PageCache::flush()
+{
+    // Write pages back in file order, to keep the writes as sequential as possible.
+    Vector<u32> dirty_page_indices;
+    for (auto const& it : m_pages) {
+        if (it.value->dirty)
+            TRY(dirty_page_indices.try_append(it.key));
+    }
+    quick_sort(dirty_page_indices);
+
+    for (auto page_index : dirty_page_indices)
+        TRY(write_back_page(*m_pages.get(page_index).value()));
+
+    dbgln_if(SQL_DEBUG, "Page cache flushed; {} page(s) written; hits = {}, misses = {}, evictions = {}",
+        dirty_page_indices.size(), m_statistics.hits, m_statistics.misses, m_statistics.evictions);
+    return {};
+}
+
+ErrorOr<PageCache::Page*> PageCache::ensure_page(u32 page_index)
+{
+    if (auto page = m_pages.get(page_index); page.has_value()) {
+        ++m_statistics.hits;
+        m_lru_list.prepend(**page);
+        return page.value();
+    }
+
+    ++m_statistics.misses;
+    if (m_pages.size() >= m_capacity)
+        TRY(evict_least_recently_used_page());
+
+    auto page = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Page));
+    page->index = page_index;
+    page->data = TRY(ByteBuffer::create_zeroed(m_page_size));
+    TRY(read_page(*page));
+
+    auto* page_pointer = page.ptr();
+    TRY(m_pages.try_set(page_index, move(page)));
+    m_lru_list.prepend(*page_pointer);
+    return page_pointer;
+}
+
+ErrorOr<void> PageCache::read_page(Page& page)
+{
+    dbgln_if(SQL_DEBUG, "Read page {}", page.index);
+
+    TRY(m_file.seek(static_cast<u64>(page.index) * m_page_size, SeekMode::SetPosition));
+
+    // The last page of the file is usually not filled completely, so read until the end of the file.
+    auto buffer = page.data.bytes();
+    while (page.size < m_page_size) {
+        auto bytes_read = TRY(m_file.read_some(buffer.slice(page.size)));
+        if (bytes_read.is_empty())
+            break;
+        page.size += bytes_read.size();
+    }
+
+    return {};
+}
+
+ErrorOr<void> PageCache::write_back_page(Page& page)
+{
+    dbgln_if(SQL_DEBUG, "Write back page {} ({} bytes)", page.index, page.size);
+    VERIFY(page.dirty);
+
+    TRY(m_file.seek(static_cast<u64>(page.index) * m_page_size, SeekMode::SetPosition));
+    TRY(m_file.write_until_depleted(page.data.bytes().trim(page.size)));
+
+    page.dirty = false;
+    ++m_statistics.write_backs;
+    return {};
+}
+
+ErrorOr<void> PageCache::evict_least_recently_used_page()
+{
+    auto* page = m_lru_list.last();
+    VERIFY(page);
+
+    if (page->dirty)
+        TRY(write_back_page(*page));
+
+    auto page_index = page->index;
+    dbgln_if(SQL_DEBUG, "Evict page {}", page_index);
+
+    m_lru_list.remove(*page);
+    m_pages.remove(page_index);
+    ++m_statistics.evictions;
+    return {};
+}
+
+}
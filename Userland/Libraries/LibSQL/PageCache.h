@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullOwnPtr.h>
+#include <LibCore/File.h>
+
+namespace SQL {
+
+/**
+ * The PageCache sits between a Heap and its file. The Heap addresses its file
+ * in fixed size Blocks, but the file is read and written in larger pages which
+ * are kept in memory, so that chained and neighbouring Blocks can be served
+ * without a seek and read for every single one of them.
+ *
+ * Pages are evicted in least recently used order once the cache is full. Pages
+ * which were written to are marked dirty and written back to the file when
+ * they are evicted or the cache is flushed.
+ */
+class PageCache {
+public:
+    static constexpr u32 DEFAULT_PAGE_SIZE = 4 * KiB;
+    static constexpr size_t DEFAULT_CAPACITY_IN_BYTES = 4 * MiB;
+
+    struct Statistics {
+        size_t hits { 0 };
+        size_t misses { 0 };
+        size_t evictions { 0 };
+        size_t write_backs { 0 };
+    };
+
+    static ErrorOr<NonnullOwnPtr<PageCache>> create(Core::File&, u32 block_size, u32 page_size = DEFAULT_PAGE_SIZE, size_t capacity_in_bytes = DEFAULT_CAPACITY_IN_BYTES);
+    ~PageCache();
+
+    u32 page_size() const { return m_page_size; }
+    size_t capacity() const { return m_capacity; }
+    size_t cached_pages() const { return m_pages.size(); }
+    Statistics const& statistics() const { return m_statistics; }
+
+    ErrorOr<void> read_block(u32 block_index, Bytes);
+    ErrorOr<void> write_block(u32 block_index, ReadonlyBytes);
+
+    ErrorOr<void> flush();
+
+private:
+    struct Page {
+        u32 index { 0 };
+        ByteBuffer data;
+
+        // The number of bytes at the start of the page which exist in the file, or were written to.
+        size_t size { 0 };
+        bool dirty { false };
+
+        IntrusiveListNode<Page> lru_node;
+    };
+
+    PageCache(Core::File&, u32 block_size, u32 page_size, size_t capacity);
+
+    ErrorOr<Page*> ensure_page(u32 page_index);
+    ErrorOr<void> read_page(Page&);
+    ErrorOr<void> write_back_page(Page&);
+    ErrorOr<void> evict_least_recently_used_page();
+
+    Core::File& m_file;
+    u32 m_block_size { 0 };
+    u32 m_page_size { 0 };
+    size_t m_capacity { 0 };
+
+    HashMap<u32, NonnullOwnPtr<Page>> m_pages;
+
+    // Most recently used pages are at the front of the list.
+    IntrusiveList<&Page::lru_node> m_lru_list;
+
+    Statistics m_statistics;
+};
+
+}
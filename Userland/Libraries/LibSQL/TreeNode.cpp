@@ -106,6 +106,8 @@ void TreeNode::deserialize(Serializer& serializer)
     auto nodes = serializer.deserialize<u32>();
     dbgln_if(SQL_DEBUG, "Deserializing node. Size {}", nodes);
     if (nodes > 0) {
+        // Nodes loaded through a DownPointer start out as an empty leaf, which is replaced by the stored node.
+        m_down.clear();
         for (u32 i = 0; i < nodes; i++) {
             auto left = serializer.deserialize<u32>();
             dbgln_if(SQL_DEBUG, "Down[{}] {}", i, left);
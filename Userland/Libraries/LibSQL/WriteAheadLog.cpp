@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Format.h>
+#include <AK/QuickSort.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Checksum/CRC32.h>
+#include <LibSQL/WriteAheadLog.h>
+
+namespace SQL {
+
+static constexpr size_t TRANSACTION_HEADER_SIZE = 3 * sizeof(u32);
+
+static u32 read_u32(ReadonlyBytes bytes, size_t offset)
+{
+    u32 value;
+    memcpy(&value, bytes.offset_pointer(offset), sizeof(value));
+    return value;
+}
+
+ErrorOr<NonnullOwnPtr<WriteAheadLog>> WriteAheadLog::open(ByteString path, u32 block_size)
+{
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::ReadWrite));
+    auto log = TRY(adopt_nonnull_own_or_enomem(new (nothrow) WriteAheadLog(move(path), block_size, move(file))));
+    log->m_size_in_bytes = TRY(log->m_file->seek(0, SeekMode::FromEndPosition));
+    return log;
+}
+
+WriteAheadLog::WriteAheadLog(ByteString path, u32 block_size, NonnullOwnPtr<Core::File> file)
+    : m_path(move(path))
+    , m_block_size(block_size)
+    , m_file(move(file))
+{
+}
+
+ErrorOr<void> WriteAheadLog::replay(Function<ErrorOr<void>(u32 block_index, ReadonlyBytes)> const& apply_block)
+{
+    TRY(m_file->seek(0, SeekMode::SetPosition));
+    auto log = TRY(m_file->read_until_eof());
+    auto bytes = log.bytes();
+
+    auto entry_size = sizeof(u32) + m_block_size;
+    size_t offset = 0;
+    size_t transactions = 0;
+
+    while (offset + TRANSACTION_HEADER_SIZE <= bytes.size()) {
+        if (read_u32(bytes, offset) != MAGIC)
+            break;
+
+        auto block_count = read_u32(bytes, offset + sizeof(u32));
+        auto checksum = read_u32(bytes, offset + 2 * sizeof(u32));
+
+        auto entries_offset = offset + TRANSACTION_HEADER_SIZE;
+        auto entries_size = static_cast<size_t>(block_count) * entry_size;
+        if (entries_offset + entries_size > bytes.size())
+            break;
+
+        auto entries = bytes.slice(entries_offset, entries_size);
+        if (Crypto::Checksum::CRC32 { entries }.digest() != checksum)
+            break;
+
+        for (size_t i = 0; i < block_count; ++i) {
+            auto entry = entries.slice(i * entry_size, entry_size);
+            TRY(apply_block(read_u32(entry, 0), entry.slice(sizeof(u32))));
+        }
+
+        offset = entries_offset + entries_size;
+        ++transactions;
+    }
+
+    if (offset != bytes.size())
+        dbgln("WriteAheadLog {}: discarding {} bytes of incomplete transaction(s)", m_path, bytes.size() - offset);
+
+    dbgln_if(SQL_DEBUG, "WriteAheadLog {}: replayed {} transaction(s)", m_path, transactions);
+    return {};
+}
+
+ErrorOr<void> WriteAheadLog::append_transaction(HashMap<u32, ByteBuffer> const& blocks)
+{
+    if (blocks.is_empty())
+        return {};
+
+    auto indices = blocks.keys();
+    quick_sort(indices);
+
+    auto entry_size = sizeof(u32) + m_block_size;
+    auto transaction = TRY(ByteBuffer::create_uninitialized(TRANSACTION_HEADER_SIZE + indices.size() * entry_size));
+
+    auto entries = transaction.bytes().slice(TRANSACTION_HEADER_SIZE);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        auto const& data = blocks.get(indices[i]).value();
+        VERIFY(data.size() == m_block_size);
+
+        auto entry = entries.slice(i * entry_size, entry_size);
+        entry.overwrite(0, &indices[i], sizeof(u32));
+        entry.slice(sizeof(u32)).overwrite(0, data.data(), m_block_size);
+    }
+
+    u32 magic = MAGIC;
+    u32 block_count = indices.size();
+    u32 checksum = Crypto::Checksum::CRC32 { entries }.digest();
+    transaction.overwrite(0, &magic, sizeof(u32));
+    transaction.overwrite(sizeof(u32), &block_count, sizeof(u32));
+    transaction.overwrite(2 * sizeof(u32), &checksum, sizeof(u32));
+
+    TRY(m_file->seek(m_size_in_bytes, SeekMode::SetPosition));
+    TRY(m_file->write_until_depleted(transaction));
+
+    m_size_in_bytes += transaction.size();
+    m_needs_sync = true;
+
+    dbgln_if(SQL_DEBUG, "WriteAheadLog {}: appended transaction of {} block(s)", m_path, block_count);
+    return {};
+}
+
+ErrorOr<void> WriteAheadLog::sync()
+{
+    if (!m_needs_sync)
+        return {};
+
+    TRY(Core::System::fsync(m_file->fd()));
+    m_needs_sync = false;
+    ++m_sync_count;
+    return {};
+}
+
+ErrorOr<void> WriteAheadLog::reset()
+{
+    TRY(m_file->truncate(0));
+    TRY(Core::System::fsync(m_file->fd()));
+
+    m_size_in_bytes = 0;
+    m_needs_sync = false;
+    return {};
+}
+
+}
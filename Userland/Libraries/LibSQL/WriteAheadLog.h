@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <LibCore/File.h>
+
+namespace SQL {
+
+/**
+ * The WriteAheadLog is a redo log kept in a separate file next to a Heap. Every
+ * committed transaction is appended to it as the full images of the blocks it
+ * modified, before any of those blocks are written to the Heap file itself.
+ *
+ * After a crash, replaying the log restores all transactions which made it to
+ * the log completely. A transaction which was only partially written is detected
+ * by its checksum and discarded, together with everything following it.
+ *
+ * Each transaction is stored as:
+ *
+ *   u32 magic
+ *   u32 block count
+ *   u32 CRC32 checksum of the block entries
+ *   block count * (u32 block index, block data)
+ */
+class WriteAheadLog {
+public:
+    static constexpr u32 MAGIC = 0x4C415753; // "SWAL"
+
+    static ErrorOr<NonnullOwnPtr<WriteAheadLog>> open(ByteString path, u32 block_size);
+
+    ByteString const& path() const { return m_path; }
+    u64 size_in_bytes() const { return m_size_in_bytes; }
+    bool needs_sync() const { return m_needs_sync; }
+    size_t sync_count() const { return m_sync_count; }
+
+    ErrorOr<void> replay(Function<ErrorOr<void>(u32 block_index, ReadonlyBytes)> const&);
+
+    // Appends a transaction to the log. It is only durable after the next call to sync().
+    ErrorOr<void> append_transaction(HashMap<u32, ByteBuffer> const& blocks);
+    ErrorOr<void> sync();
+
+    // Discards all transactions, once they have been written to the Heap file itself.
+    ErrorOr<void> reset();
+
+private:
+    WriteAheadLog(ByteString path, u32 block_size, NonnullOwnPtr<Core::File>);
+
+    ByteString m_path;
+    u32 m_block_size { 0 };
+    NonnullOwnPtr<Core::File> m_file;
+
+    u64 m_size_in_bytes { 0 };
+    bool m_needs_sync { false };
+    size_t m_sync_count { 0 };
+};
+
+}
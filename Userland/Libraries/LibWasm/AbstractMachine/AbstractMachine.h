@@ -546,20 +546,18 @@ private:
     Vector<DataInstance> m_datas;
 };
 
+// Labels don't need to know where they lead, the validator resolves that for every branch, see Expression::BranchTarget.
 class Label {
 public:
-    explicit Label(size_t arity, InstructionPointer continuation)
-        : m_arity(arity)
-        , m_continuation(continuation)
+    explicit Label(size_t stack_height)
+        : m_stack_height(stack_height)
     {
     }
 
-    auto continuation() const { return m_continuation; }
-    auto arity() const { return m_arity; }
+    auto stack_height() const { return m_stack_height; }
 
 private:
-    size_t m_arity { 0 };
-    InstructionPointer m_continuation { 0 };
+    size_t m_stack_height { 0 };
 };
 
 class Frame {
@@ -585,9 +583,10 @@ private:
     size_t m_arity { 0 };
 };
 
+// Only holds values, labels and frames are kept on their own stacks by the configuration.
 class Stack {
 public:
-    using EntryType = Variant<Value, Label, Frame>;
+    using EntryType = Value;
     Stack() = default;
 
     [[nodiscard]] ALWAYS_INLINE bool is_empty() const { return m_data.is_empty(); }
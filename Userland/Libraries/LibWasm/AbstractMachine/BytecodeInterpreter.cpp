@@ -29,13 +29,6 @@ namespace Wasm {
         }                                                                                      \
     } while (false)
 
-#define TRAP_IF_NOT_NORETURN(x)                                                                \
-    do {                                                                                       \
-        if (trap_if_not(x, #x##sv)) {                                                          \
-            dbgln_if(WASM_TRACE_DEBUG, "Trapped because {} failed, at line {}", #x, __LINE__); \
-        }                                                                                      \
-    } while (false)
-
 void BytecodeInterpreter::interpret(Configuration& configuration)
 {
     m_trap = Empty {};
@@ -62,27 +55,23 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
     }
 }
 
-void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelIndex index)
+void BytecodeInterpreter::branch_to(Configuration& configuration, Expression::BranchTarget const& target)
 {
-    dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}...", index.value());
-    auto label = configuration.nth_label(index.value());
-    dbgln_if(WASM_TRACE_DEBUG, "...which is actually IP {}, and has {} result(s)", label->continuation().value(), label->arity());
-    auto results = pop_values(configuration, label->arity());
-
-    size_t drop_count = index.value() + 1;
-    for (; !configuration.stack().is_empty();) {
-        auto& entry = configuration.stack().peek();
-        if (entry.has<Label>()) {
-            if (--drop_count == 0)
-                break;
-        }
-        configuration.stack().pop();
+    dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}, which is actually IP {}, and has {} result(s)", target.label_index, target.continuation.value(), target.arity);
+    auto& labels = configuration.label_stack();
+    auto label_position = labels.size() - target.label_index - 1;
+    auto stack_height = labels[label_position].stack_height();
+
+    auto& values = configuration.stack().entries();
+    auto results_start = values.size() - target.arity;
+    if (results_start != stack_height) {
+        for (size_t i = 0; i < target.arity; ++i)
+            values[stack_height + i] = move(values[results_start + i]);
+        values.shrink(stack_height + target.arity, true);
     }
+    labels.shrink(label_position + (target.keeps_label ? 1 : 0), true);
 
-    for (auto& result : results)
-        configuration.stack().push(move(result));
-
-    configuration.ip() = label->continuation();
+    configuration.ip() = target.continuation;
 }
 
 template<typename ReadType, typename PushType>
@@ -96,21 +85,20 @@ void BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
         return;
     }
     auto& entry = configuration.stack().peek();
-    auto base = entry.get<Value>().to<i32>();
+    auto base = entry.to<i32>();
     if (!base.has_value()) {
         m_trap = Trap { "Memory access out of bounds" };
         return;
     }
+    // The base and the offset are both 32-bit, so this can't overflow.
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base.value())) + arg.offset;
-    Checked addition { instance_address };
-    addition += sizeof(ReadType);
-    if (addition.has_overflow() || addition.value() > memory->size()) {
+    if (instance_address + sizeof(ReadType) > memory->size()) {
         m_trap = Trap { "Memory access out of bounds" };
         dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + sizeof(ReadType), memory->size());
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
-    auto slice = memory->data().bytes().slice(instance_address, sizeof(ReadType));
+    ReadonlyBytes slice { memory->data().data() + instance_address, sizeof(ReadType) };
     configuration.stack().peek() = Value(static_cast<PushType>(read_value<ReadType>(slice)));
 }
 
@@ -131,21 +119,20 @@ void BytecodeInterpreter::load_and_push_mxn(Configuration& configuration, Instru
         return;
     }
     auto& entry = configuration.stack().peek();
-    auto base = entry.get<Value>().to<i32>();
+    auto base = entry.to<i32>();
     if (!base.has_value()) {
         m_trap = Trap { "Memory access out of bounds" };
         return;
     }
+    // The base and the offset are both 32-bit, so this can't overflow.
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base.value())) + arg.offset;
-    Checked addition { instance_address };
-    addition += M * N / 8;
-    if (addition.has_overflow() || addition.value() > memory->size()) {
+    if (instance_address + M * N / 8 > memory->size()) {
         m_trap = Trap { "Memory access out of bounds" };
         dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + M * N / 8, memory->size());
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "vec-load({} : {}) -> stack", instance_address, M * N / 8);
-    auto slice = memory->data().bytes().slice(instance_address, M * N / 8);
+    ReadonlyBytes slice { memory->data().data() + instance_address, M * N / 8 };
     using V64 = NativeVectorType<M, N, SetSign>;
     using V128 = NativeVectorType<M * 2, N, SetSign>;
 
@@ -169,21 +156,20 @@ void BytecodeInterpreter::load_and_push_m_splat(Configuration& configuration, In
         return;
     }
     auto& entry = configuration.stack().peek();
-    auto base = entry.get<Value>().to<i32>();
+    auto base = entry.to<i32>();
     if (!base.has_value()) {
         m_trap = Trap { "Memory access out of bounds" };
         return;
     }
+    // The base and the offset are both 32-bit, so this can't overflow.
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base.value())) + arg.offset;
-    Checked addition { instance_address };
-    addition += M / 8;
-    if (addition.has_overflow() || addition.value() > memory->size()) {
+    if (instance_address + M / 8 > memory->size()) {
         m_trap = Trap { "Memory access out of bounds" };
         dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + M / 8, memory->size());
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "vec-splat({} : {}) -> stack", instance_address, M / 8);
-    auto slice = memory->data().bytes().slice(instance_address, M / 8);
+    ReadonlyBytes slice { memory->data().data() + instance_address, M / 8 };
     auto value = read_value<NativeIntegralType<M>>(slice);
     set_top_m_splat<M, NativeIntegralType>(configuration, value);
 }
@@ -222,7 +208,7 @@ void BytecodeInterpreter::pop_and_push_m_splat(Wasm::Configuration& configuratio
     using PopT = Conditional<M <= 32, NativeType<32>, NativeType<64>>;
     using ReadT = NativeType<M>;
     auto entry = configuration.stack().peek();
-    auto value = static_cast<ReadT>(*entry.get<Value>().to<PopT>());
+    auto value = static_cast<ReadT>(*entry.to<PopT>());
     dbgln_if(WASM_TRACE_DEBUG, "stack({}) -> splat({})", value, M);
     set_top_m_splat<M, NativeType>(configuration, value);
 }
@@ -240,7 +226,7 @@ template<typename M, template<typename> typename SetSign, typename VectorType>
 Optional<VectorType> BytecodeInterpreter::peek_vector(Configuration& configuration)
 {
     auto& entry = configuration.stack().peek();
-    auto value = entry.get<Value>().value().get_pointer<u128>();
+    auto value = entry.value().get_pointer<u128>();
     if (!value)
         return {};
     auto vector = bit_cast<VectorType>(*value);
@@ -263,17 +249,14 @@ void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAdd
     auto instance = configuration.store().get(address);
     FunctionType const* type { nullptr };
     instance->visit([&](auto const& function) { type = &function.type(); });
-    TRAP_IF_NOT(configuration.stack().entries().size() > type->parameters().size());
+    TRAP_IF_NOT(configuration.stack().entries().size() >= type->parameters().size());
     Vector<Value> args;
     args.ensure_capacity(type->parameters().size());
     auto span = configuration.stack().entries().span().slice_from_end(type->parameters().size());
-    for (auto& entry : span) {
-        auto* call_argument = entry.get_pointer<Value>();
-        TRAP_IF_NOT(call_argument);
-        args.unchecked_append(move(*call_argument));
-    }
+    for (auto& entry : span)
+        args.unchecked_append(move(entry));
 
-    configuration.stack().entries().remove(configuration.stack().size() - span.size(), span.size());
+    configuration.stack().entries().shrink(configuration.stack().size() - span.size(), true);
 
     Result result { Trap { ""sv } };
     {
@@ -301,10 +284,8 @@ void BytecodeInterpreter::binary_numeric_operation(Configuration& configuration,
 {
     auto rhs_entry = configuration.stack().pop();
     auto& lhs_entry = configuration.stack().peek();
-    auto rhs_ptr = rhs_entry.get_pointer<Value>();
-    auto lhs_ptr = lhs_entry.get_pointer<Value>();
-    auto rhs = rhs_ptr->to<PopTypeRHS>();
-    auto lhs = lhs_ptr->to<PopTypeLHS>();
+    auto rhs = rhs_entry.to<PopTypeRHS>();
+    auto lhs = lhs_entry.to<PopTypeLHS>();
     PushType result;
     auto call_result = Operator { forward<Args>(args)... }(lhs.value(), rhs.value());
     if constexpr (IsSpecializationOf<decltype(call_result), AK::ErrorOr>) {
@@ -324,8 +305,7 @@ template<typename PopType, typename PushType, typename Operator, typename... Arg
 void BytecodeInterpreter::unary_operation(Configuration& configuration, Args&&... args)
 {
     auto& entry = configuration.stack().peek();
-    auto entry_ptr = entry.get_pointer<Value>();
-    auto value = entry_ptr->to<PopType>();
+    auto value = entry.to<PopType>();
     auto call_result = Operator { forward<Args>(args)... }(*value);
     PushType result;
     if constexpr (IsSpecializationOf<decltype(call_result), AK::ErrorOr>) {
@@ -375,10 +355,10 @@ template<typename PopT, typename StoreT>
 void BytecodeInterpreter::pop_and_store(Configuration& configuration, Instruction const& instruction)
 {
     auto entry = configuration.stack().pop();
-    auto value = ConvertToRaw<StoreT> {}(*entry.get<Value>().to<PopT>());
+    auto value = ConvertToRaw<StoreT> {}(*entry.to<PopT>());
     dbgln_if(WASM_TRACE_DEBUG, "stack({}) -> temporary({}b)", value, sizeof(StoreT));
     auto base_entry = configuration.stack().pop();
-    auto base = base_entry.get<Value>().to<i32>();
+    auto base = base_entry.to<i32>();
     store_to_memory(configuration, instruction, { &value, sizeof(StoreT) }, *base);
 }
 
@@ -387,50 +367,36 @@ void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruct
     auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
     auto& address = configuration.frame().module().memories()[arg.memory_index.value()];
     auto memory = configuration.store().get(address);
+    // The base and the offset are both 32-bit, so this can't overflow.
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base)) + arg.offset;
-    Checked addition { instance_address };
-    addition += data.size();
-    if (addition.has_overflow() || addition.value() > memory->size()) {
+    if (instance_address + data.size() > memory->size()) {
         m_trap = Trap { "Memory access out of bounds" };
         dbgln("LibWasm: Memory access out of bounds (expected 0 <= {} and {} <= {})", instance_address, instance_address + data.size(), memory->size());
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "temporary({}b) -> store({})", data.size(), instance_address);
-    data.copy_to(memory->data().bytes().slice(instance_address, data.size()));
+    __builtin_memcpy(memory->data().data() + instance_address, data.data(), data.size());
 }
 
+// NOTE: The callers have already checked that the bytes are in bounds.
 template<typename T>
 T BytecodeInterpreter::read_value(ReadonlyBytes data)
 {
-    FixedMemoryStream stream { data };
-    auto value_or_error = stream.read_value<LittleEndian<T>>();
-    if (value_or_error.is_error()) {
-        dbgln("Read from {} failed", data.data());
-        m_trap = Trap { "Read from memory failed" };
-    }
-    return value_or_error.release_value();
+    T value;
+    __builtin_memcpy(&value, data.data(), sizeof(T));
+    return AK::convert_between_host_and_little_endian(value);
 }
 
 template<>
 float BytecodeInterpreter::read_value<float>(ReadonlyBytes data)
 {
-    FixedMemoryStream stream { data };
-    auto raw_value_or_error = stream.read_value<LittleEndian<u32>>();
-    if (raw_value_or_error.is_error())
-        m_trap = Trap { "Read from memory failed" };
-    auto raw_value = raw_value_or_error.release_value();
-    return bit_cast<float>(static_cast<u32>(raw_value));
+    return bit_cast<float>(read_value<u32>(data));
 }
 
 template<>
 double BytecodeInterpreter::read_value<double>(ReadonlyBytes data)
 {
-    FixedMemoryStream stream { data };
-    auto raw_value_or_error = stream.read_value<LittleEndian<u64>>();
-    if (raw_value_or_error.is_error())
-        m_trap = Trap { "Read from memory failed" };
-    auto raw_value = raw_value_or_error.release_value();
-    return bit_cast<double>(static_cast<u64>(raw_value));
+    return bit_cast<double>(read_value<u64>(data));
 }
 
 template<typename V, typename T>
@@ -478,21 +444,6 @@ MakeUnsigned<T> BytecodeInterpreter::checked_unsigned_truncate(V value)
     return true;
 }
 
-Vector<Value> BytecodeInterpreter::pop_values(Configuration& configuration, size_t count)
-{
-    Vector<Value> results;
-    results.resize(count);
-
-    for (size_t i = 0; i < count; ++i) {
-        auto top_of_stack = configuration.stack().pop();
-        if (auto value = top_of_stack.get_pointer<Value>())
-            results[i] = move(*value);
-        else
-            TRAP_IF_NOT_NORETURN(value);
-    }
-    return results;
-}
-
 void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPointer& ip, Instruction const& instruction)
 {
     dbgln_if(WASM_TRACE_DEBUG, "Executing instruction {} at ip {}", instruction_name(instruction.opcode()), ip.value());
@@ -508,7 +459,7 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         return;
     case Instructions::local_set.value(): {
         auto entry = configuration.stack().pop();
-        configuration.frame().locals()[instruction.arguments().get<LocalIndex>().value()] = move(entry.get<Value>());
+        configuration.frame().locals()[instruction.arguments().get<LocalIndex>().value()] = move(entry);
         return;
     }
     case Instructions::i32_const.value():
@@ -523,131 +474,64 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
     case Instructions::f64_const.value():
         configuration.stack().push(Value(ValueType { ValueType::F64 }, instruction.arguments().get<double>()));
         return;
-    case Instructions::block.value(): {
-        size_t arity = 0;
-        size_t parameter_count = 0;
-        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        switch (args.block_type.kind()) {
-        case BlockType::Empty:
-            break;
-        case BlockType::Type:
-            arity = 1;
-            break;
-        case BlockType::Index: {
-            auto& type = configuration.frame().module().types()[args.block_type.type_index().value()];
-            arity = type.results().size();
-            parameter_count = type.parameters().size();
-        }
-        }
-
-        configuration.stack().entries().insert(configuration.stack().size() - parameter_count, Label(arity, args.end_ip));
-        return;
-    }
+    case Instructions::block.value():
     case Instructions::loop.value(): {
-        size_t arity = 0;
-        size_t parameter_count = 0;
-        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        switch (args.block_type.kind()) {
-        case BlockType::Empty:
-            break;
-        case BlockType::Type:
-            arity = 1;
-            break;
-        case BlockType::Index: {
-            auto& type = configuration.frame().module().types()[args.block_type.type_index().value()];
-            arity = type.results().size();
-            parameter_count = type.parameters().size();
-        }
-        }
-
-        configuration.stack().entries().insert(configuration.stack().size() - parameter_count, Label(arity, ip.value() + 1));
+        auto parameter_count = configuration.frame().expression().compiled_control_flow().operands[ip.value()];
+        configuration.label_stack().append(Label(configuration.stack().size() - parameter_count));
         return;
     }
     case Instructions::if_.value(): {
-        size_t arity = 0;
-        size_t parameter_count = 0;
         auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        switch (args.block_type.kind()) {
-        case BlockType::Empty:
-            break;
-        case BlockType::Type:
-            arity = 1;
-            break;
-        case BlockType::Index: {
-            auto& type = configuration.frame().module().types()[args.block_type.type_index().value()];
-            arity = type.results().size();
-            parameter_count = type.parameters().size();
-        }
-        }
+        auto parameter_count = configuration.frame().expression().compiled_control_flow().operands[ip.value()];
 
         auto entry = configuration.stack().pop();
-        auto value = entry.get<Value>().to<i32>();
-        auto end_label = Label(arity, args.end_ip.value());
+        auto value = entry.to<i32>();
         if (value.value() == 0) {
             if (args.else_ip.has_value()) {
                 configuration.ip() = args.else_ip.value();
-                configuration.stack().entries().insert(configuration.stack().size() - parameter_count, end_label);
+                configuration.label_stack().append(Label(configuration.stack().size() - parameter_count));
             } else {
                 configuration.ip() = args.end_ip.value() + 1;
             }
         } else {
-            configuration.stack().entries().insert(configuration.stack().size() - parameter_count, end_label);
+            configuration.label_stack().append(Label(configuration.stack().size() - parameter_count));
         }
         return;
     }
     case Instructions::structured_end.value():
+        configuration.label_stack().take_last();
+        return;
     case Instructions::structured_else.value(): {
-        auto index = configuration.nth_label_index(0);
-        auto label = configuration.stack().entries()[*index].get<Label>();
-        configuration.stack().entries().remove(*index, 1);
+        configuration.label_stack().take_last();
 
-        if (instruction.opcode() == Instructions::structured_end)
-            return;
-
-        // Jump to the end label
-        configuration.ip() = label.continuation();
+        // Jump past the end of the if
+        configuration.ip() = configuration.frame().expression().compiled_control_flow().operands[ip.value()];
         return;
     }
-    case Instructions::return_.value(): {
-        auto& frame = configuration.frame();
-        Checked checked_index { configuration.stack().size() };
-        checked_index -= frame.arity();
-        VERIFY(!checked_index.has_overflow());
-
-        auto index = checked_index.value();
-        size_t i = 1;
-        for (; i <= index; ++i) {
-            auto& entry = configuration.stack().entries()[index - i];
-            if (entry.has<Label>()) {
-                if (configuration.stack().entries()[index - i - 1].has<Frame>())
-                    break;
-            }
-        }
-
-        configuration.stack().entries().remove(index - i + 1, i - 1);
-
-        // Jump past the call/indirect instruction
-        configuration.ip() = configuration.frame().expression().instructions().size();
-        return;
+    case Instructions::return_.value():
+    case Instructions::br.value(): {
+        auto& control_flow = configuration.frame().expression().compiled_control_flow();
+        return branch_to(configuration, control_flow.branch_targets[control_flow.operands[ip.value()]]);
     }
-    case Instructions::br.value():
-        return branch_to_label(configuration, instruction.arguments().get<LabelIndex>());
     case Instructions::br_if.value(): {
         auto entry = configuration.stack().pop();
-        if (entry.get<Value>().to<i32>().value_or(0) == 0)
+        if (entry.to<i32>().value_or(0) == 0)
             return;
-        return branch_to_label(configuration, instruction.arguments().get<LabelIndex>());
+        auto& control_flow = configuration.frame().expression().compiled_control_flow();
+        return branch_to(configuration, control_flow.branch_targets[control_flow.operands[ip.value()]]);
     }
     case Instructions::br_table.value(): {
         auto& arguments = instruction.arguments().get<Instruction::TableBranchArgs>();
+        auto& control_flow = configuration.frame().expression().compiled_control_flow();
+        auto targets = control_flow.branch_targets.span().slice(control_flow.operands[ip.value()], arguments.labels.size() + 1);
         auto entry = configuration.stack().pop();
-        auto maybe_i = entry.get<Value>().to<i32>();
+        auto maybe_i = entry.to<i32>();
         if (0 <= *maybe_i) {
             size_t i = *maybe_i;
             if (i < arguments.labels.size())
-                return branch_to_label(configuration, arguments.labels[i]);
+                return branch_to(configuration, targets[i]);
         }
-        return branch_to_label(configuration, arguments.default_);
+        return branch_to(configuration, targets.last());
     }
     case Instructions::call.value(): {
         auto index = instruction.arguments().get<FunctionIndex>();
@@ -661,7 +545,7 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto table_address = configuration.frame().module().tables()[args.table.value()];
         auto table_instance = configuration.store().get(table_address);
         auto entry = configuration.stack().pop();
-        auto index = entry.get<Value>().to<i32>();
+        auto index = entry.to<i32>();
         TRAP_IF_NOT(index.value() >= 0);
         TRAP_IF_NOT(static_cast<size_t>(index.value()) < table_instance->elements().size());
         auto element = table_instance->elements()[index.value()];
@@ -720,7 +604,7 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         return pop_and_store<i64, i32>(configuration, instruction);
     case Instructions::local_tee.value(): {
         auto& entry = configuration.stack().peek();
-        auto value = entry.get<Value>();
+        auto value = entry;
         auto local_index = instruction.arguments().get<LocalIndex>();
         dbgln_if(WASM_TRACE_DEBUG, "stack:peek -> locals({})", local_index.value());
         configuration.frame().locals()[local_index.value()] = move(value);
@@ -738,7 +622,7 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto global_index = instruction.arguments().get<GlobalIndex>();
         auto address = configuration.frame().module().globals()[global_index.value()];
         auto entry = configuration.stack().pop();
-        auto value = entry.get<Value>();
+        auto value = entry;
         dbgln_if(WASM_TRACE_DEBUG, "stack -> global({})", address.value());
         auto global = configuration.store().get(address);
         global->set_value(move(value));
@@ -759,7 +643,7 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto instance = configuration.store().get(address);
         i32 old_pages = instance->size() / Constants::page_size;
         auto& entry = configuration.stack().peek();
-        auto new_pages = entry.get<Value>().to<i32>();
+        auto new_pages = entry.to<i32>();
         dbgln_if(WASM_TRACE_DEBUG, "memory.grow({}), previously {} pages...", *new_pages, old_pages);
         if (instance->grow(new_pages.value() * Constants::page_size))
             configuration.stack().peek() = Value((i32)old_pages);
@@ -772,23 +656,13 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto& args = instruction.arguments().get<Instruction::MemoryIndexArgument>();
         auto address = configuration.frame().module().memories()[args.memory_index.value()];
         auto instance = configuration.store().get(address);
-        auto count = configuration.stack().pop().get<Value>().to<i32>().value();
-        auto value = configuration.stack().pop().get<Value>().to<i32>().value();
-        auto destination_offset = configuration.stack().pop().get<Value>().to<i32>().value();
-
-        TRAP_IF_NOT(static_cast<size_t>(destination_offset + count) <= instance->data().size());
-
-        if (count == 0)
-            return;
+        u64 count = bit_cast<u32>(configuration.stack().pop().to<i32>().value());
+        u8 value = static_cast<u8>(configuration.stack().pop().to<i32>().value());
+        u64 destination_offset = bit_cast<u32>(configuration.stack().pop().to<i32>().value());
 
-        Instruction synthetic_store_instruction {
-            Instructions::i32_store8,
-            Instruction::MemoryArgument { 0, 0 }
-        };
+        TRAP_IF_NOT(destination_offset + count <= instance->data().size());
 
-        for (auto i = 0; i < count; ++i) {
-            store_to_memory(configuration, synthetic_store_instruction, { &value, sizeof(value) }, destination_offset);
-        }
+        __builtin_memset(instance->data().data() + destination_offset, value, count);
         return;
     }
     // https://webassembly.github.io/spec/core/bikeshed/#exec-memory-copy
@@ -799,33 +673,15 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto source_instance = configuration.store().get(source_address);
         auto destination_instance = configuration.store().get(destination_address);
 
-        auto count = configuration.stack().pop().get<Value>().to<i32>().value();
-        auto source_offset = configuration.stack().pop().get<Value>().to<i32>().value();
-        auto destination_offset = configuration.stack().pop().get<Value>().to<i32>().value();
-
-        TRAP_IF_NOT(static_cast<size_t>(source_offset + count) <= source_instance->data().size());
-        TRAP_IF_NOT(static_cast<size_t>(destination_offset + count) <= destination_instance->data().size());
-
-        if (count == 0)
-            return;
-
-        Instruction synthetic_store_instruction {
-            Instructions::i32_store8,
-            Instruction::MemoryArgument { 0, 0, args.dst_index }
-        };
+        u64 count = bit_cast<u32>(configuration.stack().pop().to<i32>().value());
+        u64 source_offset = bit_cast<u32>(configuration.stack().pop().to<i32>().value());
+        u64 destination_offset = bit_cast<u32>(configuration.stack().pop().to<i32>().value());
 
-        if (destination_offset <= source_offset) {
-            for (auto i = 0; i < count; ++i) {
-                auto value = source_instance->data()[source_offset + i];
-                store_to_memory(configuration, synthetic_store_instruction, { &value, sizeof(value) }, destination_offset + i);
-            }
-        } else {
-            for (auto i = count - 1; i >= 0; --i) {
-                auto value = source_instance->data()[source_offset + i];
-                store_to_memory(configuration, synthetic_store_instruction, { &value, sizeof(value) }, destination_offset + i);
-            }
-        }
+        TRAP_IF_NOT(source_offset + count <= source_instance->data().size());
+        TRAP_IF_NOT(destination_offset + count <= destination_instance->data().size());
 
+        // The ranges may overlap when copying within the same memory.
+        __builtin_memmove(destination_instance->data().data() + destination_offset, source_instance->data().data() + source_offset, count);
         return;
     }
     // https://webassembly.github.io/spec/core/bikeshed/#exec-memory-init
@@ -833,23 +689,19 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto& args = instruction.arguments().get<Instruction::MemoryInitArgs>();
         auto& data_address = configuration.frame().module().datas()[args.data_index.value()];
         auto& data = *configuration.store().get(data_address);
-        auto count = *configuration.stack().pop().get<Value>().to<i32>();
-        auto source_offset = *configuration.stack().pop().get<Value>().to<i32>();
-        auto destination_offset = *configuration.stack().pop().get<Value>().to<i32>();
+        auto memory_address = configuration.frame().module().memories()[args.memory_index.value()];
+        auto memory = configuration.store().get(memory_address);
+        u64 count = bit_cast<u32>(configuration.stack().pop().to<i32>().value());
+        u64 source_offset = bit_cast<u32>(configuration.stack().pop().to<i32>().value());
+        u64 destination_offset = bit_cast<u32>(configuration.stack().pop().to<i32>().value());
 
-        TRAP_IF_NOT(count > 0);
-        TRAP_IF_NOT(source_offset + count > 0);
-        TRAP_IF_NOT(static_cast<size_t>(source_offset + count) <= data.size());
+        TRAP_IF_NOT(source_offset + count <= data.size());
+        TRAP_IF_NOT(destination_offset + count <= memory->data().size());
 
-        Instruction synthetic_store_instruction {
-            Instructions::i32_store8,
-            Instruction::MemoryArgument { 0, 0, args.memory_index }
-        };
+        if (count == 0)
+            return;
 
-        for (size_t i = 0; i < (size_t)count; ++i) {
-            auto value = data.data()[source_offset + i];
-            store_to_memory(configuration, synthetic_store_instruction, { &value, sizeof(value) }, destination_offset + i);
-        }
+        __builtin_memcpy(memory->data().data() + destination_offset, data.data().data() + source_offset, count);
         return;
     }
     // https://webassembly.github.io/spec/core/bikeshed/#exec-data-drop
@@ -875,9 +727,9 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         return;
     }
     case Instructions::ref_is_null.value(): {
-        auto top = configuration.stack().peek().get_pointer<Value>();
-        TRAP_IF_NOT(top->type().is_reference());
-        auto is_null = top->to<Reference::Null>().has_value();
+        auto& top = configuration.stack().peek();
+        TRAP_IF_NOT(top.type().is_reference());
+        auto is_null = top.to<Reference::Null>().has_value();
         configuration.stack().peek() = Value(ValueType(ValueType::I32), static_cast<u64>(is_null ? 1 : 0));
         return;
     }
@@ -888,12 +740,12 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
     case Instructions::select_typed.value(): {
         // Note: The type seems to only be used for validation.
         auto entry = configuration.stack().pop();
-        auto value = entry.get<Value>().to<i32>();
+        auto value = entry.to<i32>();
         dbgln_if(WASM_TRACE_DEBUG, "select({})", value.value());
         auto rhs_entry = configuration.stack().pop();
         auto& lhs_entry = configuration.stack().peek();
-        auto rhs = move(rhs_entry.get<Value>());
-        auto lhs = move(lhs_entry.get<Value>());
+        auto rhs = move(rhs_entry);
+        auto lhs = move(lhs_entry);
         configuration.stack().peek() = value.value() != 0 ? move(lhs) : move(rhs);
         return;
     }
@@ -9,6 +9,8 @@
 #include <AK/SourceLocation.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Try.h>
+#include <LibCore/System.h>
+#include <LibThreading/Thread.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWasm/Printer/Printer.h>
 
@@ -148,6 +150,12 @@ ErrorOr<void, ValidationError> Validator::validate(Module& module)
         }
     }
 
+    // The functions of the module are run from their own copies of the code, which need the lowered control flow too.
+    module.for_each_section_of_type<CodeSection>([&](CodeSection const& section) {
+        for (size_t i = 0; i < section.functions().size(); ++i)
+            module.functions()[i].body().set_compiled_control_flow(section.functions()[i].func().body().compiled_control_flow());
+    });
+
     module.set_validation_status(Module::ValidationStatus::Valid, {});
     return {};
 }
@@ -256,27 +264,94 @@ ErrorOr<void, ValidationError> Validator::validate(TableSection const& section)
 
 ErrorOr<void, ValidationError> Validator::validate(CodeSection const& section)
 {
-    size_t index = m_context.imported_function_count;
-    for (auto& entry : section.functions()) {
-        auto function_index = index++;
-        TRY(validate(FunctionIndex { function_index }));
-        auto& function_type = m_context.functions[function_index];
-        auto& function = entry.func();
-
-        auto function_validator = fork();
-        function_validator.m_context.locals = {};
-        function_validator.m_context.locals.extend(function_type.parameters());
-        for (auto& local : function.locals()) {
-            for (size_t i = 0; i < local.n(); ++i)
-                function_validator.m_context.locals.append(local.type());
-        }
+    auto& functions = section.functions();
+    size_t thread_count = min<size_t>(Core::System::hardware_concurrency(), functions.size() / Constants::minimum_functions_per_validator_thread);
+
+    if (thread_count <= 1) {
+        for (size_t i = 0; i < functions.size(); ++i)
+            TRY(validate_function(FunctionIndex { m_context.imported_function_count + i }, functions[i]));
+        return {};
+    }
+
+    // The function bodies don't depend on each other, so they are split into contiguous ranges that are validated on their own threads.
+    // The storage of the context is reference counted without atomics, so every thread gets a copy that shares nothing with the others.
+    auto isolated_copy = [](auto const& vector) {
+        RemoveCVReference<decltype(vector)> copy;
+        copy.extend(vector);
+        return copy;
+    };
+    struct Range {
+        OwnPtr<Validator> validator {};
+        size_t start { 0 };
+        size_t end { 0 };
+        ErrorOr<void, ValidationError> result {};
+        RefPtr<Threading::Thread> thread {};
+    };
+    Vector<Range> ranges;
+    ranges.ensure_capacity(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        Context context;
+        context.types = isolated_copy(m_context.types);
+        context.functions = isolated_copy(m_context.functions);
+        context.tables = isolated_copy(m_context.tables);
+        context.memories = isolated_copy(m_context.memories);
+        context.globals = isolated_copy(m_context.globals);
+        context.elements = isolated_copy(m_context.elements);
+        context.datas = isolated_copy(m_context.datas);
+        context.return_ = m_context.return_;
+        context.references = m_context.references;
+        context.imported_function_count = m_context.imported_function_count;
+
+        ranges.append({
+            .validator = adopt_own(*new Validator(move(context))),
+            .start = functions.size() * i / thread_count,
+            .end = functions.size() * (i + 1) / thread_count,
+        });
+    }
+
+    for (auto& range : ranges) {
+        range.thread = Threading::Thread::construct([&range, &functions] {
+            auto& validator = *range.validator;
+            for (size_t i = range.start; i < range.end; ++i) {
+                range.result = validator.validate_function(FunctionIndex { validator.m_context.imported_function_count + i }, functions[i]);
+                if (range.result.is_error())
+                    break;
+            }
+            return 0;
+        },
+            "Wasm validator"sv);
+        range.thread->start();
+    }
 
-        function_validator.m_context.labels = { ResultType { function_type.results() } };
-        function_validator.m_context.return_ = ResultType { function_type.results() };
+    for (auto& range : ranges)
+        (void)range.thread->join();
 
-        TRY(function_validator.validate(function.body(), function_type.results()));
+    // Report the same error as validating the functions in order would.
+    for (auto& range : ranges) {
+        if (range.result.is_error())
+            return range.result.release_error();
     }
+    return {};
+}
+
+ErrorOr<void, ValidationError> Validator::validate_function(FunctionIndex function_index, CodeSection::Code const& code)
+{
+    TRY(validate(function_index));
+    auto& function_type = m_context.functions[function_index.value()];
+    auto& function = code.func();
 
+    auto function_validator = fork();
+    function_validator.m_context.locals = {};
+    function_validator.m_context.locals.extend(function_type.parameters());
+    for (auto& local : function.locals()) {
+        for (size_t i = 0; i < local.n(); ++i)
+            function_validator.m_context.locals.append(local.type());
+    }
+
+    function_validator.m_context.labels = { ResultType { function_type.results() } };
+    function_validator.m_context.return_ = ResultType { function_type.results() };
+
+    TRY(function_validator.validate(function.body(), function_type.results()));
     return {};
 }
 
@@ -3797,9 +3872,96 @@ ErrorOr<Validator::ExpressionTypeResult, ValidationError> Validator::validate(Ex
     for (auto& type : result_types)
         stack.append(type);
 
+    TRY(compile_control_flow(expression, result_types.size()));
+
     return ExpressionTypeResult { stack.release_vector(), is_constant_expression };
 }
 
+ErrorOr<void, ValidationError> Validator::compile_control_flow(Expression const& expression, size_t result_count)
+{
+    auto& instructions = expression.instructions();
+
+    struct Block {
+        InstructionPointer continuation;
+        size_t branch_arity { 0 };
+        bool keeps_label { false };
+    };
+    // The body of the function is the outermost block, branching to it returns from the function.
+    // Its label belongs to the frame, so it's left for Configuration::execute() to remove.
+    Vector<Block, 8> blocks;
+    blocks.append({ instructions.size(), result_count, true });
+
+    Expression::CompiledControlFlow control_flow;
+    control_flow.operands.resize(instructions.size());
+
+    auto add_branch_target = [&](LabelIndex label) -> ErrorOr<void, ValidationError> {
+        if (label.value() >= blocks.size())
+            return Errors::invalid("label"sv);
+        auto& block = blocks[blocks.size() - label.value() - 1];
+        control_flow.branch_targets.append({
+            .continuation = block.continuation,
+            .label_index = static_cast<u32>(label.value()),
+            .arity = static_cast<u32>(block.branch_arity),
+            .keeps_label = block.keeps_label,
+        });
+        return {};
+    };
+
+    for (size_t ip = 0; ip < instructions.size(); ++ip) {
+        auto& instruction = instructions[ip];
+        switch (instruction.opcode().value()) {
+        case Instructions::block.value():
+        case Instructions::loop.value():
+        case Instructions::if_.value(): {
+            auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
+            auto type = TRY(validate(args.block_type));
+            control_flow.operands[ip] = type.parameters().size();
+            if (instruction.opcode() == Instructions::loop) {
+                blocks.append({ ip + 1, type.parameters().size(), true });
+                break;
+            }
+            // The end of an if with an else branch already points past its structured_end, the others have to skip it,
+            // as branching out of a block takes care of leaving its label.
+            auto continuation = args.else_ip.has_value() ? args.end_ip : args.end_ip + 1;
+            blocks.append({ continuation, type.results().size(), false });
+            break;
+        }
+        case Instructions::structured_else.value():
+            if (blocks.size() <= 1)
+                return Errors::invalid("usage of structured else"sv);
+            control_flow.operands[ip] = blocks.last().continuation.value();
+            break;
+        case Instructions::structured_end.value():
+            if (blocks.size() <= 1)
+                return Errors::invalid("usage of structured end"sv);
+            blocks.take_last();
+            break;
+        case Instructions::br.value():
+        case Instructions::br_if.value():
+            control_flow.operands[ip] = control_flow.branch_targets.size();
+            TRY(add_branch_target(instruction.arguments().get<LabelIndex>()));
+            break;
+        case Instructions::br_table.value(): {
+            auto& args = instruction.arguments().get<Instruction::TableBranchArgs>();
+            control_flow.operands[ip] = control_flow.branch_targets.size();
+            for (auto label : args.labels)
+                TRY(add_branch_target(label));
+            TRY(add_branch_target(args.default_));
+            break;
+        }
+        case Instructions::return_.value():
+            control_flow.operands[ip] = control_flow.branch_targets.size();
+            TRY(add_branch_target(LabelIndex(blocks.size() - 1)));
+            break;
+        default:
+            break;
+        }
+    }
+
+    expression.set_compiled_control_flow(move(control_flow));
+    return {};
+}
+
 bool Validator::Stack::operator==(Stack const& other) const
 {
     if (!m_did_insert_unknown_entry && !other.m_did_insert_unknown_entry)
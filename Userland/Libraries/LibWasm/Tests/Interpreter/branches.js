@@ -0,0 +1,58 @@
+// prettier-ignore
+const binary = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0c, 0x02, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x60, 0x02, 0x7f, 0x7f, 0x01, 0x7f, 0x03, 0x06, 0x05, 0x00, 0x00, 0x00, 0x00, 0x01, 0x07, 0x26,
+    0x05, 0x03, 0x73, 0x75, 0x6d, 0x00, 0x00, 0x06, 0x69, 0x66, 0x65, 0x6c, 0x73, 0x65, 0x00, 0x01,
+    0x05, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x00, 0x02, 0x03, 0x72, 0x65, 0x74, 0x00, 0x03, 0x05, 0x63,
+    0x61, 0x72, 0x72, 0x79, 0x00, 0x04, 0x0a, 0xba, 0x01, 0x05, 0x25, 0x02, 0x01, 0x7f, 0x01, 0x7f,
+    0x02, 0x40, 0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x4e, 0x0d, 0x01, 0x20, 0x02, 0x20, 0x01, 0x6a,
+    0x21, 0x02, 0x20, 0x01, 0x41, 0x01, 0x6a, 0x21, 0x01, 0x0c, 0x00, 0x0b, 0x0b, 0x20, 0x02, 0x0b,
+    0x43, 0x02, 0x01, 0x7f, 0x01, 0x7f, 0x02, 0x7f, 0x03, 0x40, 0x20, 0x01, 0x41, 0x05, 0x4e, 0x04,
+    0x40, 0x20, 0x02, 0x0c, 0x02, 0x0b, 0x20, 0x01, 0x41, 0x01, 0x71, 0x04, 0x40, 0x20, 0x02, 0x41,
+    0x0a, 0x6a, 0x21, 0x02, 0x0c, 0x00, 0x05, 0x20, 0x02, 0x41, 0x01, 0x6a, 0x21, 0x02, 0x0b, 0x20,
+    0x01, 0x41, 0x01, 0x6a, 0x21, 0x01, 0x20, 0x02, 0x20, 0x00, 0x6a, 0x21, 0x02, 0x0c, 0x00, 0x0b,
+    0x41, 0x7f, 0x0b, 0x0b, 0x20, 0x00, 0x02, 0x7f, 0x02, 0x7f, 0x02, 0x7f, 0x41, 0xe4, 0x00, 0x20,
+    0x00, 0x0e, 0x03, 0x00, 0x01, 0x02, 0x01, 0x41, 0x01, 0x6a, 0x0b, 0x41, 0x0a, 0x6a, 0x0b, 0x41,
+    0xe8, 0x07, 0x6a, 0x0b, 0x0b, 0x18, 0x00, 0x41, 0x01, 0x41, 0x02, 0x02, 0x40, 0x02, 0x40, 0x41,
+    0x03, 0x20, 0x00, 0x04, 0x40, 0x41, 0x2a, 0x0f, 0x0b, 0x1a, 0x0b, 0x0b, 0x6a, 0x0b, 0x14, 0x00,
+    0x02, 0x7f, 0x41, 0x05, 0x41, 0x06, 0x20, 0x00, 0x0d, 0x00, 0x1a, 0x1a, 0x20, 0x01, 0x0b, 0x20,
+    0x00, 0x6a, 0x0b
+]);
+
+// The module exports these functions, all of them take i32s and return an i32:
+// - sum(n): adds up 0..n-1 in a loop that is left through br_if.
+// - ifelse(n): branches out of both arms of an if/else inside a loop, and out of the loop from a nested if.
+// - table(i): br_table out of one of three nested blocks that each add to the carried value.
+// - ret(x): returns from inside nested blocks while other values are still on the stack.
+// - carry(a, b): br_if out of a block with more values on the stack than it results in.
+const module = parseWebAssemblyModule(binary);
+const call = (name, ...args) => module.invoke(module.getExport(name), ...args);
+
+test("loops", () => {
+    expect(call("sum", 0)).toBe(0);
+    expect(call("sum", 10)).toBe(45);
+    expect(call("sum", 1000)).toBe(499500);
+});
+
+test("branching out of if and else", () => {
+    expect(call("ifelse", 0)).toBe(23);
+    expect(call("ifelse", 3)).toBe(38);
+});
+
+test("branch tables", () => {
+    expect(call("table", 0)).toBe(1110);
+    expect(call("table", 1)).toBe(1100);
+    expect(call("table", 2)).toBe(100);
+    expect(call("table", 3)).toBe(1100);
+    expect(call("table", -1)).toBe(1100);
+});
+
+test("returning from nested blocks", () => {
+    expect(call("ret", 0)).toBe(3);
+    expect(call("ret", 1)).toBe(42);
+});
+
+test("branches drop the values they don't carry", () => {
+    expect(call("carry", 0, 9)).toBe(9);
+    expect(call("carry", 1, 9)).toBe(7);
+});
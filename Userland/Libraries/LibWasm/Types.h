@@ -676,10 +676,35 @@ public:
 
     auto& instructions() const { return m_instructions; }
 
+    // Where a branch goes, worked out once by the validator so that the interpreter never has to look for labels.
+    struct BranchTarget {
+        InstructionPointer continuation { 0 };
+        // The label the branch targets, counted from the innermost enclosing one.
+        u32 label_index { 0 };
+        // How many values are carried over to the continuation.
+        u32 arity { 0 };
+        // Branches to loops (and to the function body) stay inside the targeted label, all others leave it.
+        bool keeps_label { false };
+    };
+
+    // The control flow of the expression, lowered by the validator: for every instruction, the number of parameters
+    // of the block it starts (block/loop/if), where it continues (else), or the index of its first branch target
+    // (br/br_if/br_table/return).
+    // br_table has one target for every label, followed by the default target.
+    struct CompiledControlFlow {
+        Vector<u32> operands;
+        Vector<BranchTarget> branch_targets;
+    };
+
+    auto& compiled_control_flow() const { return m_compiled_control_flow; }
+    // The control flow only depends on the instructions, so it's fine to fill it in on an expression that can't be modified otherwise.
+    void set_compiled_control_flow(CompiledControlFlow control_flow) const { m_compiled_control_flow = move(control_flow); }
+
     static ParseResult<Expression> parse(Stream& stream);
 
 private:
     Vector<Instruction> m_instructions;
+    mutable CompiledControlFlow m_compiled_control_flow;
 };
 
 class GlobalSection {
@@ -8,6 +8,7 @@
 #include <AK/MemoryStream.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
+#include <LibCrypto/Hash/SHA2.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/BigInt.h>
@@ -325,6 +326,12 @@ JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> parse_module(JS:
     } else {
         return vm.throw_completion<JS::TypeError>("Not a BufferSource"sv);
     }
+
+    auto& cache = get_cache(*vm.current_realm());
+    auto digest = TRY_OR_THROW_OOM(vm, ByteBuffer::copy(Crypto::Hash::SHA256::hash(data).bytes()));
+    if (auto compiled_module = cache.get_compiled_module(digest))
+        return compiled_module.release_nonnull();
+
     FixedMemoryStream stream { data };
     auto module_result = Wasm::Module::parse(stream);
     if (module_result.is_error()) {
@@ -332,13 +339,12 @@ JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> parse_module(JS:
         return vm.throw_completion<JS::TypeError>(Wasm::parse_error_to_byte_string(module_result.error()));
     }
 
-    auto& cache = get_cache(*vm.current_realm());
     if (auto validation_result = cache.abstract_machine().validate(module_result.value()); validation_result.is_error()) {
         // FIXME: Throw CompileError instead.
         return vm.throw_completion<JS::TypeError>(validation_result.error().error_string);
     }
     auto compiled_module = make_ref_counted<CompiledWebAssemblyModule>(module_result.release_value());
-    cache.add_compiled_module(compiled_module);
+    cache.add_compiled_module(move(digest), compiled_module);
     return compiled_module;
 }
 
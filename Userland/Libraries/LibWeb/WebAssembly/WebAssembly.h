@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/Optional.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/Handle.h>
@@ -39,17 +40,24 @@ struct CompiledWebAssemblyModule : public RefCounted<CompiledWebAssemblyModule>
 
 class WebAssemblyCache {
 public:
-    void add_compiled_module(NonnullRefPtr<CompiledWebAssemblyModule> module) { m_compiled_modules.append(module); }
+    void add_compiled_module(ByteBuffer digest, NonnullRefPtr<CompiledWebAssemblyModule> module) { m_compiled_modules.set(move(digest), move(module)); }
     void add_function_instance(Wasm::FunctionAddress address, JS::GCPtr<JS::NativeFunction> function) { m_function_instances.set(address, function); }
 
     Optional<JS::GCPtr<JS::NativeFunction>> get_function_instance(Wasm::FunctionAddress address) { return m_function_instances.get(address); }
+    RefPtr<CompiledWebAssemblyModule> get_compiled_module(ByteBuffer const& digest)
+    {
+        if (auto module = m_compiled_modules.get(digest); module.has_value())
+            return *module;
+        return nullptr;
+    }
 
     HashMap<Wasm::FunctionAddress, JS::GCPtr<JS::NativeFunction>> function_instances() const { return m_function_instances; }
     Wasm::AbstractMachine& abstract_machine() { return m_abstract_machine; }
 
 private:
     HashMap<Wasm::FunctionAddress, JS::GCPtr<JS::NativeFunction>> m_function_instances;
-    Vector<NonnullRefPtr<CompiledWebAssemblyModule>> m_compiled_modules;
+    // Keyed by a hash of the bytes the module was compiled from, so that compiling the same bytes again reuses the module.
+    HashMap<ByteBuffer, NonnullRefPtr<CompiledWebAssemblyModule>> m_compiled_modules;
     Wasm::AbstractMachine m_abstract_machine;
 };
 
@@ -97,6 +97,19 @@ Messages::SQLServer::ExecuteStatementResponse ConnectionFromClient::execute_stat
     return Optional<SQL::ExecutionID> {};
 }
 
+Messages::SQLServer::ExecuteStatementBatchResponse ConnectionFromClient::execute_statement_batch(SQL::StatementID statement_id, Vector<Vector<SQL::Value>> const& placeholder_values)
+{
+    dbgln_if(SQLSERVER_DEBUG, "ConnectionFromClient::execute_statement_batch(statement_id: {}, batch size: {})", statement_id, placeholder_values.size());
+
+    auto statement = SQLStatement::statement_for(statement_id);
+    if (statement && statement->connection().client_id() == client_id())
+        return statement->execute_batch(move(const_cast<Vector<Vector<SQL::Value>>&>(placeholder_values)));
+
+    dbgln_if(SQLSERVER_DEBUG, "Statement has disappeared");
+    async_execution_error(statement_id, -1, SQL::SQLErrorCode::StatementUnavailable, ByteString::formatted("{}", statement_id));
+    return Optional<SQL::ExecutionID> {};
+}
+
 void ConnectionFromClient::ready_for_next_result(SQL::StatementID statement_id, SQL::ExecutionID execution_id)
 {
     dbgln_if(SQLSERVER_DEBUG, "ConnectionFromClient::ready_for_next_result(statement_id: {}, execution_id: {})", statement_id, execution_id);
@@ -43,6 +43,9 @@ ErrorOr<NonnullRefPtr<DatabaseConnection>> DatabaseConnection::create(StringView
             warnln("Could not open database: {}", result.error().error_string());
             return Error::from_string_view("Could not open database"sv);
         }
+
+        // Statements from all clients run on the same event loop, so let them share syncs of the log.
+        database->enable_group_commit();
     }
 
     return adopt_nonnull_ref_or_enomem(new (nothrow) DatabaseConnection(move(database), move(database_name), client_id));
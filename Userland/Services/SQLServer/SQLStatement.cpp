@@ -69,41 +69,150 @@ Optional<SQL::ExecutionID> SQLStatement::execute(Vector<SQL::Value> placeholder_
 
     auto execution_id = m_next_execution_id++;
 
+    if (is<SQL::AST::Select>(*m_statement)) {
+        Core::deferred_invoke([this, strong_this = NonnullRefPtr(*this), placeholder_values = move(placeholder_values), execution_id]() mutable {
+            execute_select(execution_id, move(placeholder_values));
+        });
+
+        return execution_id;
+    }
+
     Core::deferred_invoke([this, strong_this = NonnullRefPtr(*this), placeholder_values = move(placeholder_values), execution_id] {
-        auto execution_result = m_statement->execute(connection().database(), placeholder_values);
+        complete_execution(execution_id, m_statement->execute(connection().database(), placeholder_values));
+    });
+
+    return execution_id;
+}
+
+Optional<SQL::ExecutionID> SQLStatement::execute_batch(Vector<Vector<SQL::Value>> placeholder_values)
+{
+    dbgln_if(SQLSERVER_DEBUG, "SQLStatement::execute_batch(statement_id {}, batch size {}", statement_id(), placeholder_values.size());
 
-        if (execution_result.is_error()) {
-            report_error(execution_result.release_error(), execution_id);
+    auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
+    if (!client_connection) {
+        warnln("Cannot yield next result. Client disconnected");
+        return {};
+    }
+
+    auto execution_id = m_next_execution_id++;
+
+    Core::deferred_invoke([this, strong_this = NonnullRefPtr(*this), placeholder_values = move(placeholder_values), execution_id] {
+        if (!is<SQL::AST::Insert>(*m_statement)) {
+            report_error(SQL::Result { SQL::SQLCommand::Unknown, SQL::SQLErrorCode::NotYetImplemented, "Batch execution of statements other than INSERT"sv }, execution_id);
             return;
         }
 
-        auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
-        if (!client_connection) {
-            warnln("Cannot return statement execution results. Client disconnected");
+        auto const& insert = static_cast<SQL::AST::Insert const&>(*m_statement);
+        complete_execution(execution_id, insert.execute_batch(connection().database(), placeholder_values));
+    });
+
+    return execution_id;
+}
+
+void SQLStatement::complete_execution(SQL::ExecutionID execution_id, SQL::ResultOr<SQL::ResultSet> execution_result)
+{
+    if (execution_result.is_error()) {
+        report_error(execution_result.release_error(), execution_id);
+        return;
+    }
+
+    // Only report success once the modifications made by the statement are durable. The database
+    // syncs its log once for all statements executed before control returns to the event loop.
+    connection().database()->when_durable([this, strong_this = NonnullRefPtr(*this), execution_id, result = execution_result.release_value()](ErrorOr<void> durability) mutable {
+        if (durability.is_error()) {
+            report_error(durability.release_error(), execution_id);
             return;
         }
 
-        auto result = execution_result.release_value();
-        auto result_size = result.size();
-
-        if (should_send_result_rows(result)) {
-            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), true, 0, 0, 0);
-
-            m_ongoing_executions.set(execution_id, { move(result), result_size });
-            ready_for_next_result(execution_id);
-        } else {
-            if (result.command() == SQL::SQLCommand::Insert)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, result_size, 0, 0);
-            else if (result.command() == SQL::SQLCommand::Update)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, result_size, 0);
-            else if (result.command() == SQL::SQLCommand::Delete)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, result_size);
-            else
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, 0);
-        }
+        send_execution_result(execution_id, move(result));
     });
+}
 
-    return execution_id;
+void SQLStatement::send_execution_result(SQL::ExecutionID execution_id, SQL::ResultSet result)
+{
+    auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
+    if (!client_connection) {
+        warnln("Cannot return statement execution results. Client disconnected");
+        return;
+    }
+
+    auto result_size = result.size();
+
+    if (should_send_result_rows(result)) {
+        client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), true, 0, 0, 0);
+
+        Execution execution;
+        execution.result = move(result);
+        MUST(fetch_next_batch(execution));
+
+        m_ongoing_executions.set(execution_id, move(execution));
+        ready_for_next_result(execution_id);
+    } else {
+        if (result.command() == SQL::SQLCommand::Insert)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, result_size, 0, 0);
+        else if (result.command() == SQL::SQLCommand::Update)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, result_size, 0);
+        else if (result.command() == SQL::SQLCommand::Delete)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, result_size);
+        else
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, 0);
+    }
+}
+
+void SQLStatement::execute_select(SQL::ExecutionID execution_id, Vector<SQL::Value> placeholder_values)
+{
+    auto select = static_ptr_cast<SQL::AST::Select const>(m_statement);
+
+    Execution execution;
+    auto cursor = SQL::AST::Cursor::create(connection().database(), move(select), move(placeholder_values));
+    if (cursor.is_error()) {
+        report_error(cursor.release_error(), execution_id);
+        return;
+    }
+    execution.cursor = cursor.release_value();
+
+    // Pull the first batch before reporting success, so that the client learns up front whether
+    // there are any rows at all.
+    if (auto result = fetch_next_batch(execution); result.is_error()) {
+        report_error(result.release_error(), execution_id);
+        return;
+    }
+
+    auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
+    if (!client_connection) {
+        warnln("Cannot return statement execution results. Client disconnected");
+        return;
+    }
+
+    auto has_results = !execution.next_batch.is_empty();
+    client_connection->async_execution_success(statement_id(), execution_id, execution.cursor->column_names(), has_results, 0, 0, 0);
+
+    if (has_results) {
+        m_ongoing_executions.set(execution_id, move(execution));
+        ready_for_next_result(execution_id);
+    }
+}
+
+SQL::ResultOr<void> SQLStatement::fetch_next_batch(Execution& execution)
+{
+    execution.next_batch.clear_with_capacity();
+
+    while (execution.next_batch.size() < result_batch_size) {
+        Optional<SQL::Tuple> row;
+
+        if (execution.cursor) {
+            row = TRY(execution.cursor->next());
+        } else if (!execution.result->is_empty()) {
+            row = execution.result->take_first().row;
+        }
+
+        if (!row.has_value())
+            break;
+
+        TRY(execution.next_batch.try_append(row->take_data()));
+    }
+
+    return {};
 }
 
 void SQLStatement::ready_for_next_result(SQL::ExecutionID execution_id)
@@ -119,14 +228,20 @@ void SQLStatement::ready_for_next_result(SQL::ExecutionID execution_id)
         return;
     }
 
-    if (execution->result.is_empty()) {
+    if (execution->next_batch.is_empty()) {
         client_connection->async_results_exhausted(statement_id(), execution_id, execution->result_size);
         m_ongoing_executions.remove(execution_id);
         return;
     }
 
-    auto result_row = execution->result.take_first();
-    client_connection->async_next_result(statement_id(), execution_id, result_row.row.take_data());
+    execution->result_size += execution->next_batch.size();
+    client_connection->async_next_results(statement_id(), execution_id, move(execution->next_batch));
+
+    // Produce the following batch while the client is busy with this one.
+    if (auto result = fetch_next_batch(*execution); result.is_error()) {
+        m_ongoing_executions.remove(execution_id);
+        report_error(result.release_error(), execution_id);
+    }
 }
 
 bool SQLStatement::should_send_result_rows(SQL::ResultSet const& result) const
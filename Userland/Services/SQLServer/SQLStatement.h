@@ -7,9 +7,11 @@
 #pragma once
 
 #include <AK/NonnullRefPtr.h>
+#include <AK/OwnPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/Vector.h>
 #include <LibSQL/AST/AST.h>
+#include <LibSQL/AST/Operator.h>
 #include <LibSQL/Result.h>
 #include <LibSQL/ResultSet.h>
 #include <LibSQL/Type.h>
@@ -26,21 +28,39 @@ public:
     SQL::StatementID statement_id() const { return m_statement_id; }
     DatabaseConnection& connection() { return m_connection; }
     Optional<SQL::ExecutionID> execute(Vector<SQL::Value> placeholder_values);
+
+    // Executes an INSERT statement once for each set of placeholder values, as a single bulk insert.
+    Optional<SQL::ExecutionID> execute_batch(Vector<Vector<SQL::Value>> placeholder_values);
     void ready_for_next_result(SQL::ExecutionID);
 
 private:
     SQLStatement(DatabaseConnection&, NonnullRefPtr<SQL::AST::Statement> statement);
 
+    // Result rows are sent to the client in batches of this many rows, to amortize the IPC round trip
+    // between each batch and the client's request for the next one.
+    static constexpr size_t result_batch_size = 64;
+
+    struct Execution {
+        // SELECT statements are streamed through a cursor, other statements returning rows (such as
+        // DESCRIBE) are fully executed up front.
+        OwnPtr<SQL::AST::Cursor> cursor;
+        Optional<SQL::ResultSet> result;
+
+        Vector<Vector<SQL::Value>> next_batch;
+        size_t result_size { 0 };
+    };
+
+    void execute_select(SQL::ExecutionID, Vector<SQL::Value> placeholder_values);
+    void complete_execution(SQL::ExecutionID, SQL::ResultOr<SQL::ResultSet>);
+    void send_execution_result(SQL::ExecutionID, SQL::ResultSet);
+    SQL::ResultOr<void> fetch_next_batch(Execution&);
+
     bool should_send_result_rows(SQL::ResultSet const& result) const;
     void report_error(SQL::Result, SQL::ExecutionID execution_id);
 
     DatabaseConnection& m_connection;
     SQL::StatementID m_statement_id { 0 };
 
-    struct Execution {
-        SQL::ResultSet result;
-        size_t result_size { 0 };
-    };
     HashMap<SQL::ExecutionID, Execution> m_ongoing_executions;
     SQL::ExecutionID m_next_execution_id { 0 };
 
@@ -18,11 +18,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool keep_input_files { false };
     bool write_to_stdout { false };
     bool decompress { false };
+    size_t thread_count { 1 };
 
     Core::ArgsParser args_parser;
     args_parser.add_option(keep_input_files, "Keep (don't delete) input files", "keep", 'k');
     args_parser.add_option(write_to_stdout, "Write to stdout, keep original files unchanged", "stdout", 'c');
     args_parser.add_option(decompress, "Decompress", "decompress", 'd');
+    args_parser.add_option(thread_count, "Number of threads to compress with", "threads", 'p', "count");
     args_parser.add_positional_argument(filenames, "Files", "FILES");
     args_parser.parse(arguments);
 
@@ -46,7 +48,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         if (decompress)
             TRY(Compress::GzipDecompressor::decompress_file(input_filename, move(output_stream)));
         else
-            TRY(Compress::GzipCompressor::compress_file(input_filename, move(output_stream)));
+            TRY(Compress::GzipCompressor::compress_file(input_filename, move(output_stream), thread_count));
 
         if (!keep_input_files) {
             TRY(Core::System::unlink(input_filename));
@@ -66,6 +66,15 @@ static ErrorOr<void> crop_image(LoadedImage& image, Gfx::IntRect const& rect)
     return {};
 }
 
+static ErrorOr<void> resize_image(LoadedImage& image, Gfx::IntSize size, Gfx::ResamplingFilter filter)
+{
+    if (!image.bitmap.has<RefPtr<Gfx::Bitmap>>())
+        return Error::from_string_view("Can't --resize CMYK bitmaps yet"sv);
+    auto& frame = image.bitmap.get<RefPtr<Gfx::Bitmap>>();
+    frame = TRY(frame->scaled_to_size(size, filter));
+    return {};
+}
+
 static ErrorOr<void> move_alpha_to_rgb(LoadedImage& image)
 {
     if (!image.bitmap.has<RefPtr<Gfx::Bitmap>>())
@@ -199,6 +208,8 @@ struct Options {
     int frame_index = 0;
     bool invert_cmyk = false;
     Optional<Gfx::IntRect> crop_rect;
+    Optional<Gfx::IntSize> resize_size;
+    Gfx::ResamplingFilter resize_filter = Gfx::ResamplingFilter::Lanczos3;
     bool move_alpha_to_rgb = false;
     bool strip_alpha = false;
     StringView assign_color_profile_path;
@@ -230,6 +241,25 @@ static ErrorOr<Gfx::IntRect> parse_rect_string(StringView rect_string)
     return Gfx::IntRect { numbers[0], numbers[1], numbers[2], numbers[3] };
 }
 
+static ErrorOr<Gfx::IntSize> parse_size_string(StringView size_string)
+{
+    auto numbers = TRY(parse_comma_separated_numbers<i32>(size_string));
+    if (numbers.size() != 2)
+        return Error::from_string_view("size must have 2 comma-separated parts"sv);
+    if (numbers[0] <= 0 || numbers[1] <= 0)
+        return Error::from_string_view("size must be positive"sv);
+    return Gfx::IntSize { numbers[0], numbers[1] };
+}
+
+static ErrorOr<Gfx::ResamplingFilter> parse_resampling_filter(StringView filter_name)
+{
+    if (filter_name == "lanczos3"sv)
+        return Gfx::ResamplingFilter::Lanczos3;
+    if (filter_name == "mitchell"sv)
+        return Gfx::ResamplingFilter::Mitchell;
+    return Error::from_string_view("resize filter must be one of lanczos3, mitchell"sv);
+}
+
 static ErrorOr<Options> parse_options(Main::Arguments arguments)
 {
     Options options;
@@ -241,6 +271,10 @@ static ErrorOr<Options> parse_options(Main::Arguments arguments)
     args_parser.add_option(options.invert_cmyk, "Invert CMYK channels", "invert-cmyk", {});
     StringView crop_rect_string;
     args_parser.add_option(crop_rect_string, "Crop to a rectangle", "crop", {}, "x,y,w,h");
+    StringView resize_size_string;
+    args_parser.add_option(resize_size_string, "Resize to a size, after cropping", "resize", {}, "w,h");
+    StringView resize_filter_string;
+    args_parser.add_option(resize_filter_string, "Filter used by --resize, lanczos3 (the default) or mitchell", "resize-filter", {}, "FILTER");
     args_parser.add_option(options.move_alpha_to_rgb, "Copy alpha channel to rgb, clear alpha", "move-alpha-to-rgb", {});
     args_parser.add_option(options.strip_alpha, "Remove alpha channel", "strip-alpha", {});
     args_parser.add_option(options.assign_color_profile_path, "Load color profile from file and assign it to output image", "assign-color-profile", {}, "FILE");
@@ -256,6 +290,12 @@ static ErrorOr<Options> parse_options(Main::Arguments arguments)
     if (!crop_rect_string.is_empty())
         options.crop_rect = TRY(parse_rect_string(crop_rect_string));
 
+    if (!resize_size_string.is_empty())
+        options.resize_size = TRY(parse_size_string(resize_size_string));
+
+    if (!resize_filter_string.is_empty())
+        options.resize_filter = TRY(parse_resampling_filter(resize_filter_string));
+
     return options;
 }
 
@@ -276,6 +316,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     if (options.crop_rect.has_value())
         TRY(crop_image(image, options.crop_rect.value()));
 
+    if (options.resize_size.has_value())
+        TRY(resize_image(image, options.resize_size.value(), options.resize_filter));
+
     if (options.move_alpha_to_rgb)
         TRY(move_alpha_to_rgb(image));
 
@@ -8,6 +8,7 @@
 #include <AK/ByteString.h>
 #include <AK/HashMap.h>
 #include <AK/LexicalPath.h>
+#include <AK/MemoryStream.h>
 #include <AK/Span.h>
 #include <AK/Vector.h>
 #include <LibArchive/TarStream.h>
@@ -39,6 +40,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool no_auto_compress = false;
     StringView archive_file;
     bool dereference = false;
+    size_t thread_count = 1;
     StringView directory;
     Vector<ByteString> paths;
 
@@ -54,6 +56,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(directory, "Directory to extract to/create from", "directory", 'C', "DIRECTORY");
     args_parser.add_option(archive_file, "Archive file", "file", 'f', "FILE");
     args_parser.add_option(dereference, "Follow symlinks", "dereference", 'h');
+    args_parser.add_option(thread_count, "Number of threads to decompress xz archives with", "threads", 'T', "count");
     args_parser.add_positional_argument(paths, "Paths", "PATHS", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -83,8 +86,16 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         if (lzma)
             input_stream = TRY(Compress::LzmaDecompressor::create_from_container(move(input_stream)));
 
-        if (xz)
+        if (xz && thread_count > 1) {
+            // The blocks can only be located through the index at the end of the archive, so read all of it first.
+            auto compressed = TRY(input_stream->read_until_eof());
+            auto decompressed = TRY(Compress::XzDecompressor::decompress_all_in_parallel(compressed, thread_count));
+            auto decompressed_stream = TRY(try_make<AllocatingMemoryStream>());
+            TRY(decompressed_stream->write_until_depleted(decompressed));
+            input_stream = move(decompressed_stream);
+        } else if (xz) {
             input_stream = TRY(Compress::XzDecompressor::create(move(input_stream)));
+        }
 
         auto tar_stream = TRY(Archive::TarInputStream::construct(move(input_stream)));
 
@@ -238,7 +249,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             output_stream = TRY(Compress::LzmaCompressor::create_container(move(output_stream), {}));
 
         if (xz)
-            TODO();
+            output_stream = TRY(Compress::XzCompressor::create(move(output_stream)));
 
         Archive::TarOutputStream tar_stream(move(output_stream));
 
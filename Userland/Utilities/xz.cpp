@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCompress/Xz.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibMain/Main.h>
+
+static ErrorOr<void> compress(Core::File& input, NonnullOwnPtr<Core::File> output, u8 level)
+{
+    auto compressor = TRY(Compress::XzCompressor::create(move(output), Compress::LzmaCompressorOptions::preset(level)));
+
+    // Arbitrarily chosen buffer size.
+    auto buffer = TRY(ByteBuffer::create_uninitialized(64 * KiB));
+    while (!input.is_eof()) {
+        auto slice = TRY(input.read_some(buffer));
+        TRY(compressor->write_until_depleted(slice));
+    }
+
+    TRY(compressor->finish());
+    return {};
+}
+
+static ErrorOr<void> decompress(NonnullOwnPtr<Core::File> input, Core::File& output, size_t thread_count)
+{
+    if (thread_count > 1) {
+        // The blocks can only be located through the index at the end of the file, so read all of it first.
+        auto compressed = TRY(input->read_until_eof());
+        auto decompressed = TRY(Compress::XzDecompressor::decompress_all_in_parallel(compressed, thread_count));
+        TRY(output.write_until_depleted(decompressed));
+        return {};
+    }
+
+    auto buffered_input = TRY(Core::InputBufferedFile::create(move(input)));
+    auto decompressor = TRY(Compress::XzDecompressor::create(move(buffered_input)));
+
+    // Arbitrarily chosen buffer size.
+    auto buffer = TRY(ByteBuffer::create_uninitialized(64 * KiB));
+    while (!decompressor->is_eof()) {
+        auto slice = TRY(decompressor->read_some(buffer));
+        TRY(output.write_until_depleted(slice));
+    }
+
+    return {};
+}
+
+ErrorOr<int> serenity_main(Main::Arguments arguments)
+{
+    TRY(Core::System::pledge("stdio rpath wpath cpath thread"));
+
+    Vector<StringView> filenames;
+    bool keep_input_files { false };
+    bool write_to_stdout { false };
+    bool decompress_files { false };
+    size_t thread_count { 1 };
+    u8 level { 6 };
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Compress or decompress files in the XZ format");
+    args_parser.add_option(keep_input_files, "Keep (don't delete) input files", "keep", 'k');
+    args_parser.add_option(write_to_stdout, "Write to stdout, keep original files unchanged", "stdout", 'c');
+    args_parser.add_option(decompress_files, "Decompress", "decompress", 'd');
+    args_parser.add_option(thread_count, "Number of threads to decompress with", "threads", 'T', "count");
+
+    // The levels are passed as "-0" to "-9", like for other compressors. Only the extremes are listed in the help.
+    for (u8 option_level = 0; option_level <= 9; option_level++) {
+        args_parser.add_option({
+            .argument_mode = Core::ArgsParser::OptionArgumentMode::None,
+            .help_string = option_level == 0 ? "Compress as fast as possible" : "Compress as well as possible (the default is -6)",
+            .short_name = static_cast<char>('0' + option_level),
+            .accept_value = [&level, option_level](StringView) {
+                level = option_level;
+                return true;
+            },
+            .hide_mode = option_level == 0 || option_level == 9 ? Core::ArgsParser::OptionHideMode::None : Core::ArgsParser::OptionHideMode::CommandLineAndMarkdown,
+        });
+    }
+
+    args_parser.add_positional_argument(filenames, "Files", "FILES", Core::ArgsParser::Required::No);
+    args_parser.parse(arguments);
+
+    if (filenames.is_empty()) {
+        auto input = TRY(Core::File::standard_input());
+        auto output = TRY(Core::File::standard_output());
+        if (decompress_files)
+            TRY(decompress(move(input), *output, thread_count));
+        else
+            TRY(compress(*input, move(output), level));
+        return 0;
+    }
+
+    if (write_to_stdout)
+        keep_input_files = true;
+
+    for (auto const& input_filename : filenames) {
+        ByteString output_filename;
+        if (decompress_files) {
+            if (!input_filename.ends_with(".xz"sv)) {
+                warnln("unknown suffix for: {}, skipping", input_filename);
+                continue;
+            }
+            output_filename = input_filename.substring_view(0, input_filename.length() - ".xz"sv.length());
+        } else {
+            output_filename = ByteString::formatted("{}.xz", input_filename);
+        }
+
+        auto input = TRY(Core::File::open(input_filename, Core::File::OpenMode::Read));
+        auto output = write_to_stdout ? TRY(Core::File::standard_output()) : TRY(Core::File::open(output_filename, Core::File::OpenMode::Write));
+
+        if (decompress_files)
+            TRY(decompress(move(input), *output, thread_count));
+        else
+            TRY(compress(*input, move(output), level));
+
+        if (!keep_input_files)
+            TRY(Core::System::unlink(input_filename));
+    }
+
+    return 0;
+}
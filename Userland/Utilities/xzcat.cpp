@@ -12,16 +12,27 @@
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("rpath stdio"));
+    TRY(Core::System::pledge("rpath stdio thread"));
 
     StringView filename;
+    size_t thread_count { 1 };
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("Decompress and print an XZ archive");
+    args_parser.add_option(thread_count, "Number of threads to decompress with", "threads", 'T', "count");
     args_parser.add_positional_argument(filename, "File to decompress", "file");
     args_parser.parse(arguments);
 
     auto file = TRY(Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read));
+
+    if (thread_count > 1) {
+        // The blocks can only be located through the index at the end of the file, so read all of it first.
+        auto compressed = TRY(file->read_until_eof());
+        auto decompressed = TRY(Compress::XzDecompressor::decompress_all_in_parallel(compressed, thread_count));
+        out("{:s}", decompressed.bytes());
+        return 0;
+    }
+
     auto buffered_file = TRY(Core::InputBufferedFile::create(move(file)));
     auto stream = TRY(Compress::XzDecompressor::create(move(buffered_file)));
 